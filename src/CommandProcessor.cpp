@@ -23,6 +23,7 @@
 #include "CommandProcessor.hpp"
 #include "memdebug.h"
 
+#include "AfList.hpp"
 #include "AudioMode.hpp"
 #include "AudioMute.hpp"
 #include "ControllerMgr.h"
@@ -35,33 +36,38 @@
 #include "PiCode.hpp"
 #include "ProgramServiceName.hpp"
 #include "PtyCode.hpp"
+#include "RadioCalibrate.hpp"
 #include "RdsReset.hpp"
 #include "RebootControl.hpp"
 #include "RfCarrier.hpp"
 #include "RdsMessageOrder.hpp"
+#include "RdsMessageWeights.hpp"
 
 typedef bool(cCommandProcessor::*CmdHandler)(String & Parameter, String & ResponseMessage);
 std::map <String, CmdHandler> ListOfCommands
 {
-    {"aud",      & cCommandProcessor::audioMode},
-    {"freq",     & cCommandProcessor::frequency},
-    {"gpio19",   & cCommandProcessor::gpio19},
-    {"gpio23",   & cCommandProcessor::gpio23},
-    {"gpio33",   & cCommandProcessor::gpio33},
-    {"mute",     & cCommandProcessor::mute},
-    {"pic",      & cCommandProcessor::piCode},
-    {"rtper",    & cCommandProcessor::rdsTimePeriod},
-    {"psn",      & cCommandProcessor::programServiceName},
-    {"pty",      & cCommandProcessor::ptyCode},
-    {"reboot",   & cCommandProcessor::reboot},
-    {"rfc",      & cCommandProcessor::rfCarrier},
-    {"rtm",      & cCommandProcessor::radioText},
-    {"msgorder", & cCommandProcessor::MsgOrder},
-    {"start",    & cCommandProcessor::start},
-    {"stop",     & cCommandProcessor::stop},
-    {"?",        & cCommandProcessor::HelpCommand},
-    {"h",        & cCommandProcessor::HelpCommand},
-    {"help",     & cCommandProcessor::HelpCommand},
+    {"af",         & cCommandProcessor::afList},
+    {"aud",        & cCommandProcessor::audioMode},
+    {"freq",       & cCommandProcessor::frequency},
+    {"gpio19",     & cCommandProcessor::gpio19},
+    {"gpio23",     & cCommandProcessor::gpio23},
+    {"gpio33",     & cCommandProcessor::gpio33},
+    {"mute",       & cCommandProcessor::mute},
+    {"pic",        & cCommandProcessor::piCode},
+    {"rtper",      & cCommandProcessor::rdsTimePeriod},
+    {"psn",        & cCommandProcessor::programServiceName},
+    {"pty",        & cCommandProcessor::ptyCode},
+    {"recal",      & cCommandProcessor::recalibrate},
+    {"reboot",     & cCommandProcessor::reboot},
+    {"rfc",        & cCommandProcessor::rfCarrier},
+    {"rtm",        & cCommandProcessor::radioText},
+    {"msgorder",   & cCommandProcessor::MsgOrder},
+    {"msgweights", & cCommandProcessor::MsgWeights},
+    {"start",      & cCommandProcessor::start},
+    {"stop",       & cCommandProcessor::stop},
+    {"?",          & cCommandProcessor::HelpCommand},
+    {"h",          & cCommandProcessor::HelpCommand},
+    {"help",       & cCommandProcessor::HelpCommand},
 };
 
 #define CMD_LOG_RST_STR F ("restore")
@@ -110,6 +116,17 @@ bool cCommandProcessor::ProcessCommand (
     return response;
 }
 
+// *************************************************************************************************************************
+bool cCommandProcessor::afList (String & payloadStr, String & ResponseMessage)
+{
+    // DEBUG_START;
+
+    bool response = AfList.set (payloadStr, ResponseMessage, false, false);
+
+    // DEBUG_END;
+    return response;
+}
+
 // *************************************************************************************************************************
 bool cCommandProcessor::audioMode (String & payloadStr, String & ResponseMessage)
 {
@@ -177,6 +194,7 @@ bool cCommandProcessor::HelpCommand (String & payloadStr, String & ResponseMessa
     ResponseMessage += ("=========================================\n");
     ResponseMessage += ("**      CONTROLLER COMMAND SUMMARY     **\n");
     ResponseMessage += ("=========================================\n");
+    ResponseMessage += (" ALT FREQUENCIES : af=88.1,88.3 (up to 25, blank = none)\n");
     ResponseMessage += (" AUDIO MODE      : aud=mono : stereo\n");
     ResponseMessage += (" FREQUENCY       : freq=88.1<->107.9\n");
     ResponseMessage += (" GPIO-19 CONTROL : gpio19=read : outhigh : outlow\n");
@@ -188,7 +206,9 @@ bool cCommandProcessor::HelpCommand (String & payloadStr, String & ResponseMessa
     ResponseMessage += (" PROG SERV NAME  : psn=[8 char station name]\n");
     ResponseMessage += (" RADIOTXT MSG    : rtm=[64 char message]\n");
     ResponseMessage += (" RADIOTXT PERIOD : rtper=5 <-> 900 secs\n");
-    ResponseMessage += (" MESSAGE ORDER   : priority : round robin\n");
+    ResponseMessage += (" MESSAGE ORDER   : msgorder=priority : round robin : deficit round robin : earliest deadline\n");
+    ResponseMessage += (" MESSAGE WEIGHTS : msgweights=1,1,1,1,1,1 (1 <-> 16 for usb,gpio,mqtt,fppd,http,local)\n");
+    ResponseMessage += (" RF PORT RECAL   : recal=now\n");
     ResponseMessage += (" REBOOT SYSTEM   : reboot=system\n");
     ResponseMessage += (" START RDS       : start=rds\n");
     ResponseMessage += (" STOP RDS        : stop=rds\n");
@@ -299,6 +319,18 @@ bool cCommandProcessor::rdsTimePeriod (String & payloadStr, String & ResponseMes
     return response;
 }
 
+// *************************************************************************************************************************
+// recalibrate(): Force a full QN8027 antenna calibration, replacing the saved calibration.
+bool cCommandProcessor::recalibrate (String & payloadStr, String & ResponseMessage)
+{
+    // DEBUG_START;
+
+    bool response = RadioCalibrate.set (payloadStr, ResponseMessage, false, false);
+
+    // DEBUG_END;
+    return response;
+}
+
 // *************************************************************************************************************************
 bool cCommandProcessor::reboot (String & payloadStr, String & ResponseMessage)
 {
@@ -354,5 +386,16 @@ bool cCommandProcessor::MsgOrder (String & payloadStr, String & ResponseMessage)
     return response;
 }
 
+// *************************************************************************************************************************
+bool cCommandProcessor::MsgWeights (String & payloadStr, String & ResponseMessage)
+{
+    // DEBUG_START;
+
+    bool response = RdsMessageWeights.set (payloadStr, ResponseMessage, false, false);
+
+    // DEBUG_END;
+    return response;
+}
+
 // *************************************************************************************************************************
 // EOF
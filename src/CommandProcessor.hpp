@@ -24,6 +24,7 @@ class cCommandProcessor
 {
 public:
 
+    bool    afList             (String & payloadStr, String & ResponseMessage);
     bool    audioMode          (String & payloadStr, String & ResponseMessage);
     bool    frequency          (String & payloadStr, String & ResponseMessage);
     bool    gpio19             (String & payloadStr, String & ResponseMessage);
@@ -37,11 +38,13 @@ public:
     bool    programServiceName (String & payloadStr, String & ResponseMessage);
     bool    radioText          (String & payloadStr, String & ResponseMessage);
     bool    rdsTimePeriod      (String & payloadStr, String & ResponseMessage);
+    bool    recalibrate        (String & payloadStr, String & ResponseMessage);
     bool    reboot             (String & payloadStr, String & ResponseMessage);
     bool    rfCarrier          (String & payloadStr, String & ResponseMessage);
     bool    start              (String & payloadStr, String & ResponseMessage);
     bool    stop               (String & payloadStr, String & ResponseMessage);
     bool    MsgOrder           (String & payloadStr, String & ResponseMessage);
+    bool    MsgWeights         (String & payloadStr, String & ResponseMessage);
     bool    HelpCommand        (String & payloadStr, String & ResponseMessage);
 
 public:
@@ -22,6 +22,8 @@
 #include "SequenceLearning.hpp"
 #include "CurrentSequence.hpp"
 #include "FPPDiscovery.h"
+#include "FseqMetaCache.hpp"
+#include "RdsText.hpp"
 #include "language.h"
 
 #include "memdebug.h"
@@ -57,11 +59,21 @@ void c_ControllerFPPD::begin ()
     Sequences.begin ();
 
     FPPDiscovery.begin (
-        [] (String & FppdFileName, void * param)
+        [] (const cFppPacketView::Name_t & SequenceName, float SecondsElapsed, void * param)
         {
             if (param)
             {
-                reinterpret_cast <c_ControllerFPPD *> (param)->ProcessFppdFile (FppdFileName);
+                reinterpret_cast <c_ControllerFPPD *> (param)->ProcessFppdFile (SequenceName, SecondsElapsed);
+            }
+        },
+        this);
+
+    FseqMetaCache.begin (
+        [] (const String & SequenceName, const cFseqHeader & Header, void * param)
+        {
+            if (param)
+            {
+                reinterpret_cast <c_ControllerFPPD *> (param)->Sequences.SetLearnedDuration (SequenceName, Header.DurationMs ());
             }
         },
         this);
@@ -90,7 +102,7 @@ bool c_ControllerFPPD::GetNextRdsMessage (const String &, c_ControllerMgr::RdsMs
         if (!CurrentPlayingSequenceName.isEmpty ())
         {
             // DEBUG_V("Get next message");
-            AllMessagesPlayed = Sequences.GetNextRdsMessage (CurrentPlayingSequenceName, Response);
+            AllMessagesPlayed = Sequences.GetNextRdsMessage (CurrentPlayingSequenceName, CurrentPlayingSequenceHash, Response);
         }
     } while (false);
 
@@ -99,56 +111,242 @@ bool c_ControllerFPPD::GetNextRdsMessage (const String &, c_ControllerMgr::RdsMs
 }
 
 // *********************************************************************************************
-void c_ControllerFPPD::ProcessFppdFile (String & FppdFileName)
+// GetSequenceLengthMs(): From the FSEQ header if the file is here, else as long as it ran last time.
+uint32_t c_ControllerFPPD::GetSequenceLengthMs ()
 {
     // DEBUG_START;
 
-    // normalize the name
-    String TempName = FppdFileName;
-    TempName.toLowerCase ();
-    String FinalName = FppdFileName.substring (0, TempName.lastIndexOf (".fseq"));
+    uint32_t Response = FseqMetaCache.GetDurationMs (CurrentPlayingSequenceName);
 
-    struct timeval tv;
-    gettimeofday (& tv, NULL);
-    BlankTime = tv.tv_sec + BLANK_DELAY;
+    if (0 == Response)
+    {
+        auto Entry = History.find (SyncSequenceHash);
+        Response = (History.end () == Entry) ? 0 : Entry->second.LengthMs;
+    }
 
-    // DEBUG_V(String("   BlankTime: '") + String(BlankTime) + "'");
-    // DEBUG_V(String("FppdFileName: '") + FppdFileName + "'");
-    // DEBUG_V(String("   FinalName: '") + FinalName + "'");
-    if (!FinalName.equals (CurrentPlayingSequenceName))
+    // DEBUG_V(String("Sequence length: ") + String(Response));
+
+    // DEBUG_END;
+    return Response;
+}   // GetSequenceLengthMs
+
+// *********************************************************************************************
+// LearnSequenceEnd(): The sequence in SequenceHash ran for PlayedMs and NextSequenceName followed it.
+void c_ControllerFPPD::LearnSequenceEnd (uint32_t SequenceHash, uint32_t PlayedMs, const cFppPacketView::Name_t & NextSequenceName)
+{
+    // DEBUG_START;
+
+    if ((History.size () >= FPPD_HISTORY_SIZE) && (History.end () == History.find (SequenceHash)))
+    {
+        // DEBUG_V("History is full. Forget one entry");
+        History.erase (History.begin ());
+    }
+
+    SequenceHistory_t & Entry = History[SequenceHash];
+
+    Entry.LengthMs = PlayedMs;
+
+    if (NextSequenceName.Equals (Entry.NextName.c_str (), Entry.NextName.length (), Entry.NextHash))
+    {
+        Entry.NextCount = (Entry.NextCount < 0xFF) ? (Entry.NextCount + 1) : Entry.NextCount;
+    }
+    else
+    {
+        Entry.NextName = emptyString;
+        Entry.NextName.concat (NextSequenceName.Text, NextSequenceName.Length);
+        Entry.NextHash  = NextSequenceName.Hash;
+        Entry.NextCount = 1;
+    }
+
+    // DEBUG_END;
+}   // LearnSequenceEnd
+
+// *********************************************************************************************
+// poll(): FPP packets are queued by the network task and handled here.
+void c_ControllerFPPD::poll ()
+{
+    // _ DEBUG_START;
+
+    FPPDiscovery.poll ();
+    PredictSequenceChange (millis ());
+
+    // _ DEBUG_END;
+}   // poll
+
+// *********************************************************************************************
+// PredictSequenceChange(): At the predicted end of the sequence, put up the text of the sequence
+// that followed it the last few times, so it is on the air when FPP starts that sequence. The next
+// sync packet corrects a wrong guess.
+void c_ControllerFPPD::PredictSequenceChange (uint32_t now)
+{
+    // _ DEBUG_START;
+
+    do  // once
     {
-        // DEBUG_V(String("New File: '") + FinalName + "'");
-        CurrentPlayingSequenceName = FinalName;
+        if (ChangePredicted || (0 == SequenceLengthMs) || ((now - PlayStartMs) < SequenceLengthMs))
+        {
+            // _ DEBUG_V("Nothing to predict yet");
+            break;
+        }
+
+        ChangePredicted = true;
+
+        auto Entry = History.find (SyncSequenceHash);
 
-        if (CurrentPlayingSequenceName.isEmpty ())
+        if ((History.end () == Entry) || (Entry->second.NextCount < FPPD_PREDICT_MIN_COUNT))
         {
-            // DEBUG_V("No sequence playing");
-            CurrentSequence.setMessage (F ("No Sequence Playing"), eCssStyle::CssStyleTransparent);
+            // DEBUG_V("No reliable successor");
+            break;
         }
-        else
+
+        if (Entry->second.NextHash == CurrentPlayingSequenceHash)
         {
-            CurrentSequence.setMessage (CurrentPlayingSequenceName, eCssStyle::CssStyleWhite);
+            // DEBUG_V("Successor is already on the air");
+            break;
+        }
+
+        // DEBUG_V(String("Predicted next sequence: '") + Entry->second.NextName + "'");
+        SetCurrentSequence (Entry->second.NextName.c_str (), Entry->second.NextName.length (), Entry->second.NextHash);
+    } while (false);
+
+    // _ DEBUG_END;
+}   // PredictSequenceChange
+
+// *********************************************************************************************
+// ProcessFppdFile(): SequenceName has already had the ".fseq" extension removed. Repeats of the
+// current sequence are found by hash and cost no allocation. FPP sends a stop (empty name) at the
+// end of every sequence, so the successor is learned from the start that follows the stop.
+void c_ControllerFPPD::ProcessFppdFile (const cFppPacketView::Name_t & SequenceName, float SecondsElapsed)
+{
+    // DEBUG_START;
+
+    uint32_t    now         = millis ();
+    uint32_t    PositionMs  = (SecondsElapsed > 0.0) ? uint32_t (SecondsElapsed * 1000.0) : 0;
+    uint32_t    NoSequence  = cFppPacketView::Name_t ().Hash;
+    bool        Stopped     = SequenceName.IsEmpty ();
+
+    // A stop at or after the predicted end leaves the predicted successor on the air.
+    bool KeepPrediction = Stopped && ChangePredicted &&
+                          (CurrentPlayingSequenceHash != SyncSequenceHash) && (CurrentPlayingSequenceHash != NoSequence);
 
-            // DEBUG_V(String("SequenceLearningEnabled: ") + String(SequenceLearning.getBool ()));
-            if (SequenceLearning.getBool ())
+    if ((SequenceName.Hash != SyncSequenceHash) || ((PositionMs + FPPD_RESTART_MS) < SyncPositionMs))
+    {
+        // DEBUG_V("FPP started or stopped a sequence");
+        if (NoSequence != SyncSequenceHash)
+        {
+            if (Stopped)
             {
-                // DEBUG_V("Learn Message");
-                Sequences.LearnSequenceName (CurrentPlayingSequenceName);
+                // DEBUG_V("Learn the successor when the next sequence starts");
+                PendingEndHash      = SyncSequenceHash;
+                PendingPlayedMs     = now - PlayStartMs;
             }
             else
             {
-                // DEBUG_V("Not allowed to Learn Message");
+                LearnSequenceEnd (SyncSequenceHash, now - PlayStartMs, SequenceName);
             }
         }
+        else if (!Stopped && (NoSequence != PendingEndHash))
+        {
+            LearnSequenceEnd (PendingEndHash, PendingPlayedMs, SequenceName);
+        }
+
+        if (!Stopped)
+        {
+            PendingEndHash = NoSequence;
+        }
+
+        SyncSequenceHash    = SequenceName.Hash;
+        SequenceLengthMs    = 0;
+        ChangePredicted     = false;
+    }
+
+    SyncPositionMs  = PositionMs;
+    PlayStartMs     = now - PositionMs;
+
+    if (KeepPrediction)
+    {
+        // DEBUG_V("Keep the predicted sequence on the air");
+    }
+    else if (!SequenceName.Equals (CurrentPlayingSequenceName.c_str (), CurrentPlayingSequenceName.length (), CurrentPlayingSequenceHash))
+    {
+        SetCurrentSequence (SequenceName.Text, SequenceName.Length, SequenceName.Hash);
     }
     else
     {
         // DEBUG_V("Message Already in progress");
     }
 
+    if (!SequenceName.IsEmpty () && (0 == SequenceLengthMs))
+    {
+        SequenceLengthMs = GetSequenceLengthMs ();
+    }
+
+    // Keep the text up until the sequence should have ended, even if some sync packets are lost.
+    // After a stop the text stays up for BLANK_DELAY, in case the next sequence follows right away.
+    time_t HoldSec = BLANK_DELAY + ((SequenceLengthMs > PositionMs) ? ((SequenceLengthMs - PositionMs) / 1000) : 0);
+
+    struct timeval tv;
+    gettimeofday (& tv, NULL);
+    BlankTime = tv.tv_sec + HoldSec;
+    // DEBUG_V(String("   BlankTime: '") + String(BlankTime) + "'");
+
     // DEBUG_END;
 }   // ProcessFppdFile
 
+// *********************************************************************************************
+// RefreshRadioText(): Replace the FPPD text on the air now instead of when its duration runs out.
+void c_ControllerFPPD::RefreshRadioText ()
+{
+    // DEBUG_START;
+
+    c_ControllerMgr::ControllerTypeId_t SendingId = ControllerMgr.GetCurrentSendingControllerId ();
+
+    if ((FppdControllerId == SendingId) || (CtypeId::NO_CNTRL == SendingId))
+    {
+        // DEBUG_V("Refresh");
+        RdsText.Refresh ();
+    }
+
+    // DEBUG_END;
+}   // RefreshRadioText
+
+// *********************************************************************************************
+// SetCurrentSequence(): Select the message set that goes on the air.
+void c_ControllerFPPD::SetCurrentSequence (const char * SequenceName, size_t Length, uint32_t Hash)
+{
+    // DEBUG_START;
+
+    CurrentPlayingSequenceName = emptyString;
+    CurrentPlayingSequenceName.concat (SequenceName, Length);
+    CurrentPlayingSequenceHash = Hash;
+    // DEBUG_V(String("New File: '") + CurrentPlayingSequenceName + "'");
+
+    if (CurrentPlayingSequenceName.isEmpty ())
+    {
+        // DEBUG_V("No sequence playing");
+        CurrentSequence.setMessage (F ("No Sequence Playing"), eCssStyle::CssStyleTransparent);
+    }
+    else
+    {
+        CurrentSequence.setMessage (CurrentPlayingSequenceName, eCssStyle::CssStyleWhite);
+
+        // DEBUG_V(String("SequenceLearningEnabled: ") + String(SequenceLearning.getBool ()));
+        if (SequenceLearning.getBool ())
+        {
+            // DEBUG_V("Learn Message");
+            Sequences.LearnSequenceName (CurrentPlayingSequenceName);
+        }
+        else
+        {
+            // DEBUG_V("Not allowed to Learn Message");
+        }
+    }
+
+    RefreshRadioText ();
+
+    // DEBUG_END;
+}   // SetCurrentSequence
+
 // *********************************************************************************************
 void c_ControllerFPPD::restoreConfiguration (ArduinoJson::JsonObject & config)
 {
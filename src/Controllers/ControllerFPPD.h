@@ -21,6 +21,8 @@
 
 #include "ControllerCommon.h"
 #include "ControllerFPPDSequences.h"
+#include "FppPacketView.hpp"
+#include <map>
 
 class c_ControllerFPPD : public cControllerCommon
 {
@@ -30,7 +32,8 @@ public:
     virtual~c_ControllerFPPD ();
 
     void    begin ();
-    void    ProcessFppdFile (String & FppdFileName);
+    void    poll ();
+    void    ProcessFppdFile (const cFppPacketView::Name_t & SequenceName, float SecondsElapsed);
 
     void    AddControls (uint16_t ctrlTab, ControlColor color);
     void    restoreConfiguration (ArduinoJson::JsonObject & config);
@@ -40,16 +43,44 @@ public:
 
 private:
 
-    void updateVisibility ();
+    void        updateVisibility ();
+    uint32_t    GetSequenceLengthMs ();
+    void        LearnSequenceEnd (uint32_t SequenceHash, uint32_t PlayedMs, const cFppPacketView::Name_t & NextSequenceName);
+    void        PredictSequenceChange (uint32_t now);
+    void        RefreshRadioText ();
+    void        SetCurrentSequence (const char * SequenceName, size_t Length, uint32_t Hash);
 
     uint16_t                    SequencesElementId          = Control::noParent;
     uint16_t                    CurrentSequenceElementId    = Control::noParent;
 
     bool                        ControlsHaveBeenAdded = false;
     String                      CurrentPlayingSequenceName;
+    uint32_t                    CurrentPlayingSequenceHash = cFppPacketView::Name_t ().Hash;
     time_t                      BlankTime = 0;
     #define BLANK_DELAY 5
 
+    // Playback position, tracked from the sync packets.
+    #define FPPD_RESTART_MS         2000    // Position moved back this far: the sequence started over.
+    uint32_t                    SyncSequenceHash    = cFppPacketView::Name_t ().Hash;
+    uint32_t                    SyncPositionMs      = 0;
+    uint32_t                    PlayStartMs         = 0;        // millis() at position 0 of the sequence.
+    uint32_t                    SequenceLengthMs    = 0;        // 0 == Not known (yet).
+    bool                        ChangePredicted     = false;
+    uint32_t                    PendingEndHash      = cFppPacketView::Name_t ().Hash;   // Stopped, successor not seen yet.
+    uint32_t                    PendingPlayedMs     = 0;
+
+    // What happened at the end of each sequence, keyed by name hash. Learned while running, not saved.
+    #define FPPD_HISTORY_SIZE       32
+    #define FPPD_PREDICT_MIN_COUNT  2       // A successor must follow this many times in a row before it is predicted.
+    struct SequenceHistory_t
+    {
+        uint32_t    LengthMs    = 0;
+        String      NextName;
+        uint32_t    NextHash    = 0;
+        uint8_t     NextCount   = 0;        // Times in a row NextName followed this sequence.
+    };
+    std::map <uint32_t, SequenceHistory_t> History;
+
     c_ControllerFPPDSequences   Sequences;
 };  // c_ControllerFPPD
 
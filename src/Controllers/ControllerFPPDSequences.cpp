@@ -18,6 +18,7 @@
 
 // *********************************************************************************************
 #include "ControllerFPPDSequences.h"
+#include "FseqMetaCache.hpp"
 
 #include "memdebug.h"
 
@@ -28,6 +29,12 @@ static const PROGMEM char   DefaultTextFieldValue []    = "Type New Sequence Nam
 c_ControllerFPPDSequences::c_ControllerFPPDSequences ()
 {
     // DEBUG_START;
+
+    SequencesSemaphore = xSemaphoreCreateRecursiveMutex ();
+
+    // Message sets are named after their sequence. Tag that name in the RadioText.
+    ControllerMessages.SetRtPlusTagging (true);
+
     // DEBUG_END;
 }   // c_ControllerFPPDSequences
 
@@ -42,12 +49,16 @@ void c_ControllerFPPDSequences::Activate ()
 
     // DEBUG_V(String("Activate SelectedSequenceName ") + SelectedSequenceName);
 
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     for (auto & CurrentSequence : Sequences)
     {
         // DEBUG_V(String("Activate Sequence: ") + CurrentSequence.first);
         CurrentSequence.second.Activate (CurrentSequence.first.equals (SelectedSequenceName));
     }
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_END;
 }   // Activate
 
@@ -150,12 +161,16 @@ void c_ControllerFPPDSequences::AddControls (uint16_t TabId, ControlColor color)
 
     ControllerMessages.AddControls (EspuiParentElementId);
 
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     for (auto & CurrentSequence : Sequences)
     {
         // DEBUG_V(String("Adding Controls for ") + CurrentSequence.first);
         CurrentSequence.second.AddControls (EspuiParentElementId, EspuiChoiceListElementId);
     }
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_V(String("Activate ") + SelectedSequenceName);
     ESPUI.updateSelect (EspuiChoiceListElementId, SelectedSequenceName);
     Activate ();
@@ -173,17 +188,23 @@ void c_ControllerFPPDSequences::AddSequence (String & SequenceName)
 
     SelectedSequenceName = SequenceName;
 
-    Sequences[SequenceName].SetMessages (& ControllerMessages);  // must be first
-    Sequences[SequenceName].SetName (SequenceName);
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
+    c_ControllerFPPDSequence & Sequence = GetSequence (SequenceName);
+
+    Sequence.SetMessages (& ControllerMessages);  // must be first
+    Sequence.SetName (SequenceName);
 
     if (Control::noParent != EspuiParentElementId)
     {
-        Sequences[SequenceName].AddControls (EspuiParentElementId, EspuiChoiceListElementId);
-        Sequences[SequenceName].Activate (true);
+        Sequence.AddControls (EspuiParentElementId, EspuiChoiceListElementId);
+        Sequence.Activate (true);
 
         CbTextChange (nullptr, 0);
     }
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_END;
 }
 
@@ -246,6 +267,9 @@ void c_ControllerFPPDSequences::CbButtonDelete (Control * sender, int type)
 
     // DEBUG_V(String("Choice value: '") + Key + "'");
 
+    // The loop task may be using this sequence (LearnSequenceName). Erase it only while nobody is.
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     do  // once
     {
         if (type != B_DOWN)
@@ -254,7 +278,7 @@ void c_ControllerFPPDSequences::CbButtonDelete (Control * sender, int type)
             break;
         }
 
-        if (Sequences.end () == Sequences.find (ChoiceControl->value))
+        if (nullptr == SequenceIndex.Find (Key))
         {
             // DEBUG_V("Name does not exist");
             // DEBUG_V(String("  Key: '") + ChoiceControl->value + "'");
@@ -266,7 +290,8 @@ void c_ControllerFPPDSequences::CbButtonDelete (Control * sender, int type)
         ESPUI.  updateControlValue (EspuiTextEntryElementId,    DefaultTextFieldValue);
         Activate ();
 
-        Sequences[Key].Activate (false);
+        GetSequence (Key).Activate (false);
+        SequenceIndex.Remove (Key);
         Sequences.erase (Key);
 
         // DEBUG_V(String("Set the Select List to ") + N_default);
@@ -279,6 +304,8 @@ void c_ControllerFPPDSequences::CbButtonDelete (Control * sender, int type)
         displaySaveWarning ();
     } while (false);
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_END;
 }   // ButtonDeleteCb
 
@@ -296,6 +323,9 @@ void c_ControllerFPPDSequences::CbButtonUpdate (Control * sender, int type)
 
     // DEBUG_V(String("Choice value: '") + OriginalSequenceName + "'");
 
+    // Both references must stay valid while the sequence is copied and renamed.
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     do  // once
     {
         if (type != B_DOWN)
@@ -305,13 +335,13 @@ void c_ControllerFPPDSequences::CbButtonUpdate (Control * sender, int type)
         }
 
         // DEBUG_V("Copy the old sequence into a new map entry");
-        Sequences[NewSequenceName] = Sequences[OriginalSequenceName];
+        GetSequence (NewSequenceName) = GetSequence (OriginalSequenceName);
 
         // DEBUG_V("Update the name in the copy");
-        Sequences[OriginalSequenceName].SetName (NewSequenceName);
+        GetSequence (OriginalSequenceName).SetName (NewSequenceName);
 
         // DEBUG_V("Activate the copy");
-        Sequences[NewSequenceName].Activate (true);
+        GetSequence (NewSequenceName).Activate (true);
 
         // DEBUG_V("Select the copy");
         ESPUI.updateSelect (EspuiChoiceListElementId, NewSequenceName);
@@ -320,6 +350,8 @@ void c_ControllerFPPDSequences::CbButtonUpdate (Control * sender, int type)
         displaySaveWarning ();
     } while (false);
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_END;
 }   // ButtonUpdateCb
 
@@ -413,7 +445,7 @@ void c_ControllerFPPDSequences::CbTextChange (Control *, int)
             break;
         }
 
-        if (Sequences.end () != Sequences.find (TextControl->value))
+        if (nullptr != SequenceIndex.Find (TextControl->value))
         {
             // DEBUG_V("Name exists and it is not the selected name");
             // DEBUG_V(String("  Key: '") + Sequences.find(TextControl->value)->first + "'");
@@ -438,15 +470,44 @@ void c_ControllerFPPDSequences::CbTextChange (Control *, int)
     // DEBUG_END;
 }   // TextChangeCb
 
+// *********************************************************************************************
+// GetSequence(): Find or create. New sequences are added to the hash index. UI callbacks and the
+// loop task (LearnSequenceName) both create sequences, so the lookup and the insert are one step.
+// The caller must hold SequencesSemaphore for as long as it uses the reference. The delete
+// button erases sequences from the UI task.
+c_ControllerFPPDSequence & c_ControllerFPPDSequences::GetSequence (const String & SequenceName)
+{
+    // DEBUG_START;
+
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
+    c_ControllerFPPDSequence * pSequence = SequenceIndex.Find (SequenceName);
+
+    if (nullptr == pSequence)
+    {
+        // DEBUG_V(String("Create sequence: '") + SequenceName + "'");
+        auto Sequence = Sequences.insert (std::make_pair (SequenceName, c_ControllerFPPDSequence ())).first;
+        SequenceIndex.Add (Sequence->first, & Sequence->second);
+        pSequence = & Sequence->second;
+    }
+
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
+    // DEBUG_END;
+    return * pSequence;
+}   // GetSequence
+
 // *********************************************************************************************
 void c_ControllerFPPDSequences::LearnSequenceName (String & SequenceName)
 {
     // DEBUG_START;
 
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     do  // once
     {
         // does the message already exist?
-        if (Sequences.end () != Sequences.find (SequenceName))
+        if (nullptr != SequenceIndex.Find (SequenceName))
         {
             // DEBUG_V("Sequence Name Already exists");
             break;
@@ -459,7 +520,11 @@ void c_ControllerFPPDSequences::LearnSequenceName (String & SequenceName)
         // DEBUG_V("Create a Sequence");
         AddSequence (SequenceName);
 
-        Sequences[SequenceName].AddMessage (SequenceName);
+        GetSequence (SequenceName).AddMessage (SequenceName);
+
+        // DEBUG_V("Size the message to the sequence. The header may still be on its way.");
+        UnsizedSequenceName = SequenceName;
+        SetLearnedDuration (SequenceName, FseqMetaCache.GetDurationMs (SequenceName));
 
         // DEBUG_V("Create a Sequence - Done");
         displaySaveWarning ();
@@ -467,6 +532,8 @@ void c_ControllerFPPDSequences::LearnSequenceName (String & SequenceName)
         Log.infoln ((String (F ("FPPD: Learned new sequence: '")) + SequenceName + "'").c_str ());
     } while (false);
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     // DEBUG_END;
 }  // LearnSequenceName
 
@@ -490,6 +557,8 @@ void c_ControllerFPPDSequences::RestoreConfig (ArduinoJson::JsonObject & config)
 
     JsonArray SequencesArray = config[N_sequences];
 
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     for (auto CurrentSequenceConfig : SequencesArray)
     {
         String Key;
@@ -506,9 +575,11 @@ void c_ControllerFPPDSequences::RestoreConfig (ArduinoJson::JsonObject & config)
 
         // DEBUG_V();
         JsonObject Temp = CurrentSequenceConfig;
-        Sequences[Key].RestoreConfig (Temp);
+        GetSequence (Key).RestoreConfig (Temp);
     }
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     ControllerMessages.RestoreConfig (config);
 
     // DEBUG_END;
@@ -529,6 +600,8 @@ void c_ControllerFPPDSequences::SaveConfig (ArduinoJson::JsonObject & config)
 
     // DEBUG_V();
 
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
     for (auto & CurrentSequence : Sequences)
     {
         // DEBUG_V(String("Create Sequence entry") + CurrentSequence.first);
@@ -536,6 +609,8 @@ void c_ControllerFPPDSequences::SaveConfig (ArduinoJson::JsonObject & config)
         CurrentSequence.second.SaveConfig (SequenceConfig);
     }
 
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
     ControllerMessages.SaveConfig (config);
 
     // serializeJsonPretty(config, Serial);
@@ -543,5 +618,28 @@ void c_ControllerFPPDSequences::SaveConfig (ArduinoJson::JsonObject & config)
     // DEBUG_END;
 }   // SaveControllerConfiguration
 
+// *********************************************************************************************
+// SetLearnedDuration(): A newly learned sequence shows its name for the length of the sequence.
+// Sequences the user has already set up are left alone.
+void c_ControllerFPPDSequences::SetLearnedDuration (const String & SequenceName, uint32_t DurationMs)
+{
+    // DEBUG_START;
+
+    // The delete button may remove the sequence between learning it and sizing it.
+    xSemaphoreTakeRecursive (SequencesSemaphore, portMAX_DELAY);
+
+    if (DurationMs && (SequenceName == UnsizedSequenceName) && (nullptr != SequenceIndex.Find (SequenceName)))
+    {
+        // DEBUG_V(String("Duration: ") + String(DurationMs));
+        ControllerMessages.SetDurration (SequenceName, (DurationMs + 999) / 1000);
+        UnsizedSequenceName = emptyString;
+        displaySaveWarning ();
+    }
+
+    xSemaphoreGiveRecursive (SequencesSemaphore);
+
+    // DEBUG_END;
+}   // SetLearnedDuration
+
 // *********************************************************************************************
 // EOF
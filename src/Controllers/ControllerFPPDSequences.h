@@ -24,6 +24,7 @@
 #include <map>
 
 #include "ControllerFPPDSequence.h"
+#include "NameIndex.hpp"
 #include "Language.h"
 
 class c_ControllerFPPDSequences
@@ -42,15 +43,18 @@ public:
     void    CbButtonUpdate (Control * sender, int type);
     void    CbChoiceList (Control * sender, int type);
     void    CbTextChange (Control * sender, int type);
-    bool    GetNextRdsMessage (const String & value, c_ControllerMgr::RdsMsgInfo_t & Response) {return ControllerMessages.GetNextRdsMessage (value, Response);}
+    bool    GetNextRdsMessage (const String & value, uint32_t ValueHash, c_ControllerMgr::RdsMsgInfo_t & Response) {return ControllerMessages.GetNextRdsMessage (value, ValueHash, Response);}
     void    LearnSequenceName (String & value);
+    void    SetLearnedDuration (const String & SequenceName, uint32_t DurationMs);
 
 private:
 
     void    Activate ();
     void    AddSequence (String & SequenceName);
+    c_ControllerFPPDSequence & GetSequence (const String & SequenceName);
 
     String                                      SelectedSequenceName = N_default;
+    String                                      UnsizedSequenceName;    // Learned before its FSEQ header was read.
 
     uint16_t                                    EspuiParentElementId            = Control::noParent;
     uint16_t                                    EspuiChoiceListElementId        = Control::noParent;
@@ -62,6 +66,8 @@ private:
     uint16_t                                    EspuiButtonUpdateElementId      = Control::noParent;
 
     std::map <String, c_ControllerFPPDSequence> Sequences;
+    cNameIndex <c_ControllerFPPDSequence>       SequenceIndex;  // Hash lookup into Sequences.
+    SemaphoreHandle_t                           SequencesSemaphore = NULL;  // Held while a sequence is created, erased or used.
     c_ControllerMessages                        ControllerMessages;
 };  // c_ControllerFPPDSequences
 
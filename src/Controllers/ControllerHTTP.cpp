@@ -20,6 +20,7 @@
 #include <ArduinoLog.h>
 #include "ControllerHTTP.h"
 #include "Language.h"
+#include "PeakAudio.hpp"
 
 #include "memdebug.h"
 
@@ -103,6 +104,21 @@ void c_ControllerHTTP::init ()
             request->send (200, String (F ("text/plain")), String (ESP.getFreeHeap ()).c_str ());
         });
 
+    // Audio level statistics handler
+    webServer.on (
+        "/audio",
+        HTTP_GET,
+        [] (AsyncWebServerRequest * request)
+        {
+            DynamicJsonDocument AudioDoc (512);
+            JsonObject          Audio = AudioDoc.to <JsonObject>();
+            PeakAudio.GetStatistics (Audio);
+
+            String Response;
+            serializeJson (AudioDoc, Response);
+            request->send (200, String (F ("application/json")), Response);
+        });
+
     // webServer.serveStatic ("/", LittleFS, "/www/").setDefaultFile ("index.html");
     // Heap status handler
     webServer.on (
@@ -84,10 +84,15 @@ void c_ControllerLOCAL::restoreConfiguration (ArduinoJson::JsonObject & config)
     // DEBUG_START;
 
     cControllerCommon::restoreConfiguration (config);
+
+    bool NoMessageSets = Messages.empty ();
     Messages.RestoreConfig (config);
 
-    // do we need to create a set of default messages?
-    if (Messages.empty ())
+    // do we need to create a set of default messages? Decided from the config, a restore from
+    // another task is only queued for the loop task.
+    JsonArray MessageSetConfigs = config[N_messages];
+
+    if (NoMessageSets && (MessageSetConfigs.isNull () || (0 == MessageSetConfigs.size ())))
     {
         CreateDefaultMsgSet ();
     }
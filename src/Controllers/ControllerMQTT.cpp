@@ -115,6 +115,26 @@ void c_ControllerMQTT::begin ()
 
     fsm_Connection_state_disabled_imp.Init ();
 
+    // The connection FSM runs once a second. The client itself is serviced on every poll().
+    TimerWheel.Start (
+        FsmTimer,
+        1000,
+        1000,
+        [] (void * pThis)
+        {
+            c_ControllerMQTT * pMe = static_cast <c_ControllerMQTT *> (pThis);
+
+            if (pMe->pCurrentFsmState)
+            {
+                pMe->pCurrentFsmState->Poll (millis ());
+            }
+            else
+            {
+                // DEBUG_V("pCurrentFsmState not set");
+            }
+        },
+        this);
+
     mqttClient.setClient (wifiClient);
     mqttClient.setCallback (
         [] (const char * topic, byte * payload, unsigned int length)
@@ -260,24 +280,8 @@ void c_ControllerMQTT::poll (void)
 {
     // _ DEBUG_START;
 
-    uint32_t Now = millis ();
-
     mqttClient.loop ();
 
-    if (Now > FsmTimerExpirationTime)
-    {
-        FsmTimerExpirationTime += 1000;
-
-        if (pCurrentFsmState)
-        {
-            pCurrentFsmState->Poll (Now);
-        }
-        else
-        {
-            // DEBUG_V("pCurrentFsmState not set");
-        }
-    }
-
     // _ DEBUG_END;
 }   // poll
 
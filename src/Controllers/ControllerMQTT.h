@@ -29,6 +29,7 @@
 #include "ControllerCommon.h"
 #include "ControllerMessages.h"
 #include "CommandProcessor.hpp"
+#include "TimerWheel.hpp"
 
 class fsm_Connection_state;
 
@@ -80,7 +81,7 @@ private:
     friend class fsm_Connection_state_connected;
     friend class fsm_Connection_state_Disconnecting;
     fsm_Connection_state    * pCurrentFsmState      = nullptr;
-    uint32_t                FsmTimerExpirationTime  = 1000;
+    cTimerWheel::Timer_t    FsmTimer;
 };  // class c_ControllerMQTT
 
 // *********************************************************************************************
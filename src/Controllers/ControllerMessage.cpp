@@ -26,6 +26,9 @@
  #include "memdebug.h"
 #endif //  __has_include("memdebug.h")
 
+// *********************************************************************************************
+std::atomic <uint32_t> c_ControllerMessage::SettingsGeneration {0};
+
 // *********************************************************************************************
 c_ControllerMessage::c_ControllerMessage ()
 {
@@ -38,7 +41,7 @@ c_ControllerMessage::~c_ControllerMessage ()
 {
     // DEBUG_START;
 
-    // DEBUG_V(String("Remove Message: '") + MessageText + "'");
+    // DEBUG_V(String("Remove Message: '") + MessagePool.Text (MessageHandle) + "'");
 
     if (Control::noParent != MessageElementId)
     {
@@ -47,15 +50,37 @@ c_ControllerMessage::~c_ControllerMessage ()
         MessageElementId = Control::noParent;
     }
 
+    MessagePool.Release (MessageHandle);
+
     // DEBUG_END;
 }   // c_ControllerMessage
 
+// *********************************************************************************************
+// operator =: Copies the settings. The text is shared through the pool, not copied. The UI
+// entry stays with the target, so a renamed message keeps the option control it was given.
+c_ControllerMessage & c_ControllerMessage::operator = (const c_ControllerMessage & source)
+{
+    // DEBUG_START;
+
+    if (this != &source)
+    {
+        DurationSec         = source.DurationSec;
+        Enabled             = source.Enabled;
+        Schedule            = source.Schedule;
+        MessagePool.Assign (MessageHandle, source.MessageHandle);
+        RtPlusHandle        = cMessagePool::NullHandle;
+    }
+
+    // DEBUG_END;
+    return *this;
+}   // operator =
+
 // ************************************************************************************************
 void c_ControllerMessage::Activate (bool value)
 {
     // DEBUG_START;
 
-    // DEBUG_V(String("            MessageText: '") + MessageText + "'");
+    // DEBUG_V(String("            MessageText: '") + MessagePool.Text (MessageHandle) + "'");
     // DEBUG_V(String("  ActiveParentElementId: ") + String(MessageElementIds->ActiveChoiceListElementId));
     // DEBUG_V(String("  HiddenParentElementId: ") + String(MessageElementIds->HiddenChoiceListElementId));
 
@@ -105,7 +130,7 @@ void c_ControllerMessage::AddControls (MessageElementIds_t * _MessageElementIds)
 
     MessageElementIds = _MessageElementIds;
 
-    // DEBUG_V(String("                  Message: '") + MessageText + "'");
+    // DEBUG_V(String("                  Message: '") + MessagePool.Text (MessageHandle) + "'");
     // DEBUG_V(String("ActiveChoiceListElementId: '") + String(MessageElementIds->ActiveChoiceListElementId) + "'");
     // DEBUG_V(String("HiddenChoiceListElementId: '") + String(MessageElementIds->HiddenChoiceListElementId) + "'");
     // DEBUG_V(String("         EnabledElementId: '") + String(MessageElementIds->EnabledElementId) + "'");
@@ -130,44 +155,66 @@ void c_ControllerMessage::AddControls (MessageElementIds_t * _MessageElementIds)
             // DEBUG_V(String("Create Choice List Entry on Active Choice list"));
             MessageElementId = ESPUI.addControl (
                 ControlType::Option,
-                MessageText.c_str (),
-                MessageText,
+                MessagePool.Text (MessageHandle),
+                MessagePool.Text (MessageHandle),
                 ControlColor::Turquoise,
                 MessageElementIds->ActiveChoiceListElementId);
         }
 
         // DEBUG_V(String(" EspuiMessageElementId: '") + String(MessageElementId) + "'");
 
-        // DEBUG_V("Attach callbacks to the Message Details Pane.");
-        Control * DurationControl = ESPUI.getControl (MessageElementIds->DisplayDurationElementId);
+        AttachCallbacks ();
+    } while (false);
 
-        if (DurationControl)
-        {
-            DurationControl->callback   =
-                [&] (Control * sender, int type)
-                {
-                    CbDuration (sender, type);
-                };
+    // DEBUG_END;
+}   // AddControls
 
-            ESPUI.updateControl (DurationControl);
-        }
+// *********************************************************************************************
+// AttachCallbacks(): The Message Details Pane is shared by all messages. Point it at this one.
+void c_ControllerMessage::AttachCallbacks ()
+{
+    // DEBUG_START;
 
-        Control * MsgEnabledControl = ESPUI.getControl (MessageElementIds->EnabledElementId);
+    // DEBUG_V("Attach callbacks to the Message Details Pane.");
+    Control * DurationControl = ESPUI.getControl (MessageElementIds->DisplayDurationElementId);
 
-        if (MsgEnabledControl)
-        {
+    if (DurationControl)
+    {
+        DurationControl->callback   =
+            [&] (Control * sender, int type)
+            {
+                CbDuration (sender, type);
+            };
 
-            MsgEnabledControl->callback =
-                [&] (Control * sender, int type)
-                {
-                    CbEnabled (sender, type);
-                };
-            ESPUI.updateControl (MsgEnabledControl);
-        }
-    } while (false);
+        ESPUI.updateControl (DurationControl);
+    }
+
+    Control * MsgEnabledControl = ESPUI.getControl (MessageElementIds->EnabledElementId);
+
+    if (MsgEnabledControl)
+    {
+        MsgEnabledControl->callback =
+            [&] (Control * sender, int type)
+            {
+                CbEnabled (sender, type);
+            };
+        ESPUI.updateControl (MsgEnabledControl);
+    }
+
+    Control * ScheduleControl = ESPUI.getControl (MessageElementIds->ScheduleElementId);
+
+    if (ScheduleControl)
+    {
+        ScheduleControl->callback =
+            [&] (Control * sender, int type)
+            {
+                CbSchedule (sender, type);
+            };
+        ESPUI.updateControl (ScheduleControl);
+    }
 
     // DEBUG_END;
-}   // AddControls
+}   // AttachCallbacks
 
 // *********************************************************************************************
 void c_ControllerMessage::CbDuration (Control * sender, int type)
@@ -175,6 +222,7 @@ void c_ControllerMessage::CbDuration (Control * sender, int type)
     // DEBUG_START;
 
     DurationSec = atoi (sender->value.c_str ());
+    ++SettingsGeneration;
 
     displaySaveWarning ();
     Log.infoln ((String (F ("FPPD Message Duration Set to: ")) + String (DurationSec)).c_str ());
@@ -188,6 +236,7 @@ void c_ControllerMessage::CbEnabled (Control * sender, int type)
     // DEBUG_START;
 
     Enabled = sender->value.equals ("1");
+    ++SettingsGeneration;
     // DEBUG_V(String("Enabled: ") + String(Enabled));
 
     displaySaveWarning ();
@@ -197,12 +246,55 @@ void c_ControllerMessage::CbEnabled (Control * sender, int type)
 }   // EnabledCb
 
 // *********************************************************************************************
-void c_ControllerMessage::GetMessage (c_ControllerMgr::RdsMsgInfo_t & Response)
+void c_ControllerMessage::CbSchedule (Control * sender, int type)
 {
     // DEBUG_START;
 
-    Response.Text               = MessageText;
+    char ScheduleText[MESSAGE_SCHEDULE_TEXT_SIZE];
+
+    if (Schedule.Parse (sender->value.c_str ()))
+    {
+        ++SettingsGeneration;
+        displaySaveWarning ();
+    }
+    else
+    {
+        Log.warningln ((String (F ("Invalid Message Schedule: '")) + sender->value + F ("'")).c_str ());
+    }
+
+    // Show the schedule the way it was understood (or the unchanged one).
+    Schedule.Format (ScheduleText, sizeof (ScheduleText));
+    sender->value = ScheduleText;
+    ESPUI.updateControl (sender);
+    Log.infoln ((String (F ("Message Schedule Set to: ")) + ScheduleText).c_str ());
+
+    // DEBUG_END;
+}   // CbSchedule
+
+// *********************************************************************************************
+// GetMessage(): RtPlusItem is the name to tag in the text (FPPD sequence name). The tags are
+// worked out the first time the message goes out with its current text and then reused.
+void c_ControllerMessage::GetMessage (c_ControllerMgr::RdsMsgInfo_t & Response, const char * RtPlusItem)
+{
+    // DEBUG_START;
+
+    // Hand out another reference to the interned text. No String copies.
+    MessagePool.Assign (Response.Handle, MessageHandle);
+    Response.Text               = MessagePool.Text (Response.Handle);
     Response.DurationMilliSec   = DurationSec * 1000;
+    Response.RtPlus             = cRdsEncoder::RtPlusTags_t ();
+
+    if (RtPlusItem)
+    {
+        if (RtPlusHandle != MessageHandle)
+        {
+            // DEBUG_V("New text. Find the RT+ tags");
+            cRdsEncoder::FindRtPlusTags (Response.Text, RtPlusItem, RtPlusTags);
+            RtPlusHandle = MessageHandle;
+        }
+
+        Response.RtPlus = RtPlusTags;
+    }
 
     // DEBUG_END;
 }
@@ -214,8 +306,8 @@ void c_ControllerMessage::RestoreConfig (ArduinoJson::JsonObject config)
 
     if (config.containsKey (N_message))
     {
-        MessageText = (const char *)config[N_message];
-        // DEBUG_V(String("MessageText: ") + MessageText);
+        SetMessage (String ((const char *)config[N_message]));
+        // DEBUG_V(String("MessageText: ") + MessagePool.Text (MessageHandle));
     }
 
     if (config.containsKey (N_durationSec))
@@ -230,6 +322,11 @@ void c_ControllerMessage::RestoreConfig (ArduinoJson::JsonObject config)
         // DEBUG_V(String("    Enabled: ") + String(Enabled));
     }
 
+    if (config.containsKey (N_schedule))
+    {
+        Schedule.Parse ((const char *)config[N_schedule]);
+    }
+
     // DEBUG_END;
 }   // RestoreConfig
 
@@ -237,12 +334,19 @@ void c_ControllerMessage::RestoreConfig (ArduinoJson::JsonObject config)
 void c_ControllerMessage::SaveConfig (ArduinoJson::JsonObject config)
 {
     // DEBUG_START;
-    // DEBUG_V(String("Message: ") + MessageText);
+    // DEBUG_V(String("Message: ") + MessagePool.Text (MessageHandle));
 
-    config[N_message]       = MessageText;
+    config[N_message]       = String (MessagePool.Text (MessageHandle));
     config[N_durationSec]   = DurationSec;
     config[N_enabled]       = Enabled;
 
+    if (!Schedule.IsAlways ())
+    {
+        char ScheduleText[MESSAGE_SCHEDULE_TEXT_SIZE];
+        Schedule.Format (ScheduleText, sizeof (ScheduleText));
+        config[N_schedule] = String (ScheduleText);
+    }
+
     // DEBUG_END;
 }   // SaveConfig
 
@@ -251,7 +355,7 @@ void c_ControllerMessage::SelectMessage ()
 {
     // DEBUG_START;
 
-    // DEBUG_V(String("    Message: '") + MessageText + "'");
+    // DEBUG_V(String("    Message: '") + MessagePool.Text (MessageHandle) + "'");
 
     do  // once
     {
@@ -269,7 +373,7 @@ void c_ControllerMessage::SelectMessage ()
         if (control)
         {
             // DEBUG_V("Update Selected item");
-            control->value = MessageText;
+            control->value = MessagePool.Text (MessageHandle);
             ESPUI.updateControl (control);
         }
 
@@ -293,22 +397,44 @@ void c_ControllerMessage::SelectMessage ()
             control->value  = String (Enabled ? "1" : "0");
             ESPUI.updateControl (MessageElementIds->EnabledElementId);
         }
+
+        control = ESPUI.getControl (MessageElementIds->ScheduleElementId);
+
+        if (control)
+        {
+            // DEBUG_V("Set up Schedule");
+            char ScheduleText[MESSAGE_SCHEDULE_TEXT_SIZE];
+            Schedule.Format (ScheduleText, sizeof (ScheduleText));
+            control->value = ScheduleText;
+            ESPUI.updateControl (MessageElementIds->ScheduleElementId);
+        }
+
+        // DEBUG_V("Point the details pane at this message");
+        AttachCallbacks ();
     } while (false);
 
     // DEBUG_END;
 }   // SelectMessage
 
 // *********************************************************************************************
-void c_ControllerMessage::SetMessage (String & value)
+// SetMessage(): Returns false if the message pool is full. The old text is kept in that case.
+bool c_ControllerMessage::SetMessage (const String & value)
 {
     // DEBUG_START;
 
-    // DEBUG_V(String("Message: '") + MessageText + "'");
+    // DEBUG_V(String("Message: '") + MessagePool.Text (MessageHandle) + "'");
     // DEBUG_V(String("  value: '") + value + "'");
 
-    MessageText = value;
+    cMessagePool::Handle_t NewHandle = MessagePool.Intern (value.c_str ());
+
+    if (cMessagePool::NullHandle != NewHandle)
+    {
+        MessagePool.Release (MessageHandle);
+        MessageHandle = NewHandle;
+    }
 
     // DEBUG_END;
+    return cMessagePool::NullHandle != NewHandle;
 }   // SetMessage
 
 // *********************************************************************************************
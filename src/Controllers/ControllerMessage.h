@@ -20,10 +20,13 @@
 #pragma once
 
 #include "ControllerMgr.h"
+#include "MessagePool.hpp"
+#include "MessageSchedule.hpp"
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <ArduinoLog.h>
 #include <ESPUI.h>
+#include <atomic>
 
 class c_ControllerMessage
 {
@@ -36,37 +39,51 @@ public:
         uint16_t    MessageDetailsElementId     = Control::noParent;
         uint16_t    DisplayDurationElementId    = Control::noParent;
         uint16_t    EnabledElementId            = Control::noParent;
+        uint16_t    ScheduleElementId           = Control::noParent;
     };
 
     c_ControllerMessage ();
     c_ControllerMessage (const c_ControllerMessage & source) {}  // Empty Copy constructor
+    c_ControllerMessage & operator = (const c_ControllerMessage & source);
 
     virtual~c_ControllerMessage ();
     void        Activate (bool value);
     void        AddControls (MessageElementIds_t * _MessageElementIds);
     void        CbDuration (Control * sender, int type);
     void        CbEnabled (Control * sender, int type);
+    void        CbSchedule (Control * sender, int type);
     uint16_t    GetElementId () {return MessageElementId;}
 
-    void        GetMessage (c_ControllerMgr::RdsMsgInfo_t & Response);
+    void        GetMessage (c_ControllerMgr::RdsMsgInfo_t & Response, const char * RtPlusItem = nullptr);
     uint32_t    GetDuration () {return DurationSec;}
 
     bool IsEnabled () {return Enabled;}
+    bool IsScheduled () {return !Schedule.IsAlways ();}
+    const cMessageSchedule & GetSchedule () {return Schedule;}
 
     void    RestoreConfig (ArduinoJson::JsonObject config);
     void    SaveConfig (ArduinoJson::JsonObject config);
     void    SelectMessage ();
-    void    SetMessage (String & value);
+    bool    SetMessage (const String & value);
     void    SetFppdMode ();
     void    SetDurration (uint32_t value) {DurationSec = value;}
 
+    // Bumped whenever a message is enabled, disabled, retimed or rescheduled from the UI so the
+    // message sets know to resync their playlists.
+    static std::atomic <uint32_t> SettingsGeneration;
+
 private:
 
-    uint16_t            MessageElementId = Control::noParent;
-    String              MessageText;
-    uint32_t            DurationSec         = 5;
-    bool                Enabled             = true;
-    MessageElementIds_t * MessageElementIds = nullptr;
+    void    AttachCallbacks ();
+
+    uint16_t                    MessageElementId    = Control::noParent;
+    cMessagePool::Handle_t      MessageHandle       = cMessagePool::NullHandle;
+    cMessagePool::Handle_t      RtPlusHandle        = cMessagePool::NullHandle; // Text the RT+ tags were found in. Not referenced.
+    cRdsEncoder::RtPlusTags_t   RtPlusTags;
+    uint32_t                    DurationSec         = 5;
+    bool                        Enabled             = true;
+    cMessageSchedule            Schedule;
+    MessageElementIds_t         * MessageElementIds = nullptr;
 };  // c_ControllerMessage
 
 // *********************************************************************************************
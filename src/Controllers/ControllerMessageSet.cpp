@@ -19,6 +19,9 @@
 // *********************************************************************************************
 #include "ControllerMessageSet.h"
 #include "Language.h"
+#include <algorithm>
+#include <limits>
+#include <time.h>
 
 #if __has_include ("memdebug.h")
  #include "memdebug.h"
@@ -29,8 +32,6 @@ c_ControllerMessageSet::c_ControllerMessageSet ()
 {
     // DEBUG_START;
 
-    MessagesSemaphore = xSemaphoreCreateMutex ();
-
     // DEBUG_END;
 }   // c_ControllerMessageSet
 
@@ -79,14 +80,22 @@ void c_ControllerMessageSet::ActivateMessage (String MsgName)
 
     do  // once
     {
-        if (Messages.end () == Messages.find (MsgName))
+        auto Message = Messages.find (MsgName);
+
+        if (Messages.end () == Message)
         {
             // DEBUG_V("Desired message not found. Add it.");
-            AddMessage (MsgName);
+            if (!AddMessage (MsgName))
+            {
+                // DEBUG_V("Could not create the message");
+                break;
+            }
+
+            Message = Messages.find (MsgName);
         }
 
         // DEBUG_V(String("Update the choice list and populate message details"));
-        Messages[MsgName].SelectMessage ();
+        Message->second.SelectMessage ();
 
         // DEBUG_V(String("Show the message details pane"));
         CurrentMsgName = MsgName;
@@ -139,9 +148,12 @@ void c_ControllerMessageSet::AddControls (c_ControllerMessage::MessageElementIds
 }   // AddControls
 
 // ************************************************************************************************
-void c_ControllerMessageSet::AddMessage (String MsgText)
+// AddMessage(): False if the message could not be created (empty, duplicate or no pool space).
+bool c_ControllerMessageSet::AddMessage (String MsgText)
 {
     // DEBUG_START;
+
+    bool Response = false;
     // DEBUG_V(String("     message set: '") + MsgSetName + "'");
     // DEBUG_V(String("    message name: '") + MsgText + "'");
 
@@ -160,12 +172,19 @@ void c_ControllerMessageSet::AddMessage (String MsgText)
         }
 
         // DEBUG_V("Create the message");
-        xSemaphoreTake (MessagesSemaphore, portMAX_DELAY);
-        Messages[MsgText].SetMessage (MsgText);
-        MessagesIterator = nullMessagesIterator;
-        xSemaphoreGive (MessagesSemaphore);
+        bool MessageCreated = Messages[MsgText].SetMessage (MsgText);
+
+        if (!MessageCreated)
+        {
+            Messages.erase (MsgText);
+            Log.errorln ((String (F ("Message storage is full (")) + String (MESSAGE_POOL_SLOTS) + F (" messages). Cannot add: '") + MsgText + F ("'")).c_str ());
+            break;
+        }
+
+        PlaylistUpdate (MsgText);
 
-        CurrentMsgName = MsgText;
+        CurrentMsgName  = MsgText;
+        Response        = true;
 
         if (Control::noParent == MessageElementIds->ActiveChoiceListElementId)
         {
@@ -180,7 +199,8 @@ void c_ControllerMessageSet::AddMessage (String MsgText)
     } while (false);
 
     // DEBUG_END;
-}
+    return Response;
+}   // AddMessage
 
 // ************************************************************************************************
 void c_ControllerMessageSet::EraseMsg (String MsgTxt)
@@ -197,10 +217,8 @@ void c_ControllerMessageSet::EraseMsg (String MsgTxt)
             break;
         }
 
-        xSemaphoreTake (MessagesSemaphore, portMAX_DELAY);
+        PlaylistRemove (MsgTxt);
         Messages.erase (MsgTxt);
-        MessagesIterator = nullMessagesIterator;
-        xSemaphoreGive (MessagesSemaphore);
 
         if (!MsgTxt.equals (CurrentMsgName))
         {
@@ -225,15 +243,15 @@ void c_ControllerMessageSet::EraseMsg (String MsgTxt)
 }
 
 // ************************************************************************************************
-bool c_ControllerMessageSet::GetNextRdsMessage (c_ControllerMgr::RdsMsgInfo_t & Response)
+// GetNextRdsMessage(): TagRtPlus: Send RT+ tags for where the set name appears in the message.
+bool c_ControllerMessageSet::GetNextRdsMessage (c_ControllerMgr::RdsMsgInfo_t & Response, bool TagRtPlus)
 {
     // DEBUG_START;
     // DEBUG_V(String("    MsgSetName: '") + MsgSetName + "'");
     // DEBUG_V(String("CurrentMsgName: '") + CurrentMsgName + "'");
     // DEBUG_V(String(" Messages.size: '") + String(Messages.size ()) + "'");
 
-    bool    AllMsgsPlayed   = false;
-    bool    FoundAmessage   = false;
+    bool AllMsgsPlayed = false;
 
     do  // once
     {
@@ -243,49 +261,177 @@ bool c_ControllerMessageSet::GetNextRdsMessage (c_ControllerMgr::RdsMsgInfo_t &
             break;
         }
 
-        xSemaphoreTake (MessagesSemaphore, portMAX_DELAY);
+        if ((PlaylistGeneration != c_ControllerMessage::SettingsGeneration) || (time (nullptr) >= NextScheduleChange))
+        {
+            // DEBUG_V("A message setting changed or a schedule window opened or closed");
+            PlaylistRebuild ();
+        }
+
+        if (Playlist.empty ())
+        {
+            // DEBUG_V("No enabled messages");
+            AllMsgsPlayed = true;
+            break;
+        }
+
+        // DEBUG_V(String("Playing: '") + *Playlist[PlaylistPosition].pName + "'");
+        Playlist[PlaylistPosition].pMessage->GetMessage (Response, TagRtPlus ? MsgSetName.c_str () : nullptr);
 
-        for (uint32_t count = Messages.size ();(!FoundAmessage) && (0 < count);--count)
+        if (++PlaylistPosition >= Playlist.size ())
         {
-            if (nullMessagesIterator == MessagesIterator)
-            {
-                MessagesIterator = Messages.begin ();
-            }
+            // DEBUG_V("End of list of messages");
+            PlaylistPosition = 0;
+
+            // show we have completed a full pass through the list
+            AllMsgsPlayed = true;
+        }
+    } while (false);
+
+    // DEBUG_END;
+    // DEBUG_V(String("AllMsgsPlayed: ") + String(AllMsgsPlayed));
+
+    return AllMsgsPlayed;
+}
+
+// *********************************************************************************************
+// PlaylistFind(): Index of MsgName in the playlist, or of the entry it would be inserted before.
+size_t c_ControllerMessageSet::PlaylistFind (const String & MsgName)
+{
+    auto Entry = std::lower_bound (Playlist.begin (), Playlist.end (), MsgName,
+                                   [] (const PlaylistEntry_t & Entry, const String & Name) {return *Entry.pName < Name;});
+
+    return size_t (Entry - Playlist.begin ());
+}   // PlaylistFind
+
+// *********************************************************************************************
+// PlaylistRebuild(): Full resync with the Enabled flags and schedules. Resumes at the message
+// that was due next and works out when the next schedule window opens or closes.
+void c_ControllerMessageSet::PlaylistRebuild ()
+{
+    // DEBUG_START;
+
+    String      NextMsgName;
+    time_t      Now         = time (nullptr);
+    bool        ClockValid  = cMessageSchedule::ClockIsValid (Now);
+    struct tm   LocalTime;
+
+    localtime_r (&Now, &LocalTime);
+    NextScheduleChange = std::numeric_limits <time_t>::max ();
+
+    if (PlaylistPosition < Playlist.size ())
+    {
+        NextMsgName = *Playlist[PlaylistPosition].pName;
+    }
+
+    PlaylistGeneration = c_ControllerMessage::SettingsGeneration;
+    Playlist.clear ();
+
+    for (auto & CurrentMessage : Messages)
+    {
+        c_ControllerMessage & Message = CurrentMessage.second;
+
+        if (!Message.IsEnabled ())
+        {
+            continue;
+        }
 
-            // DEBUG_V(String("MessagesIterator->first: '") + MessagesIterator->first + "'");
-            if (!MessagesIterator->second.IsEnabled ())
+        if (Message.IsScheduled ())
+        {
+            if (!ClockValid)
             {
-                // DEBUG_V("Message is not enabled");
+                // DEBUG_V("No time of day yet. Check again in a minute");
+                NextScheduleChange = std::min (NextScheduleChange, Now + 60);
+                continue;
             }
-            else
+
+            NextScheduleChange = std::min (NextScheduleChange, Message.GetSchedule ().NextChange (Now, LocalTime));
+
+            if (!Message.GetSchedule ().IsActive (LocalTime))
             {
-                // DEBUG_V("Found a message");
-                MessagesIterator->second.GetMessage (Response);
-                FoundAmessage = true;
-                // DEBUG_V(String("Response: '") + Response.Text + "'");
+                continue;
             }
+        }
 
-            // DEBUG_V("Advance to the next message");
-            ++MessagesIterator;
+        Playlist.push_back ({&CurrentMessage.first, &Message});
+    }
 
-            if (MessagesIterator == Messages.end ())
-            {
-                // DEBUG_V("End of list of messages");
-                MessagesIterator = Messages.begin ();
+    PlaylistPosition = NextMsgName.isEmpty () ? 0 : PlaylistFind (NextMsgName);
 
-                // show we have completed a full pass through the list
-                AllMsgsPlayed = true;
-            }
+    if (PlaylistPosition >= Playlist.size ())
+    {
+        PlaylistPosition = 0;
+    }
+
+    // DEBUG_END;
+}   // PlaylistRebuild
+
+// *********************************************************************************************
+// PlaylistRemove(): Drop one message. Entries behind the play position keep their turn order.
+void c_ControllerMessageSet::PlaylistRemove (const String & MsgName)
+{
+    // DEBUG_START;
+
+    size_t Index = PlaylistFind (MsgName);
+
+    if ((Index < Playlist.size ()) && (*Playlist[Index].pName == MsgName))
+    {
+        Playlist.erase (Playlist.begin () + Index);
+
+        if (Index < PlaylistPosition)
+        {
+            --PlaylistPosition;
         }
 
-        xSemaphoreGive (MessagesSemaphore);
-    } while (false);
+        if (PlaylistPosition >= Playlist.size ())
+        {
+            PlaylistPosition = 0;
+        }
+    }
 
     // DEBUG_END;
-    // DEBUG_V(String("AllMsgsPlayed: ") + String(AllMsgsPlayed));
+}   // PlaylistRemove
 
-    return AllMsgsPlayed;
-}
+// *********************************************************************************************
+// PlaylistUpdate(): Add or drop one message to match its Enabled flag.
+void c_ControllerMessageSet::PlaylistUpdate (const String & MsgName)
+{
+    // DEBUG_START;
+
+    auto Message = Messages.find (MsgName);
+
+    do  // once
+    {
+        if ((Messages.end () == Message) || !Message->second.IsEnabled ())
+        {
+            PlaylistRemove (MsgName);
+            break;
+        }
+
+        if (Message->second.IsScheduled ())
+        {
+            // DEBUG_V("Let the next pick work out the schedule");
+            NextScheduleChange = 0;
+            break;
+        }
+
+        size_t Index = PlaylistFind (MsgName);
+
+        if ((Index < Playlist.size ()) && (*Playlist[Index].pName == MsgName))
+        {
+            // DEBUG_V("Already listed");
+            break;
+        }
+
+        Playlist.insert (Playlist.begin () + Index, {&Message->first, &Message->second});
+
+        if (Index < PlaylistPosition)
+        {
+            ++PlaylistPosition;
+        }
+    } while (false);
+
+    // DEBUG_END;
+}   // PlaylistUpdate
 
 // *********************************************************************************************
 void c_ControllerMessageSet::RestoreConfig (ArduinoJson::JsonObject & config)
@@ -330,7 +476,12 @@ void c_ControllerMessageSet::RestoreConfig (ArduinoJson::JsonObject & config)
 
         // DEBUG_V(String("Add message to the message set: '") + MessageName + "'");
         AddMessage (MessageName);
-        Messages[MessageName].RestoreConfig (CurrentMessageConfig);
+
+        if (HasMsg (MessageName))
+        {
+            Messages[MessageName].RestoreConfig (CurrentMessageConfig);
+            PlaylistUpdate (MessageName);
+        }
     }
 
     // DEBUG_END;
@@ -413,12 +564,20 @@ void c_ControllerMessageSet::UpdateMsgText (String & OriginalMessageText, String
             break;
         }
 
-        AddMessage (NewMessageText);
         // DEBUG_V("Copy settings");
+        if (!AddMessage (NewMessageText))
+        {
+            // DEBUG_V("Could not create the new message");
+            break;
+        }
+
         Messages[NewMessageText] = Messages[OriginalMessageText];
+        Messages[NewMessageText].SetMessage (NewMessageText);
         Messages[NewMessageText].AddControls (MessageElementIds);
+        PlaylistUpdate (NewMessageText);
 
         // DEBUG_V("Delete the original");
+        PlaylistRemove (OriginalMessageText);
         Messages.erase (OriginalMessageText);
 
         if (OriginalMessageText.equals (CurrentMsgName))
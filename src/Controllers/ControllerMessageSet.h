@@ -27,6 +27,7 @@
 #include <ESPUI.h>
 #include <list>
 #include <map>
+#include <vector>
 
 class c_ControllerMessageSet
 {
@@ -39,7 +40,7 @@ public:
 
     void    Activate (bool value);
     void    ActivateMessage (String MsgName);
-    void    AddMessage (String MsgText);
+    bool    AddMessage (String MsgText);
     void    AddControls (c_ControllerMessage::MessageElementIds_t * MessageElementIds);
     bool    empty () {return Messages.empty ();}
 
@@ -49,22 +50,38 @@ public:
     void SetName (String & value) {MsgSetName = value;}
 
     void    UpdateMsgText (String & OriginalMessageText, String & NewMessageText);
-    bool    GetNextRdsMessage (c_ControllerMgr::RdsMsgInfo_t & Response);
+    bool    GetNextRdsMessage (c_ControllerMgr::RdsMsgInfo_t & Response, bool TagRtPlus = false);
     void    SetDurration (uint32_t value);
 
 private:
 
     void ShowMsgDetailsPane (bool value);
 
+    // Playlist: the enabled messages that are inside their schedule, in map (alphabetical) order.
+    // Kept in step with Messages so a pick is one array index step. PlaylistPosition is the
+    // entry that plays next. Scheduled messages are only re-evaluated at NextScheduleChange.
+    struct PlaylistEntry_t
+    {
+        const String        * pName;        // Map key. Stable for the life of the map node.
+        c_ControllerMessage * pMessage;
+    };
+
+    size_t  PlaylistFind (const String & MsgName);
+    void    PlaylistRebuild ();
+    void    PlaylistRemove (const String & MsgName);
+    void    PlaylistUpdate (const String & MsgName);
+
     c_ControllerMessage::MessageElementIds_t            * MessageElementIds = nullptr;
 
     String                                              MsgSetName;
     String                                              CurrentMsgName;
 
+    // Only changed on the owner task of c_ControllerMessages, see c_ControllerMessages::ApplyPendingEdits().
     std::map <String, c_ControllerMessage>              Messages;
-    #define nullMessagesIterator static_cast <std::map <String, c_ControllerMessage>::iterator> (nullptr)
-    std::map <String, c_ControllerMessage>::iterator    MessagesIterator    = nullMessagesIterator;
-    SemaphoreHandle_t                                   MessagesSemaphore   = NULL;
+    std::vector <PlaylistEntry_t>                       Playlist;
+    size_t                                              PlaylistPosition    = 0;
+    uint32_t                                            PlaylistGeneration  = 0;    // c_ControllerMessage::SettingsGeneration when last synced.
+    time_t                                              NextScheduleChange  = 0;
 };  // c_ControllerMessageSet
 
 // *********************************************************************************************
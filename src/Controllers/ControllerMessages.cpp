@@ -29,12 +29,17 @@ static const String DefaultTextFieldValue   = F ("Type New RDS Message Text Here
 static const String DefaultTextWarningMsg   = F ("WARN: Instruction text cannot be in the message");
 static const String EmptyMsgWarning         = F ("WARN: Empty message is not allowed");
 
+cMpscQueue <c_ControllerMessages::MessageEdit_t, 32>    c_ControllerMessages::PendingEdits;
+TaskHandle_t                                            c_ControllerMessages::OwnerTask = NULL;
+std::atomic <uint32_t>                                  c_ControllerMessages::EditsApplied {0};
+std::atomic <uint32_t>                                  c_ControllerMessages::EditsDropped {0};
+
 // *********************************************************************************************
 c_ControllerMessages::c_ControllerMessages ()
 {
     // DEBUG_START;
 
-    MessageSetsSemaphore = xSemaphoreCreateMutex ();
+    MessageSetsSemaphore = xSemaphoreCreateRecursiveMutex ();
 
     // DEBUG_END;
 }   // c_ControllerMessages
@@ -53,8 +58,15 @@ void c_ControllerMessages::ActivateMessageSet (String MsgSetName)
     // DEBUG_START;
     // DEBUG_V(String("  MsgSetName: '") + MsgSetName + "'");
 
+    if (RunOnOwnerTask (EditActivateMessageSet, MsgSetName))
+    {
+        return;
+    }
+
     do  // once
     {
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+
         // DEBUG_V("Turn off all message sets");
         for (auto & MessageSet : MessageSets)
         {
@@ -63,14 +75,15 @@ void c_ControllerMessages::ActivateMessageSet (String MsgSetName)
 
         CurrentMsgSetName = MsgSetName;
 
-        if (MessageSets.end () == MessageSets.find (MsgSetName))
+        if (nullptr == MessageSetIndex.Find (MsgSetName))
         {
             // DEBUG_V("Desired message set not found. Create it.");
             AddMessageSet (MsgSetName);
         }
 
         // DEBUG_V(String("Activate the desired message set: ") + MsgSetName);
-        MessageSets[MsgSetName].Activate (true);
+        GetMessageSet (MsgSetName).Activate (true);
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
 
         if (Control::noParent == MessageElementIds.ActiveChoiceListElementId)
         {
@@ -275,6 +288,28 @@ void c_ControllerMessages::AddControls (uint16_t ctrlTab)
             String (900),
             ControlColor::None,
             MessageElementIds.DisplayDurationElementId);
+
+        // DEBUG_V(String("Add Schedule field"));
+        ScheduleLabelElementId = ESPUI.addControl (
+            ControlType::Label,
+            emptyString.c_str (),
+            F ("Schedule, e.g. Sat,Sun 18:00-23:00 2022-11-25..2023-01-06"),
+            ControlColor::Turquoise,
+            MessageElementIds.MessageDetailsElementId);
+        ESPUI.setElementStyle (ScheduleLabelElementId, CSS_LABEL_STYLE_BLACK);
+
+        MessageElementIds.ScheduleElementId = ESPUI.addControl (
+            ControlType::Text,
+            emptyString.c_str (),
+            F ("Always"),
+            ControlColor::Turquoise,
+            MessageElementIds.MessageDetailsElementId);
+        ESPUI.addControl (
+            ControlType::Max,
+            emptyString.c_str (),
+            String (MESSAGE_SCHEDULE_TEXT_SIZE - 1),
+            ControlColor::None,
+            MessageElementIds.ScheduleElementId);
     }
     else
     {
@@ -282,6 +317,8 @@ void c_ControllerMessages::AddControls (uint16_t ctrlTab)
     }
 
     // DEBUG_V();
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+
     for (auto & CurrentMessageSet : MessageSets)
     {
         // DEBUG_V();
@@ -299,6 +336,8 @@ void c_ControllerMessages::AddControls (uint16_t ctrlTab)
         ActivateMessageSet (MessageSets.begin ()->first);
     }
 
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
     // DEBUG_V();
     CbTextChange (nullptr, 0);
 
@@ -312,6 +351,11 @@ void c_ControllerMessages::AddMessage (String MsgSetName, String MsgText)
     // DEBUG_V(String("message set name: '") + MsgSetName + "'");
     // DEBUG_V(String("    message name: '") + MsgText + "'");
 
+    if (RunOnOwnerTask (EditAddMessage, MsgSetName, MsgText))
+    {
+        return;
+    }
+
     do  // once
     {
         if (!AddMessageSet (MsgSetName))
@@ -321,11 +365,17 @@ void c_ControllerMessages::AddMessage (String MsgSetName, String MsgText)
         }
 
         // DEBUG_V(String(" Add '" + MsgText + "' to message set: '") + MsgSetName + "'");
-        xSemaphoreTake (MessageSetsSemaphore, portMAX_DELAY);
-        MessageSets[MsgSetName].AddMessage (MsgText);
-        xSemaphoreGive (MessageSetsSemaphore);
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+        bool MessageAdded = GetMessageSet (MsgSetName).AddMessage (MsgText);
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
 
-        MessageSets[MsgSetName].ActivateMessage (MsgText);
+        if (!MessageAdded)
+        {
+            // DEBUG_V(String("Could not add '") + MsgText + "'");
+            break;
+        }
+
+        GetMessageSet (MsgSetName).ActivateMessage (MsgText);
 
         if (Control::noParent == ParentElementId)
         {
@@ -358,21 +408,23 @@ bool c_ControllerMessages::AddMessageSet (String MsgSetName)
             break;
         }
 
-        if (MessageSets.end () != MessageSets.find (MsgSetName))
+        if (RunOnOwnerTask (EditAddMessageSet, MsgSetName))
+        {
+            // DEBUG_V("Queued for the owner task");
+            break;
+        }
+
+        if (nullptr != MessageSetIndex.Find (MsgSetName))
         {
             // DEBUG_V("Message set Already exists");
             break;
         }
 
         // DEBUG_V("Add new message set entry");
-        c_ControllerMessageSet temp;
+        c_ControllerMessageSet & NewMessageSet = GetMessageSet (MsgSetName);
 
-        xSemaphoreTake (MessageSetsSemaphore, portMAX_DELAY);
-        MessageSets[MsgSetName] = temp;
-        xSemaphoreGive (MessageSetsSemaphore);
-
-        MessageSets[MsgSetName].AddControls (& MessageElementIds);
-        MessageSets[MsgSetName].SetName (MsgSetName);
+        NewMessageSet.AddControls (& MessageElementIds);
+        NewMessageSet.SetName (MsgSetName);
 
         if (CurrentMsgSetName.isEmpty ())
         {
@@ -385,6 +437,111 @@ bool c_ControllerMessages::AddMessageSet (String MsgSetName)
     return Response;
 }
 
+// ************************************************************************************************
+// ApplyEdit(): Owner task side of RunOnOwnerTask().
+void c_ControllerMessages::ApplyEdit (MessageEdit_t & Edit)
+{
+    // DEBUG_START;
+
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+
+    switch (Edit.Op)
+    {
+        case EditAddMessage:
+        {
+            AddMessage (Edit.SetName, Edit.Text);
+            break;
+        }
+
+        case EditAddMessageSet:
+        {
+            AddMessageSet (Edit.SetName);
+            break;
+        }
+
+        case EditEraseMessage:
+        {
+            EraseMessage (Edit.SetName, Edit.Text);
+            break;
+        }
+
+        case EditUpdateMessage:
+        {
+            UpdateMessage (Edit.SetName, Edit.Text, Edit.NewText);
+            break;
+        }
+
+        case EditSetDuration:
+        {
+            SetDurration (Edit.SetName, Edit.Value);
+            break;
+        }
+
+        case EditActivateMessageSet:
+        {
+            ActivateMessageSet (Edit.SetName);
+            break;
+        }
+
+        case EditClear:
+        {
+            clear ();
+            break;
+        }
+
+        case EditRestoreConfig:
+        {
+            // empirically Arduino Json needs 3.5 x the json text size to parse the text.
+            DynamicJsonDocument     ConfigDoc (Edit.Text.length () * 4);
+            DeserializationError    error = deserializeJson (ConfigDoc, Edit.Text);
+
+            if (error)
+            {
+                Log.errorln ((String (F ("Message set config could not be restored: ")) + error.c_str ()).c_str ());
+                break;
+            }
+
+            JsonObject Config = ConfigDoc.as <JsonObject>();
+            RestoreConfig (Config);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
+    // DEBUG_END;
+}   // ApplyEdit
+
+// ************************************************************************************************
+// ApplyPendingEdits(): Owner task only. Applies every queued edit as one batch. Called between
+// message picks, so the rotation never sees a half finished edit and never waits for one.
+void c_ControllerMessages::ApplyPendingEdits ()
+{
+    // _ DEBUG_START;
+
+    static MessageEdit_t    Edit;
+    bool                    RefreshUi = false;
+
+    while (PendingEdits.pop (Edit))
+    {
+        Edit.pTarget->ApplyEdit (Edit);
+        RefreshUi |= Edit.RefreshUi;
+        ++EditsApplied;
+    }
+
+    if (RefreshUi)
+    {
+        ESPUI.jsonDom (0);
+    }
+
+    // _ DEBUG_END;
+}   // ApplyPendingEdits
+
 // ************************************************************************************************
 void c_ControllerMessages::CbButtonCreate (Control * sender, int type)
 {
@@ -401,12 +558,15 @@ void c_ControllerMessages::CbButtonCreate (Control * sender, int type)
         }
 
         // DEBUG_V("Create a new message");
-        AddMessage (CurrentMsgSetName, TextControl->value);
+        if (!RunOnOwnerTask (EditAddMessage, CurrentMsgSetName, TextControl->value, emptyString, true))
+        {
+            AddMessage (CurrentMsgSetName, TextControl->value);
 
-        displaySaveWarning ();
+            // refresh the UI
+            ESPUI.jsonDom (0);
+        }
 
-        // refresh the UI
-        ESPUI.jsonDom (0);
+        displaySaveWarning ();
     } while (false);
 
     // DEBUG_END;
@@ -432,17 +592,16 @@ void c_ControllerMessages::CbButtonDelete (Control * sender, int type)
         }
 
         // DEBUG_V("Erase message from the set of messages");
-        xSemaphoreTake (MessageSetsSemaphore, portMAX_DELAY);
-        MessageSets[CurrentMsgSetName].EraseMsg (SelectedMsgName);
-        xSemaphoreGive (MessageSetsSemaphore);
+        if (!RunOnOwnerTask (EditEraseMessage, CurrentMsgSetName, SelectedMsgName, emptyString, true))
+        {
+            EraseMessage (CurrentMsgSetName, SelectedMsgName);
+
+            // refresh the UI
+            ESPUI.jsonDom (0);
+        }
 
-        // DEBUG_V();
-        CbTextChange (nullptr, 0);
         // DEBUG_V();
         displaySaveWarning ();
-
-        // refresh the UI
-        ESPUI.jsonDom (0);
     } while (false);
 
     // DEBUG_END;
@@ -471,9 +630,7 @@ void c_ControllerMessages::CbButtonUpdate (Control * sender, int type)
         String  OriginalMessageText = ChoiceControl->value;
         // DEBUG_V(String("OriginalMessageText: '") + OriginalMessageText + "'");
 
-        MessageSets[CurrentMsgSetName].UpdateMsgText (OriginalMessageText, NewMessageText);
-
-        CbTextChange (nullptr, 0);
+        UpdateMessage (CurrentMsgSetName, OriginalMessageText, NewMessageText);
         displaySaveWarning ();
     } while (false);
 
@@ -503,7 +660,15 @@ void c_ControllerMessages::CbChoiceList (Control * sender, int type)
         ESPUI.updateText (TextEntryElementId, CurrentSeletedMessageName);
 
         // DEBUG_V("tell the message it has been selected");
-        MessageSets[CurrentMsgSetName].ActivateMessage (CurrentSeletedMessageName);
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+        c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (CurrentMsgSetName);
+
+        if (pMessageSet)
+        {
+            pMessageSet->ActivateMessage (CurrentSeletedMessageName);
+        }
+
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
 
         // DEBUG_V("Update the warning and text fields");
         CbTextChange (nullptr, 0);
@@ -543,9 +708,12 @@ void c_ControllerMessages::CbTextChange (Control *, int)
     bool    EnableDelete    = true;
     bool    EnableUpdate    = true;
 
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+    c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (CurrentMsgSetName);
+
     do  // once
     {
-        if (ChoiceList->value.isEmpty () || MessageSets[CurrentMsgSetName].empty ())
+        if (ChoiceList->value.isEmpty () || (nullptr == pMessageSet) || pMessageSet->empty ())
         {
             // DEBUG_V("Disable delete/update buttons");
             EnableDelete    = false;
@@ -589,7 +757,7 @@ void c_ControllerMessages::CbTextChange (Control *, int)
             break;
         }
 
-        if (MessageSets[CurrentMsgSetName].HasMsg (TextControl->value))
+        if (pMessageSet && pMessageSet->HasMsg (TextControl->value))
         {
             // DEBUG_V("Msg exists in active set. No Create or update allowed.");
             EnableCreate    = false;
@@ -602,6 +770,8 @@ void c_ControllerMessages::CbTextChange (Control *, int)
         ESPUI.print (StatusMsgElementId, emptyString);
     } while (false);
 
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
     // DEBUG_V("Update Buttons");
     ESPUI.  setEnabled (ButtonCreateElementId,  EnableCreate);
     ESPUI.  setEnabled (ButtonDeleteElementId,  EnableDelete);
@@ -610,51 +780,150 @@ void c_ControllerMessages::CbTextChange (Control *, int)
     // DEBUG_END;
 }   // TextChangeCb
 
+// ************************************************************************************************
+// clear(): Removes every message set.
+void c_ControllerMessages::clear ()
+{
+    // DEBUG_START;
+
+    if (!RunOnOwnerTask (EditClear, emptyString))
+    {
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+        MessageSetIndex.clear ();
+        MessageSets.clear ();
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
+    }
+
+    // DEBUG_END;
+}   // clear
+
+// ************************************************************************************************
+bool c_ControllerMessages::empty ()
+{
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+    bool Response = MessageSets.empty ();
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
+    return Response;
+}  // empty
+
 // ************************************************************************************************
 bool c_ControllerMessages::empty (String & value)
 {
     // DEBUG_START;
     bool Response = true;
 
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+
     do  // once
     {
-        if (0 == MessageSets.count (value))
+        c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (value);
+
+        if (nullptr == pMessageSet)
         {
             // DEBUG_V("No such message set");
             break;
         }
 
-        Response = MessageSets[value].empty ();
+        Response = pMessageSet->empty ();
     } while (false);
 
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
     // DEBUG_END;
     return Response;
 }  // empty
 
 // ************************************************************************************************
-bool c_ControllerMessages::GetNextRdsMessage (const String & MsgSetName, c_ControllerMgr::RdsMsgInfo_t & Response)
+// GetMessageSet(): Owner task only. Find or create. New message sets are added to the hash index.
+// The lock keeps readers on other tasks out while the map changes. Use AddMessageSet() to create
+// a set, it also names the set and adds its controls.
+c_ControllerMessageSet & c_ControllerMessages::GetMessageSet (const String & MsgSetName)
 {
     // DEBUG_START;
-    bool AllMsgsPlayed = true;
+
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+
+    c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (MsgSetName);
+
+    if (nullptr == pMessageSet)
+    {
+        // DEBUG_V(String("Create message set: '") + MsgSetName + "'");
+        auto MessageSet = MessageSets.insert (std::make_pair (MsgSetName, c_ControllerMessageSet ())).first;
+        MessageSetIndex.Add (MessageSet->first, & MessageSet->second);
+        pMessageSet = & MessageSet->second;
+    }
+
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
+    // DEBUG_END;
+    return * pMessageSet;
+}   // GetMessageSet
+
+// ************************************************************************************************
+void c_ControllerMessages::EraseMessage (String MsgSetName, String MsgText)
+{
+    // DEBUG_START;
+
+    if (RunOnOwnerTask (EditEraseMessage, MsgSetName, MsgText))
+    {
+        return;
+    }
 
     do  // once
     {
-        if (0 == MessageSets.size ())
+        c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (MsgSetName);
+
+        if (nullptr == pMessageSet)
         {
-            // DEBUG_V("No messages to send");
+            // DEBUG_V("no such message set");
             break;
         }
 
-        if (MessageSets.end () == MessageSets.find (MsgSetName))
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+        pMessageSet->EraseMsg (MsgText);
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
+        if (Control::noParent == ParentElementId)
+        {
+            // DEBUG_V("Cannot set up the UI connections yet");
+            break;
+        }
+
+        CbTextChange (nullptr, 0);
+    } while (false);
+
+    // DEBUG_END;
+}   // EraseMessage
+
+// ************************************************************************************************
+// GetNextRdsMessage(): Owner task only. Edits are applied on this task too, so the set found here
+// cannot be removed while it is used.
+bool c_ControllerMessages::GetNextRdsMessage (const String & MsgSetName, c_ControllerMgr::RdsMsgInfo_t & Response)
+{
+    return GetNextRdsMessage (MsgSetName, cMessagePool::Hash (MsgSetName.c_str (), MsgSetName.length ()), Response);
+}
+
+// ************************************************************************************************
+// GetNextRdsMessage(): MsgSetNameHash is cMessagePool::Hash() of the name. Callers that look up the
+// same set over and over (FPPD) keep the hash so each lookup is a single probe of the index.
+bool c_ControllerMessages::GetNextRdsMessage (const String & MsgSetName, uint32_t MsgSetNameHash, c_ControllerMgr::RdsMsgInfo_t & Response)
+{
+    // DEBUG_START;
+    bool AllMsgsPlayed = true;
+
+    do  // once
+    {
+        c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (MsgSetName.c_str (), MsgSetName.length (), MsgSetNameHash);
+
+        if (nullptr == pMessageSet)
         {
             // DEBUG_V("no such message set");
             break;
         }
 
         // DEBUG_V("Get Next Message from the message Set");
-        xSemaphoreTake (MessageSetsSemaphore, portMAX_DELAY);
-        AllMsgsPlayed = MessageSets[MsgSetName].GetNextRdsMessage (Response);
-        xSemaphoreGive (MessageSetsSemaphore);
+        AllMsgsPlayed = pMessageSet->GetNextRdsMessage (Response, RtPlusTagging);
     } while (false);
 
     // DEBUG_END;
@@ -666,8 +935,14 @@ bool c_ControllerMessages::GetNextRdsMessage (const String & MsgSetName, c_Contr
 // ************************************************************************************************
 bool c_ControllerMessages::HasMsgSet (String & value)
 {
-    // DEBUG_V(String("MessageSets.count: ") + String(MessageSets.count(value)));
-    return 0 != MessageSets.count (value);
+    return nullptr != MessageSetIndex.Find (value);
+}
+
+// ************************************************************************************************
+// IsOwnerTask(): True before the owner task is known (boot) and on the owner task.
+bool c_ControllerMessages::IsOwnerTask ()
+{
+    return (NULL == OwnerTask) || (xTaskGetCurrentTaskHandle () == OwnerTask);
 }
 
 // *********************************************************************************************
@@ -677,6 +952,15 @@ void c_ControllerMessages::RestoreConfig (ArduinoJson::JsonObject & config)
 
     // serializeJsonPretty(config, Serial);
 
+    if (!IsOwnerTask ())
+    {
+        // DEBUG_V("Queue a copy of the config for the owner task");
+        String SerializedConfig;
+        serializeJson (config, SerializedConfig);
+        RunOnOwnerTask (EditRestoreConfig, emptyString, SerializedConfig);
+        return;
+    }
+
     if (ShowFseqNameSelection)
     {
         if (config.containsKey (N_DisplayFseqName))
@@ -713,12 +997,48 @@ void c_ControllerMessages::RestoreConfig (ArduinoJson::JsonObject & config)
 
         // DEBUG_V("Send the message set the config");
         JsonObject Temp = CurrentMessageSetConfig;
-        MessageSets[MessageSetName].RestoreConfig (Temp);
+        GetMessageSet (MessageSetName).RestoreConfig (Temp);
     }
 
     // DEBUG_END;
 }   // RestoreConfig
 
+// *********************************************************************************************
+// RunOnOwnerTask(): Hand a structural edit over to the owner task. Returns false if the caller
+// should make the edit itself (no owner task yet, or the caller is the owner task). Never blocks.
+bool c_ControllerMessages::RunOnOwnerTask (EditOp_e Op, const String & SetName, const String & Text, const String & NewText, bool RefreshUi, uint32_t Value)
+{
+    bool Response = false;
+
+    do  // once
+    {
+        if (IsOwnerTask ())
+        {
+            break;
+        }
+
+        Response = true;
+
+        MessageEdit_t NewEdit;
+        NewEdit.pTarget     = this;
+        NewEdit.Op          = Op;
+        NewEdit.RefreshUi   = RefreshUi;
+        NewEdit.SetName     = SetName;
+        NewEdit.Text        = Text;
+        NewEdit.NewText     = NewText;
+        NewEdit.Value       = Value;
+
+        if (!PendingEdits.push (NewEdit))
+        {
+            ++EditsDropped;
+            Log.errorln (F ("Message edit queue is full, edit of '%s' dropped."), SetName.c_str ());
+            break;
+        }
+    } while (false);
+
+    return Response;
+}   // RunOnOwnerTask
+
 // *********************************************************************************************
 void c_ControllerMessages::SaveConfig (ArduinoJson::JsonObject & config)
 {
@@ -734,13 +1054,16 @@ void c_ControllerMessages::SaveConfig (ArduinoJson::JsonObject & config)
     JsonArray MessageSetArray = config.createNestedArray (N_messages);
 
     // DEBUG_V();
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
 
     for (auto & CurrentMessageSet : MessageSets)
     {
         JsonObject MessageSetConfig = MessageSetArray.createNestedObject ();
-        MessageSets[CurrentMessageSet.first].SaveConfig (MessageSetConfig);
+        CurrentMessageSet.second.SaveConfig (MessageSetConfig);
     }
 
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
     // DEBUG_V("Final");
     // serializeJsonPretty(config, Serial);
 
@@ -752,7 +1075,15 @@ void c_ControllerMessages::SaveConfig (ArduinoJson::JsonObject & config, String
 {
     // DEBUG_START;
 
-    MessageSets[SetName].SaveConfig (config);
+    xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+    c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (SetName);
+
+    if (pMessageSet)
+    {
+        pMessageSet->SaveConfig (config);
+    }
+
+    xSemaphoreGiveRecursive (MessageSetsSemaphore);
 
     // DEBUG_END;
 }   // SaveConfig
@@ -772,17 +1103,59 @@ void c_ControllerMessages::SetDurration (String MsgSetName, uint32_t value)
 {
     // DEBUG_START;
 
-    if (MessageSets.end () == MessageSets.find (MsgSetName))
+    c_ControllerMessageSet * pMessageSet = nullptr;
+
+    if (RunOnOwnerTask (EditSetDuration, MsgSetName, emptyString, emptyString, false, value))
+    {
+        // DEBUG_V("Queued for the owner task");
+    }
+    else if (nullptr == (pMessageSet = MessageSetIndex.Find (MsgSetName)))
     {
         // DEBUG_V("No such message set");
     }
     else
     {
-        MessageSets[MsgSetName].SetDurration (value);
+        pMessageSet->SetDurration (value);
     }
 
     // DEBUG_END;
 }
 
+// *********************************************************************************************
+void c_ControllerMessages::UpdateMessage (String MsgSetName, String OriginalMessageText, String NewMessageText)
+{
+    // DEBUG_START;
+
+    if (RunOnOwnerTask (EditUpdateMessage, MsgSetName, OriginalMessageText, NewMessageText))
+    {
+        return;
+    }
+
+    do  // once
+    {
+        c_ControllerMessageSet * pMessageSet = MessageSetIndex.Find (MsgSetName);
+
+        if (nullptr == pMessageSet)
+        {
+            // DEBUG_V("no such message set");
+            break;
+        }
+
+        xSemaphoreTakeRecursive (MessageSetsSemaphore, portMAX_DELAY);
+        pMessageSet->UpdateMsgText (OriginalMessageText, NewMessageText);
+        xSemaphoreGiveRecursive (MessageSetsSemaphore);
+
+        if (Control::noParent == ParentElementId)
+        {
+            // DEBUG_V("Cannot set up the UI connections yet");
+            break;
+        }
+
+        CbTextChange (nullptr, 0);
+    } while (false);
+
+    // DEBUG_END;
+}   // UpdateMessage
+
 // *********************************************************************************************
 // EOF
@@ -26,6 +26,9 @@
 #include <map>
 #include "ControllerMessage.h"
 #include "ControllerMessageSet.h"
+#include "MpscQueue.hpp"
+#include "NameIndex.hpp"
+#include <atomic>
 
 class c_ControllerMessages
 {
@@ -41,6 +44,8 @@ public:
     void    AddMessage (String MsgSetName, String MsgText);
     bool    AddMessageSet (String MsgSetName);
     void    AddControls (uint16_t ctrlTab);
+    void    EraseMessage (String MsgSetName, String MsgText);
+    void    UpdateMessage (String MsgSetName, String OriginalMessageText, String NewMessageText);
 
     void    CbButtonCreate (Control * sender, int type);
     void    CbButtonDelete (Control * sender, int type);
@@ -48,16 +53,59 @@ public:
     void    CbChoiceList (Control * sender, int type);
     void    CbSwitchDisplayFseqName (Control * sender, int type);
     void    CbTextChange (Control * sender, int type);
-    void    clear ()    {MessageSets.clear ();}
-    bool    empty ()    {return MessageSets.empty ();}
+    void    clear ();
+    bool    empty ();
     bool    empty (String & value);
     void    SetShowFseqNameSelection (bool value);
+    void    SetRtPlusTagging (bool value) {RtPlusTagging = value;}
     bool    GetNextRdsMessage (const String & value, c_ControllerMgr::RdsMsgInfo_t & Response);
+    bool    GetNextRdsMessage (const String & value, uint32_t ValueHash, c_ControllerMgr::RdsMsgInfo_t & Response);
     void    SetDurration (String MsgSetName, uint32_t value);
     bool    HasMsgSet (String & value);
 
+    // Edits made by other tasks are queued and applied by the owner (RDS) task. Only the owner
+    // task adds or removes message sets, so it may use them without the lock. Other tasks hold
+    // MessageSetsSemaphore while they look at a set.
+    static void SetOwnerTask (TaskHandle_t value) {OwnerTask = value;}
+    static void ApplyPendingEdits ();
+
+    static std::atomic <uint32_t>   EditsApplied;
+    static std::atomic <uint32_t>   EditsDropped;
+
 private:
 
+    enum EditOp_e : uint8_t
+    {
+        EditAddMessage = 0,
+        EditAddMessageSet,
+        EditEraseMessage,
+        EditUpdateMessage,
+        EditSetDuration,
+        EditActivateMessageSet,
+        EditClear,
+        EditRestoreConfig,
+    };
+
+    struct MessageEdit_t
+    {
+        c_ControllerMessages    * pTarget   = nullptr;
+        EditOp_e                Op          = EditAddMessage;
+        bool                    RefreshUi   = false;
+        String                  SetName;
+        String                  Text;       // Message text, or the serialized config for EditRestoreConfig.
+        String                  NewText;
+        uint32_t                Value       = 0;
+    };
+
+    bool    RunOnOwnerTask (EditOp_e Op, const String & SetName, const String & Text = emptyString, const String & NewText = emptyString, bool RefreshUi = false, uint32_t Value = 0);
+    void    ApplyEdit (MessageEdit_t & Edit);
+    bool    IsOwnerTask ();
+
+    c_ControllerMessageSet & GetMessageSet (const String & MsgSetName);  // Owner task only.
+
+    static cMpscQueue <MessageEdit_t, 32>   PendingEdits;
+    static TaskHandle_t                     OwnerTask;
+
     uint16_t                                    ParentElementId                 = Control::noParent;
     uint16_t                                    StatusMsgElementId              = Control::noParent;
     uint16_t                                    TextEntryElementId              = Control::noParent;
@@ -68,14 +116,17 @@ private:
     uint16_t                                    ButtonUpdateElementId           = Control::noParent;
     uint16_t                                    InstructionElementId            = Control::noParent;
     uint16_t                                    SeperatorMsgElementId           = Control::noParent;
+    uint16_t                                    ScheduleLabelElementId          = Control::noParent;
     c_ControllerMessage::MessageElementIds_t    MessageElementIds;
 
     String                                      Title;
     String                                      CurrentMsgSetName;
     bool                                        ShowFseqNameSelection   = false;
     bool                                        DisplayFseqName         = false;
+    bool                                        RtPlusTagging           = false;    // Tag the message set name in its messages (RT+).
 
     std::map <String, c_ControllerMessageSet>   MessageSets;
+    cNameIndex <c_ControllerMessageSet>         MessageSetIndex;    // Hash lookup into MessageSets. No string compares on the RDS path.
     SemaphoreHandle_t                           MessageSetsSemaphore = NULL;
 };  // c_ControllerMessages
 
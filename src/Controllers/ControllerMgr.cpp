@@ -29,11 +29,16 @@
 #include "ControllerNONE.h"
 #include "ControllerUsbSERIAL.hpp"
 #include "ControllerGpioSERIAL.hpp"
+#include "ControllerMessages.h"
 #include "RdsMessageOrder.hpp"
+#include "RdsMessageWeights.hpp"
 #include "language.h"
 
 #include "memdebug.h"
 
+static const PROGMEM char   NO_CONTROLLERS_STR  [] = "No Controllers Available";
+static const PROGMEM char   NO_MESSAGES_STR     [] = "No Messages Available";
+
 struct ControllerDefinition_t
 {
     c_ControllerMgr::ControllerTypeId_t Type;
@@ -85,6 +90,12 @@ c_ControllerMgr::c_ControllerMgr ()
         ListOfControllers[index].ActiveBit      = CurrentDefinition.ActiveBit;
         ListOfControllers[index].SendingBit     = CurrentDefinition.SendingBit;
 
+        // Table order is priority order. NO_CNTRL never has a message and is left out.
+        if (ControllerTypeId_t::NO_CNTRL != CurrentDefinition.Type)
+        {
+            Scheduler.AddSource (uint8_t (index), uint8_t (&CurrentDefinition - ControllerDefinitions), 1);
+        }
+
         switch (CurrentDefinition.Type)
         {
             case ControllerTypeId_t::NO_CNTRL:
@@ -168,6 +179,7 @@ void c_ControllerMgr::AddControls (uint16_t TabId, ControlColor color)
     // DEBUG_START;
 
     RdsMessageOrder.AddControls (TabId, color);
+    RdsMessageWeights.AddControls (TabId, color);
 
     for (auto & CurrentController : ListOfControllers)
     {
@@ -184,42 +196,40 @@ void c_ControllerMgr::AddControls (uint16_t TabId, ControlColor color)
 void c_ControllerMgr::begin ()
 {
     // DEBUG_START;
+
+    // Message edits from the web server, MQTT and FPP tasks are applied on this (the loop) task.
+    c_ControllerMessages::SetOwnerTask (xTaskGetCurrentTaskHandle ());
+
     for (auto & CurrentController : ListOfControllers)
     {
         // DEBUG_V(String("Begin: ") + CurrentController.pController->GetName());
         // DEBUG_V(String("pController: 0x") + String(uint32_t(CurrentController.pController), HEX));
         CurrentController.pController->begin ();
+        CurrentController.Name = CurrentController.pController->GetName ();
     }
 
     // DEBUG_END;
 }   // begin
 
-// *********************************************************************************************
-void c_ControllerMgr::ClearAllMessagesPlayedConditions ()
-{
-    // DEBUG_START;
-
-    for (auto & CurrentController : ListOfControllers)
-    {
-        // DEBUG_V(String("Controller: '") + CurrentController.pController->GetName() + "' is cleared");
-        CurrentController.pController->ClearAllMessagesPlayed ();
-    }
-
-    // DEBUG_END;
-}  // ClearAllMessagesPlayedConditions
-
 // *********************************************************************************************
 cControllerCommon * c_ControllerMgr::GetControllerById (ControllerTypeId_t Id) {return ListOfControllers[Id].pController;}  // GetControllerById
 
 // *********************************************************************************************
+// GetNextRdsMessage(): The scheduler picks the controller, the controller picks the message.
 bool c_ControllerMgr::GetNextRdsMessage (RdsMsgInfo_t & Response)
 {
     // DEBUG_START;
-    bool AllMsgsPlayed = true;
 
+    // Safe point: catch up with queued message edits before picking.
+    c_ControllerMessages::ApplyPendingEdits ();
+
+    MessagePool.Release (Response.Handle);
     Response.DurationMilliSec   = 0;
-    Response.Text               = F ("No Controllers Available");
+    Response.Text               = NO_CONTROLLERS_STR;
+    Response.ControllerName     = "";
+    Response.RtPlus             = cRdsEncoder::RtPlusTags_t ();
     CurrentSendingControllerId  = ControllerTypeId_t::NO_CNTRL;
+    PendingAllMsgsPlayed        = true;
 
     do  // once
     {
@@ -229,63 +239,59 @@ bool c_ControllerMgr::GetNextRdsMessage (RdsMsgInfo_t & Response)
             break;
         }
 
-        // DEBUG_V("clear the Response found message indicator");
-        Response.DurationMilliSec = 0;
+        pPendingResponse = &Response;
+        int16_t Id = Scheduler.Pick (ServeRdsMessage, this, millis ());
+        pPendingResponse = nullptr;
 
-        if (RdsMessageOrder.getBool ())
+        if (Id < 0)
         {
-            // DEBUG_V("we are in strict priority order. Always start at the highest priority controller");
-            currentControllerIndex = ControllerTypeId_t::NumControllerTypes;
-            ClearAllMessagesPlayedConditions ();
+            // DEBUG_V("No controller has a message to send");
+            break;
         }
 
-        for (uint32_t count = 0;count < ControllerTypeId_t::NumControllerTypes;++count)
-        {
-            if (currentControllerIndex >= ControllerTypeId_t::NumControllerTypes)
-            {
-                // DEBUG_V("Wrap");
-                currentControllerIndex = ControllerTypeId_t::ControllerIdStart;
-                ClearAllMessagesPlayedConditions ();
-            }
-
-            auto & CurrentController = ListOfControllers[currentControllerIndex];
+        Response.ControllerName     = ListOfControllers[Id].Name.c_str ();
+        CurrentSendingControllerId  = ListOfControllers[Id].ControllerId;
 
-            if ((CurrentController.pController->GetAllMessagesSentCondition ()) ||
-                (!CurrentController.pController->ControllerIsEnabled ()))
-            {
-                // DEBUG_V(String("Controller: '") + CurrentController.pController->GetName() + "' is disabled");
-                ++currentControllerIndex;
-                continue;
-            }
+        // DEBUG_V(String("  Duration (ms): ") + String(Response.DurationMilliSec));
+        // DEBUG_V(String("           Text: ") + String(Response.Text));
+        // DEBUG_V(String("Controller Name: ") + String(Response.ControllerName));
+    } while (false);
 
-            // DEBUG_V(String("Controller: '") + CurrentController.pController->GetName() + "': Get Next Message");
-            Response.Text = F ("No Messages Available");
-            String Temp = CurrentController.pController->GetName ();
-            AllMsgsPlayed = CurrentController.pController->GetNextRdsMessage (Temp, Response);
+    // DEBUG_END;
+    return PendingAllMsgsPlayed;
+}  // GetNextRdsMessage
 
-            if (Response.DurationMilliSec)
-            {
-                // DEBUG_V("Found a message to send");
+// *********************************************************************************************
+// ServeRdsMessage(): Scheduler callback. Ask one controller for its next message.
+bool c_ControllerMgr::ServeRdsMessage (uint8_t Id, uint32_t & DurationMs, void * Param)
+{
+    // DEBUG_START;
 
-                Response.ControllerName     = CurrentController.pController->GetName ();
-                CurrentSendingControllerId  = CurrentController.ControllerId;
+    c_ControllerMgr     * pThis             = static_cast <c_ControllerMgr *>(Param);
+    ControllerInfo_t    & CurrentController = pThis->ListOfControllers[Id];
+    RdsMsgInfo_t        & Response          = *pThis->pPendingResponse;
 
-                // DEBUG_V(String("  Duration (ms): ") + String(Response.DurationMilliSec));
-                // DEBUG_V(String("           Text: ") + String(Response.Text));
-                // DEBUG_V(String("Controller Name: ") + String(Response.ControllerName));
-                break;
-            }
-            else
-            {
-                // DEBUG_V("move on to the next controller");
-                ++currentControllerIndex;
-            }
+    do  // once
+    {
+        if (!CurrentController.pController->ControllerIsEnabled ())
+        {
+            // DEBUG_V(String("Controller: '") + CurrentController.Name + "' is disabled");
+            break;
         }
+
+        // The scheduler decides who goes next, the controller always restarts its own list.
+        MessagePool.Release (Response.Handle);
+        Response.Text   = NO_MESSAGES_STR;
+        Response.RtPlus = cRdsEncoder::RtPlusTags_t ();
+        CurrentController.pController->ClearAllMessagesPlayed ();
+        pThis->PendingAllMsgsPlayed = CurrentController.pController->GetNextRdsMessage (CurrentController.Name, Response);
     } while (false);
 
+    DurationMs = Response.DurationMilliSec;
+
     // DEBUG_END;
-    return AllMsgsPlayed;
-}  // GetNextRdsMessage
+    return 0 != DurationMs;
+}  // ServeRdsMessage
 
 // *********************************************************************************************
 uint16_t c_ControllerMgr::getControllerStatusSummary ()
@@ -318,6 +324,9 @@ String c_ControllerMgr::GetName (ControllerTypeId_t Id) {return ListOfController
 void c_ControllerMgr::poll ()
 {
     // _ DEBUG_START;
+
+    c_ControllerMessages::ApplyPendingEdits ();
+
     for (auto & CurrentController : ListOfControllers)
     {
         CurrentController.pController->poll ();
@@ -336,6 +345,7 @@ void c_ControllerMgr::restoreConfiguration (ArduinoJson::JsonObject & config)
     do  // once
     {
         RdsMessageOrder.restoreConfiguration (config);
+        RdsMessageWeights.restoreConfiguration (config);
         ReadFromJSON (RdsOutputEnabled, config, F ("RdsOutputEnabled"));
 
         if (false == config.containsKey (N_controllers))
@@ -379,7 +389,8 @@ void c_ControllerMgr::saveConfiguration (ArduinoJson::JsonObject & config)
 
     do  // once
     {
-        RdsMessageOrder.restoreConfiguration (config);
+        RdsMessageOrder.saveConfiguration (config);
+        RdsMessageWeights.saveConfiguration (config);
         config[F ("RdsOutputEnabled")] = RdsOutputEnabled;
 
         if (!config.containsKey (N_controllers))
@@ -23,6 +23,8 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <ESPUI.h>
+#include "MessagePool.hpp"
+#include "RdsScheduler.hpp"
 
 class cControllerCommon;    // forward declaration
 
@@ -53,11 +55,15 @@ public:
         ControllerIdStart = 0
     };
 
+    // Text points at the interned message held by Handle (or at a fixed status string) and stays
+    // valid until the next GetNextRdsMessage() call with this structure.
     struct RdsMsgInfo_t
     {
-        String      ControllerName;
-        String      Text;
-        uint32_t    DurationMilliSec = 0;
+        const char                  * ControllerName    = "";
+        const char                  * Text              = "";
+        cMessagePool::Handle_t      Handle              = cMessagePool::NullHandle;
+        uint32_t                    DurationMilliSec    = 0;
+        cRdsEncoder::RtPlusTags_t   RtPlus;                 // Cached by the message. Empty if the text is not tagged.
     };
 
 protected:
@@ -68,15 +74,19 @@ protected:
         uint16_t            ActiveBit       = 0;
         uint16_t            SendingBit      = 0;
         cControllerCommon   * pController   = nullptr;
+        String              Name;                   // Message set name used by the controller.
     };
 
     ControllerInfo_t    ListOfControllers[ControllerTypeId_t::NumControllerTypes];
-    uint32_t            currentControllerIndex = ControllerTypeId_t::ControllerIdStart;
 private:
 
     ControllerTypeId_t  CurrentSendingControllerId  = ControllerTypeId_t::NO_CNTRL;
     bool                RdsOutputEnabled            = true;
-    void ClearAllMessagesPlayedConditions ();
+    cRdsScheduler       Scheduler;
+
+    static bool ServeRdsMessage (uint8_t Id, uint32_t & DurationMs, void * Param);
+    RdsMsgInfo_t        * pPendingResponse  = nullptr;  // Used by ServeRdsMessage() during a pick.
+    bool                PendingAllMsgsPlayed = true;
 
 public:
 
@@ -88,12 +98,15 @@ public:
     void                Display (ControllerTypeId_t Id);
     cControllerCommon   * GetControllerById (ControllerTypeId_t Id);
     bool                GetControllerEnabledFlag (ControllerTypeId_t Id);
+    ControllerTypeId_t  GetCurrentSendingControllerId ()   {return CurrentSendingControllerId;}
     uint16_t            getControllerStatusSummary ();
     String              GetName (ControllerTypeId_t Id);
     bool                GetNextRdsMessage (RdsMsgInfo_t & Response);
     void                restoreConfiguration (ArduinoJson::JsonObject & config);
     void                saveConfiguration (ArduinoJson::JsonObject & config);
     void                SetRdsOutputEnabled (bool value) {RdsOutputEnabled = value;}
+    void                SetSchedulerPolicy (cRdsScheduler::Policy_e value) {Scheduler.SetPolicy (value);}
+    void                SetSchedulerWeight (ControllerTypeId_t Id, uint8_t value) {Scheduler.SetWeight (uint8_t (Id), value);}
 };  // c_ControllerMgr
 
 #define CtypeId                 c_ControllerMgr::ControllerTypeId_t
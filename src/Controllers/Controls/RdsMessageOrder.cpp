@@ -16,31 +16,80 @@
 #include <Arduino.h>
 #include <ArduinoLog.h>
 
+#include "ControllerMgr.h"
+#include "PixelRadio.h"
 #include "RdsMessageOrder.hpp"
+#include "RdsScheduler.hpp"
 
 #include "memdebug.h"
 
-static const PROGMEM char   ConfigName  []  = "RdsMessageOrderEnabled";
-static const PROGMEM char   _Title []       = "RDS Message Order";
+static ChoiceListVector_t ListOfPolicies
+{
+    {"Priority",             String (cRdsScheduler::PolicyStrictPriority)},
+    {"Round Robin",          String (cRdsScheduler::PolicyWeightedRoundRobin)},
+    {"Deficit Round Robin",  String (cRdsScheduler::PolicyDeficitRoundRobin)},
+    {"Earliest Deadline",    String (cRdsScheduler::PolicyEarliestDeadline)},
+};
+
+static const PROGMEM char   ConfigName      []  = "RdsMessageOrder";
+static const PROGMEM char   OldConfigName   []  = "RdsMessageOrderEnabled";  // Priority / Round Robin switch.
+static const PROGMEM char   _Title []           = "RDS Message Order";
+static const PROGMEM char   DefaultPolicy   []  = "Priority";
 
 // *********************************************************************************************
-cRdsMessageOrder::cRdsMessageOrder () :   cBinaryControl (ConfigName, _Title, true)
+cRdsMessageOrder::cRdsMessageOrder () :   cChoiceListControl (ConfigName, _Title, DefaultPolicy, & ListOfPolicies)
 {
     // _ DEBUG_START;
     // _ DEBUG_END;
 }
 
 // *********************************************************************************************
-void cRdsMessageOrder::AddControls (uint16_t TabId, ControlColor color)
+// restoreConfiguration(): Older configs only have the Priority / Round Robin switch.
+void cRdsMessageOrder::restoreConfiguration (JsonObject & config)
 {
     // DEBUG_START;
 
-    cBinaryControl::AddControls (TabId, color);
-    setMessageStyle (eCssStyle::CssStyleWhite);
-    setOnMessage ("Priority", eCssStyle::CssStyleWhite);
-    setOffMessage ("Round Robin", eCssStyle::CssStyleWhite);
+    if (!config.containsKey (ConfigName) && config.containsKey (OldConfigName))
+    {
+        bool    PriorityOrder = true;
+        String  Response;
+        ReadFromJSON (PriorityOrder, config, OldConfigName);
+        set (PriorityOrder ? ListOfPolicies[0].first : ListOfPolicies[1].first, Response, SystemBooting, true);
+    }
+    else
+    {
+        cChoiceListControl::restoreConfiguration (config);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// set(): Controller commands may use any case or the policy number.
+bool cRdsMessageOrder::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    String PolicyName = value;
+
+    for (auto & CurrentPolicy : ListOfPolicies)
+    {
+        if (CurrentPolicy.first.equalsIgnoreCase (value) || CurrentPolicy.second.equals (value))
+        {
+            PolicyName = CurrentPolicy.first;
+            break;
+        }
+    }
+
+    bool Response = cChoiceListControl::set (PolicyName, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response || ForceUpdate)
+    {
+        ControllerMgr.SetSchedulerPolicy (cRdsScheduler::Policy_e (get32 ()));
+    }
 
     // DEBUG_END;
+    return Response;
 }
 
 // *********************************************************************************************
@@ -15,16 +15,18 @@
 
 // *********************************************************************************************
 #include <Arduino.h>
-#include "BinaryControl.hpp"
+#include "ChoiceListControl.hpp"
 
 // *********************************************************************************************
-class cRdsMessageOrder : public cBinaryControl
+class cRdsMessageOrder : public cChoiceListControl
 {
 public:
 
     cRdsMessageOrder ();
     virtual~cRdsMessageOrder ()    {}
-    void AddControls (uint16_t TabId, ControlColor color);
+
+    void    restoreConfiguration (JsonObject & config);
+    bool    set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate);
 };  // class cRdsMessageOrder
 
 extern cRdsMessageOrder RdsMessageOrder;
@@ -0,0 +1,156 @@
+/*
+  *    File: RdsMessageWeights.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2023
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2023, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+
+#include "ControllerMgr.h"
+#include "PixelRadio.h"
+#include "RdsMessageWeights.hpp"
+
+#include "memdebug.h"
+
+// One weight per controller, in ControllerTypeId_t order. NO_CNTRL never has a message.
+static const uint32_t       WEIGHT_COUNT        = ControllerTypeId::NO_CNTRL;
+static const uint8_t        WEIGHT_MAX          = 16;
+
+static const PROGMEM char   ConfigName      []  = "RdsMessageWeights";
+static const PROGMEM char   OldConfigName   []  = "RdsWeights";  // JSON array, one entry per controller type.
+static const PROGMEM char   _Title []           = "RDS MESSAGE WEIGHTS<br>1-16 for USB, GPIO, MQTT, FPPD, HTTP, Local<br>Round Robin and Deadline orders only";
+static const PROGMEM char   DefaultWeights  []  = "1,1,1,1,1,1";
+static const PROGMEM uint32_t MaxWeightsSz      = WEIGHT_COUNT * 3;
+
+// *********************************************************************************************
+cRdsMessageWeights::cRdsMessageWeights () :   cControlCommon (ConfigName, ControlType::Text, _Title, DefaultWeights, MaxWeightsSz)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cRdsMessageWeights::ParseList (const String & value, uint8_t * Weights)
+{
+    // DEBUG_START;
+
+    bool        Response    = true;
+    int         Start       = 0;
+    uint32_t    Count       = 0;
+
+    while (Response && (Start <= int (value.length ())))
+    {
+        int End = value.indexOf (',', Start);
+        End = (-1 == End) ? int (value.length ()) : End;
+
+        String Entry = value.substring (Start, End);
+        Entry.trim ();
+        Start = End + 1;
+
+        long Weight = Entry.toInt ();
+
+        if (Entry.isEmpty () || (Weight < 1) || (Weight > WEIGHT_MAX) || (Count >= WEIGHT_COUNT))
+        {
+            Response = false;
+            break;
+        }
+
+        Weights[Count++] = uint8_t (Weight);
+    }
+
+    // DEBUG_END;
+    return Response && (WEIGHT_COUNT == Count);
+}
+
+// *********************************************************************************************
+// restoreConfiguration(): Older configs keep the weights as a JSON array.
+void cRdsMessageWeights::restoreConfiguration (JsonObject & config)
+{
+    // DEBUG_START;
+
+    if (!config.containsKey (ConfigName) && config.containsKey (OldConfigName))
+    {
+        JsonArray   Weights = config[OldConfigName];
+        String      List;
+        String      Response;
+
+        for (uint32_t index = 0;(index < Weights.size ()) && (index < WEIGHT_COUNT);++index)
+        {
+            if (index)
+            {
+                List += ",";
+            }
+
+            List += String (unsigned(Weights[index].as <uint8_t>()));
+        }
+
+        set (List, Response, SystemBooting, true);
+    }
+    else
+    {
+        cControlCommon::restoreConfiguration (config);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cRdsMessageWeights::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = cControlCommon::set (value, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response || ForceUpdate)
+    {
+        uint8_t Weights[WEIGHT_COUNT];
+
+        if (ParseList (GetDataValueStr (), Weights))
+        {
+            for (uint32_t index = 0;index < WEIGHT_COUNT;++index)
+            {
+                ControllerMgr.SetSchedulerWeight (ControllerTypeId (index), Weights[index]);
+            }
+        }
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+bool cRdsMessageWeights::validate (const String & value, String & ResponseMessage, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool    Response = false;
+    uint8_t Weights[WEIGHT_COUNT];
+
+    if (ParseList (value, Weights))
+    {
+        Response = cControlCommon::validate (value, ResponseMessage, ForceUpdate);
+    }
+    else
+    {
+        ResponseMessage = GetTitle () + (F (": BAD_VALUE: Six weights, 1 to 16: ")) + value;
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+cRdsMessageWeights RdsMessageWeights;
+
+// *********************************************************************************************
+// OEF
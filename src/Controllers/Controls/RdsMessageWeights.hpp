@@ -0,0 +1,41 @@
+#pragma once
+/*
+  *    File: RdsMessageWeights.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "ControlCommon.hpp"
+
+// *********************************************************************************************
+class cRdsMessageWeights : public cControlCommon
+{
+public:
+
+    cRdsMessageWeights ();
+    virtual~cRdsMessageWeights ()    {}
+
+    void    restoreConfiguration (JsonObject & config);
+    bool    set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate);
+    bool    validate (const String & value, String & ResponseMessage, bool ForceUpdate);
+
+private:
+
+    // ParseList(): "1,1,2,1,1,1" to one weight per controller. Returns false if any entry is out of range.
+    bool    ParseList (const String & value, uint8_t * Weights);
+};  // class cRdsMessageWeights
+
+extern cRdsMessageWeights RdsMessageWeights;
+
+// *********************************************************************************************
+// OEF
@@ -18,6 +18,7 @@
 #include <WiFi.h>
 #include "fseq.h"
 #include "FPPDiscovery.h"
+#include "FseqMetaCache.hpp"
 #include "language.h"
 
 #if __has_include ("memdebug.h")
@@ -127,7 +128,11 @@ void c_FPPDiscovery::NetworkStateChanged (bool NewNetworkState)
 
         Log.infoln ((String (F ("FPPDiscovery subscribed to multicast: ")) + address.toString ()).c_str ());
 
-        udp.onPacket (std::bind (& c_FPPDiscovery::ProcessReceivedUdpPacket, this, std::placeholders::_1));
+        udp.onPacket (
+            [] (AsyncUDPPacket & UDPpacket)
+            {
+                FPPDiscovery.QueueUdpPacket (UDPpacket);
+            });
 
         sendPingPacket ();
     } while (false);
@@ -136,33 +141,43 @@ void c_FPPDiscovery::NetworkStateChanged (bool NewNetworkState)
 }   // NetworkStateChanged
 
 // -----------------------------------------------------------------------------
-void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
+void c_FPPDiscovery::poll ()
+{
+    // _ DEBUG_START;
+
+    UdpEvent_t Event;
+
+    while (UdpEvents.pop (Event))
+    {
+        ProcessUdpEvent (Event);
+    }
+
+    FseqMetaCache.poll ();
+
+    // _ DEBUG_END;
+}   // poll
+
+// -----------------------------------------------------------------------------
+// ProcessUdpEvent(): Runs in poll(), so nothing here races with the web server or the UI.
+void c_FPPDiscovery::ProcessUdpEvent (const UdpEvent_t & Event)
 {
     // DEBUG_START;
     do  // once
     {
-        FPPPacket * fppPacket = reinterpret_cast <FPPPacket *> (UDPpacket.data ());
-        // DEBUG_V (String ("Received UDP packet from: ") + UDPpacket.remoteIP ().toString ());
-        // DEBUG_V (String ("                 Sent to: ") + UDPpacket.localIP ().toString ());
-        // DEBUG_V (String ("         FPP packet_type: ") + String(fppPacket->packet_type));
-
-        if ((fppPacket->header[0] != 'F') ||
-            (fppPacket->header[1] != 'P') ||
-            (fppPacket->header[2] != 'P') ||
-            (fppPacket->header[3] != 'D'))
+        if (FPP_EVENT_BAD_PACKET == Event.PacketType)
         {
-            // DEBUG_V ("Invalid FPP header");
+            // DEBUG_V ("Invalid FPP packet");
             MultiSyncStats.pktError++;
             break;
         }
 
-        // DEBUG_V ();
+        // DEBUG_V (String ("         FPP packet_type: ") + String(Event.PacketType));
 
         struct timeval tv;
         gettimeofday (& tv, NULL);
         MultiSyncStats.lastReceiveTime = tv.tv_sec;
 
-        switch (fppPacket->packet_type)
+        switch (Event.PacketType)
         {
             case CTRL_PKT_CMD:  // deprecated in favor of FPP Commands
             {
@@ -173,23 +188,30 @@ void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
 
             case CTRL_PKT_SYNC:
             {
-                FPPMultiSyncPacket * msPacket = reinterpret_cast <FPPMultiSyncPacket *> (UDPpacket.data ());
-                // DEBUG_V (String (F ("msPacket->sync_type: ")) + String(msPacket->sync_type));
+                // DEBUG_V (String (F ("Event.FileType: ")) + String(Event.FileType));
 
-                if (msPacket->sync_type == SYNC_FILE_SEQ)
+                if (Event.FileType == SYNC_FILE_SEQ)
                 {
                     // FSEQ type, not media
                     // DEBUG_V (String (F ("Received FPP FSEQ sync packet")));
-                    FppRemoteIp = UDPpacket.remoteIP ();
-                    ProcessSyncPacket (msPacket->sync_action, String (msPacket->filename), msPacket->seconds_elapsed);
+                    cFppPacketView::SyncPacket_t Sync;
+                    Sync.Action         = Event.Action;
+                    Sync.FileType       = Event.FileType;
+                    Sync.FrameNumber    = Event.FrameNumber;
+                    Sync.SecondsElapsed = Event.SecondsElapsed;
+                    Sync.FileName       = cFppPacketView::Name_t (Event.FileName, Event.FileNameLength);
+                    Sync.SequenceName   = cFppPacketView::Name_t (Event.FileName, Event.SequenceNameLength);
+
+                    FppRemoteIp = IPAddress (Event.RemoteIp);
+                    ProcessSyncPacket (Sync);
                 }
-                else if (msPacket->sync_type == SYNC_FILE_MEDIA)
+                else if (Event.FileType == SYNC_FILE_MEDIA)
                 {
                     // DEBUG_V (String (F ("Unsupported SYNC_FILE_MEDIA message.")));
                 }
                 else
                 {
-                    // DEBUG_V (String (F ("Unexpected Multisync msPacket->sync_type: ")) + String (msPacket->sync_type));
+                    // DEBUG_V (String (F ("Unexpected Multisync Event.FileType: ")) + String (Event.FileType));
                 }
 
                 break;
@@ -205,7 +227,7 @@ void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
             {
                 // DEBUG_V (String (F ("FPP Blank packet")));
                 MultiSyncStats.pktBlank++;
-                CurrentFileName = emptyString;
+                SetCurrentFileName (cFppPacketView::Name_t ());
                 break;
             }
 
@@ -214,19 +236,14 @@ void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
                 // DEBUG_V (String (F ("Ping Packet")));
 
                 MultiSyncStats.pktPing++;
-                FPPPingPacket * pingPacket = reinterpret_cast <FPPPingPacket *> (UDPpacket.data ());
 
-                // DEBUG_V (String (F ("Ping Packet subtype: ")) + String (pingPacket->ping_subtype));
-                // DEBUG_V (String (F ("Ping Packet packet.versionMajor: ")) + String (pingPacket->versionMajor));
-                // DEBUG_V (String (F ("Ping Packet packet.versionMinor: ")) + String (pingPacket->versionMinor));
-                // DEBUG_V (String (F ("Ping Packet packet.hostName:     ")) + String (pingPacket->hostName));
-                // DEBUG_V (String (F ("Ping Packet packet.hardwareType: ")) + String (pingPacket->hardwareType));
+                // DEBUG_V (String (F ("Ping Packet subtype: ")) + String (Event.Action));
 
-                if (pingPacket->ping_subtype == 0x01)
+                if (Event.Action == 0x01)
                 {
                     // DEBUG_V (String (F ("FPP Ping discovery packet")));
                     // received a discover ping packet, need to send a ping out
-                    if (UDPpacket.isBroadcast () || UDPpacket.isMulticast ())
+                    if (Event.IsBroadcast)
                     {
                         // DEBUG_V ("Broadcast Ping Response");
                         sendPingPacket ();
@@ -234,12 +251,12 @@ void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
                     else
                     {
                         // DEBUG_V ("Unicast Ping Response");
-                        sendPingPacket (UDPpacket.remoteIP ());
+                        sendPingPacket (IPAddress (Event.RemoteIp));
                     }
                 }
                 else
                 {
-                    // DEBUG_V (String (F ("Unexpected Ping sub type: ")) + String (pingPacket->ping_subtype));
+                    // DEBUG_V (String (F ("Unexpected Ping sub type: ")) + String (Event.Action));
                 }
 
                 break;
@@ -261,32 +278,97 @@ void c_FPPDiscovery::ProcessReceivedUdpPacket (AsyncUDPPacket UDPpacket)
 
             default:
             {
-                // DEBUG_V (String ("UnHandled PDU: packet_type:  ") + String (fppPacket->packet_type));
+                // DEBUG_V (String ("UnHandled PDU: packet_type:  ") + String (Event.PacketType));
                 break;
             }
-        }   // switch (fppPacket->packet_type)
+        }   // switch (Event.PacketType)
     } while (false);
 
     // DEBUG_END;
-}   // ProcessReceivedUdpPacket
+}   // ProcessUdpEvent
 
 // -----------------------------------------------------------------------------
-void c_FPPDiscovery::ProcessSyncPacket (uint8_t action, String FileName, float SecondsElapsed)
+// QueueUdpPacket(): AsyncUDP callback, runs on the network task. It only copies the fields
+// poll() needs into the event queue. When the queue is full the packet is dropped and counted.
+void c_FPPDiscovery::QueueUdpPacket (AsyncUDPPacket & UDPpacket)
 {
     // DEBUG_START;
+
+    cFppPacketView      Packet;
+    UdpEvent_t          Event;
+
+    Event.PacketType    = FPP_EVENT_BAD_PACKET;
+    Event.RemoteIp      = uint32_t (UDPpacket.remoteIP ());
+    Event.IsBroadcast   = UDPpacket.isBroadcast () || UDPpacket.isMulticast ();
+
     do  // once
     {
-        // DEBUG_V (String("  action: ") + String(action));
-        // DEBUG_V (String("FileName: '") + FileName + "'");
-        CurrentFileName = FileName;
+        if (!Packet.Parse (UDPpacket.data (), UDPpacket.length ()))
+        {
+            // DEBUG_V ("Invalid FPP header");
+            break;
+        }
 
-        switch (action)
+        if (CTRL_PKT_SYNC == Packet.PacketType ())
+        {
+            cFppPacketView::SyncPacket_t Sync;
+
+            if (!Packet.GetSync (Sync))
+            {
+                // DEBUG_V ("Short sync packet");
+                break;
+            }
+
+            // Longer names are cut short. The sequence name is never longer than the file name.
+            Event.Action                = Sync.Action;
+            Event.FileType              = Sync.FileType;
+            Event.FrameNumber           = Sync.FrameNumber;
+            Event.SecondsElapsed        = Sync.SecondsElapsed;
+            Event.FileNameLength        = uint8_t (std::min (size_t (Sync.FileName.Length), sizeof (Event.FileName)));
+            Event.SequenceNameLength    = uint8_t (std::min (size_t (Sync.SequenceName.Length), sizeof (Event.FileName)));
+            memcpy (Event.FileName, Sync.FileName.Text, Event.FileNameLength);
+        }
+        else if (CTRL_PKT_PING == Packet.PacketType ())
+        {
+            cFppPacketView::PingPacket_t Ping;
+
+            if (!Packet.GetPing (Ping))
+            {
+                // DEBUG_V ("Short ping packet");
+                break;
+            }
+
+            Event.Action = Ping.SubType;
+        }
+
+        Event.PacketType = Packet.PacketType ();
+    } while (false);
+
+    UdpEvents.push (Event);
+
+    // DEBUG_END;
+}   // QueueUdpPacket
+
+// -----------------------------------------------------------------------------
+// ProcessSyncPacket(): Runs for every sync packet (several per second). Nothing is allocated unless the file changes.
+void c_FPPDiscovery::ProcessSyncPacket (const cFppPacketView::SyncPacket_t & Sync)
+{
+    // DEBUG_START;
+
+    cFppPacketView::Name_t SequenceName = Sync.SequenceName;
+
+    do  // once
+    {
+        // DEBUG_V (String("  action: ") + String(Sync.Action));
+        SetCurrentFileName (Sync.FileName);
+
+        switch (Sync.Action)
         {
             case SYNC_PKT_START:
             {
                 // DEBUG_V ("Sync::Start");
-                // DEBUG_V (String ("      FileName: ") + FileName);
-                // DEBUG_V (String ("SecondsElapsed: ") + SecondsElapsed);
+                // DEBUG_V (String ("      FileName: ") + CurrentFileName);
+                // DEBUG_V (String ("SecondsElapsed: ") + Sync.SecondsElapsed);
                 MultiSyncStats.pktSyncSeqStart++;
                 break;
             }
@@ -294,9 +376,10 @@ void c_FPPDiscovery::ProcessSyncPacket (uint8_t action, String FileName, float S
             case SYNC_PKT_STOP:
             {
                 // DEBUG_V ("Sync::Stop");
-                // DEBUG_V (String ("      FileName: ") + FileName);
-                // DEBUG_V (String ("SecondsElapsed: ") + SecondsElapsed);
-                CurrentFileName = emptyString;
+                // DEBUG_V (String ("      FileName: ") + CurrentFileName);
+                // DEBUG_V (String ("SecondsElapsed: ") + Sync.SecondsElapsed);
+                SetCurrentFileName (cFppPacketView::Name_t ());
+                SequenceName = cFppPacketView::Name_t ();
                 MultiSyncStats.pktSyncSeqStop++;
                 break;
             }
@@ -304,8 +387,8 @@ void c_FPPDiscovery::ProcessSyncPacket (uint8_t action, String FileName, float S
             case SYNC_PKT_SYNC:
             {
                 // DEBUG_V ("Sync");
-                // DEBUG_V (String ("      FileName: ") + FileName);
-                // DEBUG_V (String ("SecondsElapsed: ") + SecondsElapsed);
+                // DEBUG_V (String ("      FileName: ") + CurrentFileName);
+                // DEBUG_V (String ("SecondsElapsed: ") + Sync.SecondsElapsed);
 
                 /*
                   *    Log.infoln (String(float(millis()/1000.0)) + "," +
@@ -316,15 +399,15 @@ void c_FPPDiscovery::ProcessSyncPacket (uint8_t action, String FileName, float S
                   */
 
                 MultiSyncStats.pktSyncSeqSync++;
-                // DEBUG_V (String ("SecondsElapsed: ") + String (SecondsElapsed));
+                // DEBUG_V (String ("SecondsElapsed: ") + String (Sync.SecondsElapsed));
                 break;
             }
 
             case SYNC_PKT_OPEN:
             {
                 // DEBUG_V ("Sync::Open");
-                // DEBUG_V (String ("      FileName: ") + FileName);
-                // DEBUG_V (String ("SecondsElapsed: ") + SecondsElapsed);
+                // DEBUG_V (String ("      FileName: ") + CurrentFileName);
+                // DEBUG_V (String ("SecondsElapsed: ") + Sync.SecondsElapsed);
                 // StartPlaying (FileName, FrameId);
                 MultiSyncStats.pktSyncSeqOpen++;
                 break;
@@ -332,17 +415,39 @@ void c_FPPDiscovery::ProcessSyncPacket (uint8_t action, String FileName, float S
 
             default:
             {
-                // DEBUG_V (String (F ("Sync: ERROR: Unknown Action: ")) + String (action));
+                // DEBUG_V (String (F ("Sync: ERROR: Unknown Action: ")) + String (Sync.Action));
                 break;
             }
         }   // switch
     } while (false);
 
-    FppdCb (CurrentFileName, UserParam);
+    FppdCb (SequenceName, Sync.SecondsElapsed, UserParam);
 
     // DEBUG_END;
 }   // ProcessSyncPacket
 
+// -----------------------------------------------------------------------------
+void c_FPPDiscovery::SetCurrentFileName (const cFppPacketView::Name_t & FileName)
+{
+    // DEBUG_START;
+
+    if (!FileName.Equals (CurrentFileName.c_str (), CurrentFileName.length (), CurrentFileHash))
+    {
+        // DEBUG_V ("New file");
+        CurrentFileName = emptyString;
+        CurrentFileName.concat (FileName.Text, FileName.Length);
+        CurrentFileHash = FileName.Hash;
+
+        if (!CurrentFileName.isEmpty ())
+        {
+            // Read the header now so the length of the sequence is known while it plays.
+            FseqMetaCache.Request (CurrentFileName);
+        }
+    }
+
+    // DEBUG_END;
+}   // SetCurrentFileName
+
 // -----------------------------------------------------------------------------
 void c_FPPDiscovery::sendPingPacket (IPAddress destination)
 {
@@ -425,19 +530,51 @@ void c_FPPDiscovery::sendPingPacket (IPAddress destination)
 #endif // !def PRINT_DEBUG
 
 // -----------------------------------------------------------------------------
+static String Uint64String (uint64_t value)
+{
+    char    Buffer[21];
+    char    * pDigit = & Buffer[sizeof (Buffer) - 1];
+
+    * pDigit = '\0';
+
+    do
+    {
+        * --pDigit  = char ('0' + (value % 10));
+        value       /= 10;
+    } while (value);
+
+    return String (pDigit);
+}   // Uint64String
+
+// -----------------------------------------------------------------------------
+// BuildFseqResponse(): Answers from the header cache. A file that has not been read yet reports
+// zeros until poll() has loaded it.
 void c_FPPDiscovery::BuildFseqResponse (String fname, String & resp)
 {
     // DEBUG_START;
 
     DynamicJsonDocument JsonDoc (4 * 1024);
     JsonObject JsonData = JsonDoc.to <JsonObject>();
+    cFseqHeader Fseq;
+
+    FseqMetaCache.Get (fname, Fseq);
 
     JsonData[F ("Name")]            = fname;
-    JsonData[F ("Version")]         = String (0) + "." + String (0);
-    JsonData[F ("ID")]              = String (0);
-    JsonData[F ("StepTime")]        = String (0);
-    JsonData[F ("NumFrames")]       = String (0);
-    JsonData[F ("CompressionType")] = 0;
+    JsonData[F ("Version")]         = String (Fseq.Header.majorVersion) + "." + String (Fseq.Header.minorVersion);
+    JsonData[F ("ID")]              = Uint64String (Fseq.Header.id);
+    JsonData[F ("StepTime")]        = String (Fseq.Header.stepTime);
+    JsonData[F ("NumFrames")]       = String (Fseq.Header.TotalNumberOfFramesInSequence);
+    JsonData[F ("CompressionType")] = Fseq.Header.compressionType;
+
+    if (!Fseq.VariableHeaders.empty ())
+    {
+        JsonObject JsonVariableHeaders = JsonData.createNestedObject (F ("variableHeaders"));
+
+        for (auto & CurrentHeader : Fseq.VariableHeaders)
+        {
+            JsonVariableHeaders[String (CurrentHeader.type[0]) + CurrentHeader.type[1]] = CurrentHeader.Data;
+        }
+    }
 
     static const int TIME_STR_CHAR_COUNT = 32;
     char timeStr[TIME_STR_CHAR_COUNT];
@@ -474,8 +611,11 @@ void c_FPPDiscovery::BuildFseqResponse (String fname, String & resp)
     JsonData[F ("pktPlugin")]       = MultiSyncStats.pktPlugin;
     JsonData[F ("pktFPPCommand")]   = MultiSyncStats.pktFPPCommand;
     JsonData[F ("pktError")]        = MultiSyncStats.pktError;
-    JsonData[F ("MaxChannel")]      = String (0);
-    JsonData[F ("ChannelCount")]    = String (0);
+    JsonData[F ("pktDropped")]      = UdpEvents.Overflows.load ();
+    JsonData[F ("fseqRead")]        = FseqMetaCache.FilesRead;
+    JsonData[F ("fseqMissing")]     = FseqMetaCache.FilesMissing;
+    JsonData[F ("MaxChannel")]      = String (Fseq.Header.channelCount);
+    JsonData[F ("ChannelCount")]    = String (Fseq.Header.channelCount);
 
     serializeJson (JsonData, resp);
     // DEBUG_V (String ("resp: ") + resp);
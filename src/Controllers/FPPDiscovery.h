@@ -19,25 +19,51 @@
 #include <ArduinoLog.h>
 #include <AsyncUDP.h>
 #include <ESPAsyncWebServer.h>
+#include "FppPacketView.hpp"
+#include "MpscQueue.hpp"
 #include "PixelRadio.h"
 
 class c_FPPDiscovery
 {
 public:
 
-    typedef std::function <void(String & FileName, void * UserParam)> FileChangeCb;
+    // Called for every sequence sync packet. SequenceName points into the packet and is only valid during the call.
+    typedef std::function <void(const cFppPacketView::Name_t & SequenceName, float SecondsElapsed, void * UserParam)> FileChangeCb;
 
 private:
 
     AsyncUDP udp;
-    void    ProcessReceivedUdpPacket (AsyncUDPPacket _packet);
-    void    ProcessSyncPacket (uint8_t action, String filename, float seconds_elapsed);
+
+    // The AsyncUDP callback only queues these. poll() does the work on the loop task.
+    #define FPP_EVENT_QUEUE_SIZE        16      // Must be a power of two.
+    #define FPP_EVENT_FILE_NAME_SIZE    128
+    #define FPP_EVENT_BAD_PACKET        0xFF    // PacketType of a packet that failed the length or header check.
+    struct UdpEvent_t
+    {
+        uint8_t     PacketType          = 0;
+        uint8_t     Action              = 0;    // Sync action or ping sub type.
+        uint8_t     FileType            = 0;
+        bool        IsBroadcast         = false;
+        uint32_t    RemoteIp            = 0;
+        uint32_t    FrameNumber         = 0;
+        float       SecondsElapsed      = 0.0;
+        uint8_t     FileNameLength      = 0;
+        uint8_t     SequenceNameLength  = 0;
+        char        FileName[FPP_EVENT_FILE_NAME_SIZE];
+    };
+    cMpscQueue <UdpEvent_t, FPP_EVENT_QUEUE_SIZE> UdpEvents;
+
+    void    QueueUdpPacket (AsyncUDPPacket & UDPpacket);
+    void    ProcessUdpEvent (const UdpEvent_t & Event);
+    void    ProcessSyncPacket (const cFppPacketView::SyncPacket_t & Sync);
+    void    SetCurrentFileName (const cFppPacketView::Name_t & FileName);
     void    sendPingPacket (IPAddress destination = IPAddress(255, 255, 255, 255));
 
     bool            hasBeenInitialized  = false;
     bool            OldNetworkState     = false;
     IPAddress       FppRemoteIp         = IPAddress (uint32_t (0));
     String          CurrentFileName;
+    uint32_t        CurrentFileHash = cFppPacketView::Name_t ().Hash;
     FileChangeCb    FppdCb;
     void            * UserParam = nullptr;
 
@@ -87,6 +113,7 @@ public:
     {}
 
     void begin (FileChangeCb _FppdCb, void * _UserParam);
+    void poll ();
 
     void    ProcessFPPJson      (AsyncWebServerRequest * request);
     void    ProcessGET          (AsyncWebServerRequest * request);
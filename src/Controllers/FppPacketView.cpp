@@ -0,0 +1,155 @@
+/*
+  *    File: FppPacketView.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include "fseq.h"
+#include "FppPacketView.hpp"
+#include "MessagePool.hpp"
+
+#if __has_include ("memdebug.h")
+ #include "memdebug.h"
+#endif //  __has_include("memdebug.h")
+
+// *********************************************************************************************
+#define FPP_CTRL_PKT_SYNC   1
+#define FPP_CTRL_PKT_PING   4
+
+static const size_t     FPP_HEADER_SIZE         = offsetof (FPPPacket, data_len) + sizeof (uint16_t);
+static const size_t     FPP_SYNC_MIN_SIZE       = offsetof (FPPMultiSyncPacket, filename);
+static const size_t     FPP_PING_MIN_SIZE       = offsetof (FPPPingPacket, versionMajor);
+static const char       FSEQ_EXTENSION []       = ".fseq";
+static const size_t     FSEQ_EXTENSION_LENGTH   = sizeof (FSEQ_EXTENSION) - 1;
+
+// *********************************************************************************************
+cFppPacketView::Name_t::Name_t (const char * _Text, size_t _Length) :
+    Text (_Text),
+    Length (uint16_t (_Length)),
+    Hash (cMessagePool::Hash (_Text, _Length))
+{}
+
+// *********************************************************************************************
+bool cFppPacketView::Name_t::Equals (const char * Other, size_t OtherLength, uint32_t OtherHash) const
+{
+    return (Hash == OtherHash) && (Length == OtherLength) && (0 == memcmp (Text, Other, Length));
+}
+
+// *********************************************************************************************
+// GetName(): Up to MaxLength characters at Offset, ending at the first null or the end of the packet.
+cFppPacketView::Name_t cFppPacketView::GetName (size_t Offset, size_t MaxLength) const
+{
+    Name_t Response;
+
+    if (Offset < Length)
+    {
+        const char  * Text      = reinterpret_cast <const char *>(&Data[Offset]);
+        size_t      Available   = Length - Offset;
+        Response = Name_t (Text, strnlen (Text, (Available < MaxLength) ? Available : MaxLength));
+    }
+
+    return Response;
+}   // GetName
+
+// *********************************************************************************************
+bool cFppPacketView::GetPing (PingPacket_t & Ping) const
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do  // once
+    {
+        if ((FPP_CTRL_PKT_PING != PacketTypeValue) || (Length < FPP_PING_MIN_SIZE))
+        {
+            break;
+        }
+
+        Ping.Version    = Data[offsetof (FPPPingPacket, ping_version)];
+        Ping.SubType    = Data[offsetof (FPPPingPacket, ping_subtype)];
+        Ping.Hardware   = Data[offsetof (FPPPingPacket, ping_hardware)];
+        Ping.HostName   = GetName (offsetof (FPPPingPacket, hostName), sizeof (FPPPingPacket::hostName));
+        Response        = true;
+    } while (false);
+
+    // DEBUG_END;
+    return Response;
+}   // GetPing
+
+// *********************************************************************************************
+bool cFppPacketView::GetSync (SyncPacket_t & Sync) const
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do  // once
+    {
+        if ((FPP_CTRL_PKT_SYNC != PacketTypeValue) || (Length < FPP_SYNC_MIN_SIZE))
+        {
+            break;
+        }
+
+        // The packet is packed, so the multi byte fields are copied out rather than read in place.
+        Sync.Action     = Data[offsetof (FPPMultiSyncPacket, sync_action)];
+        Sync.FileType   = Data[offsetof (FPPMultiSyncPacket, sync_type)];
+        memcpy (&Sync.FrameNumber,      &Data[offsetof (FPPMultiSyncPacket, frame_number)],     sizeof (Sync.FrameNumber));
+        memcpy (&Sync.SecondsElapsed,   &Data[offsetof (FPPMultiSyncPacket, seconds_elapsed)],  sizeof (Sync.SecondsElapsed));
+        Sync.FileName = GetName (offsetof (FPPMultiSyncPacket, filename), sizeof (FPPMultiSyncPacket::filename));
+
+        // Same rule the FPPD controller has always used: cut at the last ".fseq", any case.
+        size_t SequenceLength = Sync.FileName.Length;
+
+        for (size_t Position = Sync.FileName.Length;Position >= FSEQ_EXTENSION_LENGTH;--Position)
+        {
+            if (0 == strncasecmp (&Sync.FileName.Text[Position - FSEQ_EXTENSION_LENGTH], FSEQ_EXTENSION, FSEQ_EXTENSION_LENGTH))
+            {
+                SequenceLength = Position - FSEQ_EXTENSION_LENGTH;
+                break;
+            }
+        }
+
+        Sync.SequenceName   = (SequenceLength == Sync.FileName.Length) ? Sync.FileName : Name_t (Sync.FileName.Text, SequenceLength);
+        Response            = true;
+    } while (false);
+
+    // DEBUG_END;
+    return Response;
+}   // GetSync
+
+// *********************************************************************************************
+bool cFppPacketView::Parse (const uint8_t * _Data, size_t _Length)
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    Data            = _Data;
+    Length          = _Length;
+    PacketTypeValue = 0xFF;
+
+    if (Data && (Length >= FPP_HEADER_SIZE) && (0 == memcmp (Data, "FPPD", 4)))
+    {
+        PacketTypeValue = Data[offsetof (FPPPacket, packet_type)];
+        Response        = true;
+    }
+
+    // DEBUG_END;
+    return Response;
+}   // Parse
+
+// *********************************************************************************************
+// OEF
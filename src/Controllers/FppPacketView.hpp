@@ -0,0 +1,79 @@
+#pragma once
+/*
+  *    File: FppPacketView.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Length checked, zero copy views of the FPP MultiSync packets declared in fseq.h. Parse() only
+  *    records where the packet is; the Get functions check that the bytes they read were received
+  *    and return names as spans (pointer + length + FNV-1a hash) into the packet buffer. A caller
+  *    can compare a name against the one it already has by hash before it copies anything.
+  *    The spans are only valid while the packet buffer is.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+
+// *********************************************************************************************
+class cFppPacketView
+{
+public:
+
+    // Name_t: A name inside the packet. Not null terminated.
+    struct Name_t
+    {
+        Name_t (const char * _Text = "", size_t _Length = 0);
+
+        bool    Equals (const char * Other, size_t OtherLength, uint32_t OtherHash) const;
+        bool    IsEmpty () const  {return 0 == Length;}
+
+        const char  * Text;
+        uint16_t    Length;
+        uint32_t    Hash;   // cMessagePool::Hash() of the text.
+    };
+
+    struct SyncPacket_t
+    {
+        uint8_t     Action          = 0;    // SYNC_PKT_xxx
+        uint8_t     FileType        = 0;    // SYNC_FILE_xxx
+        uint32_t    FrameNumber     = 0;
+        float       SecondsElapsed  = 0.0;
+        Name_t      FileName;
+        Name_t      SequenceName;           // FileName without the ".fseq" extension.
+    };
+
+    struct PingPacket_t
+    {
+        uint8_t     Version     = 0;
+        uint8_t     SubType     = 0;
+        uint8_t     Hardware    = 0;
+        Name_t      HostName;               // Empty if the packet is too short to hold it.
+    };
+
+    // Parse(): false if the packet is too short or does not start with "FPPD".
+    bool    Parse (const uint8_t * _Data, size_t _Length);
+    uint8_t PacketType () const   {return PacketTypeValue;}
+
+    // The Get functions return false if the packet is not of that type or is too short.
+    bool    GetSync (SyncPacket_t & Sync) const;
+    bool    GetPing (PingPacket_t & Ping) const;
+
+private:
+
+    Name_t  GetName (size_t Offset, size_t MaxLength) const;
+
+    const uint8_t   * Data          = nullptr;
+    size_t          Length          = 0;
+    uint8_t         PacketTypeValue = 0;
+};  // class cFppPacketView
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,136 @@
+/*
+  *    File: FseqHeader.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include "FseqHeader.hpp"
+
+#if __has_include ("memdebug.h")
+ #include "memdebug.h"
+#endif //  __has_include("memdebug.h")
+
+// *********************************************************************************************
+static const size_t     FSEQ_V1_FIXED_HEADER_SIZE   = 28;
+static const size_t     FSEQ_V2_FIXED_HEADER_SIZE   = sizeof (FSEQRawHeader);
+static const size_t     FSEQ_VAR_HEADER_SIZE        = offsetof (FSEQRawVariableDataHeader, data);
+
+// *********************************************************************************************
+cFseqHeader::cFseqHeader ()
+{
+    memset (& Header, 0, sizeof (Header));
+}   // cFseqHeader
+
+// *********************************************************************************************
+const String & cFseqHeader::GetVariableHeader (const char * Type) const
+{
+    for (auto & CurrentHeader : VariableHeaders)
+    {
+        if ((CurrentHeader.type[0] == Type[0]) && (CurrentHeader.type[1] == Type[1]))
+        {
+            return CurrentHeader.Data;
+        }
+    }
+
+    return emptyString;
+}   // GetVariableHeader
+
+// *********************************************************************************************
+bool cFseqHeader::Parse (uint8_t * Buffer, size_t Length)
+{
+    // DEBUG_START;
+
+    FSEQRawHeader * Raw = reinterpret_cast <FSEQRawHeader *>(Buffer);
+
+    Valid = false;
+    memset (& Header, 0, sizeof (Header));
+    VariableHeaders.clear ();
+
+    do  // once
+    {
+        if ((Length < FSEQ_V1_FIXED_HEADER_SIZE) ||
+            ((0 != memcmp (Raw->header, "PSEQ", 4)) && (0 != memcmp (Raw->header, "FSEQ", 4))))
+        {
+            // DEBUG_V("Not an FSEQ file");
+            break;
+        }
+
+        memcpy (Header.header, Raw->header, sizeof (Header.header));
+        Header.dataOffset                       = read16 (Raw->dataOffset);
+        Header.minorVersion                     = Raw->minorVersion;
+        Header.majorVersion                     = Raw->majorVersion;
+        Header.VariableHdrOffset                = read16 (Raw->VariableHdrOffset);
+        Header.channelCount                     = read32 (Raw->channelCount, 0);
+        Header.TotalNumberOfFramesInSequence    = read32 (Raw->TotalNumberOfFramesInSequence, 0);
+        Header.stepTime                         = Raw->stepTime;
+        Header.flags                            = Raw->flags;
+
+        if (2 == Header.majorVersion)
+        {
+            if (Length < FSEQ_V2_FIXED_HEADER_SIZE)
+            {
+                // DEBUG_V("Short v2 header");
+                break;
+            }
+
+            // The top four bits of the compression type byte extend the block count.
+            Header.compressionType      = Raw->compressionType & 0x0F;
+            Header.numCompressedBlocks  = Raw->numCompressedBlocks;
+            Header.numSparseRanges      = Raw->numSparseRanges;
+            Header.flags2               = Raw->flags2;
+            Header.id                   = read64 (Raw->id, 0);
+        }
+        else if (1 != Header.majorVersion)
+        {
+            // DEBUG_V(String("Unsupported version: ") + String(Header.majorVersion));
+            break;
+        }
+
+        // Variable headers run from VariableHdrOffset to the channel data. Stop at the end of the buffer.
+        size_t  End     = std::min (size_t (Header.dataOffset), Length);
+        size_t  Offset  = Header.VariableHdrOffset;
+
+        while ((Offset + FSEQ_VAR_HEADER_SIZE) <= End)
+        {
+            FSEQRawVariableDataHeader   * RawVar    = reinterpret_cast <FSEQRawVariableDataHeader *>(& Buffer[Offset]);
+            size_t                      VarLength   = read16 (RawVar->length);
+
+            if ((VarLength < FSEQ_VAR_HEADER_SIZE) || ((Offset + VarLength) > End))
+            {
+                // DEBUG_V("Variable header is corrupt or does not fit in the buffer");
+                break;
+            }
+
+            const char * Data = reinterpret_cast <const char *>(& RawVar->data);
+
+            FSEQParsedVariableDataHeader NewHeader;
+            NewHeader.length    = uint16_t (VarLength);
+            NewHeader.type[0]   = RawVar->type[0];
+            NewHeader.type[1]   = RawVar->type[1];
+            NewHeader.Data.concat (Data, strnlen (Data, VarLength - FSEQ_VAR_HEADER_SIZE));
+            VariableHeaders.push_back (NewHeader);
+
+            Offset += VarLength;
+        }
+
+        Valid = true;
+    } while (false);
+
+    // DEBUG_END;
+    return Valid;
+}   // Parse
+
+// *********************************************************************************************
+// OEF
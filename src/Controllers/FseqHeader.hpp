@@ -0,0 +1,54 @@
+#pragma once
+/*
+  *    File: FseqHeader.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    FSEQ v1 / v2 file header parser. Works on the first FSEQ_HEADER_READ_SIZE bytes of a sequence
+  *    file, so the channel data is never read. Variable headers (mf = media file, sp = sequence
+  *    producer, ...) that do not fit in the buffer are left out.
+  *    See https://github.com/FalconChristmas/fpp/blob/master/docs/FSEQ_Sequence_File_Format.txt
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <vector>
+#include "fseq.h"
+
+// *********************************************************************************************
+#define FSEQ_HEADER_READ_SIZE   512     // Fixed header, sparse ranges and the usual variable headers.
+
+// *********************************************************************************************
+class cFseqHeader
+{
+public:
+
+    cFseqHeader ();
+    virtual~cFseqHeader ()    {}
+
+    // Parse(): false if Buffer does not hold a complete v1 or v2 fixed header.
+    bool            Parse (uint8_t * Buffer, size_t Length);
+    bool            IsValid () const    {return Valid;}
+    uint32_t        DurationMs () const {return Header.TotalNumberOfFramesInSequence * Header.stepTime;}
+
+    // GetVariableHeader(): emptyString if the file does not have a header of that type.
+    const String &  GetVariableHeader (const char * Type) const;
+
+    FSEQParsedHeader                            Header;
+    std::vector <FSEQParsedVariableDataHeader>  VariableHeaders;
+
+private:
+
+    bool Valid = false;
+};  // class cFseqHeader
+
+// *********************************************************************************************
+// OEF
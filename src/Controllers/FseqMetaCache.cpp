@@ -0,0 +1,308 @@
+/*
+  *    File: FseqMetaCache.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+#include <LittleFS.h>
+#include <SD.h>
+#include <SPI.h>
+#include <string.h>
+#include <strings.h>
+#include "FseqMetaCache.hpp"
+#include "PixelRadio.h"
+
+#if __has_include ("memdebug.h")
+ #include "memdebug.h"
+#endif //  __has_include("memdebug.h")
+
+// *********************************************************************************************
+static const char   FSEQ_EXTENSION []       = ".fseq";
+static const size_t FSEQ_EXTENSION_LENGTH   = sizeof (FSEQ_EXTENSION) - 1;
+
+// *********************************************************************************************
+cFseqMetaCache::cFseqMetaCache ()
+{
+    // DEBUG_START;
+
+    CacheSemaphore = xSemaphoreCreateMutex ();
+
+    // DEBUG_END;
+}   // cFseqMetaCache
+
+// *********************************************************************************************
+void cFseqMetaCache::begin (LoadedCb _LoadedCb, void * _UserParam)
+{
+    // DEBUG_START;
+
+    LoadedCallback  = _LoadedCb;
+    UserParam       = _UserParam;
+
+    // DEBUG_END;
+}   // begin
+
+// *********************************************************************************************
+// Find(): Caller holds CacheSemaphore. Returns nullptr on a miss and queues a load unless the
+// file was recently found to be missing.
+const cFseqHeader * cFseqMetaCache::Find (const String & SequenceName)
+{
+    const cFseqHeader   * Response  = nullptr;
+    bool                NeedLoad    = true;
+    auto                Entry       = Entries.find (SequenceName);
+
+    if (Entries.end () != Entry)
+    {
+        Entry->second.LastUsed = millis ();
+
+        if (Entry->second.Header.IsValid ())
+        {
+            Response = & Entry->second.Header;
+        }
+
+        NeedLoad = !Entry->second.Header.IsValid () && ((millis () - Entry->second.LoadTime) >= FSEQ_META_RETRY_MS);
+    }
+
+    if (NeedLoad && !SequenceName.isEmpty ())
+    {
+        Request (SequenceName);
+    }
+
+    return Response;
+}   // Find
+
+// *********************************************************************************************
+bool cFseqMetaCache::Get (const String & Name, cFseqHeader & Response)
+{
+    // DEBUG_START;
+
+    String SequenceName = SequenceNameOf (Name);
+
+    xSemaphoreTake (CacheSemaphore, portMAX_DELAY);
+    const cFseqHeader * pHeader = Find (SequenceName);
+
+    if (pHeader)
+    {
+        Response = * pHeader;
+    }
+
+    xSemaphoreGive (CacheSemaphore);
+
+    // DEBUG_END;
+    return nullptr != pHeader;
+}   // Get
+
+// *********************************************************************************************
+// GetDurationMs(): 0 if the length of the sequence is not known (yet).
+uint32_t cFseqMetaCache::GetDurationMs (const String & Name)
+{
+    // DEBUG_START;
+
+    String SequenceName = SequenceNameOf (Name);
+
+    xSemaphoreTake (CacheSemaphore, portMAX_DELAY);
+    const cFseqHeader   * pHeader   = Find (SequenceName);
+    uint32_t            Response    = pHeader ? pHeader->DurationMs () : 0;
+    xSemaphoreGive (CacheSemaphore);
+
+    // DEBUG_END;
+    return Response;
+}   // GetDurationMs
+
+// *********************************************************************************************
+// Load(): Loop task only.
+void cFseqMetaCache::Load (const String & SequenceName)
+{
+    // DEBUG_START;
+
+    static uint8_t  Buffer[FSEQ_HEADER_READ_SIZE];
+    Entry_t         NewEntry;
+
+    do  // once
+    {
+        xSemaphoreTake (CacheSemaphore, portMAX_DELAY);
+        auto    Entry       = Entries.find (SequenceName);
+        bool    IsCurrent   = (Entries.end () != Entry) &&
+                              (Entry->second.Header.IsValid () || ((millis () - Entry->second.LoadTime) < FSEQ_META_RETRY_MS));
+        xSemaphoreGive (CacheSemaphore);
+
+        if (IsCurrent)
+        {
+            // DEBUG_V("Already loaded. Duplicate request");
+            break;
+        }
+
+        bool    SdCardBusy;
+        size_t  Length = ReadHeader (String ("/") + SequenceName + FSEQ_EXTENSION, Buffer, SdCardBusy);
+
+        if (SdCardBusy)
+        {
+            // DEBUG_V("Not missing, just not readable right now. Ask again on the next lookup");
+            break;
+        }
+
+        if (Length && NewEntry.Header.Parse (Buffer, Length))
+        {
+            ++FilesRead;
+            Log.verboseln ((String (F ("FSEQ '")) + SequenceName + F ("': ") + String (NewEntry.Header.DurationMs ()) + F (" ms")).c_str ());
+        }
+        else
+        {
+            ++FilesMissing;
+        }
+
+        NewEntry.LoadTime   = millis ();
+        NewEntry.LastUsed   = NewEntry.LoadTime;
+
+        xSemaphoreTake (CacheSemaphore, portMAX_DELAY);
+
+        if ((Entries.size () >= FSEQ_META_CACHE_SIZE) && (Entries.end () == Entries.find (SequenceName)))
+        {
+            // DEBUG_V("Cache is full. Drop the least recently used entry");
+            auto Oldest = Entries.begin ();
+
+            for (auto Current = Entries.begin ();Current != Entries.end ();++Current)
+            {
+                if ((millis () - Current->second.LastUsed) > (millis () - Oldest->second.LastUsed))
+                {
+                    Oldest = Current;
+                }
+            }
+
+            Entries.erase (Oldest);
+        }
+
+        Entries[SequenceName] = NewEntry;
+        xSemaphoreGive (CacheSemaphore);
+
+        if (NewEntry.Header.IsValid () && LoadedCallback)
+        {
+            LoadedCallback (SequenceName, NewEntry.Header, UserParam);
+        }
+    } while (false);
+
+    // DEBUG_END;
+}   // Load
+
+// *********************************************************************************************
+// poll(): One file per call so a slow SD card does not hold up the loop for long.
+void cFseqMetaCache::poll ()
+{
+    // _ DEBUG_START;
+
+    LoadRequest_t NextRequest;
+
+    if (LoadRequests.pop (NextRequest))
+    {
+        Load (String (NextRequest.Name));
+    }
+
+    // _ DEBUG_END;
+}   // poll
+
+// *********************************************************************************************
+// ReadHeader(): Reads the start of the file from LittleFS, or the SD card if it is not in LittleFS.
+// Returns the number of bytes read, 0 if the file was not found. SdCardBusy is set instead of
+// waiting when a backup has the card.
+size_t cFseqMetaCache::ReadHeader (const String & FileName, uint8_t * Buffer, bool & SdCardBusy)
+{
+    // DEBUG_START;
+
+    SdCardBusy = false;
+
+    size_t  Response = 0;
+    File    SequenceFile;
+
+    do  // once
+    {
+        if (LittleFS.exists (FileName))
+        {
+            SequenceFile = LittleFS.open (FileName, FILE_READ);
+            Response = SequenceFile.read (Buffer, FSEQ_HEADER_READ_SIZE);
+            SequenceFile.close ();
+            break;
+        }
+
+        if (!sdCardPresent ())
+        {
+            // DEBUG_V("No SD card. A backup or restore from the UI looks for one again");
+            break;
+        }
+
+        if (!sdCardLock (0))
+        {
+            // DEBUG_V("A backup is using the card. Try again later");
+            SdCardBusy = true;
+            break;
+        }
+
+        SPIClass SPI2 (HSPI);
+
+        SPI2.begin (SD_CLK_PIN, MISO_PIN, MOSI_PIN, SD_CS_PIN);
+        pinMode (MISO_PIN, INPUT_PULLUP);   // MISO requires internal pull-up.
+        SD.end ();                          // Reset interface (in case SD card had been swapped).
+
+        if (!SD.begin (SD_CS_PIN, SPI2))
+        {
+            Log.warningln (F ("FSEQ: No SD card. Sequence headers are only read from LittleFS."));
+            sdCardSetPresent (false);
+        }
+        else if (SD.exists (FileName))
+        {
+            SequenceFile = SD.open (FileName, FILE_READ);
+            Response = SequenceFile.read (Buffer, FSEQ_HEADER_READ_SIZE);
+            SequenceFile.close ();
+        }
+
+        SD.end ();
+        spiSdCardShutDown ();
+        sdCardUnlock ();
+    } while (false);
+
+    // DEBUG_END;
+    return Response;
+}   // ReadHeader
+
+// *********************************************************************************************
+// Request(): Safe from any task. The request is dropped if the queue is full; the next Get() asks again.
+void cFseqMetaCache::Request (const String & Name)
+{
+    // DEBUG_START;
+
+    LoadRequest_t NewRequest;
+
+    strncpy (NewRequest.Name, SequenceNameOf (Name).c_str (), sizeof (NewRequest.Name) - 1);
+    NewRequest.Name[sizeof (NewRequest.Name) - 1] = '\0';
+    LoadRequests.push (NewRequest);
+
+    // DEBUG_END;
+}   // Request
+
+// *********************************************************************************************
+String cFseqMetaCache::SequenceNameOf (const String & Name)
+{
+    size_t Length = Name.length ();
+
+    if ((Length > FSEQ_EXTENSION_LENGTH) && (0 == strcasecmp (& Name.c_str ()[Length - FSEQ_EXTENSION_LENGTH], FSEQ_EXTENSION)))
+    {
+        return Name.substring (0, Length - FSEQ_EXTENSION_LENGTH);
+    }
+
+    return Name;
+}   // SequenceNameOf
+
+// *********************************************************************************************
+cFseqMetaCache FseqMetaCache;
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,84 @@
+#pragma once
+/*
+  *    File: FseqMetaCache.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Parsed FSEQ headers keyed by sequence name (file name without ".fseq"). Lookups never touch a
+  *    file system: a miss queues the name and poll() reads "/<name>.fseq" from LittleFS or the SD
+  *    card on the loop task. Files that are not found are looked for again after FSEQ_META_RETRY_MS.
+  *    The SD card is skipped while none is present and never waited for while a backup uses it.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <map>
+#include "FseqHeader.hpp"
+#include "MpscQueue.hpp"
+
+// *********************************************************************************************
+#define FSEQ_META_CACHE_SIZE    16
+#define FSEQ_META_NAME_SIZE     128
+#define FSEQ_META_RETRY_MS      (60 * 1000)
+
+// *********************************************************************************************
+class cFseqMetaCache
+{
+public:
+
+    // Called on the loop task each time a header has been read from a file.
+    typedef std::function <void(const String & SequenceName, const cFseqHeader & Header, void * UserParam)> LoadedCb;
+
+    cFseqMetaCache ();
+    virtual~cFseqMetaCache ()    {}
+
+    void        begin (LoadedCb _LoadedCb, void * _UserParam);
+    void        poll ();
+
+    // Safe from any task. Name may be a file name or a sequence name. A miss queues a load.
+    bool        Get (const String & Name, cFseqHeader & Response);
+    uint32_t    GetDurationMs (const String & Name);
+    void        Request (const String & Name);
+
+    static String SequenceNameOf (const String & Name);
+
+    uint32_t    FilesRead       = 0;
+    uint32_t    FilesMissing    = 0;
+
+private:
+
+    struct Entry_t
+    {
+        cFseqHeader Header;                 // Not valid if the file was not found.
+        uint32_t    LoadTime    = 0;
+        uint32_t    LastUsed    = 0;
+    };
+
+    struct LoadRequest_t
+    {
+        char        Name[FSEQ_META_NAME_SIZE];
+    };
+
+    const cFseqHeader * Find (const String & SequenceName);
+    void                Load (const String & SequenceName);
+    size_t              ReadHeader (const String & FileName, uint8_t * Buffer, bool & SdCardBusy);
+
+    std::map <String, Entry_t>                  Entries;
+    cMpscQueue <LoadRequest_t, 4>               LoadRequests;
+    SemaphoreHandle_t                           CacheSemaphore  = NULL;
+    LoadedCb                                    LoadedCallback  = nullptr;
+    void                                        * UserParam     = nullptr;
+};  // class cFseqMetaCache
+
+extern cFseqMetaCache FseqMetaCache;
+
+// *********************************************************************************************
+// OEF
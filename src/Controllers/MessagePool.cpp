@@ -0,0 +1,270 @@
+/*
+  *    File: MessagePool.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include "MessagePool.hpp"
+#include <string.h>
+
+#if __has_include ("memdebug.h")
+ #include "memdebug.h"
+#endif //  __has_include("memdebug.h")
+
+// *********************************************************************************************
+static const uint32_t   FNV_OFFSET_BASIS    = 0x811C9DC5;
+static const uint32_t   FNV_PRIME           = 0x01000193;
+static const uint16_t   INDEX_MASK          = MESSAGE_POOL_INDEX_SIZE - 1;
+
+static_assert (MESSAGE_POOL_SLOTS < 255, "Slot ids must fit in a byte and leave room for EmptyIndex");
+static_assert (0 == (MESSAGE_POOL_INDEX_SIZE & INDEX_MASK), "MESSAGE_POOL_INDEX_SIZE must be a power of two");
+static_assert (MESSAGE_POOL_INDEX_SIZE > MESSAGE_POOL_SLOTS, "The hash index must always have an empty entry");
+
+#define MakeHandle(SlotId)  Handle_t ((uint16_t (Slots[SlotId].Generation) << 8) | (SlotId))
+
+// *********************************************************************************************
+cMessagePool::cMessagePool ()
+{
+    // DEBUG_START;
+
+    for (uint8_t SlotId = 0;SlotId < MESSAGE_POOL_SLOTS;++SlotId)
+    {
+        Slots[SlotId].Text[0]   = '\0';
+        Slots[SlotId].NextFree  = ((SlotId + 1) < MESSAGE_POOL_SLOTS) ? (SlotId + 1) : EmptyIndex;
+    }
+
+    memset (Index, EmptyIndex, sizeof (Index));
+    PoolSemaphore = xSemaphoreCreateMutex ();
+
+    // DEBUG_END;
+}   // cMessagePool
+
+// *********************************************************************************************
+cMessagePool::Handle_t cMessagePool::AddRef (Handle_t Handle)
+{
+    // DEBUG_START;
+
+    Handle_t Response = NullHandle;
+
+    xSemaphoreTake (PoolSemaphore, portMAX_DELAY);
+    Slot_t * pSlot = GetSlot (Handle);
+
+    if (pSlot)
+    {
+        ++pSlot->RefCount;
+        Response = Handle;
+    }
+
+    xSemaphoreGive (PoolSemaphore);
+
+    // DEBUG_END;
+    return Response;
+}   // AddRef
+
+// *********************************************************************************************
+// Assign(): Target = Source, keeping both reference counts right.
+void cMessagePool::Assign (Handle_t & Target, Handle_t Source)
+{
+    // DEBUG_START;
+
+    if (Target != Source)
+    {
+        Handle_t NewHandle = AddRef (Source);
+        Release (Target);
+        Target = NewHandle;
+    }
+
+    // DEBUG_END;
+}   // Assign
+
+// *********************************************************************************************
+// GetSlot(): nullptr if the handle is null, out of range or refers to a slot that has been reused.
+cMessagePool::Slot_t * cMessagePool::GetSlot (Handle_t Handle)
+{
+    Slot_t  * Response  = nullptr;
+    uint8_t SlotId      = uint8_t (Handle);
+
+    if ((NullHandle != Handle) &&
+        (SlotId < MESSAGE_POOL_SLOTS) &&
+        (Slots[SlotId].Generation == uint8_t (Handle >> 8)) &&
+        (0 != Slots[SlotId].RefCount))
+    {
+        Response = &Slots[SlotId];
+    }
+
+    return Response;
+}   // GetSlot
+
+// *********************************************************************************************
+// Hash(): 32 bit FNV-1a
+uint32_t cMessagePool::Hash (const char * Text, size_t Length)
+{
+    uint32_t Response = FNV_OFFSET_BASIS;
+
+    while (Length--)
+    {
+        Response ^= uint8_t (*Text++);
+        Response *= FNV_PRIME;
+    }
+
+    return Response;
+}   // Hash
+
+// *********************************************************************************************
+// IndexRemove(): Backward shift delete. Keeps every probe chain unbroken without tombstones.
+void cMessagePool::IndexRemove (uint8_t SlotId)
+{
+    // DEBUG_START;
+
+    uint16_t Hole = Slots[SlotId].Hash & INDEX_MASK;
+
+    while (Index[Hole] != SlotId)
+    {
+        Hole = (Hole + 1) & INDEX_MASK;
+    }
+
+    Index[Hole] = EmptyIndex;
+
+    for (uint16_t Next = (Hole + 1) & INDEX_MASK;EmptyIndex != Index[Next];Next = (Next + 1) & INDEX_MASK)
+    {
+        uint16_t Home = Slots[Index[Next]].Hash & INDEX_MASK;
+
+        // Move the entry into the hole unless its home position lies between the hole and where it sits now.
+        if (((Next - Home) & INDEX_MASK) >= ((Next - Hole) & INDEX_MASK))
+        {
+            Index[Hole] = Index[Next];
+            Index[Next] = EmptyIndex;
+            Hole        = Next;
+        }
+    }
+
+    // DEBUG_END;
+}   // IndexRemove
+
+// *********************************************************************************************
+cMessagePool::Handle_t cMessagePool::Intern (const char * Text)
+{
+    // DEBUG_START;
+
+    Handle_t    Response    = NullHandle;
+    uint8_t     Length      = uint8_t (strnlen (Text, RADIOTEXT_SIZE));
+    uint32_t    TextHash    = Hash (Text, Length);
+    uint16_t    Position    = TextHash & INDEX_MASK;
+
+    xSemaphoreTake (PoolSemaphore, portMAX_DELAY);
+
+    do  // once
+    {
+        while (EmptyIndex != Index[Position])
+        {
+            Slot_t & CurrentSlot = Slots[Index[Position]];
+
+            if ((CurrentSlot.Hash == TextHash) && (CurrentSlot.Length == Length) && (0 == memcmp (CurrentSlot.Text, Text, Length)))
+            {
+                // DEBUG_V("Already interned");
+                ++CurrentSlot.RefCount;
+                Response = MakeHandle (Index[Position]);
+                break;
+            }
+
+            Position = (Position + 1) & INDEX_MASK;
+        }
+
+        if (NullHandle != Response)
+        {
+            break;
+        }
+
+        if (EmptyIndex == FreeHead)
+        {
+            // DEBUG_V("Pool is full");
+            ++Failures;
+            break;
+        }
+
+        uint8_t SlotId      = FreeHead;
+        Slot_t  & NewSlot   = Slots[SlotId];
+        FreeHead = NewSlot.NextFree;
+
+        memcpy (NewSlot.Text, Text, Length);
+        NewSlot.Text[Length]    = '\0';
+        NewSlot.Length          = Length;
+        NewSlot.Hash            = TextHash;
+        NewSlot.RefCount        = 1;
+        NewSlot.NextFree        = EmptyIndex;
+        Index[Position]         = SlotId;
+
+        if (++InUse > MaxInUse)
+        {
+            MaxInUse = InUse;
+        }
+
+        Response = MakeHandle (SlotId);
+    } while (false);
+
+    xSemaphoreGive (PoolSemaphore);
+
+    // DEBUG_END;
+    return Response;
+}   // Intern
+
+// *********************************************************************************************
+bool cMessagePool::IsValid (Handle_t Handle) {return nullptr != GetSlot (Handle);}
+
+// *********************************************************************************************
+uint8_t cMessagePool::Length (Handle_t Handle)
+{
+    Slot_t * pSlot = GetSlot (Handle);
+
+    return pSlot ? pSlot->Length : 0;
+}   // Length
+
+// *********************************************************************************************
+void cMessagePool::Release (Handle_t & Handle)
+{
+    // DEBUG_START;
+
+    xSemaphoreTake (PoolSemaphore, portMAX_DELAY);
+    Slot_t * pSlot = GetSlot (Handle);
+
+    if (pSlot && (0 == --pSlot->RefCount))
+    {
+        // DEBUG_V("Last reference. Free the slot");
+        uint8_t SlotId = uint8_t (Handle);
+
+        IndexRemove (SlotId);
+        ++pSlot->Generation;
+        pSlot->NextFree = FreeHead;
+        FreeHead        = SlotId;
+        --InUse;
+    }
+
+    xSemaphoreGive (PoolSemaphore);
+    Handle = NullHandle;
+
+    // DEBUG_END;
+}   // Release
+
+// *********************************************************************************************
+// Text(): The slot cannot change while the caller holds a reference, so no lock is needed.
+const char * cMessagePool::Text (Handle_t Handle)
+{
+    Slot_t * pSlot = GetSlot (Handle);
+
+    return pSlot ? pSlot->Text : "";
+}   // Text
+
+// *********************************************************************************************
+cMessagePool MessagePool;
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,84 @@
+#pragma once
+/*
+  *    File: MessagePool.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Interned RadioText storage. Every message lives in one fixed size slot of a static pool and is
+  *    referred to by a 16 bit handle (slot index + generation). Identical texts share a slot, found
+  *    through an open addressing (linear probe) FNV-1a hash index. Slot text never changes while a
+  *    handle references it, so readers may use Text() without holding the pool lock.
+  *    Nothing in here touches the heap after boot.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "RdsEncoder.hpp"
+
+// *********************************************************************************************
+#define MESSAGE_POOL_SLOTS      128                         // Must be < 255
+#define MESSAGE_POOL_INDEX_SIZE (MESSAGE_POOL_SLOTS * 2)    // Must be a power of two.
+
+// *********************************************************************************************
+class cMessagePool
+{
+public:
+
+    typedef uint16_t Handle_t;
+    static const Handle_t NullHandle = 0xFFFF;
+
+    cMessagePool ();
+    virtual~cMessagePool ()    {}
+
+    // Intern(): Returns a referenced handle for Text (truncated to RADIOTEXT_SIZE). NullHandle if the pool is full.
+    Handle_t        Intern (const char * Text);
+    Handle_t        AddRef (Handle_t Handle);
+    void            Release (Handle_t & Handle);    // Handle is set to NullHandle.
+    void            Assign (Handle_t & Target, Handle_t Source);
+    bool            IsValid (Handle_t Handle);
+    const char *    Text (Handle_t Handle);
+    uint8_t         Length (Handle_t Handle);
+
+    static uint32_t Hash (const char * Text, size_t Length);
+
+    uint16_t    SlotsInUse ()   {return InUse;}
+    uint16_t    HighWater ()    {return MaxInUse;}
+    uint32_t    Failures        = 0;    // Intern() calls rejected because the pool was full.
+
+private:
+
+    struct Slot_t
+    {
+        char        Text[RADIOTEXT_SIZE + 1];
+        uint8_t     Length      = 0;
+        uint8_t     Generation  = 0;
+        uint8_t     NextFree    = 0xFF;
+        uint16_t    RefCount    = 0;
+        uint32_t    Hash        = 0;
+    };
+
+    static const uint8_t EmptyIndex = 0xFF;
+
+    Slot_t * GetSlot (Handle_t Handle);
+    void     IndexRemove (uint8_t SlotId);
+
+    Slot_t              Slots[MESSAGE_POOL_SLOTS];
+    uint8_t             Index[MESSAGE_POOL_INDEX_SIZE];
+    uint8_t             FreeHead    = 0;
+    uint16_t            InUse       = 0;
+    uint16_t            MaxInUse    = 0;
+    SemaphoreHandle_t   PoolSemaphore = NULL;
+};  // class cMessagePool
+
+extern cMessagePool MessagePool;
+
+// *********************************************************************************************
+// OEF
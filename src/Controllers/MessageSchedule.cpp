@@ -0,0 +1,401 @@
+/*
+  *    File: MessageSchedule.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "MessageSchedule.hpp"
+
+// *********************************************************************************************
+static const char * const   DayNames[]      = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static const uint16_t       MINUTES_PER_DAY = 24 * 60;
+static const time_t         SECS_PER_DAY    = 24 * 60 * 60;
+
+// *********************************************************************************************
+static int8_t ParseDay (const char * Text, size_t Length)
+{
+    int8_t Response = -1;
+
+    for (int8_t Day = 0;(Length == 3) && (Day < 7);++Day)
+    {
+        if (0 == strncasecmp (Text, DayNames[Day], 3))
+        {
+            Response = Day;
+            break;
+        }
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+// ParseDate(): "YYYY-MM-DD" to YYYYMMDD. Returns 0 if the text is not a date.
+static uint32_t ParseDate (const char * Text, size_t Length)
+{
+    unsigned    Year, Month, Day;
+    char        Tail;
+    char        Buffer[12];
+
+    if ((Length < 8) || (Length >= sizeof (Buffer)))
+    {
+        return 0;
+    }
+
+    memcpy (Buffer, Text, Length);
+    Buffer[Length] = '\0';
+
+    if ((3 != sscanf (Buffer, "%4u-%2u-%2u%c", &Year, &Month, &Day, &Tail)) ||
+        (Year < 2000) || (Year > 2099) || (Month < 1) || (Month > 12) || (Day < 1) || (Day > 31))
+    {
+        return 0;
+    }
+
+    return (Year * 10000) + (Month * 100) + Day;
+}
+
+// *********************************************************************************************
+// ParseTime(): "HH:MM" to minutes after midnight. Returns -1 if the text is not a time.
+static int16_t ParseTime (const char * Text, size_t Length)
+{
+    unsigned    Hour, Minute;
+    char        Tail;
+    char        Buffer[8];
+
+    if ((Length < 3) || (Length >= sizeof (Buffer)))
+    {
+        return -1;
+    }
+
+    memcpy (Buffer, Text, Length);
+    Buffer[Length] = '\0';
+
+    if ((2 != sscanf (Buffer, "%2u:%2u%c", &Hour, &Minute, &Tail)) || (Hour > 24) || (Minute > 59) || ((24 == Hour) && Minute))
+    {
+        return -1;
+    }
+
+    return int16_t ((Hour * 60 + Minute) % MINUTES_PER_DAY);
+}
+
+// *********************************************************************************************
+static uint32_t DateOf (const struct tm & Day) {return uint32_t ((Day.tm_year + 1900) * 10000 + (Day.tm_mon + 1) * 100 + Day.tm_mday);}
+
+// *********************************************************************************************
+bool cMessageSchedule::DayIsSelected (const struct tm & Day) const
+{
+    uint32_t Date = DateOf (Day);
+
+    return (0 != (DayMask & (1 << Day.tm_wday))) &&
+           ((0 == FirstDate) || (Date >= FirstDate)) &&
+           ((0 == LastDate) || (Date <= LastDate));
+}
+
+// *********************************************************************************************
+void cMessageSchedule::Format (char * Buffer, size_t BufferSize) const
+{
+    // DEBUG_START;
+
+    size_t Used = 0;
+
+    #define Append(...)  Used += snprintf (Buffer + Used, (Used < BufferSize) ? (BufferSize - Used) : 0, __VA_ARGS__)
+
+    Buffer[0] = '\0';
+
+    do  // once
+    {
+        if (IsAlways ())
+        {
+            Append ("Always");
+            break;
+        }
+
+        if (AllDays != DayMask)
+        {
+            // Runs of three or more days become ranges. A run through Saturday and Sunday
+            // ("Fri-Mon", "Sat,Sun") is written first so it is not split at the end of the week.
+            uint8_t First = 0;
+
+            while ((DayMask & (1 << First)) && (DayMask & (1 << ((First + 6) % 7))))
+            {
+                First = (First + 6) % 7;
+            }
+
+            for (uint8_t Count = 0;Count < 7;)
+            {
+                uint8_t Day = (First + Count) % 7;
+                uint8_t Run = 0;
+
+                while (((Count + Run) < 7) && (DayMask & (1 << ((Day + Run) % 7))))
+                {
+                    ++Run;
+                }
+
+                if (0 == Run)
+                {
+                    ++Count;
+                    continue;
+                }
+
+                if (Run < 3)
+                {
+                    Append ("%s%s", Used ? "," : "", DayNames[Day]);
+                    Run = 1;
+                }
+                else
+                {
+                    Append ("%s%s-%s", Used ? "," : "", DayNames[Day], DayNames[(Day + Run - 1) % 7]);
+                }
+
+                Count += Run;
+            }
+        }
+
+        if (StartMinute != EndMinute)
+        {
+            Append ("%s%02u:%02u-%02u:%02u", Used ? " " : "", StartMinute / 60, StartMinute % 60, EndMinute / 60, EndMinute % 60);
+        }
+
+        if (FirstDate || LastDate)
+        {
+            Append ("%s", Used ? " " : "");
+
+            if (FirstDate)
+            {
+                Append ("%04u-%02u-%02u", unsigned (FirstDate / 10000), unsigned ((FirstDate / 100) % 100), unsigned (FirstDate % 100));
+            }
+
+            if (FirstDate != LastDate)
+            {
+                Append ("..");
+
+                if (LastDate)
+                {
+                    Append ("%04u-%02u-%02u", unsigned (LastDate / 10000), unsigned ((LastDate / 100) % 100), unsigned (LastDate % 100));
+                }
+            }
+        }
+    } while (false);
+
+    #undef Append
+
+    // DEBUG_END;
+}   // Format
+
+// *********************************************************************************************
+bool cMessageSchedule::IsActive (const struct tm & LocalTime) const
+{
+    // DEBUG_START;
+
+    bool        Response    = false;
+    uint16_t    Minute      = uint16_t (LocalTime.tm_hour * 60 + LocalTime.tm_min);
+
+    do  // once
+    {
+        if (IsAlways ())
+        {
+            Response = true;
+            break;
+        }
+
+        if (StartMinute == EndMinute)
+        {
+            // All day
+            Response = DayIsSelected (LocalTime);
+            break;
+        }
+
+        if (StartMinute < EndMinute)
+        {
+            Response = (Minute >= StartMinute) && (Minute < EndMinute) && DayIsSelected (LocalTime);
+            break;
+        }
+
+        // The window runs past midnight.
+        if (Minute >= StartMinute)
+        {
+            Response = DayIsSelected (LocalTime);
+            break;
+        }
+
+        if (Minute < EndMinute)
+        {
+            // Still in the window that started yesterday.
+            struct tm Yesterday = LocalTime;
+            Yesterday.tm_mday   -= 1;
+            Yesterday.tm_isdst  = -1;
+            mktime (&Yesterday);
+            Response = DayIsSelected (Yesterday);
+        }
+    } while (false);
+
+    // DEBUG_END;
+    return Response;
+}   // IsActive
+
+// *********************************************************************************************
+bool cMessageSchedule::IsAlways () const
+{
+    return (AllDays == DayMask) && (StartMinute == EndMinute) && (0 == FirstDate) && (0 == LastDate);
+}
+
+// *********************************************************************************************
+// NextChange(): The result can only change at the window start, the window end or midnight.
+time_t cMessageSchedule::NextChange (time_t Now, const struct tm & LocalTime) const
+{
+    // DEBUG_START;
+
+    time_t  SecsToday       = time_t (LocalTime.tm_hour) * 3600 + LocalTime.tm_min * 60 + LocalTime.tm_sec;
+    time_t  Boundaries[]    = {time_t (StartMinute) * 60, time_t (EndMinute) * 60, 0};
+    time_t  Response        = SECS_PER_DAY;
+
+    for (auto Boundary : Boundaries)
+    {
+        time_t Delta = Boundary - SecsToday;
+
+        if (Delta <= 0)
+        {
+            Delta += SECS_PER_DAY;
+        }
+
+        if (Delta < Response)
+        {
+            Response = Delta;
+        }
+    }
+
+    // DEBUG_END;
+    return Now + Response;
+}   // NextChange
+
+// *********************************************************************************************
+bool cMessageSchedule::Parse (const char * Text)
+{
+    // DEBUG_START;
+
+    cMessageSchedule    NewSchedule;
+    bool                Response    = true;
+    bool                DaysGiven   = false;
+
+    while (Response && *Text)
+    {
+        if (isspace (uint8_t (*Text)))
+        {
+            ++Text;
+            continue;
+        }
+
+        size_t          Length  = strcspn (Text, " \t");
+        const char      * Token = Text;
+        const char      * Split;
+        Text += Length;
+
+        if ((6 == Length) && (0 == strncasecmp (Token, "always", 6)))
+        {
+            continue;
+        }
+
+        if ((5 == Length) && (0 == strncasecmp (Token, "daily", 5)))
+        {
+            NewSchedule.DayMask = AllDays;
+            continue;
+        }
+
+        if (nullptr != (Split = static_cast <const char *>(memchr (Token, ':', Length))))
+        {
+            // HH:MM-HH:MM
+            Split = static_cast <const char *>(memchr (Token, '-', Length));
+            int16_t Start   = Split ? ParseTime (Token, size_t (Split - Token)) : -1;
+            int16_t End     = Split ? ParseTime (Split + 1, size_t (Token + Length - Split - 1)) : -1;
+
+            Response                = (Start >= 0) && (End >= 0);
+            NewSchedule.StartMinute = uint16_t (Start);
+            NewSchedule.EndMinute   = uint16_t (End);
+            continue;
+        }
+
+        if (isdigit (uint8_t (*Token)) || ('.' == *Token))
+        {
+            // YYYY-MM-DD, YYYY-MM-DD..YYYY-MM-DD, YYYY-MM-DD.. or ..YYYY-MM-DD
+            Split = strstr (Token, "..");
+
+            if ((nullptr == Split) || (Split >= (Token + Length)))
+            {
+                NewSchedule.FirstDate   = ParseDate (Token, Length);
+                NewSchedule.LastDate    = NewSchedule.FirstDate;
+                Response                = (0 != NewSchedule.FirstDate);
+                continue;
+            }
+
+            size_t FirstLength  = size_t (Split - Token);
+            size_t LastLength   = Length - FirstLength - 2;
+            NewSchedule.FirstDate   = FirstLength ? ParseDate (Token, FirstLength) : 0;
+            NewSchedule.LastDate    = LastLength ? ParseDate (Split + 2, LastLength) : 0;
+            Response                = (!FirstLength || NewSchedule.FirstDate) && (!LastLength || NewSchedule.LastDate) &&
+                                      (FirstLength || LastLength) &&
+                                      (!NewSchedule.FirstDate || !NewSchedule.LastDate || (NewSchedule.FirstDate <= NewSchedule.LastDate));
+            continue;
+        }
+
+        // Day list: Sat,Sun or Mon-Fri or a mix.
+        if (!DaysGiven)
+        {
+            NewSchedule.DayMask = 0;
+            DaysGiven           = true;
+        }
+
+        while (Response && Length)
+        {
+            size_t      ItemLength  = strcspn (Token, ",");
+            ItemLength = (ItemLength < Length) ? ItemLength : Length;
+            const char  * Dash      = static_cast <const char *>(memchr (Token, '-', ItemLength));
+            int8_t      First       = ParseDay (Token, Dash ? size_t (Dash - Token) : ItemLength);
+            int8_t      Last        = Dash ? ParseDay (Dash + 1, size_t (Token + ItemLength - Dash - 1)) : First;
+
+            Response = (First >= 0) && (Last >= 0);
+
+            for (int8_t Day = First;Response;Day = (Day + 1) % 7)
+            {
+                NewSchedule.DayMask |= uint8_t (1 << Day);
+
+                if (Day == Last)
+                {
+                    break;
+                }
+            }
+
+            ItemLength  = (ItemLength < Length) ? (ItemLength + 1) : ItemLength;
+            Token       += ItemLength;
+            Length      -= ItemLength;
+        }
+    }
+
+    if (Response && DaysGiven && (0 == NewSchedule.DayMask))
+    {
+        Response = false;
+    }
+
+    if (Response)
+    {
+        *this = NewSchedule;
+    }
+
+    // DEBUG_END;
+    return Response;
+}   // Parse
+
+// *********************************************************************************************
+// OEF
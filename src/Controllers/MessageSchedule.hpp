@@ -0,0 +1,65 @@
+#pragma once
+/*
+  *    File: MessageSchedule.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    When a message may be sent. A schedule is a daily time window that repeats on the selected
+  *    days of the week, optionally limited to a range of dates. Text form (every part optional):
+  *        "Sat,Sun 18:00-23:00 2022-11-25..2023-01-06"
+  *        "Mon-Fri 17:30-22:00", "Daily 18:00-01:00", "2022-12-24", "Always"
+  *    A window whose end is before its start runs past midnight and belongs to the day it starts.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+// *********************************************************************************************
+// Longest Format() output is 50: "Sun,Tue,Thu,Sat 00:00-00:00 2022-11-25..2023-01-06". The
+// rest is room for text typed into the UI before it is normalized.
+#define MESSAGE_SCHEDULE_TEXT_SIZE  64
+
+// *********************************************************************************************
+class cMessageSchedule
+{
+public:
+
+    static const uint8_t AllDays = 0x7F;    // Bit N == struct tm day N (0 == Sunday).
+
+    bool    IsAlways () const;
+    bool    IsActive (const struct tm & LocalTime) const;
+
+    // NextChange(): Earliest time after Now at which IsActive() may change.
+    time_t  NextChange (time_t Now, const struct tm & LocalTime) const;
+
+    // Parse() leaves the schedule unchanged and returns false if Text is not valid.
+    bool    Parse (const char * Text);
+    void    Format (char * Buffer, size_t BufferSize) const;
+
+    // The RTC starts at 1970 until SNTP sets it. Scheduled messages stay off the air until then.
+    static bool ClockIsValid (time_t Now)   {return Now > 1640995200;}  // Jan 1 2022
+
+    uint8_t     DayMask     = AllDays;
+    uint16_t    StartMinute = 0;    // Minutes after midnight. Start == End: all day.
+    uint16_t    EndMinute   = 0;
+    uint32_t    FirstDate   = 0;    // YYYYMMDD, 0 == no limit.
+    uint32_t    LastDate    = 0;
+
+private:
+
+    bool    DayIsSelected (const struct tm & Day) const;
+};  // class cMessageSchedule
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,189 @@
+#pragma once
+/*
+  *    File: NameIndex.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Hash index over the entries of a std::map keyed by name. Entries are found by their 32 bit
+  *    FNV-1a hash (cMessagePool::Hash) through an open addressing (linear probe) table, so a lookup
+  *    with a precomputed hash costs one probe and one memcmp and never touches the heap.
+  *    The table only grows in Add(), which runs when a name is created, never on the sync path.
+  *    The index points at the map's own key and value. std::map nodes do not move, so these
+  *    pointers stay valid until the entry is erased (Remove() it first).
+  *    Find() runs on the loop task while UI callbacks may Add(), so every call takes IndexSemaphore.
+  *    It is only held for the probe itself, never while the caller uses the entry. An owner that
+  *    erases entries on another task must hold its own lock around Find() and the use of the result.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <string.h>
+#include <vector>
+#include "MessagePool.hpp"
+
+// *********************************************************************************************
+template <typename T>
+class cNameIndex
+{
+public:
+
+    cNameIndex ()    {IndexSemaphore = xSemaphoreCreateMutex ();}
+    virtual~cNameIndex ()    {}
+
+    // Find(): nullptr if Name is not listed. Hash must be cMessagePool::Hash (Name, Length).
+    T * Find (const char * Name, size_t Length, uint32_t Hash) const
+    {
+        xSemaphoreTake (IndexSemaphore, portMAX_DELAY);
+
+        T       * Response  = nullptr;
+        size_t  Mask        = Slots.size () - 1;
+
+        for (size_t Position = Hash & Mask;!Slots.empty () && Slots[Position].pKey;Position = (Position + 1) & Mask)
+        {
+            const Slot_t & Slot = Slots[Position];
+
+            if ((Slot.Hash == Hash) && (Slot.pKey->length () == Length) && (0 == memcmp (Slot.pKey->c_str (), Name, Length)))
+            {
+                Response = Slot.pValue;
+                break;
+            }
+        }
+
+        xSemaphoreGive (IndexSemaphore);
+
+        return Response;
+    }
+
+    T * Find (const String & Name) const {return Find (Name.c_str (), Name.length (), cMessagePool::Hash (Name.c_str (), Name.length ()));}
+
+    // Add(): Key must stay unchanged while it is listed. Adding a listed key updates its value.
+    void Add (const String & Key, T * pValue)
+    {
+        xSemaphoreTake (IndexSemaphore, portMAX_DELAY);
+
+        if ((Count + 1) * 2 > Slots.size ())
+        {
+            Resize ((Slots.size () < MinSize) ? MinSize : (Slots.size () * 2));
+        }
+
+        Slot_t NewSlot;
+        NewSlot.Hash    = cMessagePool::Hash (Key.c_str (), Key.length ());
+        NewSlot.pKey    = &Key;
+        NewSlot.pValue  = pValue;
+        Insert (NewSlot);
+
+        xSemaphoreGive (IndexSemaphore);
+    }
+
+    // Remove(): See Erase().
+    void Remove (const String & Key)
+    {
+        xSemaphoreTake (IndexSemaphore, portMAX_DELAY);
+        Erase (Key);
+        xSemaphoreGive (IndexSemaphore);
+    }
+
+    void    clear ()        {xSemaphoreTake (IndexSemaphore, portMAX_DELAY); Slots.clear (); Count = 0; xSemaphoreGive (IndexSemaphore);}
+    size_t  size () const   {return Count;}
+
+private:
+
+    struct Slot_t
+    {
+        uint32_t        Hash    = 0;
+        const String    * pKey  = nullptr;  // nullptr == Empty slot.
+        T               * pValue = nullptr;
+    };
+
+    static const size_t MinSize = 16;   // Must be a power of two.
+
+    // Erase(): Backward shift delete. Keeps every probe chain unbroken without tombstones.
+    void Erase (const String & Key)
+    {
+        size_t      Mask    = Slots.size () - 1;
+        uint32_t    Hash    = cMessagePool::Hash (Key.c_str (), Key.length ());
+        size_t      Hole    = Hash & Mask;
+
+        while (!Slots.empty () && Slots[Hole].pKey)
+        {
+            if ((Slots[Hole].Hash == Hash) && Slots[Hole].pKey->equals (Key))
+            {
+                break;
+            }
+
+            Hole = (Hole + 1) & Mask;
+        }
+
+        if (Slots.empty () || (nullptr == Slots[Hole].pKey))
+        {
+            return;
+        }
+
+        Slots[Hole] = Slot_t ();
+        --Count;
+
+        for (size_t Next = (Hole + 1) & Mask;Slots[Next].pKey;Next = (Next + 1) & Mask)
+        {
+            size_t Home = Slots[Next].Hash & Mask;
+
+            // Move the entry into the hole unless its home position lies between the hole and where it sits now.
+            if (((Next - Home) & Mask) >= ((Next - Hole) & Mask))
+            {
+                Slots[Hole] = Slots[Next];
+                Slots[Next] = Slot_t ();
+                Hole        = Next;
+            }
+        }
+    }
+
+    void Insert (const Slot_t & NewSlot)
+    {
+        size_t Mask = Slots.size () - 1;
+
+        for (size_t Position = NewSlot.Hash & Mask;;Position = (Position + 1) & Mask)
+        {
+            if (nullptr == Slots[Position].pKey)
+            {
+                Slots[Position] = NewSlot;
+                ++Count;
+                break;
+            }
+
+            if ((Slots[Position].Hash == NewSlot.Hash) && Slots[Position].pKey->equals (*NewSlot.pKey))
+            {
+                Slots[Position].pValue = NewSlot.pValue;
+                break;
+            }
+        }
+    }
+
+    void Resize (size_t NewSize)
+    {
+        std::vector <Slot_t> OldSlots (NewSize);
+        OldSlots.swap (Slots);
+        Count = 0;
+
+        for (auto & Slot : OldSlots)
+        {
+            if (Slot.pKey)
+            {
+                Insert (Slot);
+            }
+        }
+    }
+
+    std::vector <Slot_t>    Slots;
+    size_t                  Count           = 0;
+    SemaphoreHandle_t       IndexSemaphore  = NULL;
+};  // class cNameIndex
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,288 @@
+/*
+  *    File: RdsScheduler.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include "RdsScheduler.hpp"
+
+// *********************************************************************************************
+static const uint32_t WRR_STRIDE = 720720;  // Divisible by 1..16, so common weights give exact strides.
+
+// *********************************************************************************************
+bool cRdsScheduler::AddSource (uint8_t Id, uint8_t Priority, uint8_t Weight)
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    if (SourceCount < RDS_SCHEDULER_MAX_SOURCES)
+    {
+        Source_t & Source = Sources[SourceCount];
+        Source.Id       = Id;
+        Source.Priority = Priority;
+        Source.Weight   = Weight ? Weight : 1;
+
+        ++SourceCount;
+        Rebuild ();
+        Response = true;
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+// Charge(): Bill a source for the message it just got on air.
+void cRdsScheduler::Charge (Source_t & Source, uint32_t DurationMs)
+{
+    switch (Policy)
+    {
+        case PolicyWeightedRoundRobin:
+        {
+            Source.Pass += WRR_STRIDE / Source.Weight;
+            break;
+        }
+
+        case PolicyDeficitRoundRobin:
+        {
+            Source.Deficit -= int32_t (DurationMs);
+
+            while (Source.Deficit <= 0)
+            {
+                ++Source.Pass;
+                Source.Deficit += int32_t (DrrQuantumMs * Source.Weight);
+            }
+
+            break;
+        }
+
+        case PolicyEarliestDeadline:
+        {
+            Source.Pass = Clock + DurationMs + (EdfPeriodMs / Source.Weight);
+            break;
+        }
+
+        case PolicyStrictPriority:
+        default:
+        {
+            break;
+        }
+    }
+
+    Source.Key = MakeKey (Source);
+}
+
+// *********************************************************************************************
+uint8_t cRdsScheduler::GetWeight (uint8_t Id)
+{
+    uint8_t Response = 0;
+
+    for (uint8_t index = 0;index < SourceCount;++index)
+    {
+        if (Sources[index].Id == Id)
+        {
+            Response = Sources[index].Weight;
+            break;
+        }
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+// MakeKey(): Policy value in the upper bits, priority in the low byte as the tie breaker.
+uint64_t cRdsScheduler::MakeKey (const Source_t & Source)
+{
+    uint64_t Response = Source.Priority;
+
+    if (PolicyStrictPriority != Policy)
+    {
+        Response |= Source.Pass << 8;
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+// Pick(): Offer the slot to the sources in key order until one of them has a message.
+int16_t cRdsScheduler::Pick (ServeCallback_t Serve, void * Param, uint32_t Now)
+{
+    // DEBUG_START;
+
+    int16_t Response = -1;
+    uint8_t Skipped[RDS_SCHEDULER_MAX_SOURCES];
+    uint8_t SkippedCount = 0;
+
+    Clock   += uint32_t (Now - LastNow);   // Wrap safe.
+    LastNow = Now;
+
+    while (HeapSize)
+    {
+        uint8_t     SourceIndex = Pop ();
+        Source_t    & Source    = Sources[SourceIndex];
+        uint32_t    DurationMs  = 0;
+
+        if (Serve (Source.Id, DurationMs, Param) && DurationMs)
+        {
+            CurrentPass = Source.Pass;
+            Charge (Source, DurationMs);
+            Push (SourceIndex);
+            Response = Source.Id;
+            break;
+        }
+
+        Skipped[SkippedCount++] = SourceIndex;
+    }
+
+    // Sources with nothing to say don't bank credit while they are quiet.
+    while (SkippedCount)
+    {
+        uint8_t SourceIndex = Skipped[--SkippedCount];
+
+        if (Response >= 0)
+        {
+            Rejoin (Sources[SourceIndex]);
+        }
+
+        Push (SourceIndex);
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+uint8_t cRdsScheduler::Pop ()
+{
+    uint8_t Response = Heap[0];
+
+    Heap[0] = Heap[--HeapSize];
+
+    for (uint8_t Parent = 0;;)
+    {
+        uint8_t Smallest    = Parent;
+        uint8_t Left        = uint8_t (2 * Parent + 1);
+        uint8_t Right       = uint8_t (Left + 1);
+
+        if ((Left < HeapSize) && (Sources[Heap[Left]].Key < Sources[Heap[Smallest]].Key))
+        {
+            Smallest = Left;
+        }
+
+        if ((Right < HeapSize) && (Sources[Heap[Right]].Key < Sources[Heap[Smallest]].Key))
+        {
+            Smallest = Right;
+        }
+
+        if (Smallest == Parent)
+        {
+            break;
+        }
+
+        uint8_t Temp = Heap[Parent];
+        Heap[Parent]    = Heap[Smallest];
+        Heap[Smallest]  = Temp;
+        Parent          = Smallest;
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+void cRdsScheduler::Push (uint8_t SourceIndex)
+{
+    uint8_t Child = HeapSize++;
+
+    Heap[Child] = SourceIndex;
+
+    while (Child)
+    {
+        uint8_t Parent = uint8_t ((Child - 1) / 2);
+
+        if (Sources[Heap[Parent]].Key <= Sources[Heap[Child]].Key)
+        {
+            break;
+        }
+
+        uint8_t Temp = Heap[Parent];
+        Heap[Parent]    = Heap[Child];
+        Heap[Child]     = Temp;
+        Child           = Parent;
+    }
+}
+
+// *********************************************************************************************
+// Rebuild(): Start every source from scratch under the current policy.
+void cRdsScheduler::Rebuild ()
+{
+    // DEBUG_START;
+
+    HeapSize    = 0;
+    CurrentPass = 0;
+
+    for (uint8_t index = 0;index < SourceCount;++index)
+    {
+        Source_t & Source = Sources[index];
+        Source.Pass     = (PolicyEarliestDeadline == Policy) ? Clock : 0;
+        Source.Deficit  = int32_t (DrrQuantumMs * Source.Weight);
+        Source.Key      = MakeKey (Source);
+        Push (index);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// Rejoin(): A source that had nothing to send falls in behind the current round.
+// Under EDF an idle source keeps its (overdue) deadline so it goes first once it has a message.
+void cRdsScheduler::Rejoin (Source_t & Source)
+{
+    if (((PolicyWeightedRoundRobin == Policy) || (PolicyDeficitRoundRobin == Policy)) &&
+        (Source.Pass < CurrentPass))
+    {
+        Source.Pass     = CurrentPass;
+        Source.Deficit  = int32_t (DrrQuantumMs * Source.Weight);
+        Source.Key      = MakeKey (Source);
+    }
+}
+
+// *********************************************************************************************
+void cRdsScheduler::SetPolicy (Policy_e NewPolicy)
+{
+    // DEBUG_START;
+
+    if (NewPolicy < PolicyCount)
+    {
+        Policy = NewPolicy;
+        Rebuild ();
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// SetWeight(): Takes effect the next time the source is charged.
+void cRdsScheduler::SetWeight (uint8_t Id, uint8_t Weight)
+{
+    for (uint8_t index = 0;index < SourceCount;++index)
+    {
+        if (Sources[index].Id == Id)
+        {
+            Sources[index].Weight = Weight ? Weight : 1;
+            break;
+        }
+    }
+}
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,92 @@
+#pragma once
+/*
+  *    File: RdsScheduler.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Decides which message source (controller) gets the next RadioText slot. Sources sit in a
+  *    binary min heap keyed on (policy key, priority), so a pick costs O(log n) and ties always
+  *    resolve the same way. Policies:
+  *      Strict Priority:      Lowest priority number with a message wins.
+  *      Weighted Round Robin: Stride scheduling. Each message costs 1 / Weight.
+  *      Deficit Round Robin:  Each round a source may use Quantum * Weight mSecs of air time.
+  *      Earliest Deadline:    Each source should be heard every Period / Weight mSecs.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+
+// *********************************************************************************************
+#define RDS_SCHEDULER_MAX_SOURCES   8
+
+// *********************************************************************************************
+class cRdsScheduler
+{
+public:
+
+    enum Policy_e : uint8_t
+    {
+        PolicyStrictPriority = 0,
+        PolicyWeightedRoundRobin,
+        PolicyDeficitRoundRobin,
+        PolicyEarliestDeadline,
+        PolicyCount
+    };
+
+    // Asked for a message from source Id. Return true and set DurationMs if it produced one.
+    typedef bool (*ServeCallback_t)(uint8_t Id, uint32_t & DurationMs, void * Param);
+
+    cRdsScheduler ()    {}
+    virtual~cRdsScheduler ()    {}
+
+    bool        AddSource (uint8_t Id, uint8_t Priority, uint8_t Weight);
+    int16_t     Pick (ServeCallback_t Serve, void * Param, uint32_t Now);   // Id that was served, -1 if none.
+    void        SetPolicy (Policy_e NewPolicy);
+    void        SetWeight (uint8_t Id, uint8_t Weight);
+    Policy_e    GetPolicy ()    {return Policy;}
+    uint8_t     GetWeight (uint8_t Id);
+
+    uint32_t    DrrQuantumMs    = 10000;    // Deficit Round Robin air time per round at weight 1.
+    uint32_t    EdfPeriodMs     = 60000;    // Earliest Deadline refresh period at weight 1.
+
+private:
+
+    struct Source_t
+    {
+        uint8_t     Id          = 0;
+        uint8_t     Priority    = 0;    // Lower number == more important. Also the tie breaker.
+        uint8_t     Weight      = 1;
+        uint64_t    Pass        = 0;    // WRR virtual time, DRR round or EDF deadline.
+        int32_t     Deficit     = 0;    // DRR air time left in the current round.
+        uint64_t    Key         = 0;
+    };
+
+    void        Charge (Source_t & Source, uint32_t DurationMs);
+    void        Rejoin (Source_t & Source);
+    uint64_t    MakeKey (const Source_t & Source);
+    void        Push (uint8_t SourceIndex);
+    uint8_t     Pop ();
+    void        Rebuild ();
+
+    Source_t    Sources[RDS_SCHEDULER_MAX_SOURCES];
+    uint8_t     SourceCount     = 0;
+    uint8_t     Heap[RDS_SCHEDULER_MAX_SOURCES];    // Indexes into Sources[].
+    uint8_t     HeapSize        = 0;
+    Policy_e    Policy          = PolicyStrictPriority;
+    uint64_t    Clock           = 0;    // mSecs, does not wrap.
+    uint32_t    LastNow         = 0;
+    uint64_t    CurrentPass     = 0;    // Pass of the last source served.
+};  // class cRdsScheduler
+
+// *********************************************************************************************
+// OEF
@@ -74,9 +74,6 @@ void cDiagnostics::Poll ()
 {
     // _ DEBUG_START;
 
-    SystemVoltage.Poll ();
-    RfPaVoltage.Poll ();
-    FreeMemory.Poll ();
     FreeFlash.Poll ();
     SystemRunTime.Poll ();
     RebootControl.Poll ();
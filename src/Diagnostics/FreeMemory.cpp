@@ -37,6 +37,8 @@ void cFreeMemory::AddControls (uint16_t TabId, ControlColor color)
     cStatusControl::AddControls (TabId, color);
     setControlPanelStyle (ePanelStyle::PanelStyle135_black);
 
+    TimerWheel.Start (MeasurementTimer, MeasurementIntervalMs, MeasurementIntervalMs, [] (void * pThis) {static_cast <cFreeMemory *>(pThis)->Poll ();}, this);
+
     // DEBUG_END;
 }
 
@@ -45,23 +47,15 @@ void cFreeMemory::Poll ()
 {
     // _ DEBUG_START;
 
-    uint32_t Now = millis ();
+    uint32_t NewReading = ESP.getFreeHeap () / 1024;
 
-    if (Now >= NextReadingTimeMs)
+    if (NewReading != PreviousReading)
     {
-        // forward one second
-        NextReadingTimeMs += MeasurementIntervalMs;
-
-        uint32_t NewReading = ESP.getFreeHeap () / 1024;
-
-        if (NewReading != PreviousReading)
-        {
-            // DEBUG_V();
-            PreviousReading = NewReading;
-            String TempStr = String (NewReading);
-            set (TempStr, true, false);
-            Log.verboseln ((String (F ("Free Heap Memory: ")) + TempStr).c_str ());
-        }
+        // DEBUG_V();
+        PreviousReading = NewReading;
+        String TempStr = String (NewReading);
+        set (TempStr, true, false);
+        Log.verboseln ((String (F ("Free Heap Memory: ")) + TempStr).c_str ());
     }
 
     // _ DEBUG_END;
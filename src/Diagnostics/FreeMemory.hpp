@@ -18,6 +18,7 @@
 #include <esp_adc_cal.h>
 
 #include "StatusControl.hpp"
+#include "TimerWheel.hpp"
 
 // *********************************************************************************************
 class cFreeMemory : public cStatusControl
@@ -32,9 +33,9 @@ public:
 
 private:
 
-    const int32_t   MeasurementIntervalMs   = 1750; // Measurement Refresh Time, in mS.
-    uint32_t        NextReadingTimeMs       = MeasurementIntervalMs;
-    uint32_t        PreviousReading         = 0;
+    const int32_t           MeasurementIntervalMs   = 1750; // Measurement Refresh Time, in mS.
+    cTimerWheel::Timer_t    MeasurementTimer;
+    uint32_t                PreviousReading         = 0;
 };  // class cFreeMemory
 
 extern cFreeMemory FreeMemory;
@@ -38,7 +38,23 @@ void cVoltageStatus::AddControls (uint16_t TabId, ControlColor color)
 
     cStatusControl::AddControls (TabId, color);
     setControlPanelStyle (ePanelStyle::PanelStyle135_black);
-    initVdcAdc ();
+    begin ();
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// begin(): Start the voltage measurement. Safe to call more than once, the ADC is
+// only set up on the first call. Used when a reading is needed before the UI exists.
+void cVoltageStatus::begin ()
+{
+    // DEBUG_START;
+
+    if (nullptr == adc_chars)
+    {
+        initVdcAdc ();
+        TimerWheel.Start (MeasurementTimer, 0, MeasurementIntervalMs, [] (void * pThis) {static_cast <cVoltageStatus *>(pThis)->Poll ();}, this);
+    }
 
     // DEBUG_END;
 }
@@ -73,9 +89,6 @@ void cVoltageStatus::initVdcAdc (void)
         Log.infoln (F ("ADC eFuse not supported, using Default VRef (1100mV)."));   // Low Quality Accuracy.
     }
 
-    // make sure the poll routine fires right away
-    NextReadingTimeMs = millis () - MeasurementIntervalMs;
-
     // do a reading
     measureVoltage ();
 
@@ -88,6 +101,9 @@ void cVoltageStatus::initVdcAdc (void)
         SumOfVoltages   += SingleReadingValue;
     }
 
+    // GetVoltage() is used before the first Poll() (radio calibration fingerprint).
+    updateAverage ();
+
     // DEBUG_END;
 }
 
@@ -111,39 +127,38 @@ float cVoltageStatus::measureVoltage (void)
     // advance to the next entry in the array
     CurrentReadingIndex = (++CurrentReadingIndex) >= NumberOfReadingsToSave ? 0 : CurrentReadingIndex;
 
-    CurrentAvgVoltage   = float(SumOfVoltages) / float(NumberOfReadingsToSave);
-    CurrentAvgVoltage   = (CurrentAvgVoltage * SCALE) / 1000.0f; // Apply Attenuator Scaling, covert from mV to VDC.
-    CurrentAvgVoltage   = constrain (CurrentAvgVoltage, 0.0f, 99.0f);
+    updateAverage ();
 
     // DEBUG_END;
     return CurrentAvgVoltage;
 }
 
+// *********************************************************************************************
+// updateAverage(): CurrentAvgVoltage from the saved readings.
+void cVoltageStatus::updateAverage (void)
+{
+    CurrentAvgVoltage   = float(SumOfVoltages) / float(NumberOfReadingsToSave);
+    CurrentAvgVoltage   = (CurrentAvgVoltage * SCALE) / 1000.0f; // Apply Attenuator Scaling, covert from mV to VDC.
+    CurrentAvgVoltage   = constrain (CurrentAvgVoltage, 0.0f, 99.0f);
+}
+
 // *********************************************************************************************
 void cVoltageStatus::Poll ()
 {
     // _ DEBUG_START;
 
-    uint32_t Now = millis ();
+    uint32_t OldSumOfVoltages = SumOfVoltages;
+    // DEBUG_V(String(" OldSumOfVoltages: ") + String(OldSumOfVoltages));
+
+    float NewAverageVoltage = measureVoltage ();
+    // DEBUG_V(String(" NewSumOfVoltages: ") + String(SumOfVoltages));
+    // DEBUG_V(String("NewAverageVoltage: ") + String(float(NewAverageVoltage)));
 
-    if (Now >= NextReadingTimeMs)
+    // has the voltage changed?
+    if (OldSumOfVoltages != SumOfVoltages)
     {
-        // forward one second
-        NextReadingTimeMs += MeasurementIntervalMs;
-
-        uint32_t OldSumOfVoltages = SumOfVoltages;
-        // DEBUG_V(String(" OldSumOfVoltages: ") + String(OldSumOfVoltages));
-
-        float NewAverageVoltage = measureVoltage ();
-        // DEBUG_V(String(" NewSumOfVoltages: ") + String(SumOfVoltages));
-        // DEBUG_V(String("NewAverageVoltage: ") + String(float(NewAverageVoltage)));
-
-        // has the voltage changed?
-        if (OldSumOfVoltages != SumOfVoltages)
-        {
-            // DEBUG_V("Set a new value");
-            cStatusControl::set (String (NewAverageVoltage, 2), true, false);
-        }
+        // DEBUG_V("Set a new value");
+        cStatusControl::set (String (NewAverageVoltage, 2), true, false);
     }
 
     // _ DEBUG_END;
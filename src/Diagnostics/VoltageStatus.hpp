@@ -18,6 +18,7 @@
 #include <esp_adc_cal.h>
 
 #include "StatusControl.hpp"
+#include "TimerWheel.hpp"
 
 // *********************************************************************************************
 class cVoltageStatus : public cStatusControl
@@ -28,15 +29,17 @@ public:
     virtual~cVoltageStatus () {}
 
     void    AddControls (uint16_t TabId, ControlColor color);
+    void    begin ();
     float   GetVoltage () {return CurrentAvgVoltage;}
     void    Poll ();
 
 private:
     void    initVdcAdc (void);
     float   measureVoltage (void);
+    void    updateAverage (void);
 
     const int32_t                   MeasurementIntervalMs   = 1000; // Measurement Refresh Time, in mS.
-    uint32_t                        NextReadingTimeMs       = MeasurementIntervalMs;
+    cTimerWheel::Timer_t            MeasurementTimer;
     const uint32_t                  DEFAULT_VREF            = 1100;
     float                           SCALE                   = 1.0;
     adc1_channel_t                  ADC_PORT                = ADC1_CHANNEL_7;   // GPIO-35, Onboard ESP32 "VBAT" Voltage.
@@ -0,0 +1,85 @@
+#pragma once
+/*
+  *    File: LatestValue.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Single slot mailbox for values where only the newest one matters (RadioText, clock time).
+  *    Any number of tasks may put(), a newer value replaces one that has not been taken yet.
+  *    A single task take()s it. put() never waits for the consumer, only for the short copy.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <atomic>
+
+// *********************************************************************************************
+template <typename T>
+class cLatestValue
+{
+public:
+
+    cLatestValue ()             {Lock = xSemaphoreCreateMutex ();}
+    virtual~cLatestValue ()     {vSemaphoreDelete (Lock);}
+
+    // put(): Safe from any task.
+    void put (const T & NewValue)
+    {
+        xSemaphoreTake (Lock, portMAX_DELAY);
+
+        if (Pending.load (std::memory_order_relaxed))
+        {
+            ++Replaced;
+        }
+
+        Value = NewValue;
+        Pending.store (true, std::memory_order_release);
+        xSemaphoreGive (Lock);
+    }
+
+    // take(): Consumer task only. Returns false if nothing new was put() since the last take().
+    bool take (T & Entry)
+    {
+        bool Response = false;
+
+        if (Pending.load (std::memory_order_acquire))
+        {
+            xSemaphoreTake (Lock, portMAX_DELAY);
+            Entry = Value;
+            Pending.store (false, std::memory_order_relaxed);
+            xSemaphoreGive (Lock);
+            Response = true;
+        }
+
+        return Response;
+    }
+
+    // get(): The last value put(), taken or not.
+    T get ()
+    {
+        xSemaphoreTake (Lock, portMAX_DELAY);
+        T Response = Value;
+        xSemaphoreGive (Lock);
+
+        return Response;
+    }
+
+    std::atomic <uint32_t> Replaced {0};    // Values overwritten before the consumer took them.
+
+private:
+
+    SemaphoreHandle_t   Lock = NULL;
+    T                   Value {};
+    std::atomic <bool>  Pending {false};
+};  // class cLatestValue
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,77 @@
+/*
+  *    File: MinuteTimer.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include "MessageSchedule.hpp"
+#include "MinuteTimer.hpp"
+
+// *********************************************************************************************
+static const uint64_t MS_PER_MINUTE = 60 * 1000;
+
+// *********************************************************************************************
+void cMinuteTimer::Arm (uint32_t DelayMs)
+{
+    pWheel->Start (Timer, DelayMs, 0, [] (void * pThis) {static_cast <cMinuteTimer *>(pThis)->Poll ();}, this);
+}
+
+// *********************************************************************************************
+// begin(): Start following the minute boundaries. Wheel must be polled from the task that
+// should run Callback.
+void cMinuteTimer::begin (cTimerWheel & Wheel, WallClock_t _Clock, MinuteCallback_t _Callback, void * _Param)
+{
+    pWheel      = &Wheel;
+    Clock       = _Clock;
+    Callback    = _Callback;
+    Param       = _Param;
+    OnBoundary  = false;
+
+    Arm (0);
+}
+
+// *********************************************************************************************
+// Poll(): Runs from the timer. Calls back when the timer ran close enough to the boundary, then
+// re-arms for the next one. A clock that was just stepped costs at most one minute.
+void cMinuteTimer::Poll ()
+{
+    uint64_t NowMs = Clock ();
+
+    do  // once
+    {
+        if (!cMessageSchedule::ClockIsValid (time_t (NowMs / 1000)))
+        {
+            OnBoundary = false;
+            Arm (CLOCK_CHECK_MS);
+            break;
+        }
+
+        uint64_t    Minute  = (NowMs + (MS_PER_MINUTE / 2)) / MS_PER_MINUTE;   // Nearest boundary.
+        int32_t     ErrorMs = int32_t (int64_t (NowMs) - int64_t (Minute * MS_PER_MINUTE));
+
+        if ((ErrorMs >= -WINDOW_MS) && (ErrorMs <= WINDOW_MS))
+        {
+            ++MinutesSent;
+            Callback (Param, time_t (Minute * 60));
+        }
+        else if (OnBoundary)
+        {
+            ++MinutesMissed;
+        }
+
+        OnBoundary = true;
+        Arm (uint32_t (((Minute + 1) * MS_PER_MINUTE) - NowMs));
+    } while (false);
+}
+
+// *********************************************************************************************
+// OEF
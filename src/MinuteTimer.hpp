@@ -0,0 +1,60 @@
+#pragma once
+/*
+  *    File: MinuteTimer.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Calls back at the start of every wall clock minute. A one shot timer wheel timer is re-armed
+  *    for each boundary from the wall clock, so millis() drift and SNTP steps never add up. A timer
+  *    that ran too far from its boundary (the clock was stepped) is counted and skipped. Nothing is
+  *    called until the wall clock has been set.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <time.h>
+#include "TimerWheel.hpp"
+
+// *********************************************************************************************
+class cMinuteTimer
+{
+public:
+
+    typedef uint64_t (*WallClock_t)();                          // UTC in milliseconds.
+    typedef void (*MinuteCallback_t)(void * Param, time_t UtcMinute);
+
+    static const int32_t    WINDOW_MS       = 500;  // How far from the boundary the timer may run and still call back.
+    static const uint32_t   CLOCK_CHECK_MS  = 1000; // Retry interval while the clock has not been set.
+
+    cMinuteTimer ()     {}
+    virtual~cMinuteTimer () {}
+
+    void    begin (cTimerWheel & Wheel, WallClock_t Clock, MinuteCallback_t Callback, void * Param);
+
+    uint32_t    MinutesSent     = 0;
+    uint32_t    MinutesMissed   = 0;    // The timer ran too far from its boundary (the clock was stepped).
+
+private:
+
+    void    Arm (uint32_t DelayMs);
+    void    Poll ();
+
+    cTimerWheel             * pWheel    = nullptr;
+    cTimerWheel::Timer_t    Timer;
+    WallClock_t             Clock       = nullptr;
+    MinuteCallback_t        Callback    = nullptr;
+    void                    * Param     = nullptr;
+    bool                    OnBoundary  = false;    // Armed for a minute boundary, not a clock check.
+};  // class cMinuteTimer
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,117 @@
+#pragma once
+/*
+  *    File: MpscQueue.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Bounded lock-free queue. Any number of tasks may push(), a single task may pop().
+  *    Each slot carries a sequence number so producers claim slots with one compare-and-swap
+  *    and the consumer never waits on a producer that is still copying its entry.
+  *    Uses only std::atomic, so it builds on the host as well as on the ESP32.
+  */
+
+// *********************************************************************************************
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// *********************************************************************************************
+template <typename T, size_t SIZE>
+class cMpscQueue
+{
+    static_assert ((SIZE >= 2) && (0 == (SIZE & (SIZE - 1))), "cMpscQueue SIZE must be a power of two");
+
+public:
+
+    cMpscQueue ()
+    {
+        for (size_t index = 0;index < SIZE;++index)
+        {
+            Buffer[index].Sequence.store (index, std::memory_order_relaxed);
+        }
+    }
+
+    virtual~cMpscQueue ()    {}
+
+    // push(): Safe from any task. Returns false (entry not queued) if the queue is full.
+    bool push (const T & Entry)
+    {
+        size_t  Position = EnqueuePosition.load (std::memory_order_relaxed);
+        Cell    * pCell;
+
+        for (;;)
+        {
+            pCell = &Buffer[Position & (SIZE - 1)];
+            size_t      Sequence    = pCell->Sequence.load (std::memory_order_acquire);
+            intptr_t    Difference  = intptr_t (Sequence) - intptr_t (Position);
+
+            if (0 == Difference)
+            {
+                if (EnqueuePosition.compare_exchange_weak (Position, Position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Difference < 0)
+            {
+                ++Overflows;
+                return false;
+            }
+            else
+            {
+                Position = EnqueuePosition.load (std::memory_order_relaxed);
+            }
+        }
+
+        pCell->Data = Entry;
+        pCell->Sequence.store (Position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // pop(): Consumer task only. Returns false if the queue is empty.
+    bool pop (T & Entry)
+    {
+        Cell        * pCell     = &Buffer[DequeuePosition & (SIZE - 1)];
+        size_t      Sequence    = pCell->Sequence.load (std::memory_order_acquire);
+
+        if (intptr_t (Sequence) - intptr_t (DequeuePosition + 1) < 0)
+        {
+            return false;
+        }
+
+        Entry = pCell->Data;
+        pCell->Sequence.store (DequeuePosition + SIZE, std::memory_order_release);
+        ++DequeuePosition;
+
+        return true;
+    }
+
+    bool    empty ()    {return EnqueuePosition.load (std::memory_order_relaxed) == DequeuePosition;}
+    size_t  capacity () {return SIZE;}
+
+    std::atomic <uint32_t> Overflows {0};   // push() calls rejected because the queue was full.
+
+private:
+
+    struct Cell
+    {
+        std::atomic <size_t>    Sequence;
+        T                       Data;
+    };
+
+    Cell                    Buffer[SIZE];
+    std::atomic <size_t>    EnqueuePosition {0};
+    size_t                  DequeuePosition = 0;
+};  // class cMpscQueue
+
+// *********************************************************************************************
+// OEF
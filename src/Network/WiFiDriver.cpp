@@ -31,6 +31,7 @@
 #include "StaticGatewayAddress.hpp"
 #include "StaticNetmask.hpp"
 #include "StaticDnsAddress.hpp"
+#include "TimeZone.hpp"
 
 #include "memdebug.h"
 
@@ -79,6 +80,9 @@ const PROGMEM char  default_AP_passphrase    [] = AP_PSK_STR;
 
 #define DNS_PORT 53  // Webserver DNS port.
 
+const PROGMEM char  NTP_SERVER1_STR          [] = "pool.ntp.org";
+const PROGMEM char  NTP_SERVER2_STR          [] = "time.nist.gov";
+
 /*****************************************************************************/
 /* FSM                                                                       */
 /*****************************************************************************/
@@ -746,6 +750,9 @@ void fsm_WiFi_state_ConnectedToAP::Init ()
 
     pWiFiDriver->SetIsWiFiConnected (true);
 
+    // SNTP keeps the clock on UTC for message schedules and RDS clock time. Also sets TZ.
+    configTzTime (TimeZone.get ().c_str (), NTP_SERVER1_STR, NTP_SERVER2_STR);
+
     extern void StartESPUI ();
     StartESPUI ();
 
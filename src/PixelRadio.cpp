@@ -68,7 +68,7 @@
 #include "ControllerMgr.h"
 #include "language.h"
 #include "memdebug.h"
-#include "PeakAudio.hpp"
+#include "TimerWheel.hpp"
 #include "radio.hpp"
 #include "TestTone.hpp"
 #include "WiFiDriver.hpp"
@@ -164,8 +164,8 @@ void loop ()
     WiFiDriver.Poll ();
     ControllerMgr.poll ();
     Radio.Poll ();
-    PeakAudio.poll ();
     Diagnostics.Poll ();
+    TimerWheel.Poll (millis ());    // Timed work: RDS message expiry, test tone, status displays.
 
     // _ DEBUG_END;
 }
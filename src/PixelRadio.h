@@ -63,9 +63,10 @@ const int   XXXX_SET_ADDR   = 10;   // E2Prom Address for (unused), 16-bit.
 #define COLOR_GRY_STR   "#bfbfbf"
 
 // File System
-#define  BACKUP_FILE_NAME   "/backup.cfg"
-#define  CRED_FILE_NAME     "/credentials.txt"
-#define  LOGO_GIF_NAME      "/RadioLogo225x75_base64.gif"   // Base64 gif file, 225 pixel W x 75 pixel H.
+#define  BACKUP_FILE_NAME       "/backup.cfg"
+#define  CRED_FILE_NAME         "/credentials.txt"
+#define  RADIO_CAL_FILE_NAME    "/radiocal.json"                // QN8027 antenna calibration cache.
+#define  LOGO_GIF_NAME          "/RadioLogo225x75_base64.gif"   // Base64 gif file, 225 pixel W x 75 pixel H.
 const uint8_t   LITTLEFS_MODE   = 1;
 const uint8_t   SD_CARD_MODE    = 2;
 
@@ -96,7 +97,9 @@ const int   SIGN_ON     = 1;
 const int32_t MEAS_TIME = 50;   // Measurement Refresh Time, in mS.
 
 // Radio
-const uint8_t RADIO_CAL_RETRY = 3;  // RF Port Calibration Retry Count (Maximum Retry Count).
+const uint8_t RADIO_CAL_RETRY     = 3;  // RF Port Calibration Retry Count (Maximum Retry Count).
+const uint8_t RADIO_CAL_TOLERANCE = 2;  // Allowed ANT_REG drift from the saved calibration before a full recalibration.
+const uint8_t PEAK_SAMPLE_RATE_HZ = 20; // Audio peak sampler, readings per second.
 
 
 // Time Conversion
@@ -147,6 +150,10 @@ bool saveConfiguration (
 // Misc Prototypes
 void    initEprom (void);
 void    spiSdCardShutDown (void);
+bool    sdCardLock (uint32_t WaitMs);
+void    sdCardUnlock (void);
+bool    sdCardPresent (void);
+void    sdCardSetPresent (bool Present);
 
 const String returnClientCode (int code);
 
@@ -0,0 +1,110 @@
+/*
+  *    File: AudioLevel.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <math.h>
+#include <string.h>
+#include "AudioLevel.hpp"
+
+// *********************************************************************************************
+// AddSample(): Add one peak detector reading. The oldest sample drops out of the window.
+void cAudioLevel::AddSample (uint8_t PeakCount, uint32_t Now)
+{
+    // DEBUG_START;
+
+    if (PeakCount >= AUDIO_LEVEL_BINS)
+    {
+        PeakCount = AUDIO_LEVEL_BINS - 1;
+    }
+
+    if (AUDIO_LEVEL_HISTORY == WindowSize)
+    {
+        uint8_t Oldest = History[Head];
+        --Histogram[Oldest];
+        SumOfSquares -= uint32_t (Oldest) * Oldest;
+    }
+    else
+    {
+        ++WindowSize;
+    }
+
+    History[Head]   = PeakCount;
+    Head            = (Head + 1) % AUDIO_LEVEL_HISTORY;
+    ++Histogram[PeakCount];
+    SumOfSquares += uint32_t (PeakCount) * PeakCount;
+
+    if ((PeakCount > SilenceThreshold) || (0 == Samples))
+    {
+        LastSoundTime = Now;
+    }
+
+    ++Samples;
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cAudioLevel::GetSnapshot (Snapshot_t & Snapshot, uint32_t Now)
+{
+    // DEBUG_START;
+
+    Snapshot = Snapshot_t ();
+
+    do  // once
+    {
+        if (0 == WindowSize)
+        {
+            break;
+        }
+
+        // The histogram is already sorted by level, min and max fall out of it.
+        uint8_t MinCount    = AUDIO_LEVEL_BINS;
+        uint8_t MaxCount    = 0;
+
+        for (uint8_t bin = 0;bin < AUDIO_LEVEL_BINS;++bin)
+        {
+            if (Histogram[bin])
+            {
+                MinCount    = (MinCount < bin) ? MinCount : bin;
+                MaxCount    = bin;
+            }
+        }
+
+        memcpy (Snapshot.Histogram, Histogram, sizeof (Snapshot.Histogram));
+        Snapshot.PeakMv     = History[(Head + AUDIO_LEVEL_HISTORY - 1) % AUDIO_LEVEL_HISTORY] * AUDIO_LEVEL_MV_PER_BIN;
+        Snapshot.MinMv      = MinCount * AUDIO_LEVEL_MV_PER_BIN;
+        Snapshot.MaxMv      = MaxCount * AUDIO_LEVEL_MV_PER_BIN;
+        Snapshot.RmsMv      = uint16_t ((sqrtf (float(SumOfSquares) / float(WindowSize)) * AUDIO_LEVEL_MV_PER_BIN) + 0.5F);
+        Snapshot.WindowSize = WindowSize;
+        Snapshot.Samples    = Samples;
+        Snapshot.SilentMs   = Now - LastSoundTime;  // Wrap safe.
+    } while (false);
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cAudioLevel::Reset ()
+{
+    memset (History,   0x00, sizeof (History));
+    memset (Histogram, 0x00, sizeof (Histogram));
+    Head            = 0;
+    WindowSize      = 0;
+    SumOfSquares    = 0;
+    Samples         = 0;
+    LastSoundTime   = 0;
+}
+
+// *********************************************************************************************
+// OEF
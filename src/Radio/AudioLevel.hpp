@@ -0,0 +1,68 @@
+#pragma once
+/*
+  *    File: AudioLevel.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Rolling audio level statistics built from the QN8027 audio peak detector (STATUS_REG bits 4-7,
+  *    45mV per count). The last AUDIO_LEVEL_HISTORY samples are kept in a ring buffer. Min, max,
+  *    RMS and the level histogram always cover exactly that window.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+
+// *********************************************************************************************
+#define AUDIO_LEVEL_HISTORY     64  // Samples in the rolling window (3.2 Secs at 20Hz).
+#define AUDIO_LEVEL_BINS        16  // One histogram bin per peak detector count.
+#define AUDIO_LEVEL_MV_PER_BIN  45
+
+// *********************************************************************************************
+class cAudioLevel
+{
+public:
+
+    cAudioLevel ()  {}
+    virtual~cAudioLevel ()  {}
+
+    struct Snapshot_t
+    {
+        uint16_t    PeakMv      = 0;    // Most recent sample.
+        uint16_t    MinMv       = 0;
+        uint16_t    MaxMv       = 0;
+        uint16_t    RmsMv       = 0;
+        uint8_t     Histogram[AUDIO_LEVEL_BINS] = {0};  // Sample count per 45mV step.
+        uint8_t     WindowSize  = 0;    // Samples currently in the window.
+        uint32_t    Samples     = 0;    // Samples taken since Reset().
+        uint32_t    SilentMs    = 0;    // Time the input has been at or below SilenceThreshold.
+    };
+
+    void    AddSample (uint8_t PeakCount, uint32_t Now);
+    void    GetSnapshot (Snapshot_t & Snapshot, uint32_t Now);
+    void    Reset ();
+
+    uint8_t SilenceThreshold = 1;   // Peak counts at or below this level are treated as silence.
+
+private:
+
+    uint8_t     History[AUDIO_LEVEL_HISTORY] = {0};
+    uint8_t     Histogram[AUDIO_LEVEL_BINS] = {0};
+    uint8_t     Head            = 0;    // Next slot to write.
+    uint8_t     WindowSize      = 0;
+    uint32_t    SumOfSquares    = 0;    // Over the window, in counts squared.
+    uint32_t    Samples         = 0;
+    uint32_t    LastSoundTime   = 0;
+};  // class cAudioLevel
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,119 @@
+/*
+  *    File: AfList.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+
+#include "AfList.hpp"
+#include "QN8027RadioApi.hpp"
+#include "memdebug.h"
+
+static const PROGMEM char       RDS_AF_LIST_STR     []  = "RDS_AF_LIST_STR";
+static const PROGMEM char       RDS_AF_LIST_NM_STR  []  = "ALTERNATIVE FREQUENCIES<br>MHz, Comma Separated (88.1,88.3)";
+static const PROGMEM uint32_t   RDS_AF_LIST_MAX_SZ      = RDS_AF_MAX_COUNT * 6;
+
+// *********************************************************************************************
+cAfList::cAfList () :   cControlCommon (RDS_AF_LIST_STR, ControlType::Text, RDS_AF_LIST_NM_STR, emptyString, RDS_AF_LIST_MAX_SZ)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cAfList::ParseList (const String & value, uint8_t * Codes, uint8_t & Count)
+{
+    // DEBUG_START;
+
+    bool    Response    = true;
+    int     Start       = 0;
+
+    Count = 0;
+
+    while (Response && (Start < int (value.length ())))
+    {
+        int End = value.indexOf (',', Start);
+        End = (-1 == End) ? int (value.length ()) : End;
+
+        String Entry = value.substring (Start, End);
+        Entry.trim ();
+        Start = End + 1;
+
+        if (Entry.isEmpty ())
+        {
+            continue;
+        }
+
+        uint8_t Code = cRdsEncoder::AfCode (uint16_t (lroundf (Entry.toFloat () * 10.0f)));
+
+        if ((0 == Code) || (Count >= RDS_AF_MAX_COUNT))
+        {
+            Response = false;
+            break;
+        }
+
+        Codes[Count++] = Code;
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+bool cAfList::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = cControlCommon::set (value, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response)
+    {
+        uint8_t Codes[RDS_AF_MAX_COUNT];
+        uint8_t Count = 0;
+
+        ParseList (GetDataValueStr (), Codes, Count);
+        QN8027RadioApi.setAfList (Codes, Count);
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+bool cAfList::validate (const String & value, String & ResponseMessage, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool    Response = false;
+    uint8_t Codes[RDS_AF_MAX_COUNT];
+    uint8_t Count = 0;
+
+    if (ParseList (value, Codes, Count))
+    {
+        Response = cControlCommon::validate (value, ResponseMessage, ForceUpdate);
+    }
+    else
+    {
+        ResponseMessage = GetTitle () + (F (": BAD_VALUE: Up to 25 Frequencies, 87.6 to 107.9 MHz: ")) + value;
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+cAfList AfList;
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,40 @@
+#pragma once
+/*
+  *    File: AfList.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "ControlCommon.hpp"
+
+// *********************************************************************************************
+class cAfList : public cControlCommon
+{
+public:
+
+    cAfList ();
+    virtual~cAfList ()    {}
+
+    bool    set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate);
+    bool    validate (const String & value, String & ResponseMessage, bool ForceUpdate);
+
+private:
+
+    // ParseList(): "88.1,88.3" (MHz) to RDS AF codes. Returns false if any entry is not a valid FM frequency.
+    bool    ParseList (const String & value, uint8_t * Codes, uint8_t & Count);
+};  // class cAfList
+
+extern cAfList AfList;
+
+// *********************************************************************************************
+// OEF
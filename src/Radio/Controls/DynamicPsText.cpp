@@ -0,0 +1,59 @@
+/*
+  *    File: DynamicPsText.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+
+#include "DynamicPsText.hpp"
+#include "DynamicPsTime.hpp"
+#include "QN8027RadioApi.hpp"
+#include "memdebug.h"
+
+static const PROGMEM char   RDS_DYNAMIC_PS_STR      []  = "RDS_DYNAMIC_PS_STR";
+static const PROGMEM char   RDS_DYNAMIC_PS_NM_STR   []  = "DYNAMIC PS TEXT<br>Leave Blank to Send the Station Name";
+
+// *********************************************************************************************
+cDynamicPsText::cDynamicPsText () :   cControlCommon (
+        RDS_DYNAMIC_PS_STR,
+        ControlType::Text,
+        RDS_DYNAMIC_PS_NM_STR,
+        emptyString,
+        RDS_DYNAMIC_PS_TEXT_SIZE)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cDynamicPsText::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = cControlCommon::set (value, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response)
+    {
+        QN8027RadioApi.setDynamicPs (GetDataValueStr (), uint16_t (DynamicPsTime.get32 ()));
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+cDynamicPsText DynamicPsText;
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,62 @@
+/*
+  *    File: DynamicPsTime.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+
+#include "DynamicPsText.hpp"
+#include "DynamicPsTime.hpp"
+#include "QN8027RadioApi.hpp"
+#include "memdebug.h"
+
+static const PROGMEM char       RDS_DYNAMIC_PS_TIME     []  = "RDS_DYNAMIC_PS_TIME";
+static const PROGMEM char       RDS_DYNAMIC_PS_TIME_STR []  = "DYNAMIC PS FRAME TIME (mSec)";
+static const PROGMEM uint32_t   RDS_DYNAMIC_PS_TIME_DEF     = 2500;
+static const PROGMEM uint32_t   RDS_DYNAMIC_PS_TIME_MIN     = 1000;     // A receiver needs two or more passes of a frame.
+static const PROGMEM uint32_t   RDS_DYNAMIC_PS_TIME_MAX     = 10000;
+
+// *********************************************************************************************
+cDynamicPsTime::cDynamicPsTime () :   cNumberControl (
+        RDS_DYNAMIC_PS_TIME,
+        RDS_DYNAMIC_PS_TIME_STR,
+        RDS_DYNAMIC_PS_TIME_DEF,
+        RDS_DYNAMIC_PS_TIME_MIN,
+        RDS_DYNAMIC_PS_TIME_MAX)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cDynamicPsTime::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = cNumberControl::set (value, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response)
+    {
+        QN8027RadioApi.setDynamicPs (DynamicPsText.get (), uint16_t (get32 ()));
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+cDynamicPsTime DynamicPsTime;
+
+// *********************************************************************************************
+// OEF
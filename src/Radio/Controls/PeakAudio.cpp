@@ -18,10 +18,12 @@
 #include "memdebug.h"
 #include "PeakAudio.hpp"
 #include "QN8027RadioApi.hpp"
+#include "language.h"
 
 static const PROGMEM char RADIO_AUDLVL_STR    []    = "PEAK AUDIO LEVEL";
-static const PROGMEM uint32_t   AUDIO_MEAS_TIME     = uint32_t (2000);
+static const PROGMEM uint32_t   AUDIO_MEAS_TIME     = uint32_t (1000);
 static const PROGMEM uint32_t   AUDIO_LEVEL_MAX     = uint32_t (675);
+static const PROGMEM uint32_t   AUDIO_SILENCE_TIME  = uint32_t (10000);   // Silence shorter than this is not reported.
 
 // *********************************************************************************************
 cPeakAudio::cPeakAudio () :   cStatusControl (RADIO_AUDLVL_STR, emptyString)
@@ -32,36 +34,78 @@ cPeakAudio::cPeakAudio () :   cStatusControl (RADIO_AUDLVL_STR, emptyString)
 }
 
 // *********************************************************************************************
+void cPeakAudio::AddControls (uint16_t TabId, ControlColor color)
+{
+    // DEBUG_START;
+
+    cStatusControl::AddControls (TabId, color);
+    TimerWheel.Start (UpdateTimer, AUDIO_MEAS_TIME, AUDIO_MEAS_TIME, [] (void * pThis) {static_cast <cPeakAudio *>(pThis)->poll ();}, this);
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// GetStatistics(): Audio level statistics for the JSON status endpoint.
+void cPeakAudio::GetStatistics (JsonObject & json)
+{
+    // DEBUG_START;
+
+    cAudioLevel::Snapshot_t Snapshot;
+    QN8027RadioApi.GetAudioLevel (Snapshot);
+
+    json[N_peak]            = Snapshot.PeakMv;
+    json[N_min]             = Snapshot.MinMv;
+    json[N_max]             = Snapshot.MaxMv;
+    json[N_rms]             = Snapshot.RmsMv;
+    json[N_silentMs]        = Snapshot.SilentMs;
+    json[N_samples]         = Snapshot.Samples;
+    json[N_window]          = Snapshot.WindowSize;
+    json[N_sampleRateHz]    = QN8027RadioApi.getPeakSampleRate ();
+
+    JsonArray Histogram = json.createNestedArray (N_histogram);
+
+    for (uint8_t count : Snapshot.Histogram)
+    {
+        Histogram.add (count);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// poll(): One UI update per AUDIO_MEAS_TIME (UpdateTimer) with the whole sampler window in it.
 void cPeakAudio::poll ()
 {
     // _ DEBUG_START;
 
-    uint32_t    now             = millis ();
-    uint16_t    currentReading  = 0;
-    String      Result;
+    String Result;
 
     Result.reserve (128);
 
     do  // once
     {
-        if (now <= NextReadingTime)
+        cAudioLevel::Snapshot_t Snapshot;
+        QN8027RadioApi.GetAudioLevel (Snapshot);
+
+        if (Snapshot.MaxMv >= AUDIO_LEVEL_MAX)
         {
-            // Keep waiting
-            break;
+            Result = ">";
         }
 
-        NextReadingTime = now + AUDIO_MEAS_TIME;
-
-        currentReading = QN8027RadioApi.GetPeakAudioLevel ();
+        Result  += String (Snapshot.MaxMv);
+        Result  += F (" mV (RMS ");
+        Result  += String (Snapshot.RmsMv);
+        Result  += F (", Min ");
+        Result  += String (Snapshot.MinMv);
+        Result  += F (")");
 
-        if (currentReading >= AUDIO_LEVEL_MAX)
+        if (Snapshot.SilentMs >= AUDIO_SILENCE_TIME)
         {
-            Result = ">";
+            Result  += F ("<br>Silent for ");
+            Result  += String (Snapshot.SilentMs / 1000);
+            Result  += F (" Secs");
         }
 
-        Result  += String (currentReading);
-        Result  += F (" mV");
-
         if (!get ().equals (Result))
         {
             set (Result, true, false);
@@ -15,7 +15,9 @@
 
 // *********************************************************************************************
 #include <Arduino.h>
+#include <ArduinoJson.h>
 #include "StatusControl.hpp"
+#include "TimerWheel.hpp"
 
 // *********************************************************************************************
 class cPeakAudio : public cStatusControl
@@ -25,11 +27,13 @@ public:
     cPeakAudio ();
     virtual~cPeakAudio ()    {}
 
-    void poll ();
+    void    AddControls (uint16_t TabId, ControlColor color);
+    void    poll ();
+    void    GetStatistics (JsonObject & json);
 
 private:
 
-    uint32_t NextReadingTime = 0;
+    cTimerWheel::Timer_t UpdateTimer;
 };  // class cPeakAudio
 
 extern cPeakAudio PeakAudio;
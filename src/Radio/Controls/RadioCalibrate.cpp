@@ -0,0 +1,97 @@
+/*
+  *    File: RadioCalibrate.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+
+#include "PixelRadio.h"
+#include "QN8027RadioApi.hpp"
+#include "RadioCalibrate.hpp"
+#include "memdebug.h"
+
+// *********************************************************************************************
+static const PROGMEM char   RADIO_CALIBRATE_STR     []  = "RECALIBRATE RF PORT";
+static const PROGMEM char   RADIO_CALIBRATE_NOW_STR []  = "now";
+
+// *********************************************************************************************
+cRadioCalibrate::cRadioCalibrate () :   cButtonControl (RADIO_CALIBRATE_STR)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// Callback(): The button carries no value, a press is the same as "recal=now".
+void cRadioCalibrate::Callback (Control *, int type)
+{
+    // DEBUG_START;
+
+    if (B_DOWN == type)
+    {
+        String Dummy;
+        set (String (RADIO_CALIBRATE_NOW_STR), Dummy, false, false);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// set(): Only "now" is accepted. Throw away the saved antenna calibration and run the full calibration sweep.
+// The carrier drops for about 2 seconds. The sweep runs on the radio task, check the Home tab for the result.
+bool cRadioCalibrate::set (const String & value, String & ResponseMessage, bool, bool)
+{
+    // DEBUG_START;
+
+    bool    Response    = true;
+    String  Payload     = value;
+
+    Payload.trim ();
+    Payload.toLowerCase ();
+
+    do  // once
+    {
+        if (!Payload.equals (String (RADIO_CALIBRATE_NOW_STR)))
+        {
+            ResponseMessage = GetTitle () + (F (": BAD_VALUE: Use recal=now: ")) + value;
+            Log.warningln (ResponseMessage.c_str ());
+            Response = false;
+            break;
+        }
+
+        if (!SystemBooting)
+        {
+            Response = QN8027RadioApi.recalibrate ();
+        }
+
+        if (Response)
+        {
+            ResponseMessage = String (F ("RF Port Calibration Started."));
+        }
+        else
+        {
+            ResponseMessage = String (F ("RF Port Calibration Failed."));
+        }
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+}
+
+// *********************************************************************************************
+cRadioCalibrate RadioCalibrate;
+
+// *********************************************************************************************
+// OEF
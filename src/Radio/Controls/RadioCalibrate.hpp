@@ -0,0 +1,35 @@
+#pragma once
+/*
+  *    File: RadioCalibrate.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "ButtonControl.hpp"
+
+// *********************************************************************************************
+class cRadioCalibrate : public cButtonControl
+{
+public:
+
+    cRadioCalibrate ();
+    virtual~cRadioCalibrate ()    {}
+
+    void    Callback (Control * sender, int type);
+    bool    set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate);
+};  // class cRadioCalibrate
+
+extern cRadioCalibrate RadioCalibrate;
+
+// *********************************************************************************************
+// OEF
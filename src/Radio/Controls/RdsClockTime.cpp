@@ -0,0 +1,118 @@
+/*
+  *    File: RdsClockTime.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "QN8027RadioApi.hpp"
+#include "RdsClockTime.hpp"
+#include "memdebug.h"
+
+static const PROGMEM char   RDS_CLOCK_TIME_FLAG []  = "RDS_CLOCK_TIME_FLAG";
+static const PROGMEM char   RDS_CLOCK_TIME_STR  []  = "RDS CLOCK TIME";
+
+// *********************************************************************************************
+cRdsClockTime::cRdsClockTime () :   cBinaryControl (RDS_CLOCK_TIME_FLAG, RDS_CLOCK_TIME_STR, true)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsClockTime::AddControls (uint16_t TabId, ControlColor color)
+{
+    // DEBUG_START;
+
+    setOffMessage (F ("Off"), eCssStyle::CssStyleWhite);
+    setOnMessage (F ("Sent Every Minute"), eCssStyle::CssStyleWhite);
+
+    cBinaryControl::AddControls (TabId, color);
+
+    addInputCondition ( F ("on"),   true);
+    addInputCondition ( F ("off"),  false);
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// begin(): The timer always runs on the loop task. SendMinute() checks the setting at each
+// minute boundary, so set() from the UI or MQTT never has to touch the timer wheel.
+void cRdsClockTime::begin ()
+{
+    // DEBUG_START;
+
+    MinuteTimer.begin (TimerWheel, WallClockMs, [] (void * pThis, time_t UtcMinute) {static_cast <cRdsClockTime *>(pThis)->SendMinute (UtcMinute);}, this);
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// LocalOffsetHalfHours(): Local time - UTC in half hours, as the CT group wants it.
+int8_t cRdsClockTime::LocalOffsetHalfHours (time_t UtcTime)
+{
+    struct tm   UtcTm;
+    struct tm   LocalTm;
+
+    gmtime_r (&UtcTime, &UtcTm);
+    localtime_r (&UtcTime, &LocalTm);
+
+    int32_t DayDelta = 0;
+
+    if (LocalTm.tm_year != UtcTm.tm_year)
+    {
+        DayDelta = (LocalTm.tm_year > UtcTm.tm_year) ? 1 : -1;
+    }
+    else
+    {
+        DayDelta = LocalTm.tm_yday - UtcTm.tm_yday;
+    }
+
+    int32_t OffsetMinutes = (DayDelta * 24 * 60) + ((LocalTm.tm_hour - UtcTm.tm_hour) * 60) + (LocalTm.tm_min - UtcTm.tm_min);
+
+    return int8_t (OffsetMinutes / 30);
+}
+
+// *********************************************************************************************
+// SendMinute(): Runs from the minute timer at each boundary once SNTP has set the clock.
+void cRdsClockTime::SendMinute (time_t UtcMinute)
+{
+    // _ DEBUG_START;
+
+    if (getBool ())
+    {
+        QN8027RadioApi.sendClockTime (UtcMinute, LocalOffsetHalfHours (UtcMinute));
+        ++GroupsSent;
+    }
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+uint64_t cRdsClockTime::WallClockMs ()
+{
+    struct timeval Now;
+
+    gettimeofday (&Now, nullptr);
+
+    return (uint64_t (Now.tv_sec) * 1000) + (Now.tv_usec / 1000);
+}
+
+// *********************************************************************************************
+cRdsClockTime RdsClockTime;
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,50 @@
+#pragma once
+/*
+  *    File: RdsClockTime.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    RDS 4A clock time. Once SNTP has set the clock, one CT group is sent at the start of every
+  *    minute. A one shot timer is re-armed for each minute boundary, and the group jumps ahead of
+  *    the PS / RadioText groups waiting in the radio's transmit queue.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "BinaryControl.hpp"
+#include "MinuteTimer.hpp"
+
+// *********************************************************************************************
+class cRdsClockTime : public cBinaryControl
+{
+public:
+
+    cRdsClockTime ();
+    virtual~cRdsClockTime ()    {}
+
+    void    AddControls (uint16_t TabId, ControlColor color);
+    void    begin ();
+
+    uint32_t    GroupsSent  = 0;
+
+    cMinuteTimer    MinuteTimer;
+
+private:
+
+    void            SendMinute (time_t UtcMinute);
+    static uint64_t WallClockMs ();
+    static int8_t   LocalOffsetHalfHours (time_t UtcTime);
+};  // class cRdsClockTime
+
+extern cRdsClockTime RdsClockTime;
+
+// *********************************************************************************************
+// OEF
@@ -22,6 +22,7 @@
 #include "QN8027RadioApi.hpp"
 #include "RfCarrier.hpp"
 #include "TestTone.hpp"
+#include "TimerWheel.hpp"
 #include "memdebug.h"
 
 static const PROGMEM char   HOME_RDS_WAIT_STR       []  = "Waiting for RDS RadioText ...";
@@ -31,10 +32,20 @@ static const PROGMEM char   RDS_RF_DISABLED_STR     []  = "{ RADIO CARRIER OFF }
 static const PROGMEM char   RDS_DISABLED_STR        []  = "{ DISABLED }";
 static const PROGMEM char   RDS_EXPIRED_STR         []  = "{ EXPIRED }";
 
+// Countdown display states that are not a number of seconds.
+static const int32_t        REMAINING_TEST_MODE         = -1;
+static const int32_t        REMAINING_NO_CARRIER        = -2;
+static const int32_t        REMAINING_NO_MESSAGE        = -3;
+static const int32_t        REMAINING_EXPIRED           = -4;
+
 // *********************************************************************************************
 cRdsText::cRdsText () :   cControlCommonMsg (emptyString, ControlType::Label, HOME_CUR_TEXT_STR, emptyString, 30)
 {
     // _ DEBUG_START;
+
+    // Sized once so new messages never reallocate it.
+    LastMessageSent.reserve (RADIOTEXT_SIZE);
+
     // _ DEBUG_END;
 }
 
@@ -51,43 +62,27 @@ void cRdsText::AddControls (uint16_t value, ControlColor color)
 
     UpdateStatus ();
 
+    // First message as soon as the main loop runs, then the countdown display once a second.
+    TimerWheel.Start (MessageTimer, 0, 0, [] (void * pThis) {static_cast <cRdsText *>(pThis)->poll ();}, this);
+    TimerWheel.Start (DisplayTimer, 1000, 1000, [] (void * pThis) {static_cast <cRdsText *>(pThis)->UpdateDisplay ();}, this);
+
     // DEBUG_END;
 }
 
 // *********************************************************************************************
+// poll(): The current message has expired (MessageTimer). Get the next one.
 void cRdsText::poll ()
 {
     // _ DEBUG_START;
 
-    unsigned long now = millis ();
+    uint32_t    now         = millis ();
+    uint32_t    NextPollMs  = 1000;
 
     do  // once
     {
-        // has it been one second since the last update?
-        if (1000 > (now - CurrentMsgLastUpdateTime))
-        {
-            // need to wait a bit longer
-            break;
-        }
-
         if (TestTone.getBool ())
         {
-            // DEBUG_V();
-            CurrentMsgLastUpdateTime += 1000;
-            updateRdsMsgRemainingTime (now);
-            break;
-        }
-
-        CurrentMsgLastUpdateTime = now;
-        // _ DEBUG_V("One second later");
-
-        UpdateStatus ();
-
-        // has the current message output expired?
-        if (now < CurrentMsgEndTime)
-        {
-            // DEBUG_V("still waiting");
-            updateRdsMsgRemainingTime (now);
+            // The test tone owns the RadioText. Check back in a second.
             break;
         }
 
@@ -95,29 +90,74 @@ void cRdsText::poll ()
         ControllerMgr.GetNextRdsMessage (RdsMsgInfo);
         CurrentMsgEndTime = now + RdsMsgInfo.DurationMilliSec;
 
+        if (RdsMsgInfo.DurationMilliSec)
+        {
+            NextPollMs = RdsMsgInfo.DurationMilliSec;
+        }
+
         if (!LastMessageSent.equals (RdsMsgInfo.Text))
         {
             // _ DEBUG_V("Display the new message");
             LastMessageSent = RdsMsgInfo.Text;
-            Log.traceln (F ("Refreshing RDS RadioText Message: %s"), RdsMsgInfo.Text.c_str ());
+            Log.traceln (F ("Refreshing RDS RadioText Message: %s"), RdsMsgInfo.Text);
             String dummy;
-            set (RdsMsgInfo.Text, dummy);
+            set (LastMessageSent, dummy, RdsMsgInfo.RtPlus);
+        }
+        else
+        {
+            // Same text, the sending controller may have changed.
+            UpdateStatus ();
         }
-
-        // DEBUG_V();
-        updateRdsMsgRemainingTime (now);
     } while (false);
 
+    TimerWheel.Start (MessageTimer, NextPollMs, 0, [] (void * pThis) {static_cast <cRdsText *>(pThis)->poll ();}, this);
+    updateRdsMsgRemainingTime (now);
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// Refresh(): Drop the rest of the current message and pick the next one on the next timer tick.
+void cRdsText::Refresh ()
+{
+    // DEBUG_START;
+
+    if (TimerWheel.IsActive (MessageTimer))
+    {
+        TimerWheel.Start (MessageTimer, 0, 0, [] (void * pThis) {static_cast <cRdsText *>(pThis)->poll ();}, this);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// UpdateDisplay(): Once a second (DisplayTimer). Only touches the UI when something changed.
+void cRdsText::UpdateDisplay ()
+{
+    // _ DEBUG_START;
+
+    uint8_t NewDisplayState = (TestTone.getBool () ? 1 : 0) | (RfCarrier.getBool () ? 2 : 0);
+
+    if (NewDisplayState != DisplayState)
+    {
+        DisplayState = NewDisplayState;
+        UpdateStatus ();
+    }
+
+    updateRdsMsgRemainingTime (millis ());
+
     // _ DEBUG_END;
 }
 
 // *********************************************************************************************
-bool cRdsText::set (String & value, String &)
+// set(): RtPlus holds the tags cached with the message. Text from anywhere else is sent untagged.
+bool cRdsText::set (String & value, String &, const cRdsEncoder::RtPlusTags_t & RtPlus)
 {
     // DEBUG_START;
     // DEBUG_V(String("value: ") + value);
 
     LastMessageSent = value;
+    QN8027RadioApi.setRtPlusTags (RtPlus);
     QN8027RadioApi.setRdsMessage (LastMessageSent);
     UpdateStatus ();
 
@@ -154,43 +194,83 @@ void cRdsText::updateRdsMsgRemainingTime (uint32_t now)
 {
     // DEBUG_START;
 
-    uint32_t timeCnt = 0;
+    int32_t TimeRemaining = REMAINING_TEST_MODE;
 
     do  // once
     {
         if (TestTone.getBool ())
         {
             // DEBUG_V("Test Mode");
-            RdsTextStatus.set (String (F ("Test Mode")), false, false);
             break;
         }
 
         if (!RfCarrier.getBool ())
         {
             // DEBUG_V("No Carrier");
-            RdsTextStatus.set (RDS_DISABLED_STR, true, false);
+            TimeRemaining = REMAINING_NO_CARRIER;
             break;
         }
 
         if (0 == RdsMsgInfo.DurationMilliSec)
         {
             // DEBUG_V("No Message to send");
-            RdsTextStatus.set (HOME_RDS_WAIT_STR, true, false);
+            TimeRemaining = REMAINING_NO_MESSAGE;
             break;
         }
 
-        if (now > CurrentMsgEndTime)
+        // Signed difference, survives millis() wrap.
+        TimeRemaining = int32_t (CurrentMsgEndTime - now);
+
+        if (TimeRemaining < 0)
         {
             // DEBUG_V("Timed Out");
-            RdsTextStatus.set (RDS_EXPIRED_STR, true, false);
+            TimeRemaining = REMAINING_EXPIRED;
             break;
         }
 
-        unsigned long TimeRemaining = ((CurrentMsgEndTime - now) + 999) / 1000;
-        // DEBUG_V(String("Update Timer: ") + String(TimeRemaining));
-        RdsTextStatus.set (String (TimeRemaining) + F (" Secs"), true, false);
+        TimeRemaining = (TimeRemaining + 999) / 1000;
     } while (false);
 
+    // Only format and send a new status when the display would change.
+    if (TimeRemaining != LastTimeRemaining)
+    {
+        LastTimeRemaining = TimeRemaining;
+
+        switch (TimeRemaining)
+        {
+            case REMAINING_TEST_MODE:
+            {
+                RdsTextStatus.set (String (F ("Test Mode")), false, false);
+                break;
+            }
+
+            case REMAINING_NO_CARRIER:
+            {
+                RdsTextStatus.set (RDS_DISABLED_STR, true, false);
+                break;
+            }
+
+            case REMAINING_NO_MESSAGE:
+            {
+                RdsTextStatus.set (HOME_RDS_WAIT_STR, true, false);
+                break;
+            }
+
+            case REMAINING_EXPIRED:
+            {
+                RdsTextStatus.set (RDS_EXPIRED_STR, true, false);
+                break;
+            }
+
+            default:
+            {
+                // DEBUG_V(String("Update Timer: ") + String(TimeRemaining));
+                RdsTextStatus.set (String (TimeRemaining) + F (" Secs"), true, false);
+                break;
+            }
+        }
+    }
+
     // DEBUG_END;
 }
 
@@ -17,6 +17,7 @@
 #include <Arduino.h>
 #include "ControllerMgr.h"
 #include "ControlCommonMsg.hpp"
+#include "TimerWheel.hpp"
 
 // *********************************************************************************************
 class cRdsText : public cControlCommonMsg
@@ -28,17 +29,22 @@ public:
 
     void    AddControls (uint16_t TabId, ControlColor color);
     void    poll ();
-    bool    set (String & value, String & Response);
+    void    Refresh ();
+    bool    set (String & value, String & Response, const cRdsEncoder::RtPlusTags_t & RtPlus = cRdsEncoder::RtPlusTags_t ());
 
 private:
 
+    void    UpdateDisplay ();
     void    UpdateStatus ();
     void    updateRdsMsgRemainingTime (uint32_t now);
 
     c_ControllerMgr::RdsMsgInfo_t   RdsMsgInfo;
-    uint32_t                        CurrentMsgEndTime           = 0;
-    uint32_t                        CurrentMsgLastUpdateTime    = 0;
+    uint32_t                        CurrentMsgEndTime   = 0;
     String                          LastMessageSent;
+    cTimerWheel::Timer_t            MessageTimer;
+    cTimerWheel::Timer_t            DisplayTimer;
+    uint8_t                         DisplayState        = 0xFF;     // Test tone and carrier flags last shown.
+    int32_t                         LastTimeRemaining   = 0x7FFFFFFF;
 };  // class cRdsText
 
 extern cRdsText RdsText;
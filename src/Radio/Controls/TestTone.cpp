@@ -78,12 +78,13 @@ void cTestTone::Init ()
     digitalWrite (MUX_PIN, TONE_OFF);   // Init Audio Mux, Enable Audio Line-In Jack, Music LED On.
     ledcSetup (TEST_TONE_CHNL, 1000, 8);
 
-    FsmTimerExpirationTime = millis () + 1000;
-
     fsm_Tone_state_Idle_imp.SetParent (this);
     fsm_Tone_state_SendingTone_imp.SetParent (this);
     pCurrentFsmState = & fsm_Tone_state_Idle_imp;
 
+    // The FSM runs once a second. Periodic timers do not slip.
+    TimerWheel.Start (FsmTimer, 1000, 1000, [] (void * pThis) {static_cast <cTestTone *>(pThis)->poll ();}, this);
+
     // DEBUG_END;
 }
 
@@ -92,21 +93,7 @@ void cTestTone::poll ()
 {
     // _ DEBUG_START;
 
-    uint32_t now = millis ();
-
-    do  // once
-    {
-        if (now < FsmTimerExpirationTime)
-        {
-            // keep waiting
-            break;
-        }
-
-        // do not use 'now' here or you will slip time
-        FsmTimerExpirationTime += 1000;
-
-        pCurrentFsmState->Poll (now);
-    } while (false);
+    pCurrentFsmState->Poll (millis ());
 
     // DEBUG_END;
 }
@@ -263,7 +250,7 @@ void fsm_Tone_state_SendingTone::Poll (uint32_t now)
 
         pTestTone->UpdateRdsTimeMsg ();
 
-        if (now < ToneExpirationTime)
+        if (int32_t (now - ToneExpirationTime) < 0)
         {
             // DEBUG_V("Need to wait longer");
             break;
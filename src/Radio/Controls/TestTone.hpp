@@ -15,6 +15,7 @@
 
 // *********************************************************************************************
 #include "BinaryControl.hpp"
+#include "TimerWheel.hpp"
 #include <Arduino.h>
 
 class fsm_Tone_state;
@@ -42,8 +43,8 @@ protected:
 
     friend class fsm_Tone_state_Idle;
     friend class fsm_Tone_state_SendingTone;
-    fsm_Tone_state  * pCurrentFsmState      = nullptr;
-    uint32_t        FsmTimerExpirationTime  = 0;
+    fsm_Tone_state          * pCurrentFsmState  = nullptr;
+    cTimerWheel::Timer_t    FsmTimer;
 };  // class cTestTone
 
 class fsm_Tone_state
@@ -0,0 +1,73 @@
+/*
+  *    File: TimeZone.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <ArduinoLog.h>
+#include <time.h>
+
+#include "TimeZone.hpp"
+#include "memdebug.h"
+
+static const PROGMEM char       TIME_ZONE_STR       []  = "TIME ZONE (POSIX TZ)";
+static const PROGMEM char       TIME_ZONE           []  = "TIME_ZONE_STR";
+static const PROGMEM char       TIME_ZONE_DEF_STR   []  = "UTC0";
+static const PROGMEM uint32_t   TIME_ZONE_MAX_SZ        = 48;
+
+// *********************************************************************************************
+cTimeZone::cTimeZone () :   cControlCommon (TIME_ZONE, ControlType::Text, TIME_ZONE_STR, TIME_ZONE_DEF_STR, TIME_ZONE_MAX_SZ)
+{
+    // _ DEBUG_START;
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+bool cTimeZone::set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = cControlCommon::set (value, ResponseMessage, SkipLogOutput, ForceUpdate);
+
+    if (Response)
+    {
+        setenv ("TZ", GetDataValueStr ().c_str (), 1);
+        tzset ();
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+bool cTimeZone::validate (const String & value, String & ResponseMessage, bool ForceUpdate)
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    // A POSIX TZ string starts with a zone name of at least three characters.
+    if ((value.length () >= 3) && (-1 == value.indexOf (' ')))
+    {
+        Response = cControlCommon::validate (value, ResponseMessage, ForceUpdate);
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+cTimeZone TimeZone;
+
+// *********************************************************************************************
+// OEF
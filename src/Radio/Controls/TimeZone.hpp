@@ -0,0 +1,38 @@
+#pragma once
+/*
+  *    File: TimeZone.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Local time zone as a POSIX TZ string, e.g. "CST6CDT,M3.2.0,M11.1.0" or "CET-1CEST,M3.5.0,M10.5.0/3".
+  *    Used for message schedules and the RDS clock time local offset. SNTP keeps the clock on UTC.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include "ControlCommon.hpp"
+
+// *********************************************************************************************
+class cTimeZone : public cControlCommon
+{
+public:
+
+    cTimeZone ();
+    virtual~cTimeZone ()    {}
+
+    bool    set (const String & value, String & ResponseMessage, bool SkipLogOutput, bool ForceUpdate);
+    bool    validate (const String & value, String & ResponseMessage, bool ForceUpdate);
+};  // class cTimeZone
+
+extern cTimeZone TimeZone;
+
+// *********************************************************************************************
+// OEF
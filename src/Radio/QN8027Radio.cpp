@@ -157,15 +157,17 @@ void QN8027Radio::setFrequency (float frequency)
     uint8_t frequencyL = frequencyB & 0XFF;
 
     // freqL = frequencyL;
-    write1Byte (SYSTEM_REG, frequencyH);
-    write1Byte (CH1_REG,    frequencyL);
+    writeReg (SYSTEM_REG,   frequencyH);
+    writeReg (CH1_REG,      frequencyL);
 }
 
-/* Get Currently Transmitting Frequency with decimal point */
+/* Get Currently Transmitting Frequency with decimal point.
+  *    Served from the register shadow once the channel registers have been written.
+  */
 float QN8027Radio::getFrequency ()
 {
-    uint8_t frequencyH  = read1Byte (SYSTEM_REG) & CH0_MASK;
-    uint8_t frequencyL  = read1Byte (CH1_REG);
+    uint8_t frequencyH  = readReg (SYSTEM_REG) & CH0_MASK;
+    uint8_t frequencyL  = readReg (CH1_REG);
     float   freqCombine = (float)(((frequencyH << 8) | frequencyL) * 5 + 7600) / 100;
 
     return freqCombine;
@@ -177,6 +179,7 @@ uint8_t QN8027Radio::read1Byte (uint8_t regAddr)
 {
     uint8_t readData = 0xff;
 
+    ++I2cReadCount;
     //    noInterrupts();  // Mod by TEB, Feb-01-2022
     Wire.beginTransmission (QN8027_I2C_ADDR);
     Wire.write (regAddr);
@@ -194,33 +197,161 @@ uint8_t QN8027Radio::read1Byte (uint8_t regAddr)
     return readData;
 }
 
+/* Read a register. Config registers that only change when we write them are served from the shadow copy.
+  *    Volatile registers (STATUS, ANT, CID) always go to the chip.
+  */
+uint8_t QN8027Radio::readReg (uint8_t regAddr)
+{
+    uint32_t RegBit = (regAddr < QN8027_REG_COUNT) ? (1UL << regAddr) : 0;
+
+    if (RegBit & QN8027_CACHED_REGS)
+    {
+        if (!(ShadowValid & RegBit))
+        {
+            RegShadow[regAddr]  = read1Byte (regAddr);
+            ShadowValid         |= RegBit;
+        }
+
+        return RegShadow[regAddr];
+    }
+
+    return read1Byte (regAddr);
+}
+
 /* Write any writable Register of QN8027
   *         regAddr = Address of Register want to write.
   *         comData = data you want to write in that register. comData means command Data.
   */
 void QN8027Radio::write1Byte (uint8_t regAddr, uint8_t comData)
 {
+    ++I2cWriteCount;
     //    noInterrupts();  // Mod by TEB, Feb-01-2022
     Wire.beginTransmission (QN8027_I2C_ADDR);
     Wire.   write ( regAddr);
     Wire.   write ( comData);
     Wire.endTransmission ();    // ACK read
     //    interrupts();
+
+    if (regAddr < QN8027_REG_COUNT)
+    {
+        RegShadow[regAddr]  = comData;
+        ShadowValid         |= (1UL << regAddr);
+        ShadowDirty         &= ~(1UL << regAddr);
+    }
+}
+
+/* Write consecutive registers in a single I2C transaction using the chip's register address auto-increment.
+  *    The shadow copy is updated for every register covered by the burst.
+  */
+void QN8027Radio::writeBurst (uint8_t startRegAddr, const uint8_t * data, uint8_t length)
+{
+    ++I2cWriteCount;
+    Wire.beginTransmission (QN8027_I2C_ADDR);
+    Wire.write (startRegAddr);
+    Wire.write (data, length);
+    Wire.endTransmission ();    // ACK read
+
+    for (uint8_t index = 0;index < length;++index)
+    {
+        uint8_t regAddr = startRegAddr + index;
+
+        if (regAddr < QN8027_REG_COUNT)
+        {
+            RegShadow[regAddr]  = data[index];
+            ShadowValid         |= (1UL << regAddr);
+            ShadowDirty         &= ~(1UL << regAddr);
+        }
+    }
+}
+
+/* Cached register write. The bus transaction is skipped when the chip already holds comData.
+  *    While deferred writes are enabled the value is only recorded and sent by flushRegisters().
+  */
+void QN8027Radio::writeReg (uint8_t regAddr, uint8_t comData)
+{
+    uint32_t RegBit = (regAddr < QN8027_REG_COUNT) ? (1UL << regAddr) : 0;
+
+    do  // once
+    {
+        if (0 == RegBit)
+        {
+            write1Byte (regAddr, comData);
+            break;
+        }
+
+        if ((ShadowValid & RegBit) && (RegShadow[regAddr] == comData))
+        {
+            ++I2cWritesSkipped;
+            break;
+        }
+
+        if (DeferWrites)
+        {
+            RegShadow[regAddr]  = comData;
+            ShadowValid         |= RegBit;
+            ShadowDirty         |= RegBit;
+            break;
+        }
+
+        write1Byte (regAddr, comData);
+    } while (false);
+}
+
+/* Send all registers that were changed while deferred writes were enabled, lowest address first. */
+void QN8027Radio::flushRegisters ()
+{
+    for (uint8_t regAddr = 0;(regAddr < QN8027_REG_COUNT) && ShadowDirty;++regAddr)
+    {
+        if (ShadowDirty & (1UL << regAddr))
+        {
+            write1Byte (regAddr, RegShadow[regAddr]);
+        }
+    }
+}
+
+/* Forget everything we know about the chip registers (chip reset or chip replaced). */
+void QN8027Radio::invalidateShadow ()
+{
+    ShadowValid = 0;
+    ShadowDirty = 0;
+}
+
+/* When enabled, cached writes are collected and sent by flushRegisters(). Disabling flushes pending writes. */
+void QN8027Radio::setDeferredWrites (bool value)
+{
+    DeferWrites = value;
+
+    if (!DeferWrites)
+    {
+        flushRegisters ();
+    }
 }
 
 /* base Function For RDS data sending.
   */
 void QN8027Radio::sendRDS (char By0, char By1, char By2, char By3, char By4, char By5, char By6, char By7)
 {
-    rdsSentStatus = read1Byte (STATUS_REG) & 8;
-    write1Byte (RDSD0_REG,  By0);
-    write1Byte (RDSD1_REG,  By1);
-    write1Byte (RDSD2_REG,  By2);
-    write1Byte (RDSD3_REG,  By3);
-    write1Byte (RDSD4_REG,  By4);
-    write1Byte (RDSD5_REG,  By5);
-    write1Byte (RDSD6_REG,  By6);
-    write1Byte (RDSD7_REG,  By7);
+    const uint8_t Group[RDS_GROUP_SIZE] =
+    {
+        uint8_t(By0), uint8_t(By1), uint8_t(By2), uint8_t(By3), uint8_t(By4), uint8_t(By5), uint8_t(By6), uint8_t(By7)
+    };
+
+    sendRDSGroup (Group);
+}
+
+/* Send one packed RDS group. RDSD0..RDSD7 are loaded with a single burst write, then the
+  *    SYSTEM_REG RDS ready bit is toggled to tell the chip a new group is waiting.
+  */
+void QN8027Radio::sendRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE])
+{
+    rdsSentStatus = readStatus () & RDS_SENT_MASK;
+    loadRDSGroup (Group);
+}
+
+/* Load a group into RDSD0..RDSD7 and toggle the ready bit. rdsSentStatus must already hold the current sent bit. */
+void QN8027Radio::loadRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE])
+{
+    writeBurst (RDSD0_REG, Group, RDS_GROUP_SIZE);
 
     if (rdsReady == 4)
     {
@@ -231,19 +362,175 @@ void QN8027Radio::sendRDS (char By0, char By1, char By2, char By3, char By4, cha
         rdsReady = 4;
     }
 
+    // The chip only takes the group when it sees the toggle, so it is never deferred.
+    bool Deferred = DeferWrites;
+    DeferWrites = false;
     updateSYSTEM_REG ();
+    DeferWrites = Deferred;
+}
+
+/* Add a group to the transmit queue. When the queue is full the oldest pending group is dropped.
+  *    The queue is drained by pollRDS().
+  */
+bool QN8027Radio::queueRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE])
+{
+    bool Response = true;
+
+    if (pendingRDSGroups () == (RDS_TX_QUEUE_SIZE - 1))
+    {
+        RdsTxTail = (RdsTxTail + 1) & (RDS_TX_QUEUE_SIZE - 1);
+        ++RdsGroupsDropped;
+        Response = false;
+    }
+
+    memcpy (RdsTxQueue[RdsTxHead], Group, RDS_GROUP_SIZE);
+    RdsTxHead = (RdsTxHead + 1) & (RDS_TX_QUEUE_SIZE - 1);
+
+    return Response;
+}
+
+/* Remove pending groups of one group type (0 == PS, 2 == RadioText, ...) so stale text is not sent.
+  *    The group type is the upper nibble of block 2.
+  */
+void QN8027Radio::purgeRDSGroups (uint8_t GroupType)
+{
+    uint8_t WriteIndex = RdsTxTail;
+
+    for (uint8_t ReadIndex = RdsTxTail;ReadIndex != RdsTxHead;ReadIndex = (ReadIndex + 1) & (RDS_TX_QUEUE_SIZE - 1))
+    {
+        if ((RdsTxQueue[ReadIndex][2] >> 4) == GroupType)
+        {
+            continue;
+        }
+
+        if (WriteIndex != ReadIndex)
+        {
+            memcpy (RdsTxQueue[WriteIndex], RdsTxQueue[ReadIndex], RDS_GROUP_SIZE);
+        }
+
+        WriteIndex = (WriteIndex + 1) & (RDS_TX_QUEUE_SIZE - 1);
+    }
+
+    RdsTxHead = WriteIndex;
+}
+
+/* Send a group as soon as the chip takes the next one, ahead of anything in the queue.
+  *    Used for time critical groups (clock time). Only one can be pending, a newer one replaces it.
+  */
+void QN8027Radio::sendUrgentRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE])
+{
+    if (RdsUrgentPending)
+    {
+        ++RdsGroupsDropped;
+    }
+
+    memcpy (RdsUrgentGroup, Group, RDS_GROUP_SIZE);
+    RdsUrgentPending = true;
+}
+
+/* Send a 4A clock time group (UTC date and time plus the local time offset). */
+void QN8027Radio::sendClockTime (uint32_t Mjd, uint8_t Hour, uint8_t Minute, int8_t LocalOffsetHalfHours)
+{
+    cRdsEncoder::RdsGroup_t Group;
+
+    RdsEncoder.BuildClockTimeGroup (Group, Mjd, Hour, Minute, LocalOffsetHalfHours);
+    sendUrgentRDSGroup (Group);
+}
+
+void QN8027Radio::clearRDSQueue ()
+{
+    RdsTxHead           = 0;
+    RdsTxTail           = 0;
+    RdsTxBusy           = false;
+    RdsUrgentPending    = false;
+}
+
+/* Drive the RDS transmitter. Call this often (every few mS) from the main loop.
+  *    A new group is handed to the chip once it toggles the RDS sent bit for the previous one.
+  *    Returns true if a group was loaded. Never blocks.
+  */
+const uint32_t  RDS_GROUP_TIME_MS   = 80;   // A group takes ~87.6mS on air. Do not poll the chip before then.
+const uint32_t  RDS_CHECK_TIME_MS   = 5;
+const uint32_t  RDS_SEND_TIMEOUT_MS = 150;
+bool QN8027Radio::pollRDS ()
+{
+    bool        Response    = false;
+    uint32_t    now         = millis ();
+
+    do  // once
+    {
+        if (RdsTxBusy)
+        {
+            if (int32_t(now - RdsTxNextCheck) < 0)
+            {
+                break;
+            }
+
+            uint8_t status = readStatus () & RDS_SENT_MASK;
+
+            if (status == rdsSentStatus)
+            {
+                if ((now - RdsTxStartTime) < RDS_SEND_TIMEOUT_MS)
+                {
+                    RdsTxNextCheck = now + RDS_CHECK_TIME_MS;
+                    break;
+                }
+
+                // chip did not take the group (carrier off?). Move on.
+                ++RdsSendTimeouts;
+            }
+
+            rdsSentStatus   = status;
+            RdsTxBusy       = false;
+        }
+        else if (RdsUrgentPending || (RdsTxHead != RdsTxTail))
+        {
+            rdsSentStatus = readStatus () & RDS_SENT_MASK;
+        }
+
+        if (DeferWrites && (ShadowDirty & (1UL << SYSTEM_REG)))
+        {
+            // A SYSTEM_REG change is waiting for commit(). Sending the rdsReady toggle now would apply it early.
+            break;
+        }
+
+        if (RdsUrgentPending)
+        {
+            loadRDSGroup (RdsUrgentGroup);
+            RdsUrgentPending = false;
+        }
+        else if (RdsTxHead != RdsTxTail)
+        {
+            loadRDSGroup (RdsTxQueue[RdsTxTail]);
+            RdsTxTail = (RdsTxTail + 1) & (RDS_TX_QUEUE_SIZE - 1);
+        }
+        else
+        {
+            break;
+        }
+
+        ++RdsGroupsSent;
+        RdsTxBusy       = true;
+        RdsTxStartTime  = now;
+        RdsTxNextCheck  = now + RDS_GROUP_TIME_MS;
+        Response        = true;
+    } while (false);
+
+    return Response;
 }
 
 // ---------------------------SYSTEM_REG------------------------------------------------------------
 /*
   *    Resets all registers(settings) to default.
   */
-void QN8027Radio::updateSYSTEM_REG () {write1Byte (SYSTEM_REG, (radioStatus | monoAudio | muteAudio | rdsReady | freqH));}
+void QN8027Radio::updateSYSTEM_REG () {writeReg (SYSTEM_REG, (radioStatus | monoAudio | muteAudio | rdsReady | freqH));}
 
 void QN8027Radio::reset ()
 {
     write1Byte (SYSTEM_REG, 0x80);
     delayMicroseconds (100);
+    invalidateShadow ();            // All registers are back to their power on defaults.
+    clearRDSQueue ();
     write1Byte (SYSTEM_REG, 0x00);  // Mod by TEB, Jan-29-2022.
 }
 
@@ -288,6 +575,8 @@ void QN8027Radio::MonoAudio (uint8_t onOffCtrl)
         monoAudio = 0;
     }
 
+    // PS groups sent from now on carry the stereo flag in their Decoder Identification bits.
+    RdsEncoder.SetDecoderInfo (monoAudio ? 0 : RDS_DI_STEREO);
     updateSYSTEM_REG ();
 
     // write1Byte(SYSTEM_REG,(radioStatus | monoAudio | muteAudio | rdsReady | freqH));
@@ -311,7 +600,7 @@ void QN8027Radio::Switch (uint8_t onOffCtrl)
 }
 
 // ---------------------------GPLT_REG----------------------------------------------------------
-void QN8027Radio::updateGPLT_REG () {write1Byte (GPLT_REG, (preEmphTime | privateMode | PAAutoOffTime | TxPilotFreqDeviation));}
+void QN8027Radio::updateGPLT_REG () {writeReg (GPLT_REG, (preEmphTime | privateMode | PAAutoOffTime | TxPilotFreqDeviation));}
 
 // I really dont know why is this option there. it gave mono audio with narrow CarrierWave bandwidth in my tests.
 // you can provide ON or OFF in parameter to this function.
@@ -363,10 +652,10 @@ void QN8027Radio::setTxPilotFreqDeviation (uint8_t PGain)
 
 // Change the PI Code. Be sure to use a valid PI Code.
 // See https://picodes.nrscstandards.org/ and https://www.fmsystems-inc.com/rds-pi-code-formula-station-callsigns/
-void QN8027Radio::setPiCode (uint16_t piCodeVal) {piCode = piCodeVal;}
+void QN8027Radio::setPiCode (uint16_t piCodeVal) {piCode = piCodeVal; RdsEncoder.SetPiCode (piCodeVal);}
 
 // Change the PTY Code. Be sure to use a valid PTY Code.
-void QN8027Radio::setPtyCode (uint8_t ptyCodeVal) {ptyCode = ptyCodeVal;}
+void QN8027Radio::setPtyCode (uint8_t ptyCodeVal) {ptyCode = ptyCodeVal; RdsEncoder.SetPtyCode (ptyCodeVal);}
 
 /*
   *    ON  : RF power Amplifier will be off automatically after 60 second of no audio input at pin 6 and pin 7 (which is default)
@@ -389,7 +678,7 @@ void QN8027Radio::radioNoAudioAutoOFF (uint8_t onOffCtrl)
 }
 
 // ------------------------XTL_REG-------------------------------------------------------------
-void QN8027Radio::updateXTL_REG () {write1Byte (XTL_REG, (clockSource | CrystalCurrentuA));}
+void QN8027Radio::updateXTL_REG () {writeReg (XTL_REG, (clockSource | CrystalCurrentuA));}
 
 /*
   *    Type::meaning
@@ -419,7 +708,7 @@ void QN8027Radio::setCrystalCurrent (float percentOfMax)    // current between 0
 }
 
 // -----------------------VGA_REG--------------------------------------------------------------
-void QN8027Radio::updateVGA_REG () {write1Byte (VGA_REG, (crystalFreqMHz | TxInputBufferGain | TxDigitalGain | LRInputImpdKOhm));}
+void QN8027Radio::updateVGA_REG () {writeReg (VGA_REG, (crystalFreqMHz | TxInputBufferGain | TxDigitalGain | LRInputImpdKOhm));}
 
 /*
   *    if clock input source is XTAL then you can set which XTAL was used.
@@ -524,7 +813,7 @@ void QN8027Radio::setAudioInpImp (uint8_t impdInKOhms)
   *    default is 129 which means 74.82 KHz
   *    maximum bandwidth can be 148 KHz by setting Fdev value to 255
   */
-void QN8027Radio::setTxFreqDeviation (uint8_t Fdev) {write1Byte (FDEV_REG, Fdev);}
+void QN8027Radio::setTxFreqDeviation (uint8_t Fdev) {writeReg (FDEV_REG, Fdev);}
 
 // ---------------------------RDS_REG-------------------------------------------------------
 /* set RDS channel ON or OFF */
@@ -539,7 +828,7 @@ void QN8027Radio::RDS (uint8_t onOffCtrl)
         RDSEnable = 0;
     }
 
-    write1Byte (RDS_REG, (RDSEnable | RDSFreqDeviationKHz));
+    writeReg (RDS_REG, (RDSEnable | RDSFreqDeviationKHz));
 }
 
 /* set bandwidth of RDS channel.
@@ -551,7 +840,7 @@ void QN8027Radio::RDS (uint8_t onOffCtrl)
 void QN8027Radio::setRDSFreqDeviation (uint8_t RDSFreqDev)
 {
     RDSFreqDeviationKHz = RDSFreqDev;
-    write1Byte (RDS_REG, (RDSEnable | RDSFreqDeviationKHz));
+    writeReg (RDS_REG, (RDSEnable | RDSFreqDeviationKHz));
 }
 
 // --------------------------PAC_REG---------------------------------------------------------
@@ -578,7 +867,7 @@ void QN8027Radio::clearAudioPeak ()
         AudioPeakClear = 128;
     }
 
-    write1Byte (PAC_REG, (AudioPeakClear | PAOutputPower));
+    writeReg (PAC_REG, (AudioPeakClear | PAOutputPower));
 }
 
 /*
@@ -595,7 +884,7 @@ void QN8027Radio::clearAudioPeak ()
 void QN8027Radio::setTxPower (uint8_t setX)
 {
     PAOutputPower = setX & 0x7F;    // Mod by TEB, Jan-31-2022.
-    write1Byte (PAC_REG, (AudioPeakClear | PAOutputPower));
+    writeReg (PAC_REG, (AudioPeakClear | PAOutputPower));
 }
 
 // ----------------------STATUS_REG ----------------------------------------------------------
@@ -614,32 +903,93 @@ void QN8027Radio::setTxPower (uint8_t setX)
   */
 uint8_t QN8027Radio::getFSMStatus ()
 {
-    uint8_t tmp = read1Byte (STATUS_REG);
-
-    return tmp & 7;
+    return readStatus () & FSM_STATE_MASK;
 }
 
 /* get maximum amplitude of input audio since last reading
   *    multiply this value by 45 and you will get amplitude in mili Volts.
+  *    Peaks seen by other status reads since the last call are included.
   */
 uint8_t QN8027Radio::getAudioInpPeak ()
 {
-    uint8_t tmp = read1Byte (STATUS_REG);
+    readStatus ();
+
+    uint8_t tmp = AudioPeakHold;
 
+    AudioPeakHold = 0;
     clearAudioPeak ();
 
-    return tmp >> 4;
+    return tmp;
 }
 
+/* Legacy status read. Also restarts the audio peak detector. Use readStatus() when only the
+  *    FSM state or the RDS sent bit is needed.
+  */
 uint8_t QN8027Radio::getStatus ()
 {
-    uint8_t tmp = read1Byte (STATUS_REG);
+    uint8_t tmp = readStatus ();
 
+    AudioPeakHold = 0;
     clearAudioPeak ();
 
     return tmp;
 }
 
+/* Read STATUS_REG once, without side effects on the chip.
+  *    The audio peak field is remembered so it is not lost to reads made for the FSM state.
+  */
+uint8_t QN8027Radio::readStatus ()
+{
+    LastStatus = read1Byte (STATUS_REG);
+
+    if ((LastStatus >> 4) > AudioPeakHold)
+    {
+        AudioPeakHold = LastStatus >> 4;
+    }
+
+    return LastStatus;
+}
+
+/* Wait up to WaitMs for the FSM to reach one of the states in StateMask (bit N == FSM state N).
+  *    STATUS_REG is read once per 1mS pass and the audio peak detector is left alone.
+  *    Right after a command the chip still reports its old state, so nothing is tested until SettleMs
+  *    has passed. ExitOnChange: also stop as soon as the FSM moves off its starting state.
+  *    Returns true if a state in StateMask was reached.
+  */
+bool QN8027Radio::waitForFsmState (uint8_t StateMask, uint32_t WaitMs, uint32_t SettleMs, bool ExitOnChange)
+{
+    bool        Response        = false;
+    uint32_t    StartTime       = millis ();
+    uint8_t     InitialState    = readStatus () & FSM_STATE_MASK;
+    uint8_t     State           = InitialState;
+
+    do
+    {
+        bool Settled = (millis () - StartTime) >= SettleMs;
+
+        if (Settled && (StateMask & (1 << State)))
+        {
+            Response = true;
+            break;
+        }
+
+        if (Settled && ExitOnChange && (State != InitialState))
+        {
+            break;
+        }
+
+        if (Settled && ((millis () - StartTime) >= WaitMs))
+        {
+            break;
+        }
+
+        delay (1);
+        State = readStatus () & FSM_STATE_MASK;
+    } while (true);
+
+    return Response;
+}
+
 // Read the PI Code.
 // See https://picodes.nrscstandards.org/ and https://www.fmsystems-inc.com/rds-pi-code-formula-station-callsigns/
 uint16_t QN8027Radio::getPiCode (void) {return piCode;}
@@ -650,39 +1000,35 @@ uint8_t QN8027Radio::getPTYCode (void) {return ptyCode;}
 // -------------------RDS sending---------------------------------------------------------------
 /*
   *    Sends Program Service Name (PSN = Station ID) such as "KZAP FM" to a RDS enabled receiver.
-  *    PSN must be maximum 8 byte long String.
-  *    PSN shorter than 8 bytes will contain a null termination. This tells the RDS Receiver when to end decoding.
+  *    PSN must be maximum 8 byte long String. Shorter names are padded with spaces.
+  *    The 0A groups come from the encoder's cached table and are queued for pollRDS().
   */
-void QN8027Radio::sendStationName (String SN)
-{
-    char    char_array[PSN_SIZE + 1];
-    int     str_len;
-    int     rds_len;
+void QN8027Radio::sendStationName (String SN) {sendStationName (SN.c_str ());}
 
-    if (SN.length () > PSN_SIZE)    // Prevent Buffer Overflow.
-    {
-        SN = SN.substring (0, PSN_SIZE);
-    }
+void QN8027Radio::sendStationName (const char * SN)
+{
+    RdsEncoder.SetProgramServiceName (SN);
+    queuePsGroups ();
+}
 
-    str_len = SN.length () + 1;
-    rds_len = str_len + (str_len % 2);          // Make it a multiple of 2.
+/*
+  *    Sets the Alternative Frequency list carried in block 3 of the 0A groups and resends the PS groups.
+  *    Codes are 1..204 (87.6 to 107.9 MHz), see cRdsEncoder::AfCode(). An empty list sends "No AF exists".
+  */
+void QN8027Radio::setAfList (const uint8_t * Codes, uint8_t Count)
+{
+    RdsEncoder.SetAlternativeFrequencies (Codes, Count);
+    queuePsGroups ();
+}
 
-    memset (char_array, char(NULL), PSN_SIZE);  // Clear PSN Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
-    SN.toCharArray (char_array, str_len);
+// The PS table holds a multiple of four groups so the name is always sent complete.
+void QN8027Radio::queuePsGroups ()
+{
+    purgeRDSGroups (cRdsEncoder::GroupType_PS); // Drop any PS groups that have not been sent yet.
 
-    for (int i = 0;i < rds_len;i += 2)
+    for (uint8_t i = 0;i < RdsEncoder.GetPsGroupCount ();++i)
     {
-        if (i >= PSN_SIZE)
-        {
-            break;  // Prevent RDS buffer overflow. Mod By TEB, Jan-31-2022.
-        }
-
-        uint8_t ptyHi = (ptyCode & 0x18) >> 3;  // top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp,
-                                                // Jun-13-2022
-        uint8_t ptyLo = (ptyCode << 5) & 0xE0;  // bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp,
-                                                // Jun-13-2022
-        sendRDS (highByte (piCode), lowByte (piCode), ptyHi, ptyLo | (0x08 + (i / 2)), 0xE0, 0xCD, char_array[i], char_array[i + 1]);
-        waitForRDSSend ();
+        queueRDSGroup (RdsEncoder.GetPsGroup (i));
     }
 }
 
@@ -698,8 +1044,8 @@ void QN8027Radio::waitForRDSSend ()
 
     do
     {
-        status  = read1Byte (STATUS_REG);
-        status  = status & 8;
+        status  = readStatus ();
+        status  = status & RDS_SENT_MASK;
 
         if (timeout++ > (100 / RDS_SEND_DELAY))  // Allow up to 100mS RDS Send time. Mod by TEB, Dec-27-2021
         {
@@ -714,45 +1060,39 @@ void QN8027Radio::waitForRDSSend ()
 }
 
 /*Sends Song Artist Album Name. RT must be maximum 64 Byte long*/
-// RadioText shorter than 64 bytes will contain a null termination. This tells the RDS Receiver when to end decoding.
-/* Execution time is about 1.2mS */
+// RadioText shorter than 64 bytes is terminated with a carriage return. This tells the RDS Receiver when to end decoding.
+/* The 2A groups come from the encoder's cached table and are queued for pollRDS(). Execution time is well under 1mS */
 void QN8027Radio::sendRadioText (String RT)
 {
-    char    char_array[RADIOTEXT_SIZE + 1];
-    int     rds_len;
-    int     str_len;
+    RdsEncoder.SetRadioText (RT.c_str ());
+
+    purgeRDSGroups (cRdsEncoder::GroupType_RT); // Drop any RadioText groups left over from the previous message.
 
-    if (RT.length () > RADIOTEXT_SIZE)  // Prevent Buffer Overflow.
+    for (uint8_t i = 0;i < RdsEncoder.GetRtGroupCount ();++i)
     {
-        RT = RT.substring (0, RADIOTEXT_SIZE);
+        queueRDSGroup (RdsEncoder.GetRtGroup (i));
     }
 
-    str_len = RT.length () + 1;
-    rds_len = str_len + (str_len % 4);                  // Make it a multiple of 4.
-    memset (char_array, char(NULL), RADIOTEXT_SIZE);    // Clear RadioText Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
-    RT.toCharArray (char_array, str_len);               // Copy RadioText to Buffer.
+    // RT+ (3A announcement + 11A tags) follows the text it describes, so RadioText is never delayed.
+    purgeRDSGroups (cRdsEncoder::GroupType_ODA);
+    purgeRDSGroups (cRdsEncoder::GroupType_RTPLUS);
 
-    for (int i = 0;i < rds_len;i += 4)
+    for (uint8_t i = 0;i < RdsEncoder.GetRtPlusGroupCount ();++i)
     {
-        if (i >= RADIOTEXT_SIZE)
-        {
-            break;  // Prevent RDS buffer overflow. Mod By TEB, Jan-31-2022.
-        }
+        queueRDSGroup (RdsEncoder.GetRtPlusGroup (i));
+    }
+}
 
-        uint8_t ptyHi = (ptyCode & 0x18) >> 3;  // top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp,
-                                                // Jun-13-2022
-        uint8_t ptyLo = (ptyCode << 5) & 0xE0;  // bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp,
-                                                // Jun-13-2022
-        sendRDS (
-            highByte (piCode),
-            lowByte (piCode),
-            0x20 | ptyHi,
-            ptyLo | (i / 4),
-            char_array[i],
-            char_array[i + 1],
-            char_array[i + 2],
-            char_array[i + 3]);
-        waitForRDSSend ();
+/* Set the RT+ tags for the next sendRadioText(). Empty tags turn RT+ off. */
+void QN8027Radio::setRtPlusTags (const cRdsEncoder::RtPlusTags_t & Tags)
+{
+    if (Tags.IsEmpty ())
+    {
+        RdsEncoder.ClearRtPlusTags ();
+    }
+    else
+    {
+        RdsEncoder.SetRtPlusTags (Tags);
     }
 }
 
@@ -10,11 +10,11 @@
 
 #include "PixelRadio.h"
 #include <Wire.h>
+#include "RdsEncoder.hpp"
 #ifndef QN8027Radio_h
     #define QN8027Radio_h
     #define                 QN8027_I2C_ADDR 0x2C
-    #define         RADIOTEXT_SIZE          64
-    #define         PSN_SIZE                8
+    #define         RDS_TX_QUEUE_SIZE       64  // Pending RDS groups. Must be a power of two.
 
     // QN8027 Register
     #define         SYSTEM_REG  0x00
@@ -37,6 +37,17 @@
     #define         FDEV_REG    0x11
     #define         RDS_REG     0x12
     #define         ANT_REG     0x1E
+    #define         QN8027_REG_COUNT    0x20
+
+    // Registers whose contents only change when we write them. These are served from the shadow copy.
+    #define         QN8027_CACHED_REGS  ((1UL << SYSTEM_REG) | (1UL << CH1_REG) | (1UL << GPLT_REG) | (1UL << XTL_REG) | \
+                                         (1UL << VGA_REG) | (1UL << PAC_REG) | (1UL << FDEV_REG) | (1UL << RDS_REG))
+
+    // STATUS_REG fields
+    #define         FSM_STATE_MASK      0x07
+    #define         FSM_STATE_IDLE      0x02
+    #define         FSM_STATE_TRANSMIT  0x05
+    #define         RDS_SENT_MASK       0x08
 
     // indicate self definition
     #define                 ON          0x01
@@ -52,6 +63,31 @@ private:
         uint8_t _address    = QN8027_I2C_ADDR;  // TEB, MAR-07-2022
         uint8_t freqH       = 0x00;             // TEB, MAR-07-2022
 
+        // Register shadow. Holds the last value written to (or read from) each chip register.
+        uint8_t     RegShadow[QN8027_REG_COUNT] = {0};
+        uint32_t    ShadowValid = 0;    // Bit N set: RegShadow[N] is known.
+        uint32_t    ShadowDirty = 0;    // Bit N set: RegShadow[N] has not been sent to the chip yet.
+        bool        DeferWrites = false;
+
+        // Asynchronous RDS transmitter. Groups are queued here and handed to the chip by pollRDS().
+        uint8_t     RdsTxQueue[RDS_TX_QUEUE_SIZE][RDS_GROUP_SIZE];
+        uint8_t     RdsTxHead       = 0;        // Next free slot.
+        uint8_t     RdsTxTail       = 0;        // Next group to send.
+        bool        RdsTxBusy       = false;    // A group was handed to the chip and has not been confirmed yet.
+        uint32_t    RdsTxStartTime  = 0;        // millis() when the current group was handed to the chip.
+        uint32_t    RdsTxNextCheck  = 0;        // millis() when the RDS sent bit should be checked again.
+        uint8_t     RdsUrgentGroup[RDS_GROUP_SIZE];
+        bool        RdsUrgentPending = false;   // RdsUrgentGroup goes out ahead of the queue (clock time).
+
+        void        loadRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE]);
+        void        queuePsGroups ();
+
+        // Status tracking. Every STATUS_REG read goes through readStatus().
+        uint8_t     LastStatus      = 0;
+        uint8_t     AudioPeakHold   = 0;    // Highest audio peak seen since the last getAudioInpPeak().
+
+        cRdsEncoder RdsEncoder;     // Builds and caches the RDS groups for the current station state.
+
 public:
 
         // SYSTEM
@@ -91,10 +127,26 @@ public:
 
         uint8_t     rdsSentStatus = 0;      // Toggle between 8 and 0 when RDS is sent successfully.
 
+        // I2C bus statistics
+        uint32_t    I2cReadCount        = 0;
+        uint32_t    I2cWriteCount       = 0;
+        uint32_t    I2cWritesSkipped    = 0;
+
+        // RDS transmitter statistics
+        uint32_t    RdsGroupsSent       = 0;
+        uint32_t    RdsGroupsDropped    = 0;
+        uint32_t    RdsSendTimeouts     = 0;
 
         QN8027Radio ();
         QN8027Radio (int address);
         void write1Byte (uint8_t regAddr, uint8_t comData);
+        void writeReg (uint8_t regAddr, uint8_t comData);
+        void writeBurst (uint8_t startRegAddr, const uint8_t * data, uint8_t length);
+
+        void    flushRegisters ();
+        void    invalidateShadow ();
+        void    setDeferredWrites (bool value);
+        bool    hasDirtyRegisters () {return 0 != ShadowDirty;}
 
         void    setFrequency (float frequency);
         void    reset ();
@@ -105,16 +157,32 @@ public:
         void    setPreEmphTime50 (uint8_t onOffCtrl);
         void    Switch (uint8_t onOffCtrl); // radioPower
         void    sendRDS (char By0, char By1, char By2, char By3, char By4, char By5, char By6, char By7);
+        void    sendRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE]);
+        bool    queueRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE]);
+        void    purgeRDSGroups (uint8_t GroupType);
+        void    sendUrgentRDSGroup (const uint8_t (&Group)[RDS_GROUP_SIZE]);
+        void    sendClockTime (uint32_t Mjd, uint8_t Hour, uint8_t Minute, int8_t LocalOffsetHalfHours);
+        void    clearRDSQueue ();
+        uint8_t pendingRDSGroups () {return (RdsTxHead - RdsTxTail) & (RDS_TX_QUEUE_SIZE - 1);}
+        bool    pollRDS ();
         void    sendStationName (String SN);
+        void    sendStationName (const char * SN);
         void    sendRadioText (String RT);
+        void    setRtPlusTags (const cRdsEncoder::RtPlusTags_t & Tags);
+        void    setAfList (const uint8_t * Codes, uint8_t Count);
         void    waitForRDSSend ();
 
         float       getFrequency ();
         uint8_t     read1Byte (uint8_t regAddr);
+        uint8_t     readReg (uint8_t regAddr);
         uint8_t     canRDSbeSent ();
         uint8_t     getFSMStatus ();
         uint8_t     getAudioInpPeak ();
         uint8_t     getStatus ();
+        uint8_t     readStatus ();
+        uint8_t     getLastStatus ()    {return LastStatus;}
+        uint8_t     getLastFSMState ()  {return LastStatus & FSM_STATE_MASK;}
+        bool        waitForFsmState (uint8_t StateMask, uint32_t WaitMs, uint32_t SettleMs, bool ExitOnChange);
         uint16_t    getPiCode (void);
         uint8_t     getPTYCode (void);  // dkulp, Jun-13-2022
 
@@ -17,8 +17,12 @@
 #include <ArduinoLog.h>
 #include <Wire.h>
 
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
 #include "language.h"
 #include "QN8027RadioApi.hpp"
+#include "RfPaVoltage.hpp"
 #include "RfPower.hpp"
 #include "memdebug.h"
 
@@ -27,6 +31,21 @@ static const uint8_t    I2C_QN8027_ADDR = 0x2c;     // I2C Address of QN8027 FM
 static const uint8_t    I2C_DEV_CNT     = 1;        // Number of expected i2c devices on bus.
 static const uint32_t I2C_FREQ_HZ       = 100000;   // I2C master clock frequency
 
+// Antenna calibration
+static const float      CAL_FREQ_HIGH   = 108.0F;   // High end of FM tuning range.
+static const float      CAL_FREQ_LOW    = 85.0F;    // Low end of FM tuning range.
+static const size_t     CAL_JSON_SIZE   = 256;
+
+// Radio task
+static const uint32_t   RADIO_TASK_STACK_SIZE   = 4096;
+static const UBaseType_t RADIO_TASK_PRIORITY    = 2;    // Above loop(), below the network stack.
+static const BaseType_t RADIO_TASK_CORE         = 1;    // Same core as loop().
+static const uint32_t   RADIO_TASK_TICK_MS      = 5;    // RDS transmitter poll interval.
+static const uint32_t   RADIO_COMMAND_WAIT_MS   = 5000; // Longest wait for queue space before the command is dropped. More than a recalibrate takes.
+
+// Audio peak sampler
+static const uint8_t    PEAK_SAMPLE_RATE_MAX    = 50;   // Readings per second.
+
 #define TAKE_SEMAPHORE(Sem, Skip)   if (!Skip) {xSemaphoreTakeRecursive (Sem, portMAX_DELAY);}
 #define GIVE_SEMAPHORE(Sem, Skip)   if (!Skip) {xSemaphoreGiveRecursive (Sem);}
 
@@ -40,7 +59,16 @@ void cQN8027RadioApi::begin ()
     Wire.setClock (I2C_FREQ_HZ);        // 100KHz i2c speed.
     pinMode (SCL_PIN, INPUT_PULLUP);    // I2C Clock Pin.
 
-    if (!checkRadioIsPresent ())
+    RadioSemaphore      = xSemaphoreCreateRecursiveMutex ();
+    AudioLevelSemaphore = xSemaphoreCreateMutex ();
+    setPeakSampleRate (PEAK_SAMPLE_RATE_HZ);
+
+    // DEBUG_V(String("RadioSemaphore: 0x") + String(uint32_t(RadioSemaphore), HEX));
+    if (NULL == RadioSemaphore)
+    {
+        Log.errorln (F ("Could not allocate a semaphore for access to the radio hardware"));
+    }
+    else if (!checkRadioIsPresent ())
     {
         TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_FAIL;
         Log.errorln (F ("-> QN8027 is Missing"));
@@ -48,19 +76,18 @@ void cQN8027RadioApi::begin ()
     else
     {
         Log.verboseln (F ("-> QN8027 is Present"));
-        RadioSemaphore = xSemaphoreCreateRecursiveMutex ();
 
-        // DEBUG_V(String("RadioSemaphore: 0x") + String(uint32_t(RadioSemaphore), HEX));
-        if (NULL == RadioSemaphore)
-        {
-            Log.errorln (F ("Could not allocate a semaphore for access to the radio hardware"));
-        }
-        else
+        // DEBUG_V(String("fmRadioTestCode: 0x") + String(fmRadioTestCode, HEX))
+        initRadioChip ();   // If QN8027 fails we will warn user on UI homeTab.
+
+        // From here on only the radio task talks to the chip.
+        if (pdPASS != xTaskCreatePinnedToCore (RadioTask, "RadioTask", RADIO_TASK_STACK_SIZE, this, RADIO_TASK_PRIORITY, &RadioTaskHandle, RADIO_TASK_CORE))
         {
-            // DEBUG_V(String("fmRadioTestCode: 0x") + String(fmRadioTestCode, HEX))
-            initRadioChip ();   // If QN8027 fails we will warn user on UI homeTab.
-            Log.infoln (F ("FM Radio RDS/RBDS Started."));
+            RadioTaskHandle = NULL;
+            Log.errorln (F ("-> Could not start the radio task, radio calls will run on the calling task."));
         }
+
+        Log.infoln (F ("FM Radio RDS/RBDS Started."));
     }
 
     // DEBUG_END;
@@ -81,7 +108,7 @@ bool cQN8027RadioApi::calibrateAntenna (bool SkipSemaphore)
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-        setFrequency (108.0F, true);  // High end of FM tuning range.
+        setFrequency (CAL_FREQ_HIGH, true, true);
         waitForIdle (50, true);
         setRfCarrier (OFF, true);
         waitForIdle (15, true);
@@ -91,7 +118,7 @@ bool cQN8027RadioApi::calibrateAntenna (bool SkipSemaphore)
         waitForIdle (120, true);
         regVal1 = FmRadio.read1Byte (ANT_REG);
 
-        setFrequency (85.0F, true);  // High end of FM tuning range.
+        setFrequency (CAL_FREQ_LOW, true, true);
         waitForIdle (50, true);
         setRfCarrier (OFF, true);
         waitForIdle (15, true);
@@ -110,193 +137,892 @@ bool cQN8027RadioApi::calibrateAntenna (bool SkipSemaphore)
         }
         else if ((regVal1 <= 0x01) || (regVal1 >= 0x1f) || (regVal2 <= 0x01) || (regVal2 >= 0x1f))
         {
-            Response = false;
-            Log.errorln (F ("-> QN8027 RF Port has Poor Calibration, RF Tuning Range Impaired."));
+            Response = false;
+            Log.errorln (F ("-> QN8027 RF Port has Poor Calibration, RF Tuning Range Impaired."));
+        }
+        else
+        {
+            Response = true;
+            Log.infoln (F ("-> QN8027 RF Port Matching OK, Calibration Successful."));
+
+            Calibration.AntHigh     = regVal1;
+            Calibration.AntLow      = regVal2;
+            Calibration.Frequency   = CAL_FREQ_LOW;
+        }
+
+        /*
+          *    radio.setFrequency(103.0F); // Recalibrate at middle FM range.
+          *    waitForIdle(50, true);
+          *    radio.Switch(OFF);
+          *    waitForIdle(15, true);
+          *    radio.Switch(ON);
+          *    waitForIdle(50, true);
+          */
+
+        FmRadio.reCalibrate ();
+        waitForIdle (120, true);
+
+        setRfCarrierOFF (true);
+        waitForIdle (50, true);
+
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+//
+// checkRadioIsPresent(): Check to see if QN8027 FM Radio Chip is installed. Return true if Ok.
+bool cQN8027RadioApi::checkRadioIsPresent (bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    bool response = false;
+
+    if (RadioSemaphore)
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+
+        Wire.beginTransmission (QN8027_I2C_ADDR);
+
+        if (Wire.endTransmission (true) == 0)
+        {
+            // Receive 0 = success (ACK response)
+            response = true;
+        }
+
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+    return response;
+}
+
+// *********************************************************************************************
+// initRadioChip(); Initialize the QN8027 FM Radio Chip. Returns Test Result Code.
+void cQN8027RadioApi::initRadioChip (bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    uint8_t regVal;
+
+    Log.infoln (String (F ("Initializing QN8027 FM Radio Chip ...")).c_str ());
+
+    do  // once
+    {
+        regVal = FmRadio.read1Byte (CID1_REG);
+
+        if ((regVal == 0x00) || ((regVal & 0x0C) != 0x00))
+        {
+            Log.errorln (F ("-> Incorrect CID1 Chip Family ID: 0x%02X"), regVal);
+            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_MISSING;
+            break;
+        }
+
+        Log.verboseln (String (F ("-> CID1 Chip Family ID: 0x%02X")).c_str (), regVal);
+        ChipCid1 = regVal;
+
+        regVal = FmRadio.read1Byte (CID2_REG);
+
+        if ((regVal & 0xF0) != 0x40)
+        {
+            Log.errorln (F ("-> Incorrect CID2 Version: 0x%02X"), regVal);
+            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_MISSING;
+            break;
+        }
+
+        Log.verboseln (F ("-> CID2 Chip Version: 0x%02X"), regVal);
+        ChipCid2 = regVal;
+
+        FmRadio.reset ();
+        delay (30);
+
+        FmRadio.setClockSource (0x00);          // XTAL on pins 1 & 2.
+        FmRadio.setCrystalFreq (12);
+        FmRadio.setCrystalCurrent (30);         // 30% of 400uA Max = 120uA.
+        FmRadio.setTxFreqDeviation (0x81);      // 75Khz, Total Broadcast channel Bandwidth
+        FmRadio.setTxPilotFreqDeviation (9);    // Use default 9% (6.75KHz) Pilot Tone Deviation.
+        FmRadio.setTxPower (RfPower.get32 ());
+        waitForIdle (25, true);
+
+        if (verifyCalibration (true))
+        {
+            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_OK;
+        }
+        else
+        {
+            runCalibration (true);
+        }
+
+        waitForIdle (50, true);
+
+        FmRadio.scrambleAudio (OFF);
+        delay (5);
+
+        FmRadio.clearAudioPeak ();
+        delay (5);
+
+        FmRadio.mute (true);
+        delay (5);
+
+        FmRadio.setRDSFreqDeviation (10);   // RDS Freq Deviation = 0.35KHz * Value.
+        delay (1);
+        FmRadio.RDS (ON);
+        waitForIdle (20, true);
+
+        FmRadio.updateSYSTEM_REG ();    // This is needed to Start FM Broadcast.
+        waitForIdle (20, true);
+        FmRadio.clearAudioPeak ();
+        delay (1);
+
+        Log.infoln (F ("-> Radio Status: %02X"), (FmRadio.readStatus () & FSM_STATE_MASK));
+    } while (false);
+
+    if (QN8027RadioFmTestStatus_e::FM_TEST_OK == TestStatus)
+    {
+        Log.infoln (F ("-> QN8027 Initialization Complete."));
+    }
+    else
+    {
+        Log.errorln (F ("-> QN8027 Failed Initialization."));
+    }
+
+    /*
+      *     // DEBUG ONLY.
+      *     for (int i = 0; i <= 0x1F; i++) {
+      *         Log.infoln(F( "Radio Register %02X is: %02X"), i, radio.read1Byte(i));
+      *     }
+      */
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// GetAudioLevel(): Copy of the rolling audio level statistics. Does not touch the radio.
+void cQN8027RadioApi::GetAudioLevel (cAudioLevel::Snapshot_t & Snapshot)
+{
+    // DEBUG_START;
+
+    Snapshot = cAudioLevel::Snapshot_t ();
+
+    if (AudioLevelSemaphore)
+    {
+        xSemaphoreTake (AudioLevelSemaphore, portMAX_DELAY);
+        AudioLevel.GetSnapshot (Snapshot, millis ());
+        xSemaphoreGive (AudioLevelSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// GetPeakAudioLevel(): Highest audio peak in the sampler window. Max 675mV.
+uint16_t cQN8027RadioApi::GetPeakAudioLevel ()
+{
+    // DEBUG_START;
+
+    cAudioLevel::Snapshot_t Snapshot;
+    GetAudioLevel (Snapshot);
+
+    // DEBUG_END;
+    return Snapshot.MaxMv;
+}
+
+// *********************************************************************************************
+// sampleAudioPeak(): Read the audio peak detector at PeakSampleIntervalMs. One STATUS_REG read
+// and one peak clear per sample, no waiting on the radio.
+void cQN8027RadioApi::sampleAudioPeak (uint32_t now, bool SkipSemaphore)
+{
+    // _ DEBUG_START;
+
+    do  // once
+    {
+        // Don't clear the peak detector in the middle of a configuration change.
+        if (UpdateDepth || (NULL == AudioLevelSemaphore) || ((now - LastPeakSampleTime) < PeakSampleIntervalMs))
+        {
+            break;
+        }
+
+        LastPeakSampleTime = now;
+
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        uint8_t PeakCount   = FmRadio.getAudioInpPeak ();
+        uint8_t FsmState    = FmRadio.getLastFSMState ();
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+
+        // Peak readings taken while the chip is calibrating or changing channel are meaningless.
+        if (0 == ((FSM_MASK_IDLE | FSM_MASK_TRANSMIT) & (1 << FsmState)))
+        {
+            break;
+        }
+
+        xSemaphoreTake (AudioLevelSemaphore, portMAX_DELAY);
+        AudioLevel.AddSample (PeakCount, now);
+        xSemaphoreGive (AudioLevelSemaphore);
+    } while (false);
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// setPeakSampleRate(): Audio peak sampler rate, 1 to PEAK_SAMPLE_RATE_MAX readings per second.
+void cQN8027RadioApi::setPeakSampleRate (uint8_t RateHz)
+{
+    // DEBUG_START;
+
+    RateHz                  = constrain (RateHz, uint8_t (1), PEAK_SAMPLE_RATE_MAX);
+    PeakSampleIntervalMs    = 1000 / RateHz;
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// Poll(): Feed queued RDS groups to the chip. Never waits for the radio. If another task
+// currently owns the radio we simply try again on the next pass through the main loop.
+// Once the radio task runs, it does this itself.
+void cQN8027RadioApi::Poll ()
+{
+    // _ DEBUG_START;
+
+    if (!RadioTaskHandle && RadioSemaphore && (pdTRUE == xSemaphoreTakeRecursive (RadioSemaphore, 0)))
+    {
+        sampleAudioPeak (millis (), true);
+        FmRadio.pollRDS ();
+        xSemaphoreGiveRecursive (RadioSemaphore);
+    }
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// pollDynamicPs(): Radio task. Send the next dynamic PS frame when it is due. Frames are timed
+// from when the previous one was due, not from when it was sent, so the cadence does not drift.
+void cQN8027RadioApi::pollDynamicPs (uint32_t now)
+{
+    // _ DEBUG_START;
+
+    if (PsFrames.Count () && (int32_t (now - NextPsFrameTime) >= 0))
+    {
+        FmRadio.sendStationName (PsFrames.Next ());
+        NextPsFrameTime += PsFrameTimeMs;
+
+        if (int32_t (now - NextPsFrameTime) >= 0)
+        {
+            // Fell more than a frame behind. Start the timing over.
+            NextPsFrameTime = now + PsFrameTimeMs;
+        }
+    }
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// queueRdsGroup(): Add one packed RDS group to the chip's transmit queue. From another task only
+// the newest group waiting for the radio task is kept.
+void cQN8027RadioApi::queueRdsGroup (const uint8_t (&Group)[RDS_GROUP_SIZE], bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    if (UseRadioTask ())
+    {
+        RdsGroup_t Entry;
+        memcpy (Entry.Group, Group, RDS_GROUP_SIZE);
+        RdsGroupSlot.put (Entry);
+        xTaskNotifyGive (RadioTaskHandle);
+    }
+    else if (RadioSemaphore)
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        FmRadio.queueRDSGroup (Group);
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// sendClockTime(): Send a 4A clock time group for UTC minute UtcTime. It goes out ahead of the
+// PS / RadioText groups already queued, so call it right at the minute boundary.
+void cQN8027RadioApi::sendClockTime (time_t UtcTime, int8_t LocalOffsetHalfHours, bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    if (UseRadioTask ())
+    {
+        ClockTimeSlot.put ({UtcTime, LocalOffsetHalfHours});
+        xTaskNotifyGive (RadioTaskHandle);
+    }
+    else if (RadioSemaphore)
+    {
+        struct tm UtcTm;
+        gmtime_r (&UtcTime, &UtcTm);
+        uint32_t Mjd = cRdsEncoder::ModifiedJulianDay (uint16_t (UtcTm.tm_year + 1900), uint8_t (UtcTm.tm_mon + 1), uint8_t (UtcTm.tm_mday));
+
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        FmRadio.sendClockTime (Mjd, uint8_t (UtcTm.tm_hour), uint8_t (UtcTm.tm_min), LocalOffsetHalfHours);
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// RadioTask(): The only task that talks to the QN8027 once begin() is done. Runs queued
+// commands in the order they were posted and keeps the RDS transmitter fed.
+void cQN8027RadioApi::RadioTask (void * pvParameters)
+{
+    cQN8027RadioApi     * pThis = static_cast <cQN8027RadioApi *>(pvParameters);
+    RadioCommand_t      Command;
+
+    for (;;)
+    {
+        // Wake up on a new command or when the RDS transmitter needs attention.
+        ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (RADIO_TASK_TICK_MS));
+
+        while (pThis->CommandQueue.pop (Command))
+        {
+            pThis->ExecuteCommand (Command);
+            ++pThis->CommandsExecuted;
+        }
+
+        pThis->TakeRdsContent ();
+
+        xSemaphoreTakeRecursive (pThis->RadioSemaphore, portMAX_DELAY);
+        pThis->sampleAudioPeak (millis (), true);
+        pThis->pollDynamicPs (millis ());
+        pThis->FmRadio.pollRDS ();
+        xSemaphoreGiveRecursive (pThis->RadioSemaphore);
+    }
+}
+
+// *********************************************************************************************
+// RunOnRadioTask(): Hand a call over to the radio task. Returns false if the caller should run
+// the call itself (no radio task yet, or the caller is the radio task). Otherwise the call is never
+// run by the caller: that would reorder it against the queued commands and the radio task may be in
+// the middle of a beginUpdate() / commit() transaction. When the queue is full the caller waits up to
+// RADIO_COMMAND_WAIT_MS for space, then the command is dropped and counted.
+bool cQN8027RadioApi::RunOnRadioTask (RadioCommand_e Command, uint32_t Value, bool Carrier, const void * Text, size_t TextLength)
+{
+    bool Response = false;
+
+    do  // once
+    {
+        if (!UseRadioTask ())
+        {
+            break;
+        }
+
+        Response = true;
+
+        RadioCommand_t NewCommand;
+        NewCommand.Command  = Command;
+        NewCommand.Carrier  = Carrier;
+        NewCommand.Value    = Value;
+        TextLength          = std::min (TextLength, sizeof (NewCommand.Text) - 1);
+        memcpy (NewCommand.Text, Text, TextLength);
+        NewCommand.Text[TextLength] = 0x00;
+
+        uint32_t    StartTime   = millis ();
+        bool        Queued      = false;
+
+        while (!(Queued = CommandQueue.push (NewCommand)))
+        {
+            if ((millis () - StartTime) >= RADIO_COMMAND_WAIT_MS)
+            {
+                break;
+            }
+
+            xTaskNotifyGive (RadioTaskHandle);
+            vTaskDelay (pdMS_TO_TICKS (RADIO_TASK_TICK_MS));
+        }
+
+        if (!Queued)
+        {
+            ++CommandsDropped;
+            Log.errorln (F ("Radio command queue is full, command %d dropped."), Command);
+            break;
+        }
+
+        xTaskNotifyGive (RadioTaskHandle);
+    } while (false);
+
+    return Response;
+}
+
+// *********************************************************************************************
+// UseRadioTask(): True once the radio task runs and the caller is some other task.
+bool cQN8027RadioApi::UseRadioTask ()
+{
+    return (NULL != RadioTaskHandle) && (xTaskGetCurrentTaskHandle () != RadioTaskHandle);
+}
+
+// *********************************************************************************************
+// ExecuteCommand(): Radio task side of RunOnRadioTask().
+void cQN8027RadioApi::ExecuteCommand (RadioCommand_t & Command)
+{
+    // DEBUG_START;
+
+    switch (Command.Command)
+    {
+        case CmdBeginUpdate:
+        {
+            beginUpdate ();
+            break;
+        }
+
+        case CmdCommit:
+        {
+            commit ();
+            break;
+        }
+
+        case CmdRecalibrate:
+        {
+            recalibrate ();
+            break;
+        }
+
+        case CmdSetAfList:
+        {
+            setAfList (reinterpret_cast <const uint8_t *>(Command.Text), uint8_t (Command.Value));
+            break;
+        }
+
+        case CmdSetAudioImpedance:
+        {
+            setAudioImpedance (uint8_t (Command.Value));
+            break;
+        }
+
+        case CmdSetAudioMute:
+        {
+            setAudioMute (0 != Command.Value);
+            break;
+        }
+
+        case CmdSetDigitalGain:
+        {
+            setDigitalGain (uint8_t (Command.Value));
+            break;
+        }
+
+        case CmdSetDynamicPs:
+        {
+            setDynamicPs (String (Command.Text), uint16_t (Command.Value));
+            break;
+        }
+
+        case CmdSetFrequency:
+        {
+            setFrequency (float(Command.Value) / 100.0F, Command.Carrier);
+            break;
+        }
+
+        case CmdSetMonoAudio:
+        {
+            setMonoAudio (0 != Command.Value);
+            break;
+        }
+
+        case CmdSetPreEmphasis:
+        {
+            setPreEmphasis (uint8_t (Command.Value), Command.Carrier);
+            break;
+        }
+
+        case CmdSetProgramServiceName:
+        {
+            setProgramServiceName (String (Command.Text), Command.Carrier);
+            break;
+        }
+
+        case CmdSetPiCode:
+        {
+            setPiCode (uint16_t (Command.Value), Command.Carrier);
+            break;
+        }
+
+        case CmdSetPtyCode:
+        {
+            setPtyCode (uint8_t (Command.Value), Command.Carrier);
+            break;
+        }
+
+        case CmdSetRfAutoOff:
+        {
+            setRfAutoOff (0 != Command.Value, Command.Carrier);
+            break;
+        }
+
+        case CmdSetRfCarrier:
+        {
+            setRfCarrier (0 != Command.Value);
+            break;
+        }
+
+        case CmdSetRfPower:
+        {
+            setRfPower (uint8_t (Command.Value), Command.Carrier);
+            break;
+        }
+
+        case CmdSetVgaGain:
+        {
+            setVgaGain (uint8_t (Command.Value));
+            break;
+        }
+
+        default:
+        {
+            Log.errorln (F ("Unknown radio command %d."), Command.Command);
+            break;
+        }
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// TakeRdsContent(): Radio task. Send the RDS content other tasks left in the slots. RT+ tags go
+// with the message they were set for.
+void cQN8027RadioApi::TakeRdsContent ()
+{
+    // _ DEBUG_START;
+
+    RdsMessage_t    Message;
+    ClockTime_t     ClockTime;
+    RdsGroup_t      Group;
+
+    if (ClockTimeSlot.take (ClockTime))
+    {
+        sendClockTime (ClockTime.UtcTime, ClockTime.LocalOffsetHalfHours);
+    }
+
+    if (RdsMessageSlot.take (Message))
+    {
+        String Text (Message.Text);
+        setRtPlusTags (Message.Tags);
+        setRdsMessage (Text);
+    }
+
+    if (RdsGroupSlot.take (Group))
+    {
+        queueRdsGroup (Group.Group);
+    }
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+// beginUpdate(): Start collecting radio changes. Register writes are held in the register shadow and
+// carrier off/on requests are merged. Nothing reaches the chip until the matching commit().
+// Transactions nest. The radio stays locked to the calling task until the outermost commit().
+void cQN8027RadioApi::beginUpdate (bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    if (RunOnRadioTask (CmdBeginUpdate))
+    {
+        return;
+    }
+
+    if (RadioSemaphore)
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+
+        if (0 == UpdateDepth++)
+        {
+            PendingCarrierCycle = false;
+            PendingCarrierSet   = false;
+            PendingCarrier      = (0 != FmRadio.radioStatus);
+            FmRadio.setDeferredWrites (true);
+        }
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// commit(): Apply everything collected since beginUpdate() with at most one carrier off/on cycle.
+void cQN8027RadioApi::commit (bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    if (RunOnRadioTask (CmdCommit))
+    {
+        return;
+    }
+
+    if (RadioSemaphore && UpdateDepth)
+    {
+        if (0 == --UpdateDepth)
+        {
+            if (PendingCarrierCycle)
+            {
+                // SYSTEM_REG is the first register flushed, so the carrier is off before anything else changes.
+                FmRadio.Switch (OFF);
+            }
+
+            FmRadio.setDeferredWrites (false);
+            waitForIdle (100, true);
+
+            if (PendingCarrierCycle || PendingCarrierSet)
+            {
+                FmRadio.Switch (PendingCarrier ? ON : OFF);
+                waitForIdle (100, true);
+            }
+        }
+
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// getPaVoltageBand(): RF PA supply voltage rounded to whole volts. Part of the calibration fingerprint.
+uint8_t cQN8027RadioApi::getPaVoltageBand ()
+{
+    // DEBUG_START;
+
+    RfPaVoltage.begin ();   // Radio starts before the UI, make sure the ADC is running.
+    uint8_t Response = uint8_t (RfPaVoltage.GetVoltage () + 0.5F);
+
+    // DEBUG_END;
+    return Response;
+}
+
+// *********************************************************************************************
+// loadCalibration(): Read the saved antenna calibration. On exit, true if a complete entry was found.
+bool cQN8027RadioApi::loadCalibration ()
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do  // once
+    {
+        File file = LittleFS.open (RADIO_CAL_FILE_NAME, FILE_READ);
+
+        if (!file)
+        {
+            Log.verboseln (F ("-> No Saved QN8027 Calibration."));
+            break;
         }
-        else
+
+        DynamicJsonDocument     doc (CAL_JSON_SIZE);
+        DeserializationError    error = deserializeJson (doc, file);
+        file.close ();
+
+        if (error)
         {
-            Response = true;
-            Log.infoln (F ("-> QN8027 RF Port Matching OK, Calibration Successful."));
+            Log.errorln (F ("-> Saved QN8027 Calibration is Unreadable, Error:%s."), error.c_str ());
+            break;
         }
 
-        /*
-          *    radio.setFrequency(103.0F); // Recalibrate at middle FM range.
-          *    waitForIdle(50, true);
-          *    radio.Switch(OFF);
-          *    waitForIdle(15, true);
-          *    radio.Switch(ON);
-          *    waitForIdle(50, true);
-          */
+        JsonObject root = doc.as <JsonObject>();
 
-        FmRadio.reCalibrate ();
-        waitForIdle (120, true);
+        if (!root.containsKey (N_Cid1) || !root.containsKey (N_Cid2) || !root.containsKey (N_PaBand) ||
+            !root.containsKey (N_AntHigh) || !root.containsKey (N_AntLow) || !root.containsKey (N_Frequency))
+        {
+            Log.errorln (F ("-> Saved QN8027 Calibration is Incomplete."));
+            break;
+        }
 
-        setRfCarrierOFF (true);
-        waitForIdle (50, true);
+        ReadFromJSON (Calibration.Cid1,         root,   N_Cid1);
+        ReadFromJSON (Calibration.Cid2,         root,   N_Cid2);
+        ReadFromJSON (Calibration.PaBand,       root,   N_PaBand);
+        ReadFromJSON (Calibration.AntHigh,      root,   N_AntHigh);
+        ReadFromJSON (Calibration.AntLow,       root,   N_AntLow);
+        ReadFromJSON (Calibration.Frequency,    root,   N_Frequency);
 
-        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-    }
+        Response = true;
+    } while (false);
 
     // DEBUG_END;
     return Response;
 }
 
 // *********************************************************************************************
-//
-// checkRadioIsPresent(): Check to see if QN8027 FM Radio Chip is installed. Return true if Ok.
-bool cQN8027RadioApi::checkRadioIsPresent (bool SkipSemaphore)
+// recalibrate(): Forced full antenna calibration (UI button / "recal" command).
+// The saved calibration is replaced. Frequency and carrier state are restored afterwards.
+// When called from another task the calibration is queued and true means "started".
+bool cQN8027RadioApi::recalibrate (bool SkipSemaphore)
 {
     // DEBUG_START;
 
-    bool response = false;
+    bool Response = false;
 
-    if (RadioSemaphore)
+    if (RunOnRadioTask (CmdRecalibrate))
+    {
+        // Runs in the background. The result shows up in GetTestStatus().
+        Response = true;
+    }
+    else if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-        Wire.beginTransmission (QN8027_I2C_ADDR);
+        float   frequency   = FmRadio.getFrequency ();
+        bool    carrier     = (0 != FmRadio.radioStatus);
 
-        if (Wire.endTransmission (true) == 0)
-        {
-            // Receive 0 = success (ACK response)
-            response = true;
-        }
+        Log.infoln (F ("Recalibrating QN8027 RF Port ..."));
+        LittleFS.remove (RADIO_CAL_FILE_NAME);
+        Response = runCalibration (true);
+
+        setFrequency (frequency, carrier, true);
 
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
     // DEBUG_END;
-    return response;
+    return Response;
 }
 
 // *********************************************************************************************
-// initRadioChip(); Initialize the QN8027 FM Radio Chip. Returns Test Result Code.
-void cQN8027RadioApi::initRadioChip (bool SkipSemaphore)
+// runCalibration(): Full antenna calibration with retries. A good result is saved.
+bool cQN8027RadioApi::runCalibration (bool SkipSemaphore)
 {
     // DEBUG_START;
 
-    uint8_t regVal;
-
-    Log.infoln (String (F ("Initializing QN8027 FM Radio Chip ...")).c_str ());
+    TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-    do  // once
+    for (uint8_t i = 0;i < RADIO_CAL_RETRY;i++)
     {
-        regVal = FmRadio.read1Byte (CID1_REG);
-
-        if ((regVal == 0x00) || ((regVal & 0x0C) != 0x00))
+        // Allow several attempts to get good port matching results.
+        if (calibrateAntenna (true))
         {
-            Log.errorln (F ("-> Incorrect CID1 Chip Family ID: 0x%02X"), regVal);
-            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_MISSING;
+            // QN8027 RF Port Matching OK, exit.
+            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_OK;
+            saveCalibration ();
             break;
         }
 
-        Log.verboseln (String (F ("-> CID1 Chip Family ID: 0x%02X")).c_str (), regVal);
-
-        regVal = FmRadio.read1Byte (CID2_REG);
+        TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_VSWR;
 
-        if ((regVal & 0xF0) != 0x40)
+        if (i < RADIO_CAL_RETRY - 1)
         {
-            Log.errorln (F ("-> Incorrect CID2 Version: 0x%02X"), regVal);
-            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_MISSING;
-            break;
+            Log.infoln (F ("-> Retesting QN8027 RF Port Matching, Retry #%d"), i + 1);
         }
+    }
 
-        Log.verboseln (F ("-> CID2 Chip Version: 0x%02X"), regVal);
+    GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-        FmRadio.reset ();
-        delay (30);
+    // DEBUG_END;
+    return QN8027RadioFmTestStatus_e::FM_TEST_OK == TestStatus;
+}
 
-        FmRadio.setClockSource (0x00);          // XTAL on pins 1 & 2.
-        FmRadio.setCrystalFreq (12);
-        FmRadio.setCrystalCurrent (30);         // 30% of 400uA Max = 120uA.
-        FmRadio.setTxFreqDeviation (0x81);      // 75Khz, Total Broadcast channel Bandwidth
-        FmRadio.setTxPilotFreqDeviation (9);    // Use default 9% (6.75KHz) Pilot Tone Deviation.
-        FmRadio.setTxPower (RfPower.get32 ());
-        waitForIdle (25, true);
+// *********************************************************************************************
+// saveCalibration(): Save the antenna calibration together with the hardware fingerprint.
+void cQN8027RadioApi::saveCalibration ()
+{
+    // DEBUG_START;
 
-        for (uint8_t i = 0;i < RADIO_CAL_RETRY;i++)
-        {
-            // Allow several attempts to get good port matching results.
-            if (calibrateAntenna ())
-            {
-                // QN8027 RF Port Matching OK, exit.
-                TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_OK;
-                break;
-            }
+    Calibration.Cid1    = ChipCid1;
+    Calibration.Cid2    = ChipCid2;
+    Calibration.PaBand  = getPaVoltageBand ();
 
-            TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_VSWR;
+    DynamicJsonDocument doc (CAL_JSON_SIZE);
+    JsonObject          root = doc.to <JsonObject>();
 
-            if (i < RADIO_CAL_RETRY - 1)
-            {
-                Log.infoln (F ("-> Retesting QN8027 RF Port Matching, Retry #%d"), i + 1);
-            }
-        }
+    root[N_Cid1]        = Calibration.Cid1;
+    root[N_Cid2]        = Calibration.Cid2;
+    root[N_PaBand]      = Calibration.PaBand;
+    root[N_AntHigh]     = Calibration.AntHigh;
+    root[N_AntLow]      = Calibration.AntLow;
+    root[N_Frequency]   = Calibration.Frequency;
 
-        waitForIdle (50, true);
+    LittleFS.remove (RADIO_CAL_FILE_NAME);
+    File file = LittleFS.open (RADIO_CAL_FILE_NAME, FILE_WRITE);
 
-        FmRadio.scrambleAudio (OFF);
-        delay (5);
+    if (!file)
+    {
+        Log.errorln (F ("-> Failed to create QN8027 Calibration File."));
+    }
+    else
+    {
+        if (serializeJson (root, file) == 0)
+        {
+            Log.errorln (F ("-> Failed to write QN8027 Calibration File."));
+        }
 
-        FmRadio.clearAudioPeak ();
-        delay (5);
+        file.close ();
+    }
 
-        FmRadio.mute (true);
-        delay (5);
+    // DEBUG_END;
+}
 
-        FmRadio.setRDSFreqDeviation (10);   // RDS Freq Deviation = 0.35KHz * Value.
-        delay (1);
-        FmRadio.RDS (ON);
-        waitForIdle (20, true);
+// *********************************************************************************************
+// verifyCalibration(): Fast boot check. If the chip and PA supply match the saved calibration,
+// a single recalibration at the saved frequency is compared with the saved ANT_REG value.
+// On exit, true if the saved calibration is still good and the full sweep can be skipped.
+bool cQN8027RadioApi::verifyCalibration (bool SkipSemaphore)
+{
+    // DEBUG_START;
 
-        FmRadio.updateSYSTEM_REG ();    // This is needed to Start FM Broadcast.
-        waitForIdle (20, true);
-        FmRadio.clearAudioPeak ();
-        delay (1);
+    bool Response = false;
 
-        Log.infoln (F ("-> Radio Status: %02X"), (FmRadio.getStatus () & 0x07));
-    } while (false);
+    TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-    if (QN8027RadioFmTestStatus_e::FM_TEST_OK == TestStatus)
-    {
-        Log.infoln (F ("-> QN8027 Initialization Complete."));
-    }
-    else
+    do  // once
     {
-        Log.errorln (F ("-> QN8027 Failed Initialization."));
-    }
+        if (!loadCalibration ())
+        {
+            break;
+        }
 
-    /*
-      *     // DEBUG ONLY.
-      *     for (int i = 0; i <= 0x1F; i++) {
-      *         Log.infoln(F( "Radio Register %02X is: %02X"), i, radio.read1Byte(i));
-      *     }
-      */
+        uint8_t PaBand = getPaVoltageBand ();
+
+        if ((Calibration.Cid1 != ChipCid1) || (Calibration.Cid2 != ChipCid2) || (Calibration.PaBand != PaBand))
+        {
+            Log.infoln (F ("-> QN8027 Hardware Changed (CID1=0x%02X, CID2=0x%02X, PA=%dV), Full Calibration Needed."), ChipCid1, ChipCid2, PaBand);
+            break;
+        }
+
+        setFrequency (Calibration.Frequency, true, true);
+        FmRadio.reCalibrate ();
+        waitForIdle (120, true);
+        uint8_t regVal = FmRadio.read1Byte (ANT_REG);
+        setRfCarrierOFF (true);
+
+        if (abs (int(regVal) - int(Calibration.AntLow)) > RADIO_CAL_TOLERANCE)
+        {
+            Log.infoln (F ("-> QN8027 RF Port Changed (0x%02X, saved 0x%02X), Full Calibration Needed."), regVal, Calibration.AntLow);
+            break;
+        }
+
+        Log.infoln (F ("-> QN8027 RF Port Matches Saved Calibration (0x%02X)."), regVal);
+        Response = true;
+    } while (false);
+
+    GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
     // DEBUG_END;
+    return Response;
 }
 
 // *********************************************************************************************
-// measureAudioLevel(): Measure the Peak Audio Level. Max 675mV.
-uint16_t cQN8027RadioApi::GetPeakAudioLevel (bool SkipSemaphore)
+// setAfList(): Alternative Frequency codes (see cRdsEncoder::AfCode()) sent in the 0A groups.
+void cQN8027RadioApi::setAfList (const uint8_t * Codes, uint8_t Count, bool SkipSemaphore)
 {
     // DEBUG_START;
 
-    uint16_t mV = 0;
+    Count = (Count > RDS_AF_MAX_COUNT) ? RDS_AF_MAX_COUNT : Count;
 
+    if (RunOnRadioTask (CmdSetAfList, Count, false, Codes, Count))
+    {
+        return;
+    }
 
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-
-        waitForIdle (100, true);
-        mV = FmRadio.getStatus () >> 4;
-        FmRadio.clearAudioPeak ();
-
+        FmRadio.setAfList (Codes, Count);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
     // DEBUG_END;
-    return mV * 45;  // Audio Peak is 45mV per count.
 }
 
 // *********************************************************************************************
@@ -305,6 +1031,11 @@ void cQN8027RadioApi::setAudioImpedance (uint8_t value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetAudioImpedance, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
@@ -323,6 +1054,11 @@ void cQN8027RadioApi::setAudioMute (bool value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetAudioMute, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
@@ -341,6 +1077,11 @@ void cQN8027RadioApi::setDigitalGain (uint8_t value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetDigitalGain, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
@@ -353,18 +1094,53 @@ void cQN8027RadioApi::setDigitalGain (uint8_t value, bool SkipSemaphore)
     // DEBUG_END;
 }
 
+// *********************************************************************************************
+// setDynamicPs(): Page value through the PS, one 8 character frame every FrameTimeMs. Frames go
+// out through the RDS group queue, the carrier is left alone. An empty value restores the static PS.
+void cQN8027RadioApi::setDynamicPs (const String & value, uint16_t FrameTimeMs, bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    if (RunOnRadioTask (CmdSetDynamicPs, FrameTimeMs, false, value.c_str (), value.length ()))
+    {
+        return;
+    }
+
+    // Before begin() this only records the frames. The radio task starts sending them.
+    bool WasDynamic = (0 != PsFrames.Count ());
+    PsFrames.Build (value.c_str ());
+    PsFrameTimeMs   = FrameTimeMs;
+    NextPsFrameTime = millis ();
+
+    if (RadioSemaphore && WasDynamic && (0 == PsFrames.Count ()))
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        FmRadio.sendStationName (StaticPsName);
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
 // *********************************************************************************************
 // setFrequency(): Set the Radio Frequency on the QN8027.
 void cQN8027RadioApi::setFrequency (float frequency, bool Carrier, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetFrequency, uint32_t ((frequency * 100.0F) + 0.5F), Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         setRfCarrierOFF (true);
         FmRadio.setFrequency (frequency);
         setRfCarrier (Carrier, true);
+        commit (true);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -377,6 +1153,11 @@ void cQN8027RadioApi::setMonoAudio (bool value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetMonoAudio, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
@@ -394,12 +1175,19 @@ void cQN8027RadioApi::setPiCode (uint16_t value, bool Carrier, bool SkipSemaphor
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetPiCode, value, Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         setRfCarrierOFF (true);
         FmRadio.setPiCode (value);
         setRfCarrier (Carrier, true);
+        commit (true);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -413,12 +1201,19 @@ void cQN8027RadioApi::setPreEmphasis (uint8_t value, bool Carrier, bool SkipSema
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetPreEmphasis, value, Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         setRfCarrierOFF (true);
         FmRadio.setPreEmphTime50 (value);
         setRfCarrier (Carrier, true);
+        commit (true);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -426,16 +1221,28 @@ void cQN8027RadioApi::setPreEmphasis (uint8_t value, bool Carrier, bool SkipSema
 }
 
 // *********************************************************************************************
+// setProgramServiceName(): The static PS goes out through the RDS group queue like the dynamic
+// PS frames, the carrier is left alone. While a dynamic PS runs this only records the name.
 void cQN8027RadioApi::setProgramServiceName (const String & value, bool Carrier, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetProgramServiceName, 0, Carrier, value.c_str (), value.length ()))
+    {
+        return;
+    }
+
+    strncpy (StaticPsName, value.c_str (), PSN_SIZE);
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-        setRfCarrierOFF (true);
-        FmRadio.sendStationName (value);
-        setRfCarrier (Carrier, true);
+
+        if (0 == PsFrames.Count ())
+        {
+            FmRadio.sendStationName (StaticPsName);
+        }
+
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -447,12 +1254,19 @@ void cQN8027RadioApi::setPtyCode (uint8_t value, bool Carrier, bool SkipSemaphor
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetPtyCode, value, Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         setRfCarrierOFF (true);
         FmRadio.setPtyCode (value);
         setRfCarrier (Carrier, true);
+        commit (true);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -464,12 +1278,21 @@ void cQN8027RadioApi::setRdsMessage (String & value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
-    if (RadioSemaphore)
+    if (UseRadioTask ())
+    {
+        RdsMessage_t    Message;
+        size_t          Length = std::min (size_t (value.length ()), sizeof (Message.Text) - 1);
+
+        memcpy (Message.Text, value.c_str (), Length);
+        Message.Text[Length]    = 0x00;
+        Message.Tags            = RtPlusTagsSlot.get ();
+        RdsMessageSlot.put (Message);
+        xTaskNotifyGive (RadioTaskHandle);
+    }
+    else if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-        waitForIdle (100, true);
-        FmRadio.sendRadioText (value);
-        waitForIdle (100, true);
+        FmRadio.sendRadioText (value);  // Queued. Sent by Poll().
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -485,12 +1308,19 @@ void cQN8027RadioApi::setRfAutoOff (bool value, bool Carrier, bool SkipSemaphore
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetRfAutoOff, value, Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         setRfCarrierOFF (true);
         FmRadio.radioNoAudioAutoOFF (value ? ON : OFF);
         setRfCarrier (Carrier, true);
+        commit (true);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -515,12 +1345,29 @@ void cQN8027RadioApi::setRfCarrier (bool value, bool SkipSemaphore)
     // DEBUG_START;
     // DEBUG_V(String("value: ") + String(value));
 
+    if (RunOnRadioTask (CmdSetRfCarrier, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
-        waitForIdle (100, true);
-        FmRadio.Switch (value ? ON : OFF);  // Update QN8027 Carrier.
-        waitForIdle (100, true);
+
+        if (UpdateDepth)
+        {
+            // Applied by commit().
+            PendingCarrierCycle |= !value;
+            PendingCarrierSet   = value;
+            PendingCarrier      = value;
+        }
+        else
+        {
+            waitForIdle (100, true);
+            FmRadio.Switch (value ? ON : OFF);  // Update QN8027 Carrier.
+            waitForIdle (100, true);
+        }
+
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -534,9 +1381,15 @@ void cQN8027RadioApi::setRfPower (uint8_t value, bool Carrier, bool SkipSemaphor
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetRfPower, value, Carrier))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        beginUpdate (true);
         waitForIdle (100, true);
         FmRadio.setTxPower (value);
         waitForIdle (100, true);
@@ -547,6 +1400,25 @@ void cQN8027RadioApi::setRfPower (uint8_t value, bool Carrier, bool SkipSemaphor
             setRfCarrier (Carrier, true);
         }
 
+        commit (true);
+        GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// setRtPlusTags(): RT+ tags for the next setRdsMessage(). Empty tags turn RT+ off.
+void cQN8027RadioApi::setRtPlusTags (const cRdsEncoder::RtPlusTags_t & Tags, bool SkipSemaphore)
+{
+    // DEBUG_START;
+
+    RtPlusTagsSlot.put (Tags);
+
+    if (!UseRadioTask () && RadioSemaphore)
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
+        FmRadio.setRtPlusTags (Tags);
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
@@ -559,6 +1431,11 @@ void cQN8027RadioApi::setVgaGain (uint8_t value, bool SkipSemaphore)
 {
     // DEBUG_START;
 
+    if (RunOnRadioTask (CmdSetVgaGain, value))
+    {
+        return;
+    }
+
     if (RadioSemaphore)
     {
         TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
@@ -573,55 +1450,44 @@ void cQN8027RadioApi::setVgaGain (uint8_t value, bool SkipSemaphore)
 
 // *********************************************************************************************
 // waitForIdle(): Wait for QN8027 to enter Idle State. This means register command has executed.
+// Also returns as soon as the chip leaves the state it was in when we started waiting.
 void cQN8027RadioApi::waitForIdle (uint16_t waitMs, bool SkipSemaphore)
 {
     // DEBUG_START;
-    if (RadioSemaphore)
-    {
-        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-        uint8_t stateCode1;
-        uint8_t stateCode2;
+    waitForState (FSM_MASK_IDLE | FSM_MASK_TRANSMIT, waitMs, true, SkipSemaphore);
 
-        do  // once
-        {
-            stateCode1 = FmRadio.getStatus () & 0x07;
-            // DEBUG_V(String("stateCode1: 0x") + String(stateCode1, HEX));
+    // DEBUG_END;
+}
 
-            // make sure the delay is a minimum of 5ms
-            if (5 > waitMs)
-            {
-                waitMs = 5;
-            }
+// *********************************************************************************************
+// waitForState(): Wait up to waitMs for the QN8027 FSM to reach one of the states in StateMask.
+// See QN8027Radio::waitForFsmState(). Nothing is tested until FSM_SETTLE_MS has passed (the minimum
+// wait the driver has always had).
+// Returns true if a state in StateMask was reached. Inside a transaction nothing has been sent to
+// the chip yet, so there is nothing to wait for.
+bool cQN8027RadioApi::waitForState (uint8_t StateMask, uint16_t waitMs, bool ExitOnChange, bool SkipSemaphore)
+{
+    // DEBUG_START;
 
-            do
-            {
-                waitMs -= 5;
+    bool Response = (0 != UpdateDepth);
 
-                delay (5);
+    if (RadioSemaphore && !UpdateDepth)
+    {
+        TAKE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
 
-                stateCode2 = FmRadio.getStatus () & 0x07;
-                // DEBUG_V(String("stateCode2: 0x") + String(stateCode2, HEX));
+        uint32_t StartTime = millis ();
 
-                if ((stateCode2 == 0x02) || (stateCode2 == 0x05))
-                {
-                    // we are idle
-                    break;
-                }
-                else if (stateCode1 != stateCode2)
-                {
-                    FmRadio.getStatus ();   // Clear next status byte.
-                    break;
-                }
-            } while (5 <= waitMs);
-        } while (false);
+        Response = FmRadio.waitForFsmState (StateMask, waitMs, FSM_SETTLE_MS, ExitOnChange);
 
-        // DEBUG_V(String("waitForIdle End Status is: 0x") + String(FmRadio.getStatus() & 0x07, HEX));
+        ++WaitCount;
+        WaitTimeMs += millis () - StartTime;
 
         GIVE_SEMAPHORE (RadioSemaphore, SkipSemaphore);
     }
 
     // DEBUG_END;
+    return Response;
 }
 
 // *********************************************************************************************
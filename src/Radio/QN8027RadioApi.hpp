@@ -15,7 +15,12 @@
 
 // *********************************************************************************************
 #include "QN8027Radio.h"
+#include "AudioLevel.hpp"
+#include "RdsPsFrames.hpp"
+#include "LatestValue.hpp"
+#include "MpscQueue.hpp"
 #include <Arduino.h>
+#include <atomic>
 
 // *********************************************************************************************
 class cQN8027RadioApi
@@ -26,10 +31,21 @@ public:
     virtual~cQN8027RadioApi ()    {}
 
     void        begin ();
-    uint16_t    GetPeakAudioLevel (bool SkipSemaphore                                           = false);
+    void        Poll ();
+    void        beginUpdate (bool SkipSemaphore                                                 = false);
+    void        commit (bool SkipSemaphore                                                      = false);
+    bool        recalibrate (bool SkipSemaphore                                                 = false);
+    void        GetAudioLevel (cAudioLevel::Snapshot_t & Snapshot);
+    uint16_t    GetPeakAudioLevel ();
+    void        setPeakSampleRate (uint8_t RateHz);
+    uint8_t     getPeakSampleRate ()    {return uint8_t (1000 / PeakSampleIntervalMs);}
+    void        queueRdsGroup (const uint8_t (&Group)[RDS_GROUP_SIZE], bool SkipSemaphore      = false);
+    void        sendClockTime (time_t UtcTime, int8_t LocalOffsetHalfHours, bool SkipSemaphore  = false);
+    void        setAfList (const uint8_t * Codes, uint8_t Count, bool SkipSemaphore            = false);
     void        setAudioImpedance (uint8_t value, bool SkipSemaphore                            = false);
     void        setAudioMute (bool value, bool SkipSemaphore                                    = false);
     void        setDigitalGain (uint8_t value, bool SkipSemaphore                               = false);
+    void        setDynamicPs (const String & value, uint16_t FrameTimeMs, bool SkipSemaphore    = false);
     void        setFrequency (float frequency, bool Carrier, bool SkipSemaphore                 = false);
     void        setMonoAudio (bool value, bool SkipSemaphore                                    = false);
     void        setPreEmphasis (uint8_t value, bool carrier, bool SkipSemaphore                 = false);
@@ -38,6 +54,7 @@ public:
     void        setPtyCode (uint8_t value, bool carrier, bool SkipSemaphore                     = false);
     void        setRdsMessage (String & value, bool SkipSemaphore                               = false);
     void        setRfAutoOff (bool value, bool carrier, bool SkipSemaphore                      = false);
+    void        setRtPlusTags (const cRdsEncoder::RtPlusTags_t & Tags, bool SkipSemaphore        = false);
     void        setRfCarrierOFF (bool SkipSemaphore                                             = false);
     void        setRfCarrier (bool value, bool SkipSemaphore                                    = false);
     void        setRfPower (uint8_t value, bool carrier, bool SkipSemaphore                     = false);
@@ -51,20 +68,136 @@ public:
         FM_TEST_MISSING,    // QN8027 Chip missing.
         FM_TEST_FAIL        // QN8027 Chip Bad.
     } QN8027RadioFmTestStatus_e;
-    QN8027RadioFmTestStatus_e GetTestStatus () {return TestStatus;}
+    QN8027RadioFmTestStatus_e GetTestStatus () {return TestStatus.load ();}
+
+    // FSM states for waitForState(), bit N == FSM state N.
+    static const uint8_t    FSM_MASK_IDLE       = (1 << FSM_STATE_IDLE);
+    static const uint8_t    FSM_MASK_TRANSMIT   = (1 << FSM_STATE_TRANSMIT);
+
+    uint32_t    WaitCount   = 0;    // waitForState() statistics.
+    uint32_t    WaitTimeMs  = 0;
+
+    // Radio task statistics
+    std::atomic <uint32_t>  CommandsExecuted    {0};
+    std::atomic <uint32_t>  CommandsDropped     {0};    // Queue stayed full for RADIO_COMMAND_WAIT_MS.
 
 private:
 
+    // Commands handed to the radio task. One per public API call.
+    enum RadioCommand_e : uint8_t
+    {
+        CmdBeginUpdate = 0,
+        CmdCommit,
+        CmdRecalibrate,
+        CmdSetAfList,
+        CmdSetAudioImpedance,
+        CmdSetAudioMute,
+        CmdSetDigitalGain,
+        CmdSetDynamicPs,
+        CmdSetFrequency,
+        CmdSetMonoAudio,
+        CmdSetPreEmphasis,
+        CmdSetProgramServiceName,
+        CmdSetPiCode,
+        CmdSetPtyCode,
+        CmdSetRfAutoOff,
+        CmdSetRfCarrier,
+        CmdSetRfPower,
+        CmdSetVgaGain,
+    };
+
+    struct RadioCommand_t
+    {
+        RadioCommand_e  Command;
+        bool            Carrier;
+        uint32_t        Value;                      // Frequency is sent in 10KHz units.
+        char            Text[RADIOTEXT_SIZE + 1];   // PS name, dynamic PS text or AF codes.
+    };
+
+    static void RadioTask (void * pvParameters);
+    bool        UseRadioTask ();
+    bool        RunOnRadioTask (RadioCommand_e Command, uint32_t Value = 0, bool Carrier = false, const void * Text = nullptr, size_t TextLength = 0);
+    void        ExecuteCommand (RadioCommand_t & Command);
+    void        TakeRdsContent ();
+
+    cMpscQueue <RadioCommand_t, 16> CommandQueue;
+    TaskHandle_t                    RadioTaskHandle = NULL;
+
+    // RDS content. Only the newest value matters, so other tasks leave it in a slot the radio task
+    // empties on every pass instead of queueing it behind the settings commands.
+    struct RdsMessage_t
+    {
+        char                        Text[RADIOTEXT_SIZE + 1];
+        cRdsEncoder::RtPlusTags_t   Tags;
+    };
+
+    struct ClockTime_t
+    {
+        time_t  UtcTime;
+        int8_t  LocalOffsetHalfHours;
+    };
+
+    struct RdsGroup_t
+    {
+        uint8_t Group[RDS_GROUP_SIZE];
+    };
+
+    cLatestValue <RdsMessage_t>                 RdsMessageSlot;
+    cLatestValue <cRdsEncoder::RtPlusTags_t>    RtPlusTagsSlot;     // Tags for the next setRdsMessage(). Read, never taken.
+    cLatestValue <ClockTime_t>                  ClockTimeSlot;
+    cLatestValue <RdsGroup_t>                   RdsGroupSlot;
+
+    // Audio peak sampler. Written by the radio task, read by everyone else.
+    void                sampleAudioPeak (uint32_t now, bool SkipSemaphore = false);
+    cAudioLevel         AudioLevel;
+    SemaphoreHandle_t   AudioLevelSemaphore     = NULL;
+    uint32_t            PeakSampleIntervalMs    = 50;
+    uint32_t            LastPeakSampleTime      = 0;
+
     bool    calibrateAntenna (bool SkipSemaphore                = false);
+    bool    runCalibration (bool SkipSemaphore                  = false);
+    bool    verifyCalibration (bool SkipSemaphore               = false);
+    bool    loadCalibration ();
+    void    saveCalibration ();
+    uint8_t getPaVoltageBand ();
     bool    checkRadioIsPresent (bool SkipSemaphore             = false);
     void    initRadioChip (bool SkipSemaphore                   = false);
     void    waitForIdle (uint16_t waitMs, bool SkipSemaphore    = false);
+    bool    waitForState (uint8_t StateMask, uint16_t waitMs, bool ExitOnChange, bool SkipSemaphore = false);
+    static const uint8_t FSM_SETTLE_MS = 5;     // The FSM may not have picked up a new command before this.
+
+    // Dynamic PS. The radio task steps through the frames, so the timing does not depend on loop().
+    void                pollDynamicPs (uint32_t now);
+    cRdsPsFrames        PsFrames;
+    uint32_t            PsFrameTimeMs       = 0;
+    uint32_t            NextPsFrameTime     = 0;
+    char                StaticPsName[PSN_SIZE + 1] = {0};  // Restored when dynamic PS is turned off.
+
+    // Configuration transaction (beginUpdate() / commit()).
+    uint8_t                     UpdateDepth             = 0;
+    bool                        PendingCarrierCycle     = false;    // A change inside the transaction needs the carrier turned off.
+    bool                        PendingCarrierSet       = false;
+    bool                        PendingCarrier          = false;    // Carrier state to restore at commit().
+
+    // Antenna calibration cache. Saved to RADIO_CAL_FILE_NAME after a good calibration.
+    struct RadioCalibration_t
+    {
+        uint8_t Cid1        = 0;
+        uint8_t Cid2        = 0;
+        uint8_t PaBand      = 0;    // PA supply voltage, rounded to whole volts.
+        uint8_t AntHigh     = 0;    // ANT_REG after calibrating at CAL_FREQ_HIGH.
+        uint8_t AntLow      = 0;    // ANT_REG after calibrating at CAL_FREQ_LOW.
+        float   Frequency   = 0.0;  // Frequency of the final calibration (AntLow).
+    };
+    RadioCalibration_t          Calibration;
+    uint8_t                     ChipCid1 = 0;
+    uint8_t                     ChipCid2 = 0;
 
     bool                        DeviceIsPresent = false;
     QN8027Radio                 FmRadio;
     SemaphoreHandle_t           RadioSemaphore = NULL;
 
-    QN8027RadioFmTestStatus_e   TestStatus = QN8027RadioFmTestStatus_e::FM_TEST_FAIL;
+    std::atomic <QN8027RadioFmTestStatus_e> TestStatus {QN8027RadioFmTestStatus_e::FM_TEST_FAIL};
 };  // class cQN8027RadioApi
 
 extern cQN8027RadioApi QN8027RadioApi;
@@ -0,0 +1,309 @@
+/*
+  *    File: RdsBitstream.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Block layout: | Information word (16) | Checkword + Offset word (10) |
+  *    Generator polynomial: g(x) = x^10 + x^8 + x^7 + x^5 + x^4 + x^3 + 1
+  */
+
+// *********************************************************************************************
+#include <string.h>
+#include "RdsBitstream.hpp"
+
+// *********************************************************************************************
+static const uint16_t   RDS_POLY        = 0x5B9;    // g(x), including the x^10 term.
+static const uint16_t   RDS_CHECK_MASK  = 0x3FF;
+
+// *********************************************************************************************
+// Checkword(): Remainder of Data * x^10 modulo g(x), plus the offset word.
+uint16_t cRdsBitstream::Checkword (uint16_t Data, uint16_t Offset)
+{
+    uint32_t Register = uint32_t (Data) << 10;
+
+    for (int bit = 25;bit >= 10;--bit)
+    {
+        if (Register & (1UL << bit))
+        {
+            Register ^= uint32_t (RDS_POLY) << (bit - 10);
+        }
+    }
+
+    return uint16_t ((Register ^ Offset) & RDS_CHECK_MASK);
+}
+
+// *********************************************************************************************
+uint32_t cRdsBitstream::EncodeBlock (uint16_t Data, uint16_t Offset)
+{
+    return (uint32_t (Data) << 10) | Checkword (Data, Offset);
+}
+
+// *********************************************************************************************
+void cRdsBitstream::EncodeGroup (const cRdsEncoder::RdsGroup_t & Group, RdsBits_t & Bits)
+{
+    // DEBUG_START;
+
+    uint16_t    Block2Value = uint16_t ((Group[2] << 8) | Group[3]);
+    uint16_t    Offsets[4]  = {Offset_A, Offset_B, (Block2Value & 0x0800) ? uint16_t (Offset_Cprime) : uint16_t (Offset_C), Offset_D};
+    size_t      BitIndex    = 0;
+
+    memset (Bits, 0x00, sizeof (Bits));
+
+    for (uint8_t block = 0;block < 4;++block)
+    {
+        uint32_t Coded = EncodeBlock (uint16_t ((Group[block * 2] << 8) | Group[block * 2 + 1]), Offsets[block]);
+
+        for (int bit = RDS_BLOCK_BITS - 1;bit >= 0;--bit, ++BitIndex)
+        {
+            if (Coded & (1UL << bit))
+            {
+                Bits[BitIndex >> 3] |= uint8_t (0x80 >> (BitIndex & 7));
+            }
+        }
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// DifferentialEncode(): Output bit = input bit XOR previous output bit.
+void cRdsBitstream::DifferentialEncode (uint8_t * Bits, size_t BitCount, uint8_t & State)
+{
+    for (size_t index = 0;index < BitCount;++index)
+    {
+        uint8_t Mask = uint8_t (0x80 >> (index & 7));
+        State ^= GetBit (Bits, index) ? 1 : 0;
+
+        if (State)
+        {
+            Bits[index >> 3] |= Mask;
+        }
+        else
+        {
+            Bits[index >> 3] &= uint8_t (~Mask);
+        }
+    }
+}
+
+// *********************************************************************************************
+// DifferentialDecode(): Output bit = input bit XOR previous input bit.
+void cRdsBitstream::DifferentialDecode (uint8_t * Bits, size_t BitCount, uint8_t & State)
+{
+    for (size_t index = 0;index < BitCount;++index)
+    {
+        uint8_t Mask    = uint8_t (0x80 >> (index & 7));
+        uint8_t Input   = GetBit (Bits, index) ? 1 : 0;
+
+        if (Input ^ State)
+        {
+            Bits[index >> 3] |= Mask;
+        }
+        else
+        {
+            Bits[index >> 3] &= uint8_t (~Mask);
+        }
+
+        State = Input;
+    }
+}
+
+// *********************************************************************************************
+// CorrectBlock(): Fix a single bit error in a block expected at Position. Returns false if the
+// block is valid as received or the error is not a single bit error.
+bool cRdsDecoder::CorrectBlock (uint32_t & Block, uint8_t Position)
+{
+    static const uint16_t Offsets[4] = {cRdsBitstream::Offset_A, cRdsBitstream::Offset_B, cRdsBitstream::Offset_C, cRdsBitstream::Offset_D};
+
+    bool        Response        = false;
+    uint16_t    BlockSyndrome   = Syndrome (Block);
+
+    for (uint8_t Pass = 0;(Pass < 2) && !Response;++Pass)
+    {
+        // Block C can carry either offset.
+        uint16_t Offset = (1 == Pass) ? uint16_t (cRdsBitstream::Offset_Cprime) : Offsets[Position & 0x03];
+
+        if ((1 == Pass) && (2 != Position))
+        {
+            break;
+        }
+
+        for (uint8_t bit = 0;bit < RDS_BLOCK_BITS;++bit)
+        {
+            // The syndrome is linear: a flipped bit adds the syndrome of that bit alone.
+            if ((BlockSyndrome ^ Offset) == Syndrome (1UL << bit))
+            {
+                Block       ^= (1UL << bit);
+                Response    = true;
+                break;
+            }
+        }
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+void cRdsDecoder::GetGroup (cRdsEncoder::RdsGroup_t & Group)
+{
+    for (uint8_t block = 0;block < 4;++block)
+    {
+        Group[block * 2]        = uint8_t (Blocks[block] >> 8);
+        Group[block * 2 + 1]    = uint8_t (Blocks[block]);
+    }
+
+    GroupReady = false;
+}
+
+// *********************************************************************************************
+// MatchOffset(): Returns the block position (0..3) whose offset word matches, -1 if none does.
+int8_t cRdsDecoder::MatchOffset (uint32_t Block)
+{
+    int8_t Response = -1;
+
+    switch (Syndrome (Block))
+    {
+        case cRdsBitstream::Offset_A:
+        {
+            Response = 0;
+            break;
+        }
+
+        case cRdsBitstream::Offset_B:
+        {
+            Response = 1;
+            break;
+        }
+
+        case cRdsBitstream::Offset_C:
+        case cRdsBitstream::Offset_Cprime:
+        {
+            Response = 2;
+            break;
+        }
+
+        case cRdsBitstream::Offset_D:
+        {
+            Response = 3;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+bool cRdsDecoder::PushBit (bool Bit)
+{
+    // DEBUG_START;
+
+    ++BitsReceived;
+    ShiftRegister = ((ShiftRegister << 1) | (Bit ? 1 : 0)) & ((1UL << RDS_BLOCK_BITS) - 1);
+
+    do  // once
+    {
+        if (!Synchronized)
+        {
+            // Slide bit by bit until a block with a valid offset word shows up.
+            if (BitsReceived < RDS_BLOCK_BITS)
+            {
+                break;
+            }
+
+            int8_t Position = MatchOffset (ShiftRegister);
+
+            if (Position < 0)
+            {
+                break;
+            }
+
+            Synchronized        = true;
+            BitCount            = 0;
+            Blocks[Position]    = uint16_t (ShiftRegister >> 10);
+            ValidBlocks         = uint8_t (1 << Position);
+            ExpectedBlock       = (Position + 1) & 0x03;
+            break;
+        }
+
+        if (++BitCount < RDS_BLOCK_BITS)
+        {
+            break;
+        }
+
+        BitCount = 0;
+
+        uint32_t Block = ShiftRegister;
+
+        if ((MatchOffset (Block) != ExpectedBlock) && CorrectBlock (Block, ExpectedBlock))
+        {
+            ++BlocksCorrected;
+        }
+
+        if (MatchOffset (Block) != ExpectedBlock)
+        {
+            // One bad block costs the group and the block sync.
+            ++BlockErrors;
+            ++SyncLosses;
+            Synchronized    = false;
+            ValidBlocks     = 0;
+            break;
+        }
+
+        if (0 == ExpectedBlock)
+        {
+            ValidBlocks = 0;
+        }
+
+        Blocks[ExpectedBlock]   = uint16_t (Block >> 10);
+        ValidBlocks             |= uint8_t (1 << ExpectedBlock);
+
+        if ((3 == ExpectedBlock) && (0x0F == ValidBlocks))
+        {
+            ++GroupsDecoded;
+            GroupReady = true;
+        }
+
+        ExpectedBlock = (ExpectedBlock + 1) & 0x03;
+    } while (false);
+
+    // DEBUG_END;
+    return GroupReady;
+}
+
+// *********************************************************************************************
+void cRdsDecoder::Reset ()
+{
+    ShiftRegister   = 0;
+    Synchronized    = false;
+    ExpectedBlock   = 0;
+    BitCount        = 0;
+    ValidBlocks     = 0;
+    GroupReady      = false;
+    BitsReceived    = 0;
+    GroupsDecoded   = 0;
+    BlockErrors     = 0;
+    BlocksCorrected = 0;
+    SyncLosses      = 0;
+}
+
+// *********************************************************************************************
+// Syndrome(): Offset word of an error free block.
+uint16_t cRdsDecoder::Syndrome (uint32_t Block)
+{
+    return uint16_t ((Block ^ cRdsBitstream::Checkword (uint16_t (Block >> 10), 0)) & RDS_CHECK_MASK);
+}
+
+// *********************************************************************************************
+// OEF
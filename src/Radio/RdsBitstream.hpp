@@ -0,0 +1,100 @@
+#pragma once
+/*
+  *    File: RdsBitstream.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Software model of the RDS data link layer (IEC 62106). The QN8027 adds the 10 bit checkwords
+  *    itself, so this model is only used to verify what goes on air: it turns the 8 byte group payloads
+  *    into the 104 bit (1187.5 bps) stream and decodes that stream back into groups. Once the decoder
+  *    is synchronized it corrects single bit errors in a block.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include "RdsEncoder.hpp"
+
+// *********************************************************************************************
+#define RDS_BLOCK_BITS      26
+#define RDS_GROUP_BITS      (4 * RDS_BLOCK_BITS)
+#define RDS_GROUP_BYTES     (RDS_GROUP_BITS / 8)
+#define RDS_BIT_RATE        1187.5
+
+// *********************************************************************************************
+class cRdsBitstream
+{
+public:
+
+    typedef uint8_t RdsBits_t[RDS_GROUP_BYTES];
+
+    // Offset words
+    enum RdsOffset_e
+    {
+        Offset_A        = 0x0FC,
+        Offset_B        = 0x198,
+        Offset_C        = 0x168,
+        Offset_Cprime   = 0x350,
+        Offset_D        = 0x1B4,
+    };
+
+    static uint16_t Checkword (uint16_t Data, uint16_t Offset);
+    static uint32_t EncodeBlock (uint16_t Data, uint16_t Offset);
+
+    // Group payload to 104 bits, MSB first. Block 3 uses offset C' for version B groups.
+    static void     EncodeGroup (const cRdsEncoder::RdsGroup_t & Group, RdsBits_t & Bits);
+
+    // Differential coding as applied ahead of the bi-phase modulator. State carries over between calls.
+    static void     DifferentialEncode (uint8_t * Bits, size_t BitCount, uint8_t & State);
+    static void     DifferentialDecode (uint8_t * Bits, size_t BitCount, uint8_t & State);
+
+    static bool     GetBit (const uint8_t * Bits, size_t Index) {return 0 != (Bits[Index >> 3] & (0x80 >> (Index & 7)));}
+};  // class cRdsBitstream
+
+// *********************************************************************************************
+class cRdsDecoder
+{
+public:
+
+    cRdsDecoder ()  {}
+    virtual~cRdsDecoder ()  {}
+
+    // Feed one received bit. Returns true when a complete group (after correction) is available.
+    bool    PushBit (bool Bit);
+    void    GetGroup (cRdsEncoder::RdsGroup_t & Group);
+    void    Reset ();
+
+    bool        IsSynchronized ()   {return Synchronized;}
+
+    uint32_t    BitsReceived    = 0;
+    uint32_t    GroupsDecoded   = 0;
+    uint32_t    BlockErrors     = 0;
+    uint32_t    BlocksCorrected = 0;
+    uint32_t    SyncLosses      = 0;
+
+private:
+
+    int8_t      MatchOffset (uint32_t Block);
+    uint16_t    Syndrome (uint32_t Block);
+    bool        CorrectBlock (uint32_t & Block, uint8_t Position);
+
+    uint32_t    ShiftRegister   = 0;
+    bool        Synchronized    = false;
+    uint8_t     ExpectedBlock   = 0;    // 0..3 == A, B, C/C', D
+    uint8_t     BitCount        = 0;    // Bits of the current block received so far.
+    uint16_t    Blocks[4]       = {0};
+    uint8_t     ValidBlocks     = 0;    // Bit N set: Blocks[N] passed its check.
+    bool        GroupReady      = false;
+};  // class cRdsDecoder
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,485 @@
+/*
+  *    File: RdsEncoder.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Block 2 layout (all groups):
+  *    | Group Type (4) | B0 (1) | TP (1) | PTY (5) | Group specific (5) |
+  */
+
+// *********************************************************************************************
+#include <string.h>
+#include "RdsEncoder.hpp"
+
+// *********************************************************************************************
+static const uint16_t   RDS_NO_AF_BLOCK = 0xE0CD;   // 224 == "No AF exists", 205 == Filler code.
+static const uint8_t    RDS_AF_COUNT_BASE   = 224;  // 225..249 == Number of AFs that follow.
+static const uint8_t    RDS_AF_FILLER       = 205;
+static const uint16_t   RDS_AF_BASE_FREQ    = 875;  // Code 1 == 87.6 MHz, in 100 KHz steps.
+static const uint8_t    RDS_AF_MAX_CODE     = 204;  // 107.9 MHz
+static const char       RDS_RT_END      = 0x0D;     // RadioText end of message marker.
+
+// PixelRadio is not a traffic station and mostly plays music.
+static const bool   RDS_TRAFFIC_PROGRAM         = false;
+static const bool   RDS_TRAFFIC_ANNOUNCEMENT    = false;
+static const bool   RDS_MUSIC                   = true;
+
+// *********************************************************************************************
+cRdsEncoder::cRdsEncoder ()
+{
+    // _ DEBUG_START;
+
+    memset (ProgramServiceName, 0x00,   sizeof (ProgramServiceName));
+    memset (RadioText,          0x00,   sizeof (RadioText));
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+uint8_t cRdsEncoder::AfCode (uint16_t FrequencyMHz10)
+{
+    return ((FrequencyMHz10 > RDS_AF_BASE_FREQ) && (FrequencyMHz10 <= (RDS_AF_BASE_FREQ + RDS_AF_MAX_CODE))) ?
+           uint8_t (FrequencyMHz10 - RDS_AF_BASE_FREQ) : 0;
+}
+
+// *********************************************************************************************
+uint16_t cRdsEncoder::Block2 (uint8_t GroupType, uint8_t Low5Bits)
+{
+    return uint16_t ((uint16_t (GroupType & 0x0F) << 12) |
+                     (uint16_t (RDS_TRAFFIC_PROGRAM ? 1 : 0) << 10) |
+                     (uint16_t (PtyCode & 0x1F) << 5) |
+                     (Low5Bits & 0x1F));
+}
+
+// *********************************************************************************************
+void cRdsEncoder::BuildClockTimeGroup (RdsGroup_t & Group, uint32_t Mjd, uint8_t Hour, uint8_t Minute, int8_t LocalOffsetHalfHours)
+{
+    // DEBUG_START;
+
+    uint8_t OffsetSign  = (LocalOffsetHalfHours < 0) ? 1 : 0;
+    uint8_t OffsetValue = uint8_t ((LocalOffsetHalfHours < 0) ? -LocalOffsetHalfHours : LocalOffsetHalfHours) & 0x1F;
+
+    PackGroup (Group,
+               PiCode,
+               Block2 (GroupType_CT, uint8_t ((Mjd >> 15) & 0x03)),
+               uint16_t (((Mjd & 0x7FFF) << 1) | ((Hour >> 4) & 0x01)),
+               uint16_t ((uint16_t (Hour & 0x0F) << 12) | (uint16_t (Minute & 0x3F) << 6) | (OffsetSign << 5) | OffsetValue));
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::BuildPsGroups ()
+{
+    // DEBUG_START;
+
+    // Encode the AF list (method A) once. Block 0 carries the count and the first AF, the rest carry pairs.
+    uint16_t    AfBlocks[RDS_AF_BLOCK_COUNT];
+    uint8_t     AfBlockCount = 1;
+
+    AfBlocks[0] = RDS_NO_AF_BLOCK;
+
+    if (AfCount)
+    {
+        AfBlocks[0] = uint16_t ((uint16_t (RDS_AF_COUNT_BASE + AfCount) << 8) | AfCodes[0]);
+
+        for (uint8_t index = 1;index < AfCount;index += 2)
+        {
+            uint8_t Second = ((index + 1) < AfCount) ? AfCodes[index + 1] : RDS_AF_FILLER;
+            AfBlocks[AfBlockCount++] = uint16_t ((uint16_t (AfCodes[index]) << 8) | Second);
+        }
+    }
+
+    // Enough groups to send every AF block at least once and end on a complete PS name.
+    PsGroupCount = uint8_t (((AfBlockCount + RDS_PS_GROUP_COUNT - 1) / RDS_PS_GROUP_COUNT) * RDS_PS_GROUP_COUNT);
+
+    for (uint8_t index = 0;index < PsGroupCount;++index)
+    {
+        // One Decoder Identification bit per segment, d3 first.
+        uint8_t segment = index % RDS_PS_GROUP_COUNT;
+        uint8_t DiBit   = (DecoderInfo >> (3 - segment)) & 0x01;
+        uint8_t Low5    = uint8_t ((RDS_TRAFFIC_ANNOUNCEMENT ? 0x10 : 0x00) | (RDS_MUSIC ? 0x08 : 0x00) | (DiBit << 2) | segment);
+
+        PackGroup (PsGroups[index],
+                   PiCode,
+                   Block2 (GroupType_PS, Low5),
+                   AfBlocks[index % AfBlockCount],
+                   uint16_t ((uint8_t (ProgramServiceName[segment * 2]) << 8) | uint8_t (ProgramServiceName[segment * 2 + 1])));
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::BuildRtGroups ()
+{
+    // DEBUG_START;
+
+    char    Buffer[RADIOTEXT_SIZE + 4];
+    size_t  Length = strnlen (RadioText, RADIOTEXT_SIZE);
+
+    memset (Buffer, ' ', sizeof (Buffer));
+    memcpy (Buffer, RadioText, Length);
+
+    if (Length < RADIOTEXT_SIZE)
+    {
+        // Short messages are terminated so the receiver knows where to stop.
+        Buffer[Length++] = RDS_RT_END;
+    }
+
+    RtGroupCount = uint8_t ((Length + 3) / 4);
+
+    for (uint8_t segment = 0;segment < RtGroupCount;++segment)
+    {
+        const char * Text = &Buffer[segment * 4];
+
+        PackGroup (RtGroups[segment],
+                   PiCode,
+                   Block2 (GroupType_RT, uint8_t ((RtAbFlag ? 0x10 : 0x00) | segment)),
+                   uint16_t ((uint8_t (Text[0]) << 8) | uint8_t (Text[1])),
+                   uint16_t ((uint8_t (Text[2]) << 8) | uint8_t (Text[3])));
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::BuildRtPlusGroups ()
+{
+    // DEBUG_START;
+
+    // ODA announcement: RT+ is carried in group 11A.
+    PackGroup (RtPlusGroups[0],
+               PiCode,
+               Block2 (GroupType_ODA, uint8_t (GroupType_RTPLUS << 1)),
+               0x0000,
+               RDS_RTPLUS_AID);
+
+    PackGroup (RtPlusGroups[1],
+               PiCode,
+               Block2 (GroupType_RTPLUS, uint8_t ((RtPlusToggle ? 0x10 : 0x00) | 0x08 | RtPlusBlock2Low)),
+               RtPlusBlock3,
+               RtPlusBlock4);
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::ClearRtPlusTags ()
+{
+    // DEBUG_START;
+
+    if (RtPlusValid)
+    {
+        RtPlusValid = false;
+        Dirty       = true;
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::CopyText (char * Dest, size_t DestSize, const char * Source, char Pad)
+{
+    // DEBUG_START;
+
+    size_t Length = (Source) ? strnlen (Source, DestSize - 1) : 0;
+
+    memset (Dest, Pad, DestSize - 1);
+    memcpy (Dest, Source, Length);
+    Dest[DestSize - 1] = 0x00;
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// FindRtPlusTags(): ItemName is usually an FPP sequence name. "Title - Artist" names are tagged as
+// ItemTitle + ItemArtist, anything else as ItemTitle.
+bool cRdsEncoder::FindRtPlusTags (const char * Text, const char * ItemName, RtPlusTags_t & Tags)
+{
+    // DEBUG_START;
+
+    bool    Response    = false;
+    size_t  TextLength  = strnlen (Text, RADIOTEXT_SIZE);
+    size_t  NameLength  = strnlen (ItemName, RADIOTEXT_SIZE);
+
+    Tags = RtPlusTags_t ();
+
+    for (size_t Start = 0;NameLength && ((Start + NameLength) <= TextLength);++Start)
+    {
+        if (0 != memcmp (&Text[Start], ItemName, NameLength))
+        {
+            continue;
+        }
+
+        const char  * Split         = nullptr;
+        size_t      TitleLength     = 0;
+        size_t      ArtistLength    = 0;
+
+        for (size_t Offset = 1;(Offset + 4) <= NameLength;++Offset)
+        {
+            if (0 == memcmp (&ItemName[Offset], " - ", 3))
+            {
+                Split           = &ItemName[Offset];
+                TitleLength     = Offset;
+                ArtistLength    = NameLength - Offset - 3;
+                break;
+            }
+        }
+
+        Response = true;
+
+        if (nullptr == Split)
+        {
+            Tags.Type1      = RtPlus_ItemTitle;
+            Tags.Start1     = uint8_t (Start);
+            Tags.Length1    = uint8_t (NameLength);
+            break;
+        }
+
+        // The second tag can only be 32 characters long. At most one of the two is longer than that.
+        bool    ArtistFirst = (ArtistLength > 32);
+        uint8_t TitleStart  = uint8_t (Start);
+        uint8_t ArtistStart = uint8_t (Start + TitleLength + 3);
+
+        Tags.Type1      = ArtistFirst ? RtPlus_ItemArtist : RtPlus_ItemTitle;
+        Tags.Start1     = ArtistFirst ? ArtistStart : TitleStart;
+        Tags.Length1    = uint8_t (ArtistFirst ? ArtistLength : TitleLength);
+        Tags.Type2      = ArtistFirst ? RtPlus_ItemTitle : RtPlus_ItemArtist;
+        Tags.Start2     = ArtistFirst ? TitleStart : ArtistStart;
+        Tags.Length2    = uint8_t (ArtistFirst ? TitleLength : ArtistLength);
+        break;
+    }
+
+    // DEBUG_END;
+    return Response;
+}   // FindRtPlusTags
+
+// *********************************************************************************************
+uint8_t cRdsEncoder::GetPsGroupCount ()
+{
+    Update ();
+    return PsValid ? PsGroupCount : 0;
+}
+
+// *********************************************************************************************
+const cRdsEncoder::RdsGroup_t & cRdsEncoder::GetPsGroup (uint8_t index)
+{
+    Update ();
+    return PsGroups[index % PsGroupCount];
+}
+
+// *********************************************************************************************
+uint8_t cRdsEncoder::GetRtGroupCount ()
+{
+    Update ();
+    return RtValid ? RtGroupCount : 0;
+}
+
+// *********************************************************************************************
+const cRdsEncoder::RdsGroup_t & cRdsEncoder::GetRtGroup (uint8_t index)
+{
+    Update ();
+    return RtGroups[index % RDS_RT_MAX_GROUP_COUNT];
+}
+
+// *********************************************************************************************
+uint8_t cRdsEncoder::GetRtPlusGroupCount ()
+{
+    Update ();
+    return RtPlusValid ? 2 : 0;
+}
+
+// *********************************************************************************************
+const cRdsEncoder::RdsGroup_t & cRdsEncoder::GetRtPlusGroup (uint8_t index)
+{
+    Update ();
+    return RtPlusGroups[index % 2];
+}
+
+// *********************************************************************************************
+// ModifiedJulianDay(): Gregorian calendar date to MJD (days since Nov-17-1858).
+uint32_t cRdsEncoder::ModifiedJulianDay (uint16_t Year, uint8_t Month, uint8_t Day)
+{
+    int32_t     y   = int32_t (Year) - ((Month <= 2) ? 1 : 0);
+    int32_t     era = ((y >= 0) ? y : (y - 399)) / 400;
+    uint32_t    yoe = uint32_t (y - era * 400);
+    uint32_t    doy = (153 * (Month + ((Month > 2) ? -3 : 9)) + 2) / 5 + Day - 1;
+    uint32_t    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    // days since 1970-01-01 + MJD of 1970-01-01
+    return uint32_t (era * 146097 + int32_t (doe) - 719468 + 40587);
+}
+
+// *********************************************************************************************
+void cRdsEncoder::PackGroup (RdsGroup_t & Group, uint16_t Block1, uint16_t Block2Value, uint16_t Block3, uint16_t Block4)
+{
+    Group[0]    = uint8_t (Block1 >> 8);
+    Group[1]    = uint8_t (Block1);
+    Group[2]    = uint8_t (Block2Value >> 8);
+    Group[3]    = uint8_t (Block2Value);
+    Group[4]    = uint8_t (Block3 >> 8);
+    Group[5]    = uint8_t (Block3);
+    Group[6]    = uint8_t (Block4 >> 8);
+    Group[7]    = uint8_t (Block4);
+}
+
+// *********************************************************************************************
+void cRdsEncoder::SetAlternativeFrequencies (const uint8_t * Codes, uint8_t Count)
+{
+    // DEBUG_START;
+
+    uint8_t NewCodes[RDS_AF_MAX_COUNT];
+    uint8_t NewCount = 0;
+
+    for (uint8_t index = 0;(index < Count) && (NewCount < RDS_AF_MAX_COUNT);++index)
+    {
+        if ((Codes[index] >= 1) && (Codes[index] <= RDS_AF_MAX_CODE))
+        {
+            NewCodes[NewCount++] = Codes[index];
+        }
+    }
+
+    if ((NewCount != AfCount) || (0 != memcmp (NewCodes, AfCodes, NewCount)))
+    {
+        memcpy (AfCodes, NewCodes, NewCount);
+        AfCount = NewCount;
+        Dirty   = true;
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRdsEncoder::SetDecoderInfo (uint8_t value)
+{
+    value &= 0x0F;
+
+    if (value != DecoderInfo)
+    {
+        DecoderInfo = value;
+        Dirty       = true;
+    }
+}
+
+// *********************************************************************************************
+void cRdsEncoder::SetPiCode (uint16_t value)
+{
+    if (value != PiCode)
+    {
+        PiCode  = value;
+        Dirty   = true;
+    }
+}
+
+// *********************************************************************************************
+// SetProgramServiceName(): Names shorter than 8 characters are padded with spaces.
+void cRdsEncoder::SetProgramServiceName (const char * value)
+{
+    char NewName[PSN_SIZE + 1];
+
+    CopyText (NewName, sizeof (NewName), value, ' ');
+
+    if (!PsValid || (0 != memcmp (NewName, ProgramServiceName, PSN_SIZE)))
+    {
+        memcpy (ProgramServiceName, NewName, sizeof (ProgramServiceName));
+        PsValid = true;
+        Dirty   = true;
+    }
+}
+
+// *********************************************************************************************
+void cRdsEncoder::SetPtyCode (uint8_t value)
+{
+    value &= 0x1F;
+
+    if (value != PtyCode)
+    {
+        PtyCode = value;
+        Dirty   = true;
+    }
+}
+
+// *********************************************************************************************
+// SetRadioText(): A new text flips the A/B flag so receivers clear the old message.
+void cRdsEncoder::SetRadioText (const char * value)
+{
+    char NewText[RADIOTEXT_SIZE + 1];
+
+    CopyText (NewText, sizeof (NewText), value, 0x00);
+
+    if (!RtValid || (0 != strncmp (NewText, RadioText, RADIOTEXT_SIZE)))
+    {
+        memcpy (RadioText, NewText, sizeof (RadioText));
+        RtAbFlag    = !RtAbFlag;
+        RtValid     = true;
+        Dirty       = true;
+    }
+}
+
+// *********************************************************************************************
+// SetRtPlusTags(): Tag positions are character offsets into the current RadioText.
+// A tag with a length of zero is sent as a dummy tag.
+void cRdsEncoder::SetRtPlusTags (uint8_t Type1, uint8_t Start1, uint8_t Length1, uint8_t Type2, uint8_t Start2, uint8_t Length2)
+{
+    // DEBUG_START;
+
+    if (0 == Length1)
+    {
+        Type1   = RtPlus_Dummy;
+        Start1  = 0;
+    }
+
+    if (0 == Length2)
+    {
+        Type2   = RtPlus_Dummy;
+        Start2  = 0;
+    }
+
+    uint8_t     Marker1 = Length1 ? (Length1 - 1) : 0;    // Length markers hold the additional length.
+    uint8_t     Marker2 = Length2 ? (Length2 - 1) : 0;
+
+    uint16_t    NewLow      = (Type1 >> 3) & 0x07;
+    uint16_t    NewBlock3   = uint16_t ((uint16_t (Type1 & 0x07) << 13) | (uint16_t (Start1 & 0x3F) << 7) | (uint16_t (Marker1 & 0x3F) << 1) | ((Type2 >> 5) & 0x01));
+    uint16_t    NewBlock4   = uint16_t ((uint16_t (Type2 & 0x1F) << 11) | (uint16_t (Start2 & 0x3F) << 5) | (Marker2 & 0x1F));
+
+    if (!RtPlusValid || (NewLow != RtPlusBlock2Low) || (NewBlock3 != RtPlusBlock3) || (NewBlock4 != RtPlusBlock4))
+    {
+        RtPlusBlock2Low = NewLow;
+        RtPlusBlock3    = NewBlock3;
+        RtPlusBlock4    = NewBlock4;
+        RtPlusToggle    = !RtPlusToggle;    // New item.
+        RtPlusValid     = true;
+        Dirty           = true;
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// Update(): Rebuild the cached group tables if the station state changed.
+void cRdsEncoder::Update ()
+{
+    // DEBUG_START;
+
+    if (Dirty)
+    {
+        BuildPsGroups ();
+        BuildRtGroups ();
+        BuildRtPlusGroups ();
+        Dirty = false;
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+// OEF
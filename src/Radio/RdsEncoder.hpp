@@ -0,0 +1,153 @@
+#pragma once
+/*
+  *    File: RdsEncoder.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Hardware independent RDS group encoder (IEC 62106). Builds the 8 byte group payloads (four
+  *    16 bit blocks, checkwords are added by the transmitter) for groups 0A, 2A, 3A, 4A and 11A
+  *    (RT+). The groups for the current station state are encoded once and cached.
+  *    The cache is rebuilt only when PI, PTY, DI, PS, RT, RT+ or the AF list change.
+  *    The AF list (method A) is encoded once into block 3 values, one per 0A group, so each PS
+  *    group in the table is a plain copy.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+
+// *********************************************************************************************
+#define RDS_GROUP_SIZE          8   // Bytes per RDS group (four 16 bit blocks, checkwords added by the chip).
+#define PSN_SIZE                8
+#define RADIOTEXT_SIZE          64
+#define RDS_PS_GROUP_COUNT      (PSN_SIZE / 2)
+#define RDS_AF_MAX_COUNT        25                                  // Method A limit.
+#define RDS_AF_BLOCK_COUNT      ((RDS_AF_MAX_COUNT + 2) / 2)        // "224 + N, AF1" followed by AF pairs.
+#define RDS_PS_MAX_GROUP_COUNT  (((RDS_AF_BLOCK_COUNT + RDS_PS_GROUP_COUNT - 1) / RDS_PS_GROUP_COUNT) * RDS_PS_GROUP_COUNT)
+#define RDS_RT_MAX_GROUP_COUNT  (RADIOTEXT_SIZE / 4)
+#define RDS_RTPLUS_AID          0x4BD7
+#define RDS_DI_STEREO           0x01    // Decoder Identification d0.
+
+// *********************************************************************************************
+class cRdsEncoder
+{
+public:
+
+    typedef uint8_t RdsGroup_t[RDS_GROUP_SIZE];
+
+    // RDS group type codes (upper nibble of block 2).
+    enum RdsGroupType_e
+    {
+        GroupType_PS        = 0,
+        GroupType_RT        = 2,
+        GroupType_ODA       = 3,
+        GroupType_CT        = 4,
+        GroupType_RTPLUS    = 11,
+    };
+
+    // RT+ content types used by PixelRadio.
+    enum RtPlusContentType_e
+    {
+        RtPlus_Dummy        = 0,
+        RtPlus_ItemTitle    = 1,
+        RtPlus_ItemAlbum    = 2,
+        RtPlus_ItemArtist   = 4,
+    };
+
+    // RT+ tags for one RadioText. A tag with a length of zero is not used.
+    struct RtPlusTags_t
+    {
+        uint8_t Type1   = RtPlus_Dummy;
+        uint8_t Start1  = 0;
+        uint8_t Length1 = 0;
+        uint8_t Type2   = RtPlus_Dummy;
+        uint8_t Start2  = 0;
+        uint8_t Length2 = 0;
+
+        bool IsEmpty () const {return (0 == Length1) && (0 == Length2);}
+    };
+
+    cRdsEncoder ();
+    virtual~cRdsEncoder ()  {}
+
+    void    SetPiCode (uint16_t value);
+    void    SetPtyCode (uint8_t value);
+    void    SetDecoderInfo (uint8_t value);     // DI bits d3..d0, see RDS_DI_STEREO.
+    void    SetProgramServiceName (const char * value);
+    void    SetRadioText (const char * value);
+    void    SetRtPlusTags (uint8_t Type1, uint8_t Start1, uint8_t Length1, uint8_t Type2, uint8_t Start2, uint8_t Length2);
+    void    SetRtPlusTags (const RtPlusTags_t & Tags) {SetRtPlusTags (Tags.Type1, Tags.Start1, Tags.Length1, Tags.Type2, Tags.Start2, Tags.Length2);}
+    void    ClearRtPlusTags ();
+
+    // SetAlternativeFrequencies(): AF codes (1..204), see AfCode(). Extra codes past RDS_AF_MAX_COUNT are ignored.
+    void            SetAlternativeFrequencies (const uint8_t * Codes, uint8_t Count);
+    uint8_t         GetAlternativeFrequencyCount ()   {return AfCount;}
+    static uint8_t  AfCode (uint16_t FrequencyMHz10);   // 876 (87.6 MHz) .. 1079 (107.9 MHz). 0 == Not a valid AF.
+
+    // FindRtPlusTags(): Tag ItemName where it appears in Text. Returns false (no tags) if it does not.
+    static bool FindRtPlusTags (const char * Text, const char * ItemName, RtPlusTags_t & Tags);
+
+    uint16_t    GetPiCode ()    {return PiCode;}
+    uint8_t     GetPtyCode ()   {return PtyCode;}
+
+    // Cached group tables
+    uint8_t             GetPsGroupCount ();
+    const RdsGroup_t    &GetPsGroup (uint8_t index);
+    uint8_t             GetRtGroupCount ();
+    const RdsGroup_t    &GetRtGroup (uint8_t index);
+    uint8_t             GetRtPlusGroupCount ();    // ODA announcement (3A) + RT+ (11A)
+    const RdsGroup_t    &GetRtPlusGroup (uint8_t index);
+
+    // Clock time. Not cached, send it once per minute at the minute boundary.
+    void            BuildClockTimeGroup (RdsGroup_t & Group, uint32_t Mjd, uint8_t Hour, uint8_t Minute, int8_t LocalOffsetHalfHours);
+    static uint32_t ModifiedJulianDay (uint16_t Year, uint8_t Month, uint8_t Day);
+
+    void    Update ();
+
+private:
+
+    uint16_t    Block2 (uint8_t GroupType, uint8_t Low5Bits);   // Version A
+    void        PackGroup (RdsGroup_t & Group, uint16_t Block1, uint16_t Block2, uint16_t Block3, uint16_t Block4);
+    void        CopyText (char * Dest, size_t DestSize, const char * Source, char Pad);
+
+    void        BuildPsGroups ();
+    void        BuildRtGroups ();
+    void        BuildRtPlusGroups ();
+
+    // Station state
+    uint16_t    PiCode              = 0;
+    uint8_t     PtyCode             = 0;
+    uint8_t     DecoderInfo         = RDS_DI_STEREO;
+    char        ProgramServiceName[PSN_SIZE + 1];
+    bool        PsValid             = false;
+    char        RadioText[RADIOTEXT_SIZE + 1];
+    bool        RtValid             = false;
+    bool        RtAbFlag            = false;
+    uint8_t     AfCodes[RDS_AF_MAX_COUNT];
+    uint8_t     AfCount             = 0;
+    bool        RtPlusValid         = false;
+    bool        RtPlusToggle        = false;
+    uint16_t    RtPlusBlock2Low     = 0;
+    uint16_t    RtPlusBlock3        = 0;
+    uint16_t    RtPlusBlock4        = 0;
+
+    // Cached groups
+    bool        Dirty = true;
+    RdsGroup_t  PsGroups[RDS_PS_MAX_GROUP_COUNT];   // Every PS segment paired with every AF block.
+    uint8_t     PsGroupCount = RDS_PS_GROUP_COUNT;
+    RdsGroup_t  RtGroups[RDS_RT_MAX_GROUP_COUNT];
+    uint8_t     RtGroupCount = 0;
+    RdsGroup_t  RtPlusGroups[2];    // ODA announcement, RT+
+};  // class cRdsEncoder
+
+// *********************************************************************************************
+// OEF
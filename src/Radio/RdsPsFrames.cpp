@@ -0,0 +1,106 @@
+/*
+  *    File: RdsPsFrames.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include <string.h>
+#include "RdsPsFrames.hpp"
+
+// *********************************************************************************************
+// AddFrame(): Center Text in a space padded frame.
+void cRdsPsFrames::AddFrame (const char * Text, size_t Length)
+{
+    // DEBUG_START;
+
+    if (FrameCount < RDS_DYNAMIC_PS_MAX_FRAMES)
+    {
+        char * Frame = Frames[FrameCount++];
+
+        memset (Frame, ' ', PSN_SIZE);
+        memcpy (&Frame[(PSN_SIZE - Length) / 2], Text, Length);
+        Frame[PSN_SIZE] = '\0';
+    }
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+uint8_t cRdsPsFrames::Build (const char * Text)
+{
+    // DEBUG_START;
+
+    size_t  TextLength  = strnlen (Text, RDS_DYNAMIC_PS_TEXT_SIZE);
+    char    Pending[PSN_SIZE];
+    size_t  PendingLength = 0;
+
+    FrameCount  = 0;
+    Position    = 0;
+
+    for (size_t Start = 0;Start < TextLength;)
+    {
+        if (' ' == Text[Start])
+        {
+            ++Start;
+            continue;
+        }
+
+        size_t WordLength = strcspn (&Text[Start], " ");
+        WordLength = (WordLength < (TextLength - Start)) ? WordLength : (TextLength - Start);
+
+        if (PendingLength && ((PendingLength + 1 + WordLength) > PSN_SIZE))
+        {
+            AddFrame (Pending, PendingLength);
+            PendingLength = 0;
+        }
+
+        while (WordLength > PSN_SIZE)
+        {
+            AddFrame (&Text[Start], PSN_SIZE);
+            Start       += PSN_SIZE;
+            WordLength  -= PSN_SIZE;
+        }
+
+        if (PendingLength)
+        {
+            Pending[PendingLength++] = ' ';
+        }
+
+        memcpy (&Pending[PendingLength], &Text[Start], WordLength);
+        PendingLength   += WordLength;
+        Start           += WordLength;
+    }
+
+    if (PendingLength)
+    {
+        AddFrame (Pending, PendingLength);
+    }
+
+    // DEBUG_END;
+    return FrameCount;
+}   // Build
+
+// *********************************************************************************************
+const char * cRdsPsFrames::Next ()
+{
+    const char * Response = Frames[Position];
+
+    if (++Position >= FrameCount)
+    {
+        Position = 0;
+    }
+
+    return Response;
+}   // Next
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,53 @@
+#pragma once
+/*
+  *    File: RdsPsFrames.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Dynamic PS. Text longer than the 8 character PS is split once, when it changes, into a list of
+  *    8 character frames that are then sent one after the other. Words are kept whole where they
+  *    fit, packed as many to a frame as will fit and centered. Longer words are split.
+  *    This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include "RdsEncoder.hpp"
+
+// *********************************************************************************************
+#define RDS_DYNAMIC_PS_TEXT_SIZE    64
+#define RDS_DYNAMIC_PS_MAX_FRAMES   32
+
+// *********************************************************************************************
+class cRdsPsFrames
+{
+public:
+
+    cRdsPsFrames ()    {}
+    virtual~cRdsPsFrames ()    {}
+
+    uint8_t         Build (const char * Text);  // Returns the number of frames. 0 == dynamic PS is off.
+    uint8_t         Count ()    {return FrameCount;}
+    const char *    Frame (uint8_t Index)   {return Frames[Index % RDS_DYNAMIC_PS_MAX_FRAMES];}
+    const char *    Next ();                // Frames in order, starting over after the last one.
+
+private:
+
+    void    AddFrame (const char * Text, size_t Length);
+
+    char    Frames[RDS_DYNAMIC_PS_MAX_FRAMES][PSN_SIZE + 1];
+    uint8_t FrameCount  = 0;
+    uint8_t Position    = 0;
+};  // class cRdsPsFrames
+
+// *********************************************************************************************
+// OEF
@@ -26,19 +26,24 @@
 #include <ArduinoLog.h>
 #include <Wire.h>
 
+#include "AfList.hpp"
 #include "AnalogAudioGain.hpp"
 #include "AudioInputImpedance.hpp"
 #include "AudioMode.hpp"
 #include "AudioMute.hpp"
 #include "DigitalAudioGain.hpp"
+#include "DynamicPsText.hpp"
+#include "DynamicPsTime.hpp"
 #include "FrequencyAdjust.hpp"
 #include "PiCode.hpp"
 #include "PreEmphasis.hpp"
 #include "PtyCode.hpp"
+#include "RdsClockTime.hpp"
 #include "RdsText.hpp"
 #include "RfCarrier.hpp"
 #include "RfPower.hpp"
 #include "TestTone.hpp"
+#include "TimeZone.hpp"
 
 // *********************************************************************************************
 void cRadio::begin ()
@@ -46,38 +51,71 @@ void cRadio::begin ()
     // DEBUG_START;
 
     QN8027RadioApi.begin ();    // If QN8027 fails we will warn user on UI homeTab.
+    RdsClockTime.begin ();
     Log.infoln (F ("FM Radio RDS/RBDS Started."));
 
     // DEBUG_END;
 }
 
+// *********************************************************************************************
+// beginUpdate() / commit(): Group several radio setting changes so the chip is updated
+// with a single RF carrier off/on cycle.
+void cRadio::beginUpdate ()
+{
+    // DEBUG_START;
+
+    QN8027RadioApi.beginUpdate ();
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cRadio::commit ()
+{
+    // DEBUG_START;
+
+    QN8027RadioApi.commit ();
+
+    // DEBUG_END;
+}
+
 // *********************************************************************************************
 void cRadio::Poll ()
 {
     // _ DEBUG_START;
 
-    TestTone.poll ();
-    RdsText.poll ();
+    QN8027RadioApi.Poll ();
 
     // _ DEBUG_END;
 }
 
 // *********************************************************************************************
+// restoreConfiguration(): At boot this runs before begin(), the radio is not running yet and begin()
+// sends all the settings in one pass. A restore from the SD card while running is sent as one
+// transaction, so the carrier is cycled at most once.
 void cRadio::restoreConfiguration (JsonObject & config)
 {
     // DEBUG_START;
 
+    beginUpdate ();
+    AfList.restoreConfiguration (config);
     AnalogAudioGain.restoreConfiguration (config);
     AudioInputImpedance.restoreConfiguration (config);
     AudioMode.restoreConfiguration (config);
     AudioMute.restoreConfiguration (config);
     DigitalAudioGain.restoreConfiguration (config);
+    DynamicPsTime.restoreConfiguration (config);
+    DynamicPsText.restoreConfiguration (config);
     FrequencyAdjust.restoreConfiguration (config);
     PiCode.restoreConfiguration (config);
     PreEmphasis.restoreConfiguration (config);
     PtyCode.restoreConfiguration (config);
+    RdsClockTime.restoreConfiguration (config);
     RfCarrier.restoreConfiguration (config);
     RfPower.restoreConfiguration (config);
+    TimeZone.restoreConfiguration (config);
+    commit ();
+
     // DEBUG_END;
 }
 
@@ -86,17 +124,22 @@ void cRadio::saveConfiguration (JsonObject & config)
 {
     // DEBUG_START;
 
+    AfList.saveConfiguration (config);
     AnalogAudioGain.saveConfiguration (config);
     AudioInputImpedance.saveConfiguration (config);
     AudioMode.saveConfiguration (config);
     AudioMute.saveConfiguration (config);
     DigitalAudioGain.saveConfiguration (config);
+    DynamicPsTime.saveConfiguration (config);
+    DynamicPsText.saveConfiguration (config);
     FrequencyAdjust.saveConfiguration (config);
     PiCode.saveConfiguration (config);
     PreEmphasis.saveConfiguration (config);
     PtyCode.saveConfiguration (config);
+    RdsClockTime.saveConfiguration (config);
     RfCarrier.saveConfiguration (config);
     RfPower.saveConfiguration (config);
+    TimeZone.saveConfiguration (config);
 
     // DEBUG_END;
 }
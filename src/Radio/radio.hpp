@@ -35,6 +35,8 @@ public:
 
     void    begin ();
     void    Poll ();
+    void    beginUpdate ();
+    void    commit ();
     void    restoreConfiguration (JsonObject & json);
     void    saveConfiguration (JsonObject & json);
 
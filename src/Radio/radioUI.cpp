@@ -19,22 +19,28 @@
 #include <Arduino.h>
 #include <ArduinoLog.h>
 
+#include "AfList.hpp"
 #include "AnalogAudioGain.hpp"
 #include "AudioGain.hpp"
 #include "AudioInputImpedance.hpp"
 #include "AudioMode.hpp"
 #include "AudioMute.hpp"
 #include "DigitalAudioGain.hpp"
+#include "DynamicPsText.hpp"
+#include "DynamicPsTime.hpp"
 #include "FrequencyAdjust.hpp"
 #include "PeakAudio.hpp"
 #include "PiCode.hpp"
 #include "PreEmphasis.hpp"
 #include "ProgramServiceName.hpp"
 #include "PtyCode.hpp"
+#include "RadioCalibrate.hpp"
+#include "RdsClockTime.hpp"
 #include "RdsReset.hpp"
 #include "RdsText.hpp"
 #include "RfCarrier.hpp"
 #include "TestTone.hpp"
+#include "TimeZone.hpp"
 
 const char PROGMEM  ADJUST_FRQ_CTRL_STR  [] = "FM TRANSMIT FREQUENCY";
 const char PROGMEM  ADJUST_AUDIO_SEP_STR [] = "AUDIO CONTROLS";
@@ -93,6 +99,7 @@ void cRadio::AddRadioControls (uint16_t radioTab, ControlColor color)
     ESPUI.addControl (ControlType::Separator, RADIO_SEP_RF_SET_STR, emptyString, ControlColor::None, radioTab);
     FrequencyAdjust.AddRadioControls (radioTab, color);
     RfCarrier.AddControls (radioTab, color);
+    RadioCalibrate.AddControls (radioTab, color);
 
     ESPUI.addControl (ControlType::Separator, RADIO_SEP_MOD_STR, emptyString, ControlColor::None, radioTab);
     AudioMode.AddControls (radioTab, color);
@@ -122,8 +129,13 @@ void cRadio::AddRdsControls (uint16_t rdsTab, ControlColor color)
     // DEBUG_START;
 
     ProgramServiceName.AddControls (rdsTab, color);
+    DynamicPsText.AddControls (rdsTab, color);
+    DynamicPsTime.AddControls (rdsTab, color);
     PiCode.AddControls (rdsTab, color);
     PtyCode.AddControls (rdsTab, color);
+    AfList.AddControls (rdsTab, color);
+    RdsClockTime.AddControls (rdsTab, color);
+    TimeZone.AddControls (rdsTab, color);
     RdsReset.AddControls (rdsTab, color);
 
     // DEBUG_END;
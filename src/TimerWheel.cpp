@@ -0,0 +1,212 @@
+/*
+  *    File: TimerWheel.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  */
+
+// *********************************************************************************************
+#include "TimerWheel.hpp"
+
+// *********************************************************************************************
+// Cascade(): Move the timers of one upper level slot down to where they now belong.
+// Returns Index so the caller knows whether the next level has to cascade as well.
+uint32_t cTimerWheel::Cascade (Timer_t * (&Level)[LEVELN_SIZE], uint32_t Index)
+{
+    Timer_t * pTimer = Level[Index];
+
+    Level[Index] = nullptr;
+
+    while (pTimer)
+    {
+        Timer_t * pNext = pTimer->pNext;
+        Insert (*pTimer);
+        pTimer = pNext;
+    }
+
+    return Index;
+}
+
+// *********************************************************************************************
+// Insert(): File a timer by how far away it is. Overdue timers go into the next slot to run.
+void cTimerWheel::Insert (Timer_t & Timer)
+{
+    uint32_t Delta = Timer.Expires - CurrentTick;
+
+    if (int32_t (Delta) < 0)
+    {
+        Link (Level0[CurrentTick & (LEVEL0_SIZE - 1)], Timer);
+    }
+    else if (Delta < LEVEL0_SIZE)
+    {
+        Link (Level0[Timer.Expires & (LEVEL0_SIZE - 1)], Timer);
+    }
+    else if (Delta < (1UL << (LEVEL0_BITS + LEVELN_BITS)))
+    {
+        Link (Level1[(Timer.Expires >> LEVEL0_BITS) & (LEVELN_SIZE - 1)], Timer);
+    }
+    else
+    {
+        // Anything further out than the wheel reaches is parked in the last slot and re-filed later.
+        uint32_t Expires = (Delta > MAX_TICKS) ? (CurrentTick + MAX_TICKS) : Timer.Expires;
+        Link (Level2[(Expires >> (LEVEL0_BITS + LEVELN_BITS)) & (LEVELN_SIZE - 1)], Timer);
+    }
+}
+
+// *********************************************************************************************
+void cTimerWheel::Link (Timer_t * & pHead, Timer_t & Timer)
+{
+    Timer.pNext     = pHead;
+    Timer.ppPrev    = &pHead;
+
+    if (pHead)
+    {
+        pHead->ppPrev = &Timer.pNext;
+    }
+
+    pHead = &Timer;
+}
+
+// *********************************************************************************************
+// Poll(): Call from loop(). Runs every timer that is due by Now.
+void cTimerWheel::Poll (uint32_t Now)
+{
+    // _ DEBUG_START;
+
+    uint32_t Elapsed = Now - LastNow;
+
+    do  // once
+    {
+        if (!Started)
+        {
+            // First call. Time starts now.
+            LastNow = Now;
+            Started = true;
+            break;
+        }
+
+        if (Elapsed < TIMER_WHEEL_TICK_MS)
+        {
+            // Nothing can be due yet.
+            break;
+        }
+
+        uint32_t Ticks = Elapsed / TIMER_WHEEL_TICK_MS;
+        LastNow += Ticks * TIMER_WHEEL_TICK_MS;
+
+        if (0 == ActiveTimers)
+        {
+            CurrentTick += Ticks;
+            break;
+        }
+
+        while (Ticks--)
+        {
+            RunTick ();
+        }
+    } while (false);
+
+    // _ DEBUG_END;
+}
+
+// *********************************************************************************************
+uint32_t cTimerWheel::RemainingMs (const Timer_t & Timer)
+{
+    uint32_t Response = 0;
+
+    if (IsActive (Timer) && (int32_t (Timer.Expires - CurrentTick) > 0))
+    {
+        Response = (Timer.Expires - CurrentTick) * TIMER_WHEEL_TICK_MS;
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+// RunTick(): Advance the wheel one tick and run the timers in the slot that comes due.
+void cTimerWheel::RunTick ()
+{
+    uint32_t Index = CurrentTick & (LEVEL0_SIZE - 1);
+
+    if ((0 == Index) && (0 == Cascade (Level1, (CurrentTick >> LEVEL0_BITS) & (LEVELN_SIZE - 1))))
+    {
+        Cascade (Level2, (CurrentTick >> (LEVEL0_BITS + LEVELN_BITS)) & (LEVELN_SIZE - 1));
+    }
+
+    ++CurrentTick;
+
+    // Take the whole slot first. Callbacks may start or stop any timer, including the ones in this list.
+    pExpiring = Level0[Index];
+    Level0[Index] = nullptr;
+
+    if (pExpiring)
+    {
+        pExpiring->ppPrev = &pExpiring;
+    }
+
+    while (pExpiring)
+    {
+        Timer_t & Timer = *pExpiring;
+        Stop (Timer);
+
+        if (Timer.PeriodTicks)
+        {
+            // Re-arm from the scheduled time, not from now, so periodic timers do not drift.
+            Timer.Expires += Timer.PeriodTicks;
+            Insert (Timer);
+            ++ActiveTimers;
+        }
+
+        ++CallbacksRun;
+        Timer.Callback (Timer.Param);
+    }
+}
+
+// *********************************************************************************************
+void cTimerWheel::Start (Timer_t & Timer, uint32_t DelayMs, uint32_t PeriodMs, TimerCallback_t Callback, void * Param)
+{
+    // DEBUG_START;
+
+    Stop (Timer);
+
+    Timer.Callback      = Callback;
+    Timer.Param         = Param;
+    Timer.PeriodTicks   = (PeriodMs + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS;
+    Timer.Expires       = CurrentTick + ((DelayMs + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS);
+
+    Insert (Timer);
+    ++ActiveTimers;
+
+    // DEBUG_END;
+}
+
+// *********************************************************************************************
+void cTimerWheel::Stop (Timer_t & Timer)
+{
+    if (Timer.ppPrev)
+    {
+        *Timer.ppPrev = Timer.pNext;
+
+        if (Timer.pNext)
+        {
+            Timer.pNext->ppPrev = Timer.ppPrev;
+        }
+
+        Timer.pNext     = nullptr;
+        Timer.ppPrev    = nullptr;
+        --ActiveTimers;
+    }
+}
+
+// *********************************************************************************************
+cTimerWheel TimerWheel;
+
+// *********************************************************************************************
+// OEF
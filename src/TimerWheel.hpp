@@ -0,0 +1,87 @@
+#pragma once
+/*
+  *    File: TimerWheel.hpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Hierarchical timer wheel for the main loop. Components own their Timer_t objects and
+  *    register one shot or periodic callbacks. Poll() costs one compare when no tick has passed
+  *    and only visits the slots whose time has come. Starting and stopping a timer is O(1).
+  *      Level 0: 256 slots of TIMER_WHEEL_TICK_MS  (2.56 Secs)
+  *      Level 1:  64 slots of 256 ticks           (2.7 Mins)
+  *      Level 2:  64 slots of 16384 ticks         (2.9 Hours, longer timers are re-filed)
+  *    All time math is done on unsigned differences, so millis() wrap is harmless.
+  *    Callbacks run on the task that calls Poll(). This file does not depend on the Arduino framework.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+
+// *********************************************************************************************
+#define TIMER_WHEEL_TICK_MS 10
+
+// *********************************************************************************************
+class cTimerWheel
+{
+public:
+
+    typedef void (*TimerCallback_t)(void * Param);
+
+    struct Timer_t
+    {
+        Timer_t             * pNext     = nullptr;
+        Timer_t             ** ppPrev   = nullptr;  // Non null while the timer is armed.
+        uint32_t            Expires     = 0;        // In ticks.
+        uint32_t            PeriodTicks = 0;        // Zero for one shot timers.
+        TimerCallback_t     Callback    = nullptr;
+        void                * Param     = nullptr;
+    };
+
+    cTimerWheel ()  {}
+    virtual~cTimerWheel ()  {}
+
+    // Run Callback(Param) DelayMs from now and then every PeriodMs (0 == once). Re-arms a running timer.
+    void        Start (Timer_t & Timer, uint32_t DelayMs, uint32_t PeriodMs, TimerCallback_t Callback, void * Param);
+    void        Stop (Timer_t & Timer);
+    bool        IsActive (const Timer_t & Timer)    {return nullptr != Timer.ppPrev;}
+    uint32_t    RemainingMs (const Timer_t & Timer);
+    void        Poll (uint32_t Now);
+
+    uint32_t    ActiveTimers    = 0;
+    uint32_t    CallbacksRun    = 0;
+
+private:
+
+    static const uint8_t    LEVEL0_BITS = 8;
+    static const uint8_t    LEVELN_BITS = 6;
+    static const uint32_t   LEVEL0_SIZE = (1UL << LEVEL0_BITS);
+    static const uint32_t   LEVELN_SIZE = (1UL << LEVELN_BITS);
+    static const uint32_t   MAX_TICKS   = (1UL << (LEVEL0_BITS + (2 * LEVELN_BITS))) - 1;
+
+    void        Insert (Timer_t & Timer);
+    void        Link (Timer_t * & pHead, Timer_t & Timer);
+    uint32_t    Cascade (Timer_t * (&Level)[LEVELN_SIZE], uint32_t Index);
+    void        RunTick ();
+
+    Timer_t     * Level0[LEVEL0_SIZE]   = {nullptr};
+    Timer_t     * Level1[LEVELN_SIZE]   = {nullptr};
+    Timer_t     * Level2[LEVELN_SIZE]   = {nullptr};
+    Timer_t     * pExpiring             = nullptr;  // Timers being run by the current tick.
+    uint32_t    CurrentTick             = 0;
+    uint32_t    LastNow                 = 0;
+    bool        Started                 = false;
+};  // class cTimerWheel
+
+extern cTimerWheel TimerWheel;
+
+// *********************************************************************************************
+// OEF
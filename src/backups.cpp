@@ -63,6 +63,7 @@ bool checkEmergencyCredentials (const char * fileName)
     File    file;
     SPIClass SPI2 (HSPI);
 
+    sdCardLock (portMAX_DELAY);
     SPI2.begin (SD_CLK_PIN, MISO_PIN, MOSI_PIN, SD_CS_PIN);
     pinMode (MISO_PIN, INPUT_PULLUP);   // MISO requires internal pull-up.
     SD.end ();                          // Reset interface (in case SD card had been swapped).
@@ -72,10 +73,14 @@ bool checkEmergencyCredentials (const char * fileName)
     {
         SD.end ();
         spiSdCardShutDown ();
+        sdCardSetPresent (false);
+        sdCardUnlock ();
 
         return false;
     }
 
+    sdCardSetPresent (true);
+
     if (SD.exists (fileName))   // Found Special Credential File.
     {
         Log.infoln (F ("Restoring WiFi Credentials From SD Card ..."));
@@ -84,6 +89,7 @@ bool checkEmergencyCredentials (const char * fileName)
     {
         SD.end ();
         spiSdCardShutDown ();
+        sdCardUnlock ();
 
         return false;
     }
@@ -99,6 +105,7 @@ bool checkEmergencyCredentials (const char * fileName)
     SD.end ();
     // SPI2.end();
     spiSdCardShutDown ();
+    sdCardUnlock ();
 
     if (error)
     {
@@ -160,6 +167,7 @@ bool saveConfiguration (uint8_t saveMode, const char * fileName)
     else if (saveMode == SD_CARD_MODE)
     {
         Log.infoln ((String (F ("Backup Configuration to SD Card: '")) + String (fileName) + "'").c_str ());
+        sdCardLock (portMAX_DELAY);
         SPI2.begin (SD_CLK_PIN, MISO_PIN, MOSI_PIN, SD_CS_PIN);
         pinMode (MISO_PIN, INPUT_PULLUP);   // MISO requires internal pull-up.
         SD.end ();                          // Re-init Interface in case SD card had been swapped).
@@ -169,10 +177,13 @@ bool saveConfiguration (uint8_t saveMode, const char * fileName)
             Log.errorln (F ("-> SD Card failed Initialization, Aborted."));
             SD.end ();
             spiSdCardShutDown ();
+            sdCardSetPresent (false);
+            sdCardUnlock ();
 
             return false;
         }
 
+        sdCardSetPresent (true);
         // SD.remove(fileName);
         Log.infoln (F ("-> SD Card Type: %s"), SD.cardType () < SD_TYPE_CNT ? sdTypeStr[SD.cardType ()] : "Error");
         file = SD.open (fileName, FILE_WRITE);
@@ -193,6 +204,7 @@ bool saveConfiguration (uint8_t saveMode, const char * fileName)
             Log.errorln (F ("-> Failed to create SD Card file."));
             SD.end ();
             spiSdCardShutDown ();
+            sdCardUnlock ();
         }
         else
         {
@@ -262,6 +274,7 @@ bool saveConfiguration (uint8_t saveMode, const char * fileName)
     {
         SD.end ();
         spiSdCardShutDown ();
+        sdCardUnlock ();
     }
 
     doc.clear ();
@@ -285,6 +298,7 @@ bool restoreConfiguration (uint8_t restoreMode, const char * fileName)
     else if (restoreMode == SD_CARD_MODE)
     {
         Log.infoln (F ("Restore Configuration From SD Card ..."));
+        sdCardLock (portMAX_DELAY);
         SPI2.begin (SD_CLK_PIN, MISO_PIN, MOSI_PIN, SD_CS_PIN);
 
         pinMode (MISO_PIN, INPUT_PULLUP);   // MISO requires internal pull-up.
@@ -305,10 +319,14 @@ bool restoreConfiguration (uint8_t restoreMode, const char * fileName)
 
             SD.end ();
             spiSdCardShutDown ();
+            sdCardSetPresent (false);
+            sdCardUnlock ();
 
             return false;
         }
 
+        sdCardSetPresent (true);
+
         Log.infoln (F ("-> SD Card Type: %s"), SD.cardType () < SD_TYPE_CNT ? sdTypeStr[SD.cardType ()] : "Error");
         file = SD.open (fileName, FILE_READ);
     }
@@ -328,6 +346,7 @@ bool restoreConfiguration (uint8_t restoreMode, const char * fileName)
         {
             SD.end ();
             spiSdCardShutDown ();
+            sdCardUnlock ();
         }
 
         return false;
@@ -361,6 +380,7 @@ bool restoreConfiguration (uint8_t restoreMode, const char * fileName)
     {
         SD.end ();
         spiSdCardShutDown ();
+        sdCardUnlock ();
     }
 
     if (error)
@@ -77,6 +77,7 @@ void instalLogoImageFile (void)
     sprintf (logBuff, String (F ("Logo Gif File (%s) is Missing. Will Load it From the SD Card.")).c_str (), LOGO_GIF_NAME);
     Log.errorln (logBuff);
 
+    sdCardLock (portMAX_DELAY);
     SPI2.begin (SD_CLK_PIN, MISO_PIN, MOSI_PIN, SD_CS_PIN);
     pinMode (MISO_PIN, INPUT_PULLUP);   // MISO requires internal pull-up.
     SD.end ();                          // Reset interface (in case SD card had been swapped).
@@ -85,6 +86,8 @@ void instalLogoImageFile (void)
     {
         SD.end ();
         spiSdCardShutDown ();
+        sdCardSetPresent (false);
+        sdCardUnlock ();
 
         sprintf (logBuff, String (F ("-> SD Card Not Installed. Cannot Load Missing Logo Gif File.")).c_str ());
         Log.errorln (logBuff);
@@ -92,6 +95,8 @@ void instalLogoImageFile (void)
         return;  // No SD Card, nothing to do, exit.
     }
 
+    sdCardSetPresent (true);
+
     File sdcImageFile;  // SD Card Image File.
 
     sdcImageFile    = SD.open (LOGO_GIF_NAME, FILE_READ);
@@ -109,6 +114,7 @@ void instalLogoImageFile (void)
         sdcImageFile.close ();
         SD.end ();
         spiSdCardShutDown ();
+        sdCardUnlock ();
         sprintf (logBuff, String (F ("-> Bad/Missing SD Card Logo File.")).c_str ());
         Log.errorln (logBuff);
 
@@ -153,6 +159,7 @@ void instalLogoImageFile (void)
     sdcImageFile.close ();
     SD.end ();
     spiSdCardShutDown ();
+    sdCardUnlock ();
 
     littlefsInit ();
 }
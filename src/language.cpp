@@ -34,9 +34,13 @@ const PROGMEM char  CSS_LABEL_STYLE_WHITE          []  = "background-color: unse
 
 const PROGMEM char  N_About                    []   = "About";
 const PROGMEM char  N_About_PixelRadio         []   = "About PixelRadio";
+const PROGMEM char  N_AntHigh                  []   = "AntHigh";
+const PROGMEM char  N_AntLow                   []   = "AntLow";
 const PROGMEM char  N_BAUDRATE                 []   = "BAUDRATE";
 const PROGMEM char  N_Baudrate                 []   = "Baudrate";
 const PROGMEM char  N_br                       []   = "<br>";
+const PROGMEM char  N_Cid1                     []   = "Cid1";
+const PROGMEM char  N_Cid2                     []   = "Cid2";
 const PROGMEM char  N_ControllerEnabled        []   = "ControllerEnabled";
 const PROGMEM char  N_command                  []   = "command";
 const PROGMEM char  N_controllers              []   = "controllers";
@@ -45,19 +49,31 @@ const PROGMEM char  N_DisplayFseqName          []   = "DisplayFseqName";
 const PROGMEM char  N_durationSec              []   = "durationSec";
 const PROGMEM char  N_Enable                   []   = "Enable";
 const PROGMEM char  N_enabled                  []   = "enabled";
+const PROGMEM char  N_Frequency                []   = "Frequency";
+const PROGMEM char  N_histogram                []   = "histogram";
 const PROGMEM char  N_list                     []   = "list";
+const PROGMEM char  N_max                      []   = "max";
 const PROGMEM char  N_MaxIdleSec               []   = "MaxIdleSec";
 const PROGMEM char  N_message                  []   = "message";
 const PROGMEM char  N_messages                 []   = "messages";
 const PROGMEM char  N_Messages                 []   = "Messages";
+const PROGMEM char  N_min                      []   = "min";
 const PROGMEM char  N_name                     []   = "name";
+const PROGMEM char  N_PaBand                   []   = "PaBand";
 const PROGMEM char  N_path                     []   = "path";
 const PROGMEM char  N_PayloadTest              []   = "PayloadTest";
+const PROGMEM char  N_peak                     []   = "peak";
 const PROGMEM char  N_PixelRadio               []   = "PixelRadio";
 const PROGMEM char  N_ProgramServiceName       []   = "ProgramServiceName";
+const PROGMEM char  N_rms                      []   = "rms";
+const PROGMEM char  N_sampleRateHz             []   = "sampleRateHz";
+const PROGMEM char  N_samples                  []   = "samples";
+const PROGMEM char  N_schedule                 []   = "schedule";
 const PROGMEM char  N_sequences                []   = "sequences";
+const PROGMEM char  N_silentMs                 []   = "silentMs";
 const PROGMEM char  N_type                     []   = "type";
 const PROGMEM char  N_Version                  []   = "Version";
+const PROGMEM char  N_window                   []   = "window";
 
 // Controller Command Keywords
 const PROGMEM char  CMD_AUDMODE_STR           []    = "aud";    // Radio Stereo / Mono Audio Mode.
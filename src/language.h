@@ -84,9 +84,13 @@ extern const PROGMEM char   CSS_LABEL_STYLE_WHITE[];
 
 extern const PROGMEM char   N_About[];
 extern const PROGMEM char   N_About_PixelRadio[];
+extern const PROGMEM char   N_AntHigh[];
+extern const PROGMEM char   N_AntLow[];
 extern const PROGMEM char   N_BAUDRATE[];
 extern const PROGMEM char   N_Baudrate[];
 extern const PROGMEM char   N_br[];
+extern const PROGMEM char   N_Cid1[];
+extern const PROGMEM char   N_Cid2[];
 extern const PROGMEM char   N_ControllerEnabled[];
 extern const PROGMEM char   N_controllers[];
 extern const PROGMEM char   N_command[];
@@ -95,21 +99,33 @@ extern const PROGMEM char   N_DisplayFseqName[];
 extern const PROGMEM char   N_durationSec[];
 extern const PROGMEM char   N_Enable[];
 extern const PROGMEM char   N_enabled[];
+extern const PROGMEM char   N_Frequency[];
+extern const PROGMEM char   N_histogram[];
 extern const PROGMEM char   N_list[];
+extern const PROGMEM char   N_max[];
 extern const PROGMEM char   N_MaxIdleSec[];
 extern const PROGMEM char   N_message[];
 extern const PROGMEM char   N_messages[];
 extern const PROGMEM char   N_Messages[];
+extern const PROGMEM char   N_min[];
 extern const PROGMEM char   N_MQTT_IP_STR[];
 extern const PROGMEM char   N_MQTT_USER_STR[];
 extern const PROGMEM char   N_name[];
+extern const PROGMEM char   N_PaBand[];
 extern const PROGMEM char   N_path[];
 extern const PROGMEM char   N_PayloadTest[];
+extern const PROGMEM char   N_peak[];
 extern const PROGMEM char   N_PixelRadio[];
+extern const PROGMEM char   N_rms[];
+extern const PROGMEM char   N_sampleRateHz[];
+extern const PROGMEM char   N_samples[];
+extern const PROGMEM char   N_schedule[];
 extern const PROGMEM char   N_sequences[];
 extern const PROGMEM char   N_SequenceLearningEnabled[];
+extern const PROGMEM char   N_silentMs[];
 extern const PROGMEM char   N_type[];
 extern const PROGMEM char   N_Version[];
+extern const PROGMEM char   N_window[];
 
 // Controller Command Keywords
 extern const PROGMEM char   CMD_AUDMODE_STR[];
@@ -21,6 +21,11 @@
 #include <EEPROM.h>
 #include <SPI.h>
 #include <Wire.h>
+#include <atomic>
+
+// *********************************************************************************************
+static SemaphoreHandle_t    SdCardSemaphore = xSemaphoreCreateMutex ();
+static std::atomic <bool>   SdCardFound     {true};  // Assume a card until a mount attempt fails.
 
 // *********************************************************************************************
 // *********************************************************************************************
@@ -58,3 +63,32 @@ void spiSdCardShutDown (void)
     pinMode (   MOSI_PIN,   INPUT_PULLUP);      // SD CMD, Allow pin to Pullup High (for reliable Flashing).
     pinMode (   SD_CLK_PIN, INPUT_PULLUP);      // SD CLK.
 }
+
+// *********************************************************************************************
+// sdCardLock(): Take the SD card before SD.begin() and keep it until spiSdCardShutDown().
+// Backups run from UI callbacks while the FSEQ header cache reads the card on the loop task.
+// Returns false if another user still has the card after WaitMs.
+bool sdCardLock (uint32_t WaitMs)
+{
+    return pdTRUE == xSemaphoreTake (SdCardSemaphore, (portMAX_DELAY == WaitMs) ? portMAX_DELAY : pdMS_TO_TICKS (WaitMs));
+}
+
+// *********************************************************************************************
+void sdCardUnlock (void)
+{
+    xSemaphoreGive (SdCardSemaphore);
+}
+
+// *********************************************************************************************
+// sdCardPresent(): Result of the last SD.begin(). Background readers skip the card when it is
+// false. A backup or restore from the UI always tries the card, so inserting one is noticed.
+bool sdCardPresent (void)
+{
+    return SdCardFound;
+}
+
+// *********************************************************************************************
+void sdCardSetPresent (bool Present)
+{
+    SdCardFound = Present;
+}
@@ -204,6 +204,9 @@ void buildGUI (void)
     uint16_t    diagTab     = ESPUI.addControl (ControlType::Tab, "DIAG", DIAG_TAB_STR);
     uint16_t    aboutTab    = ESPUI.addControl (ControlType::Tab, "ABOUT", N_About);
 
+    // Creating the radio controls pushes every saved setting to the radio. Apply them as one update.
+    Radio.beginUpdate ();
+
     // ************
     // Home Tab
     ESPUI.addControl (ControlType::Separator, HOME_FM_SEP_STR, emptyString, ControlColor::None, homeTab);
@@ -226,6 +229,7 @@ void buildGUI (void)
     ESPUI.addControl (ControlType::Separator, RDS_GENERAL_SET_STR, emptyString, ControlColor::None, rdsTab);
     Radio.AddRdsControls (rdsTab, ControlColor::Alizarin);
     ConfigSave.AddControls (rdsTab, ControlColor::Alizarin);
+    Radio.commit ();
 
     //
     // *************
@@ -0,0 +1,150 @@
+#pragma once
+/*
+  *    File: Arduino.h
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Host (env:native) stand-in for the parts of the Arduino core and FreeRTOS that the hardware
+  *    independent modules use. millis() runs on a simulated clock that only delay() and the tests
+  *    move, so timing tests are exact and fast. Semaphores are real mutexes so the multi-threaded
+  *    stress tests see the same locking as the target.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// *********************************************************************************************
+#define PROGMEM
+#define F(s)            (s)
+#define FPSTR(s)        (s)
+#define HIGH            1
+#define LOW             0
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define INPUT_PULLDOWN  3
+
+typedef bool boolean;
+
+// *********************************************************************************************
+// Simulated clock
+inline uint32_t & MockMillis ()   {static uint32_t Now = 0; return Now;}
+inline uint32_t & MockMicros ()   {static uint32_t Now = 0; return Now;}
+
+inline uint32_t millis ()                       {return MockMillis ();}
+inline uint32_t micros ()                       {return MockMicros () + (MockMillis () * 1000);}
+inline void     delay (uint32_t Ms)             {MockMillis () += Ms;}
+inline void     delayMicroseconds (uint32_t Us) {MockMicros () += Us;}
+inline void     yield ()                        {}
+inline void     pinMode (uint8_t, uint8_t)      {}
+inline void     digitalWrite (uint8_t, uint8_t) {}
+
+// *********************************************************************************************
+class String
+{
+public:
+
+    String ()                               {}
+    String (const char * Text) : Value (Text ? Text : "") {}
+    String (const std::string & Text) : Value (Text) {}
+    String (char c) : Value (1, c) {}
+    String (int Number) : Value (std::to_string (Number)) {}
+    String (unsigned Number) : Value (std::to_string (Number)) {}
+    String (long Number) : Value (std::to_string (Number)) {}
+    String (unsigned long Number) : Value (std::to_string (Number)) {}
+
+    const char *    c_str () const                      {return Value.c_str ();}
+    unsigned        length () const                     {return unsigned (Value.length ());}
+    bool            isEmpty () const                    {return Value.empty ();}
+    bool            equals (const String & s) const     {return Value == s.Value;}
+    bool            concat (const char * s, unsigned n) {Value.append (s, n); return true;}
+    bool            concat (const String & s)           {Value.append (s.Value); return true;}
+    void            reserve (unsigned n)                {Value.reserve (n);}
+    char            operator [] (unsigned i) const      {return (i < Value.length ()) ? Value[i] : 0;}
+    String          substring (unsigned From) const     {return (From < Value.length ()) ? String (Value.substr (From)) : String ();}
+    String          substring (unsigned From, unsigned To) const {return (From < To && From < Value.length ()) ? String (Value.substr (From, To - From)) : String ();}
+    int             indexOf (char c) const              {size_t p = Value.find (c); return (std::string::npos == p) ? -1 : int (p);}
+    int             indexOf (char c, unsigned From) const   {size_t p = Value.find (c, From); return (std::string::npos == p) ? -1 : int (p);}
+    int             indexOf (const String & s) const    {size_t p = Value.find (s.Value); return (std::string::npos == p) ? -1 : int (p);}
+    int             lastIndexOf (const char * s) const  {size_t p = Value.rfind (s); return (std::string::npos == p) ? -1 : int (p);}
+    void            toLowerCase ()                      {for (auto & c : Value) {c = char (tolower (c));}}
+    void            toUpperCase ()                      {for (auto & c : Value) {c = char (toupper (c));}}
+    void            trim ()                             {size_t b = Value.find_first_not_of (" \t\r\n"); size_t e = Value.find_last_not_of (" \t\r\n"); Value = (std::string::npos == b) ? std::string () : Value.substr (b, e - b + 1);}
+    long            toInt () const                      {return atol (Value.c_str ());}
+    float           toFloat () const                    {return float (atof (Value.c_str ()));}
+
+    String &        operator += (const String & s)      {Value += s.Value; return *this;}
+    String &        operator += (const char * s)        {Value += s; return *this;}
+    String &        operator += (char c)                {Value += c; return *this;}
+    bool            operator == (const String & s) const {return Value == s.Value;}
+    bool            operator == (const char * s) const  {return Value == s;}
+    bool            operator != (const String & s) const {return Value != s.Value;}
+    bool            operator < (const String & s) const {return Value < s.Value;}
+
+    friend String   operator + (const String & a, const String & b) {return String (a.Value + b.Value);}
+    friend String   operator + (const String & a, const char * b)   {return String (a.Value + b);}
+    friend String   operator + (const char * a, const String & b)   {return String (a + b.Value);}
+
+private:
+
+    std::string Value;
+};  // class String
+
+inline const String emptyString;
+
+// *********************************************************************************************
+// FreeRTOS
+typedef uint32_t                    TickType_t;
+typedef int                         BaseType_t;
+typedef unsigned                    UBaseType_t;
+typedef std::recursive_timed_mutex  * SemaphoreHandle_t;
+typedef void                        * TaskHandle_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              1
+#define portMAX_DELAY       TickType_t (0xffffffffUL)
+#define pdMS_TO_TICKS(ms)   TickType_t (ms)
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex ()           {return new std::recursive_timed_mutex;}
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex ()  {return new std::recursive_timed_mutex;}
+inline void vSemaphoreDelete (SemaphoreHandle_t Sem)        {delete Sem;}
+
+inline BaseType_t xSemaphoreTake (SemaphoreHandle_t Sem, TickType_t Ticks)
+{
+    if (portMAX_DELAY == Ticks)
+    {
+        Sem->lock ();
+        return pdTRUE;
+    }
+
+    return Sem->try_lock_for (std::chrono::milliseconds (Ticks)) ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t   xSemaphoreGive (SemaphoreHandle_t Sem)                              {Sem->unlock (); return pdTRUE;}
+inline BaseType_t   xSemaphoreTakeRecursive (SemaphoreHandle_t Sem, TickType_t Ticks)   {return xSemaphoreTake (Sem, Ticks);}
+inline BaseType_t   xSemaphoreGiveRecursive (SemaphoreHandle_t Sem)                     {return xSemaphoreGive (Sem);}
+inline void         vTaskDelay (TickType_t Ticks)                                       {std::this_thread::sleep_for (std::chrono::milliseconds (Ticks));}
+inline void         xTaskNotifyGive (TaskHandle_t)                                      {}
+inline TaskHandle_t xTaskGetCurrentTaskHandle ()                                       {static thread_local char Task; return &Task;}
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,40 @@
+#pragma once
+/*
+  *    File: ArduinoLog.h
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Host (env:native) stand-in for ArduinoLog. Messages are counted, not printed.
+  */
+
+// *********************************************************************************************
+#include <stdint.h>
+
+// *********************************************************************************************
+class Logging
+{
+public:
+
+    template <typename ... Args> void   errorln (Args ...)      {++Errors;}
+    template <typename ... Args> void   warningln (Args ...)    {++Warnings;}
+    template <typename ... Args> void   noticeln (Args ...)     {}
+    template <typename ... Args> void   infoln (Args ...)       {}
+    template <typename ... Args> void   traceln (Args ...)      {}
+    template <typename ... Args> void   verboseln (Args ...)    {}
+
+    uint32_t    Errors      = 0;
+    uint32_t    Warnings    = 0;
+};  // class Logging
+
+static Logging Log;
+
+// *********************************************************************************************
+// OEF
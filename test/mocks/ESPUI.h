@@ -0,0 +1,133 @@
+#pragma once
+/*
+  *    File: ESPUI.h
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Host (env:native) stand-in for ESPUI. Controls are kept in a map so getControl() works and
+  *    values written by update calls can be read back. Nothing is sent anywhere. The map has its
+  *    own lock, like the real library, because the stress tests add controls from several threads.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+#include <functional>
+#include <map>
+#include <mutex>
+
+// *********************************************************************************************
+enum ControlType : uint8_t
+{
+    Title, Pad, PadWithCenter, Button, Label, Switcher, Slider, Number, Text, Graph, GraphPoint,
+    Tab, Select, Option, Min, Max, Step, Gauge, Accel, Separator, Time, Password, UpdateOffset = 100
+};
+
+enum ControlColor : uint8_t
+{
+    Turquoise, Emerald, Peterriver, Wetasphalt, Sunflower, Carrot, Alizarin, Dark, None = 0xFF
+};
+
+enum
+{
+    B_DOWN = -1, B_UP = 1, S_ACTIVE = 7, S_INACTIVE = 8, SL_VALUE = 9, N_VALUE = 10, T_VALUE = 11, M_VALUE = 12
+};
+
+// *********************************************************************************************
+class Control
+{
+public:
+
+    static const uint16_t noParent = 0xffff;
+
+    std::function <void(Control *, int)>    callback = nullptr;
+    ControlType     type            = Title;
+    ControlColor    color           = None;
+    bool            visible         = true;
+    bool            enabled         = true;
+    uint16_t        id              = noParent;
+    uint16_t        parentControl   = noParent;
+    String          value;
+    String          label;
+    String          panelStyle;
+    String          elementStyle;
+};  // class Control
+
+// *********************************************************************************************
+class ESPUIClass
+{
+public:
+
+    uint16_t addControl (ControlType type, const char * label, const String & value = emptyString, ControlColor color = None,
+                         uint16_t parent = Control::noParent, std::function <void(Control *, int)> callback = nullptr)
+    {
+        std::lock_guard <std::recursive_mutex> Lock (Mutex);
+        Control & NewControl = Controls[NextId];
+
+        NewControl.id               = NextId;
+        NewControl.type             = type;
+        NewControl.label            = label;
+        NewControl.value            = value;
+        NewControl.color            = color;
+        NewControl.parentControl    = parent;
+        NewControl.callback         = callback;
+
+        return NextId++;
+    }
+
+    Control * getControl (uint16_t id)
+    {
+        std::lock_guard <std::recursive_mutex> Lock (Mutex);
+        auto Entry = Controls.find (id);
+
+        return (Controls.end () == Entry) ? nullptr : &Entry->second;
+    }
+
+    void removeControl (uint16_t id, bool = false)                  {std::lock_guard <std::recursive_mutex> Lock (Mutex); Controls.erase (id);}
+    void updateControl (Control *, int = -1)                        {}
+    void updateControl (uint16_t, int = -1)                         {}
+    void updateControlValue (uint16_t id, const String & value)     {Set (id, value);}
+    void updateControlLabel (uint16_t id, const char * label)       {Control * pControl = getControl (id); if (pControl) {pControl->label = label;}}
+    void updateText (uint16_t id, const String & value)             {Set (id, value);}
+    void updateSelect (uint16_t id, const String & value)           {Set (id, value);}
+    void updateNumber (uint16_t id, long value)                     {Set (id, String (value));}
+    void updateSwitcher (uint16_t id, bool value)                   {Set (id, String (value ? "1" : "0"));}
+    void print (uint16_t id, const String & value)                  {Set (id, value);}
+    void updateVisibility (uint16_t id, bool visible)               {Control * pControl = getControl (id); if (pControl) {pControl->visible = visible;}}
+    void setEnabled (uint16_t id, bool enabled)                     {Control * pControl = getControl (id); if (pControl) {pControl->enabled = enabled;}}
+    void setElementStyle (uint16_t, const String &)                 {}
+    void setPanelStyle (uint16_t, const String &)                   {}
+    void jsonDom (uint16_t, void * = nullptr, bool = false)         {++Refreshes;}
+    void jsonReload ()                                              {++Refreshes;}
+
+    uint32_t Refreshes = 0;
+
+private:
+
+    void Set (uint16_t id, const String & value)
+    {
+        std::lock_guard <std::recursive_mutex> Lock (Mutex);
+        Control * pControl = getControl (id);
+
+        if (pControl)
+        {
+            pControl->value = value;
+        }
+    }
+
+    std::recursive_mutex            Mutex;
+    std::map <uint16_t, Control>    Controls;
+    uint16_t                        NextId = 1;
+};  // class ESPUIClass
+
+static ESPUIClass ESPUI;
+
+// *********************************************************************************************
+// OEF
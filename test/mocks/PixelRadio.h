@@ -0,0 +1,26 @@
+#pragma once
+/*
+  *    File: PixelRadio.h
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Host (env:native) stand-in for PixelRadio.h. The real one pulls in the web UI and WiFi.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+
+// *********************************************************************************************
+inline bool SystemBooting = false;
+inline void displaySaveWarning ()   {}
+
+// *********************************************************************************************
+// OEF
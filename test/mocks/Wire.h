@@ -0,0 +1,119 @@
+#pragma once
+/*
+  *    File: Wire.h
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Host (env:native) stand-in for the Arduino Wire library. It behaves like an I2C device with
+  *    auto-incrementing registers (the QN8027) and counts bus transactions. A test can hook reads
+  *    and writes to simulate the chip, e.g. the FSM state in STATUS_REG.
+  */
+
+// *********************************************************************************************
+#include <Arduino.h>
+
+// *********************************************************************************************
+class TwoWire
+{
+public:
+
+    static const uint8_t REG_COUNT = 0x20;
+
+    void        begin (int = -1, int = -1)  {}
+    void        setClock (uint32_t)         {}
+    void        beginTransmission (uint8_t) {Writing = true; AddressSent = false;}
+
+    size_t write (uint8_t Data)
+    {
+        if (!AddressSent)
+        {
+            Pointer     = Data;
+            AddressSent = true;
+        }
+        else
+        {
+            Registers[Pointer % REG_COUNT] = Data;
+
+            if (OnWrite)
+            {
+                OnWrite (Pointer % REG_COUNT, Data);
+            }
+
+            ++BytesWritten;
+            ++Pointer;
+        }
+
+        return 1;
+    }
+
+    size_t write (const uint8_t * Data, size_t Length)
+    {
+        for (size_t Index = 0;Index < Length;++Index)
+        {
+            write (Data[Index]);
+        }
+
+        return Length;
+    }
+
+    uint8_t endTransmission (bool = true)
+    {
+        if (Writing)
+        {
+            ++Transactions;
+            Writing = false;
+        }
+
+        return 0;
+    }
+
+    uint8_t requestFrom (uint8_t, uint8_t Count)
+    {
+        ++Transactions;
+        Available = Count;
+        return Count;
+    }
+
+    int available ()    {return Available;}
+
+    int read ()
+    {
+        uint8_t Response = OnRead ? OnRead (Pointer % REG_COUNT) : Registers[Pointer % REG_COUNT];
+
+        ++BytesRead;
+        ++Pointer;
+        Available = (Available > 0) ? (Available - 1) : 0;
+
+        return Response;
+    }
+
+    void ResetCounters ()   {Transactions = 0; BytesWritten = 0; BytesRead = 0;}
+
+    uint8_t     Registers[REG_COUNT] = {0};
+    uint32_t    Transactions    = 0;
+    uint32_t    BytesWritten    = 0;
+    uint32_t    BytesRead       = 0;
+
+    std::function <uint8_t(uint8_t Reg)>            OnRead  = nullptr;
+    std::function <void(uint8_t Reg, uint8_t Data)> OnWrite = nullptr;
+
+private:
+
+    bool    Writing     = false;
+    bool    AddressSent = false;
+    uint8_t Pointer     = 0;
+    int     Available   = 0;
+};  // class TwoWire
+
+static TwoWire Wire;
+
+// *********************************************************************************************
+// OEF
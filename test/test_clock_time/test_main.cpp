@@ -0,0 +1,377 @@
+/*
+  *    File: test_main.cpp (test_clock_time)
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    RDS 4A clock time on a simulated clock. The minute timer runs on a timer wheel polled the
+  *    way loop() polls it, the radio streams PS / RadioText to a simulated chip, and every group
+  *    the chip takes is logged against the wall clock. Checks how close to each minute edge CT
+  *    goes on air, what happens when the clock drifts or is stepped, and what CT costs the PS and
+  *    RadioText groups. Run with: pio test -e native -f test_clock_time
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <vector>
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/QN8027Radio.cpp"
+#include "../../src/TimerWheel.cpp"
+#include "../../src/MinuteTimer.cpp"
+
+// *********************************************************************************************
+static const uint64_t   WALL_BASE_MS    = 1672531200000ULL + 17123;   // Jan 1 2023, 17 seconds into a minute.
+static const uint32_t   LOOP_MS         = 5;                        // loop() pass time.
+static const uint32_t   GROUP_MS        = 88;                       // One group on air.
+
+// Wall clock = WALL_BASE_MS + millis () scaled by DriftPpm, plus StepMs. Zero means "not set".
+static bool     ClockSet    = true;
+static int32_t  DriftPpm    = 0;
+static int64_t  StepMs      = 0;
+
+static uint64_t WallClockMs ()
+{
+    if (!ClockSet)
+    {
+        return 0;
+    }
+
+    int64_t Now = int64_t (millis ());
+
+    return uint64_t (int64_t (WALL_BASE_MS) + Now + ((Now * DriftPpm) / 1000000) + StepMs);
+}
+
+// Every group the chip took, with the wall clock at that moment.
+struct Loaded_t
+{
+    uint64_t    WallMs;
+    uint8_t     Group[RDS_GROUP_SIZE];
+};
+
+static std::vector <Loaded_t>   Loaded;
+
+static uint8_t GroupType (const uint8_t * Group)   {return Group[2] >> 4;}
+
+// Simulated chip: the RDS sent bit toggles one group time after the ready bit toggles.
+static uint32_t LoadTime    = 0;
+static uint8_t  SentBit     = 0;
+static uint8_t  LastReady   = 0;
+
+static void AttachChip ()
+{
+    LoadTime    = millis ();
+    SentBit     = 0;
+    LastReady   = 0;
+    Loaded.clear ();
+
+    Wire.OnWrite = [] (uint8_t Reg, uint8_t Data)
+                   {
+                       if ((SYSTEM_REG == Reg) && ((Data & 0x04) != LastReady))
+                       {
+                           Loaded_t Entry;
+
+                           LastReady    = Data & 0x04;
+                           LoadTime     = millis ();
+                           Entry.WallMs = WallClockMs ();
+                           memcpy (Entry.Group, &Wire.Registers[RDSD0_REG], RDS_GROUP_SIZE);
+                           Loaded.push_back (Entry);
+                       }
+                   };
+
+    Wire.OnRead = [] (uint8_t Reg) -> uint8_t
+                  {
+                      if (STATUS_REG != Reg)
+                      {
+                          return Wire.Registers[Reg];
+                      }
+
+                      if ((millis () - LoadTime) >= GROUP_MS)
+                      {
+                          SentBit   ^= RDS_SENT_MASK;
+                          LoadTime  = millis () + 0x40000000;   // toggle once per load
+                      }
+
+                      return FSM_STATE_TRANSMIT | SentBit;
+                  };
+}
+
+static void DetachChip ()
+{
+    Wire.OnWrite    = nullptr;
+    Wire.OnRead     = nullptr;
+}
+
+// *********************************************************************************************
+// The station: the minute timer sends CT the way cRdsClockTime does, the radio task keeps the
+// transmit queue topped up with the PS and RadioText groups.
+struct Station_t
+{
+    QN8027Radio     Radio;
+    cRdsEncoder     Encoder;
+    cTimerWheel     Wheel;
+    cMinuteTimer    Minutes;
+    bool            SendCt      = true;
+    uint32_t        NextGroup   = 0;
+
+    static void SendMinute (void * pThis, time_t UtcMinute)
+    {
+        Station_t * pStation = static_cast <Station_t *>(pThis);
+
+        if (pStation->SendCt)
+        {
+            struct tm UtcTm;
+            gmtime_r (&UtcMinute, &UtcTm);
+
+            uint32_t Mjd = cRdsEncoder::ModifiedJulianDay (uint16_t (UtcTm.tm_year + 1900), uint8_t (UtcTm.tm_mon + 1), uint8_t (UtcTm.tm_mday));
+            pStation->Radio.sendClockTime (Mjd, uint8_t (UtcTm.tm_hour), uint8_t (UtcTm.tm_min), 2);
+        }
+    }
+
+    void begin ()
+    {
+        Encoder.SetPiCode (0x1234);
+        Encoder.SetProgramServiceName ("PIXLRADO");
+        Encoder.SetRadioText ("PixelRadio clock time test, a RadioText that needs all sixteen groups!!");
+        Radio.sendRDSGroup (Encoder.GetPsGroup (0));     // settle SYSTEM_REG in the shadow
+        AttachChip ();
+        Minutes.begin (Wheel, WallClockMs, SendMinute, this);
+    }
+
+    void Run (uint32_t Ms)
+    {
+        uint32_t    PsCount = Encoder.GetPsGroupCount ();
+        uint32_t    Count   = PsCount + Encoder.GetRtGroupCount ();
+
+        for (uint32_t Elapsed = 0;Elapsed < Ms;Elapsed += LOOP_MS)
+        {
+            Wheel.Poll (millis ());
+
+            while (Radio.pendingRDSGroups () < 4)
+            {
+                uint32_t Index = NextGroup++ % Count;
+                Radio.queueRDSGroup ((Index < PsCount) ? Encoder.GetPsGroup (uint8_t (Index)) : Encoder.GetRtGroup (uint8_t (Index - PsCount)));
+            }
+
+            Radio.pollRDS ();
+            delay (LOOP_MS);
+        }
+    }
+};
+
+// Decoded 4A group.
+static uint64_t CtMinute (const uint8_t * Group)
+{
+    uint16_t    Block2  = uint16_t ((Group[2] << 8) | Group[3]);
+    uint16_t    Block3  = uint16_t ((Group[4] << 8) | Group[5]);
+    uint16_t    Block4  = uint16_t ((Group[6] << 8) | Group[7]);
+    uint32_t    Mjd     = (uint32_t (Block2 & 0x03) << 15) | (Block3 >> 1);
+    uint32_t    Hour    = (uint32_t (Block3 & 0x01) << 4) | (Block4 >> 12);
+    uint32_t    Minute  = (Block4 >> 6) & 0x3F;
+
+    // MJD 40587 == Jan 1 1970.
+    return (((uint64_t (Mjd - 40587) * 24) + Hour) * 60) + Minute;
+}
+
+// Error of every CT group against the minute it carries. Returns the worst (absolute) value.
+static int64_t CtErrors (uint32_t & CtGroups, int64_t & Earliest)
+{
+    int64_t Worst = 0;
+
+    CtGroups    = 0;
+    Earliest    = INT64_MAX;
+
+    for (auto & Entry : Loaded)
+    {
+        if (cRdsEncoder::GroupType_CT != GroupType (Entry.Group))
+        {
+            continue;
+        }
+
+        int64_t Error = int64_t (Entry.WallMs) - int64_t (CtMinute (Entry.Group) * MS_PER_MINUTE);
+        Worst       = (llabs (Error) > llabs (Worst)) ? Error : Worst;
+        Earliest    = (Error < Earliest) ? Error : Earliest;
+        ++CtGroups;
+    }
+
+    return Worst;
+}
+
+// *********************************************************************************************
+// One CT group per minute edge, on air within one group time plus the timer tick and the loop pass.
+void test_minute_edge_accuracy ()
+{
+    const uint32_t Minutes = 30;
+
+    for (int32_t Drift : {0, 200, -200})
+    {
+        Station_t Station;
+
+        MockMillis ()   = 0;
+        ClockSet        = true;
+        DriftPpm        = Drift;
+        StepMs          = 0;
+
+        Station.begin ();
+        Station.Run (Minutes * 60 * 1000);
+        DetachChip ();
+
+        uint32_t    CtGroups;
+        int64_t     Earliest;
+        int64_t     Worst = CtErrors (CtGroups, Earliest);
+
+        char Message[120];
+        snprintf (Message, sizeof (Message), "drift %+d ppm: %u CT groups in %u minutes, on air %+lld..%+lld mS from the minute edge",
+                  int(Drift), unsigned(CtGroups), unsigned(Minutes), (long long)(Earliest), (long long)(Worst));
+        TEST_MESSAGE (Message);
+
+        TEST_ASSERT_EQUAL_UINT32 (Minutes, CtGroups);
+        TEST_ASSERT_EQUAL_UINT32 (Minutes, Station.Minutes.MinutesSent);
+        TEST_ASSERT_EQUAL_UINT32 (0, Station.Minutes.MinutesMissed);
+        TEST_ASSERT_EQUAL_UINT32 (0, Station.Radio.RdsGroupsDropped);
+        TEST_ASSERT_GREATER_OR_EQUAL (-20, Earliest);
+        TEST_ASSERT_LESS_OR_EQUAL (GROUP_MS + (2 * TIMER_WHEEL_TICK_MS) + (2 * LOOP_MS), Worst);
+    }
+}
+
+// *********************************************************************************************
+// No CT before the clock is set. A step mid-minute costs at most that minute, never a wrong time.
+void test_unset_and_stepped_clock ()
+{
+    Station_t Station;
+
+    MockMillis ()   = 0;
+    ClockSet        = false;
+    DriftPpm        = 0;
+    StepMs          = 0;
+
+    Station.begin ();
+    Station.Run (2 * 60 * 1000);
+
+    uint32_t    CtGroups;
+    int64_t     Earliest;
+    CtErrors (CtGroups, Earliest);
+    TEST_ASSERT_EQUAL_UINT32 (0, CtGroups);
+    TEST_ASSERT_EQUAL_UINT32 (0, Station.Minutes.MinutesSent);
+
+    // SNTP sets the clock.
+    ClockSet = true;
+    Station.Run (3 * 60 * 1000);
+    TEST_ASSERT_GREATER_OR_EQUAL (2, Station.Minutes.MinutesSent);
+
+    // SNTP steps the clock 20 seconds ahead, then back again.
+    uint32_t Sent = Station.Minutes.MinutesSent;
+    StepMs = 20 * 1000;
+    Station.Run (3 * 60 * 1000);
+    StepMs = 0;
+    Station.Run (3 * 60 * 1000);
+    DetachChip ();
+
+    int64_t Worst = CtErrors (CtGroups, Earliest);
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "%u CT groups, %u minutes missed after two clock steps, on air %+lld..%+lld mS from the minute edge",
+              unsigned(CtGroups), unsigned(Station.Minutes.MinutesMissed), (long long)(Earliest), (long long)(Worst));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_LESS_OR_EQUAL (2, Station.Minutes.MinutesMissed);
+    TEST_ASSERT_GREATER_OR_EQUAL (Sent + 4, Station.Minutes.MinutesSent);
+    TEST_ASSERT_EQUAL_UINT32 (Station.Minutes.MinutesSent, CtGroups);
+    TEST_ASSERT_GREATER_OR_EQUAL (-20, Earliest);
+    TEST_ASSERT_LESS_OR_EQUAL (GROUP_MS + (2 * TIMER_WHEEL_TICK_MS) + (2 * LOOP_MS), Worst);
+}
+
+// *********************************************************************************************
+// What CT costs: the group rate stays the same, each CT group displaces exactly one PS / RT
+// group, and a RadioText refresh is delayed by at most one group time.
+void test_group_rate_impact ()
+{
+    const uint32_t  Minutes = 20;
+    uint32_t        Groups[2];
+    uint32_t        Other[2];
+    uint32_t        CtGroups[2];
+    uint64_t        WorstRtCycle[2];
+
+    for (uint32_t Pass = 0;Pass < 2;++Pass)
+    {
+        Station_t Station;
+
+        MockMillis ()   = 0;
+        ClockSet        = true;
+        DriftPpm        = 0;
+        StepMs          = 0;
+        Station.SendCt  = (1 == Pass);
+
+        Station.begin ();
+        Station.Run (Minutes * 60 * 1000);
+        DetachChip ();
+
+        int64_t Earliest;
+        CtErrors (CtGroups[Pass], Earliest);
+
+        Groups[Pass]        = uint32_t (Loaded.size ());
+        Other[Pass]         = Groups[Pass] - CtGroups[Pass];
+        WorstRtCycle[Pass]  = 0;
+
+        // Time from one RT segment 0 to the next: one full RadioText refresh.
+        uint64_t LastRtStart = 0;
+
+        for (auto & Entry : Loaded)
+        {
+            if ((cRdsEncoder::GroupType_RT == GroupType (Entry.Group)) && (0 == (Entry.Group[3] & 0x0F)))
+            {
+                if (LastRtStart)
+                {
+                    uint64_t Cycle = Entry.WallMs - LastRtStart;
+                    WorstRtCycle[Pass] = (Cycle > WorstRtCycle[Pass]) ? Cycle : WorstRtCycle[Pass];
+                }
+
+                LastRtStart = Entry.WallMs;
+            }
+        }
+    }
+
+    char Message[160];
+    snprintf (Message, sizeof (Message), "CT off: %u groups (%.2f/S), worst RT refresh %u mS",
+              unsigned(Groups[0]), double(Groups[0]) / (Minutes * 60), unsigned(WorstRtCycle[0]));
+    TEST_MESSAGE (Message);
+    snprintf (Message, sizeof (Message), "CT on:  %u groups (%.2f/S), %u CT (%.3f%%), worst RT refresh %u mS",
+              unsigned(Groups[1]), double(Groups[1]) / (Minutes * 60), unsigned(CtGroups[1]),
+              (100.0 * CtGroups[1]) / Groups[1], unsigned(WorstRtCycle[1]));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0, CtGroups[0]);
+    TEST_ASSERT_EQUAL_UINT32 (Minutes, CtGroups[1]);
+    TEST_ASSERT_UINT32_WITHIN (1, Groups[0], Groups[1]);
+    TEST_ASSERT_UINT32_WITHIN (1, Other[0] - CtGroups[1], Other[1]);
+    TEST_ASSERT_LESS_OR_EQUAL (WorstRtCycle[0] + GROUP_MS + LOOP_MS, WorstRtCycle[1]);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_minute_edge_accuracy);
+    RUN_TEST (test_unset_and_stepped_clock);
+    RUN_TEST (test_group_rate_impact);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,388 @@
+/*
+  *    File: test_main.cpp (test_fpp_packet_view)
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    cFppPacketView length checks and sequence names, then a replay of an FPP MultiSync packet
+  *    stream the way a show master sends it: a playlist of sequences, each opened, started, synced
+  *    four times a second and stopped, with pings and damaged packets mixed in. The stream is run
+  *    through the packet views and through the old String based path. Reports the time and heap
+  *    allocations per packet for both and checks they see the same sequence changes.
+  *    Run with: pio test -e native -f test_fpp_packet_view
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+#include "../../src/Controllers/MessagePool.cpp"
+#include "../../src/Controllers/FppPacketView.cpp"
+
+// *********************************************************************************************
+// Every heap allocation made by the test is counted.
+static std::atomic <uint32_t> Allocations {0};
+
+void * operator new (size_t Size)
+{
+    ++Allocations;
+
+    void * Response = malloc (Size ? Size : 1);
+
+    if (nullptr == Response)
+    {
+        throw std::bad_alloc ();
+    }
+
+    return Response;
+}
+
+void operator delete (void * Pointer) noexcept          {free (Pointer);}
+void operator delete (void * Pointer, size_t) noexcept  {free (Pointer);}
+
+// *********************************************************************************************
+#define SYNC_PKT_START  0
+#define SYNC_PKT_STOP   1
+#define SYNC_PKT_SYNC   2
+#define SYNC_PKT_OPEN   3
+
+static const size_t SYNC_NAME_OFFSET = offsetof (FPPMultiSyncPacket, filename);
+
+// A received packet. The buffer is always a full packet so the old path, which never checked the
+// length, can be replayed safely.
+struct Packet_t
+{
+    FPPMultiSyncPacket  Buffer;
+    size_t              Length;
+    bool                Valid;  // What the old path was trusted to get.
+};
+
+static Packet_t MakeSync (uint8_t Action, uint32_t Frame, const char * FileName)
+{
+    Packet_t Packet;
+
+    memset (Packet.Buffer.raw, 0, sizeof (Packet.Buffer.raw));
+    memcpy (Packet.Buffer.raw, "FPPD", 4);
+    Packet.Buffer.packet_type       = FPP_CTRL_PKT_SYNC;
+    Packet.Buffer.sync_action       = Action;
+    Packet.Buffer.sync_type         = 0;
+    Packet.Buffer.frame_number      = Frame;
+    Packet.Buffer.seconds_elapsed   = float (Frame) * 0.025f;
+    strncpy (Packet.Buffer.filename, FileName, sizeof (Packet.Buffer.filename));
+
+    // FPP sends the name and its terminator, not the whole name field.
+    Packet.Length                   = SYNC_NAME_OFFSET + std::min (strlen (FileName) + 1, sizeof (FPPMultiSyncPacket::filename));
+    Packet.Buffer.data_len          = uint16_t (Packet.Length - 7);
+    Packet.Valid                    = true;
+
+    return Packet;
+}
+
+static Packet_t MakePing ()
+{
+    Packet_t Packet;
+
+    memset (Packet.Buffer.raw, 0, sizeof (Packet.Buffer.raw));
+    memcpy (Packet.Buffer.raw, "FPPD", 4);
+    Packet.Buffer.packet_type   = FPP_CTRL_PKT_PING;
+    Packet.Buffer.raw[7]        = 3;    // ping_version
+    Packet.Buffer.raw[8]        = 0;    // ping_subtype
+    Packet.Length               = sizeof (FPPPingPacket::raw);
+    Packet.Valid                = true;
+
+    return Packet;
+}
+
+// *********************************************************************************************
+// Every length from nothing to the full packet: nothing past Length is ever read.
+void test_length_checks ()
+{
+    Packet_t                        Packet = MakeSync (SYNC_PKT_SYNC, 1234, "Wizards In Winter - TSO.fseq");
+    cFppPacketView                  View;
+    cFppPacketView::SyncPacket_t    Sync;
+
+    for (size_t Length = 0;Length <= Packet.Length;++Length)
+    {
+        bool Parsed = View.Parse (Packet.Buffer.raw, Length);
+        TEST_ASSERT_EQUAL (Length >= FPP_HEADER_SIZE, Parsed);
+
+        bool GotSync = Parsed && View.GetSync (Sync);
+        TEST_ASSERT_EQUAL (Length >= SYNC_NAME_OFFSET, GotSync);
+
+        if (GotSync)
+        {
+            TEST_ASSERT_LESS_OR_EQUAL (Length - SYNC_NAME_OFFSET, Sync.FileName.Length);
+            TEST_ASSERT_EQUAL_UINT32 (1234, Sync.FrameNumber);
+        }
+    }
+
+    // Not FPP, or the wrong type.
+    memcpy (Packet.Buffer.raw, "FPPX", 4);
+    TEST_ASSERT_FALSE (View.Parse (Packet.Buffer.raw, Packet.Length));
+    TEST_ASSERT_FALSE (View.Parse (nullptr, 100));
+
+    Packet_t                        Ping = MakePing ();
+    cFppPacketView::PingPacket_t    PingInfo;
+
+    TEST_ASSERT_TRUE (View.Parse (Ping.Buffer.raw, Ping.Length));
+    TEST_ASSERT_FALSE (View.GetSync (Sync));
+    TEST_ASSERT_TRUE (View.GetPing (PingInfo));
+    TEST_ASSERT_EQUAL_UINT8 (3, PingInfo.Version);
+    TEST_ASSERT_TRUE (View.Parse (Ping.Buffer.raw, FPP_PING_MIN_SIZE - 1));
+    TEST_ASSERT_FALSE (View.GetPing (PingInfo));
+}
+
+// *********************************************************************************************
+// The last ".fseq", in any case, is cut off. A name that fills the field has no terminator.
+void test_sequence_names ()
+{
+    struct
+    {
+        const char  * FileName;
+        const char  * SequenceName;
+    } const Cases[] =
+    {
+        {"Wizards In Winter - TSO.fseq",    "Wizards In Winter - TSO"   },
+        {"Carol Of The Bells.FSEQ",         "Carol Of The Bells"        },
+        {"intro.fseq.fseq",                 "intro.fseq"                },
+        {"Countdown",                       "Countdown"                 },
+        {".fseq",                           ""                          },
+        {"",                                ""                          },
+    };
+
+    cFppPacketView                  View;
+    cFppPacketView::SyncPacket_t    Sync;
+
+    for (auto & Case : Cases)
+    {
+        Packet_t Packet = MakeSync (SYNC_PKT_START, 0, Case.FileName);
+
+        TEST_ASSERT_TRUE (View.Parse (Packet.Buffer.raw, Packet.Length));
+        TEST_ASSERT_TRUE (View.GetSync (Sync));
+        TEST_ASSERT_EQUAL (strlen (Case.SequenceName), Sync.SequenceName.Length);
+        TEST_ASSERT_EQUAL_MEMORY (Case.SequenceName, Sync.SequenceName.Text, Sync.SequenceName.Length);
+        TEST_ASSERT_EQUAL_HEX32 (cMessagePool::Hash (Case.SequenceName, strlen (Case.SequenceName)), Sync.SequenceName.Hash);
+        TEST_ASSERT_TRUE (Sync.SequenceName.Equals (Case.SequenceName, strlen (Case.SequenceName), Sync.SequenceName.Hash));
+    }
+
+    std::string Long (sizeof (FPPMultiSyncPacket::filename), 'x');
+    Packet_t    Packet = MakeSync (SYNC_PKT_SYNC, 0, Long.c_str ());
+
+    TEST_ASSERT_EQUAL (SYNC_NAME_OFFSET + sizeof (FPPMultiSyncPacket::filename), Packet.Length);
+    TEST_ASSERT_TRUE (View.Parse (Packet.Buffer.raw, Packet.Length));
+    TEST_ASSERT_TRUE (View.GetSync (Sync));
+    TEST_ASSERT_EQUAL (sizeof (FPPMultiSyncPacket::filename), Sync.FileName.Length);
+}
+
+// *********************************************************************************************
+// A show: each sequence is opened, started, synced every 10 frames (25 mS frames, four syncs a
+// second) and stopped. A ping every 30 seconds, a damaged packet every 500.
+static std::vector <Packet_t> MakeShow (uint32_t Loops)
+{
+    static const char * Playlist [] =
+    {
+        "Wizards In Winter - TSO.fseq",
+        "Carol Of The Bells - Lindsey Stirling.fseq",
+        "Let It Go - Idina Menzel.fseq",
+        "Christmas Canon - TSO.fseq",
+    };
+
+    std::vector <Packet_t>  Response;
+    uint32_t                Count = 0;
+
+    auto Add = [&] (const Packet_t & Packet)
+               {
+                   Response.push_back (Packet);
+
+                   if (0 == (++Count % 500))
+                   {
+                       Packet_t Damaged = Packet;
+                       Damaged.Length   = SYNC_NAME_OFFSET - 1;
+                       Damaged.Valid    = false;
+                       Response.push_back (Damaged);
+
+                       Damaged.Buffer.raw[3] = 'X';
+                       Damaged.Length        = Packet.Length;
+                       Response.push_back (Damaged);
+                   }
+               };
+
+    for (uint32_t Loop = 0;Loop < Loops;++Loop)
+    {
+        for (auto FileName : Playlist)
+        {
+            const uint32_t Frames = 180 * 40;  // Three minutes.
+
+            Add (MakeSync (SYNC_PKT_OPEN,   0, FileName));
+            Add (MakeSync (SYNC_PKT_START,  0, FileName));
+
+            for (uint32_t Frame = 10;Frame < Frames;Frame += 10)
+            {
+                Add (MakeSync (SYNC_PKT_SYNC, Frame, FileName));
+
+                if (0 == (Frame % (30 * 40)))
+                {
+                    Add (MakePing ());
+                }
+            }
+
+            Add (MakeSync (SYNC_PKT_STOP, Frames, FileName));
+        }
+    }
+
+    return Response;
+}
+
+// The packet view path: nothing is copied unless the sequence changes.
+static void ReplayViews (const std::vector <Packet_t> & Show, std::vector <uint32_t> & Changes)
+{
+    cFppPacketView  View;
+    String          CurrentSequence;
+    uint32_t        CurrentHash = cFppPacketView::Name_t ().Hash;
+
+    for (auto & Packet : Show)
+    {
+        cFppPacketView::SyncPacket_t Sync;
+
+        if (!View.Parse (Packet.Buffer.raw, Packet.Length) || !View.GetSync (Sync))
+        {
+            continue;
+        }
+
+        cFppPacketView::Name_t SequenceName = (SYNC_PKT_STOP == Sync.Action) ? cFppPacketView::Name_t () : Sync.SequenceName;
+
+        if (!SequenceName.Equals (CurrentSequence.c_str (), CurrentSequence.length (), CurrentHash))
+        {
+            CurrentSequence = emptyString;
+            CurrentSequence.concat (SequenceName.Text, SequenceName.Length);
+            CurrentHash     = SequenceName.Hash;
+            Changes.push_back (CurrentHash);
+        }
+    }
+}
+
+// The path the views replaced: the packet is cast to the fseq.h struct and every sync builds,
+// copies, lowercases and cuts a String. Only sees the packets it could safely read.
+static void ProcessFppdFile (String & FppdFileName, String & CurrentSequence, std::vector <uint32_t> & Changes)
+{
+    String TempName = FppdFileName;
+    TempName.toLowerCase ();
+    String FinalName = FppdFileName.substring (0, unsigned(TempName.lastIndexOf (".fseq")));
+
+    if (!FinalName.equals (CurrentSequence))
+    {
+        CurrentSequence = FinalName;
+        Changes.push_back (cMessagePool::Hash (CurrentSequence.c_str (), CurrentSequence.length ()));
+    }
+}
+
+static void ProcessSyncPacket (uint8_t Action, String FileName, String & CurrentSequence, std::vector <uint32_t> & Changes)
+{
+    String FppdFileName = (SYNC_PKT_STOP == Action) ? String () : FileName;
+    ProcessFppdFile (FppdFileName, CurrentSequence, Changes);
+}
+
+static void ReplayStrings (const std::vector <Packet_t> & Show, std::vector <uint32_t> & Changes)
+{
+    String CurrentSequence;
+
+    for (auto & Packet : Show)
+    {
+        const FPPPacket * fppPacket = reinterpret_cast <const FPPPacket *>(Packet.Buffer.raw);
+
+        if (!Packet.Valid || (0 != memcmp (fppPacket->header, "FPPD", 4)) || (FPP_CTRL_PKT_SYNC != fppPacket->packet_type))
+        {
+            continue;
+        }
+
+        const FPPMultiSyncPacket * msPacket = reinterpret_cast <const FPPMultiSyncPacket *>(Packet.Buffer.raw);
+        ProcessSyncPacket (msPacket->sync_action, String (msPacket->filename), CurrentSequence, Changes);
+    }
+}
+
+void test_replay_show ()
+{
+    const uint32_t              Replays = 20;
+    std::vector <Packet_t>      Show    = MakeShow (2);
+    double                      NsPerPacket[2];
+    uint32_t                    AllocationsPerReplay[2];
+    std::vector <uint32_t>      Changes[2];
+
+    for (uint32_t Path = 0;Path < 2;++Path)
+    {
+        Changes[Path].reserve (Show.size ());
+
+        uint32_t    AllocationsBefore   = Allocations;
+        auto        Start               = std::chrono::steady_clock::now ();
+
+        for (uint32_t Replay = 0;Replay < Replays;++Replay)
+        {
+            Changes[Path].clear ();
+
+            if (0 == Path)
+            {
+                ReplayViews (Show, Changes[Path]);
+            }
+            else
+            {
+                ReplayStrings (Show, Changes[Path]);
+            }
+        }
+
+        double Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+
+        NsPerPacket[Path]           = (Seconds * 1e9) / (double(Show.size ()) * Replays);
+        AllocationsPerReplay[Path]  = (Allocations - AllocationsBefore) / Replays;
+    }
+
+    char Message[160];
+    snprintf (Message, sizeof (Message), "%u packets, %u sequence changes", unsigned(Show.size ()), unsigned(Changes[0].size ()));
+    TEST_MESSAGE (Message);
+    snprintf (Message, sizeof (Message), "Packet views: %.0f nS, %.3f heap allocations per packet (%.1fM packets/S)",
+              NsPerPacket[0], double(AllocationsPerReplay[0]) / Show.size (), 1e3 / NsPerPacket[0]);
+    TEST_MESSAGE (Message);
+    snprintf (Message, sizeof (Message), "Old Strings:  %.0f nS, %.3f heap allocations per packet (%.1fM packets/S)",
+              NsPerPacket[1], double(AllocationsPerReplay[1]) / Show.size (), 1e3 / NsPerPacket[1]);
+    TEST_MESSAGE (Message);
+
+    // Both paths see the same sequences: a start and a stop for each one played.
+    TEST_ASSERT_EQUAL (2 * 4 * 2, Changes[0].size ());
+    TEST_ASSERT_TRUE (Changes[0] == Changes[1]);
+
+    // The views allocate only on a change, never for a repeat sync.
+    TEST_ASSERT_LESS_OR_EQUAL (Changes[0].size (), AllocationsPerReplay[0]);
+    TEST_ASSERT_LESS_THAN (NsPerPacket[1], NsPerPacket[0]);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_length_checks);
+    RUN_TEST (test_sequence_names);
+    RUN_TEST (test_replay_show);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,328 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    QN8027Radio::waitForFsmState() against a simulated QN8027 FSM. Compares the time spent blocked
+  *    and the I2C traffic with the 5mS getStatus() polling loop it replaced.
+  *    Run with: pio test -e native -f test_fsm_wait
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <vector>
+#include <unity.h>
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/QN8027Radio.cpp"
+
+// *********************************************************************************************
+// Simulated FSM. A command is picked up 1mS after it is written, then the chip steps through
+// the states of its settle sequence. Settle times are typical values seen on a QN8027.
+static const uint32_t   PICKUP_MS       = 1;
+static const uint32_t   RECAL_MS        = 40;
+static const uint32_t   TX_READY_MS     = 2;
+static const uint32_t   PA_CAL_MS       = 10;
+static const uint32_t   CHANNEL_CAL_MS  = 12;
+
+class cSimFsm
+{
+public:
+
+    void Attach ()
+    {
+        Previous    = FSM_STATE_IDLE;
+        Final       = FSM_STATE_IDLE;
+        Steps.clear ();
+        Transmit    = false;
+        PeakClears  = 0;
+
+        Wire.OnWrite    = [this] (uint8_t Reg, uint8_t Data) {Write (Reg, Data);};
+        Wire.OnRead     = [this] (uint8_t Reg) -> uint8_t
+                          {
+                              return (STATUS_REG == Reg) ? State () : Wire.Registers[Reg];
+                          };
+    }
+
+    void Detach ()
+    {
+        Wire.OnWrite    = nullptr;
+        Wire.OnRead     = nullptr;
+    }
+
+    uint8_t State ()
+    {
+        uint32_t Elapsed = millis () - Start;
+
+        if (Elapsed < PICKUP_MS)
+        {
+            return Previous;
+        }
+
+        Elapsed -= PICKUP_MS;
+
+        for (auto & Step : Steps)
+        {
+            if (Elapsed < Step.second)
+            {
+                return Step.first;
+            }
+
+            Elapsed -= Step.second;
+        }
+
+        return Final;
+    }
+
+    uint32_t SettleMs ()
+    {
+        uint32_t Total = PICKUP_MS;
+
+        for (auto & Step : Steps)
+        {
+            Total += Step.second;
+        }
+
+        return Total;
+    }
+
+    uint32_t PeakClears = 0;
+
+private:
+
+    void Event (std::vector <std::pair <uint8_t, uint32_t>> NewSteps)
+    {
+        Previous    = State ();
+        Start       = millis ();
+        Steps       = NewSteps;
+        Final       = Transmit ? FSM_STATE_TRANSMIT : FSM_STATE_IDLE;
+    }
+
+    void Write (uint8_t Reg, uint8_t Data)
+    {
+        if (SYSTEM_REG == Reg)
+        {
+            bool NewTransmit = (0 != (Data & 0x20));
+            bool Changed     = (NewTransmit != Transmit);
+
+            Transmit = NewTransmit;
+
+            if (Data & 0x40)
+            {
+                Event ({{1, RECAL_MS}});
+            }
+            else if (Changed && Transmit)
+            {
+                Event ({{3, TX_READY_MS}, {4, PA_CAL_MS}});
+            }
+            else if (Changed)
+            {
+                Event ({});
+            }
+        }
+        else if ((CH1_REG == Reg) && Transmit)
+        {
+            Event ({{4, CHANNEL_CAL_MS}});
+        }
+        else if (PAC_REG == Reg)
+        {
+            ++PeakClears;
+        }
+    }
+
+    uint32_t    Start       = 0;
+    uint8_t     Previous    = FSM_STATE_IDLE;
+    uint8_t     Final       = FSM_STATE_IDLE;
+    bool        Transmit    = false;
+    std::vector <std::pair <uint8_t, uint32_t>> Steps;
+};  // class cSimFsm
+
+static cSimFsm SimFsm;
+
+// *********************************************************************************************
+// The waitForIdle() loop this driver used before: getStatus() (with its audio peak clear) every 5mS.
+static void LegacyWaitForIdle (QN8027Radio & Radio, uint16_t waitMs)
+{
+    uint8_t stateCode1 = Radio.getStatus () & 0x07;
+    uint8_t stateCode2;
+
+    if (5 > waitMs)
+    {
+        waitMs = 5;
+    }
+
+    do
+    {
+        waitMs -= 5;
+        delay (5);
+        stateCode2 = Radio.getStatus () & 0x07;
+
+        if ((stateCode2 == 0x02) || (stateCode2 == 0x05))
+        {
+            break;
+        }
+        else if (stateCode1 != stateCode2)
+        {
+            Radio.getStatus ();
+            break;
+        }
+    } while (5 <= waitMs);
+}
+
+static void NewWaitForIdle (QN8027Radio & Radio, uint16_t waitMs)
+{
+    Radio.waitForFsmState ((1 << FSM_STATE_IDLE) | (1 << FSM_STATE_TRANSMIT), waitMs, 5, true);
+}
+
+// *********************************************************************************************
+struct RunStats_t
+{
+    uint32_t    BlockedMs       = 0;
+    uint32_t    Transactions    = 0;
+    uint32_t    PeakClears      = 0;
+};
+
+// A boot style command sequence. Every command is wrapped in a wait before and after, the way
+// cQN8027RadioApi does it. Only the waits are counted as blocked time.
+static RunStats_t RunSequence (void (* Wait)(QN8027Radio &, uint16_t))
+{
+    QN8027Radio Radio;
+    RunStats_t  Stats;
+
+    SimFsm.Attach ();
+    Wire.ResetCounters ();
+
+    auto Command = [&] (std::function <void()> Operation, uint16_t waitMs)
+                   {
+                       for (int Pass = 0;Pass < 2;++Pass)
+                       {
+                           if (1 == Pass)
+                           {
+                               Operation ();
+                           }
+
+                           uint32_t Start   = millis ();
+                           uint32_t Clears  = SimFsm.PeakClears;
+                           Wait (Radio, waitMs);
+                           Stats.BlockedMs  += millis () - Start;
+                           Stats.PeakClears += SimFsm.PeakClears - Clears;
+                       }
+                   };
+
+    Command ([&] () {Radio.reCalibrate ();}, 120);
+    Command ([&] () {Radio.Switch (ON);}, 100);
+
+    for (uint8_t Channel = 0;Channel < 10;++Channel)
+    {
+        Command ([&] () {Radio.writeReg (CH1_REG, Channel * 4);}, 100);
+    }
+
+    for (uint8_t Power = 40;Power < 80;Power += 4)
+    {
+        Command ([&] () {Radio.setTxPower (Power);}, 100);
+    }
+
+    Stats.Transactions = Wire.Transactions;
+    SimFsm.Detach ();
+
+    return Stats;
+}
+
+// *********************************************************************************************
+void test_sequence_benchmark ()
+{
+    RunStats_t  Legacy  = RunSequence (LegacyWaitForIdle);
+    RunStats_t  New     = RunSequence (NewWaitForIdle);
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "Legacy: %u mS blocked, %u I2C transactions, %u peak clears",
+              unsigned(Legacy.BlockedMs), unsigned(Legacy.Transactions), unsigned(Legacy.PeakClears));
+    TEST_MESSAGE (Message);
+    snprintf (Message, sizeof (Message), "New:    %u mS blocked, %u I2C transactions, %u peak clears",
+              unsigned(New.BlockedMs), unsigned(New.Transactions), unsigned(New.PeakClears));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_LESS_THAN_UINT32 (Legacy.BlockedMs, New.BlockedMs);
+    TEST_ASSERT_EQUAL_UINT32 (0, New.PeakClears);
+}
+
+// *********************************************************************************************
+// Waiting for a state returns within one poll of the chip getting there.
+void test_wait_tracks_settle_time ()
+{
+    QN8027Radio Radio;
+
+    SimFsm.Attach ();
+
+    Radio.Switch (ON);
+    uint32_t    Settle  = SimFsm.SettleMs ();
+    uint32_t    Start   = millis ();
+    TEST_ASSERT_TRUE (Radio.waitForFsmState (1 << FSM_STATE_TRANSMIT, 200, 5, false));
+    TEST_ASSERT_UINT32_WITHIN (1, Settle, millis () - Start);
+
+    Radio.writeReg (CH1_REG, 0x55);
+    Settle  = SimFsm.SettleMs ();
+    Start   = millis ();
+    TEST_ASSERT_TRUE (Radio.waitForFsmState (1 << FSM_STATE_TRANSMIT, 200, 5, false));
+    TEST_ASSERT_UINT32_WITHIN (1, Settle, millis () - Start);
+
+    // Nothing to settle: the minimum wait only.
+    Start = millis ();
+    TEST_ASSERT_TRUE (Radio.waitForFsmState (1 << FSM_STATE_TRANSMIT, 200, 5, false));
+    TEST_ASSERT_EQUAL_UINT32 (5, millis () - Start);
+
+    // A state that never comes times out.
+    Start = millis ();
+    TEST_ASSERT_FALSE (Radio.waitForFsmState (1 << FSM_STATE_IDLE, 50, 5, false));
+    TEST_ASSERT_EQUAL_UINT32 (50, millis () - Start);
+
+    SimFsm.Detach ();
+}
+
+// *********************************************************************************************
+// ExitOnChange stops as soon as the chip has picked up the command.
+void test_exit_on_change ()
+{
+    QN8027Radio Radio;
+
+    SimFsm.Attach ();
+    Radio.Switch (ON);
+    Radio.waitForFsmState (1 << FSM_STATE_TRANSMIT, 200, 5, false);
+
+    Radio.reCalibrate ();
+    uint32_t Start = millis ();
+    TEST_ASSERT_FALSE (Radio.waitForFsmState (1 << FSM_STATE_TRANSMIT, 200, 5, true));
+    TEST_ASSERT_EQUAL_UINT32 (5, millis () - Start);
+    TEST_ASSERT_EQUAL_UINT8 (1, Radio.getLastFSMState ());
+
+    SimFsm.Detach ();
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_sequence_benchmark);
+    RUN_TEST (test_wait_tracks_settle_time);
+    RUN_TEST (test_exit_on_change);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
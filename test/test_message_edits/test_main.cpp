@@ -0,0 +1,302 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    c_ControllerMessages edits from other tasks. Edits made off the owner task (set activation,
+  *    clear, config restore, message edits) must wait for ApplyPendingEdits(). Several std::thread
+  *    producers then edit message sets while the owner task rotates through them. Reports the edit
+  *    throughput and the owner's rotation latency, and checks the final contents.
+  *    Run with: pio test -e native -f test_message_edits
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../../src/language.cpp"
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Controllers/MessagePool.cpp"
+#include "../../src/Controllers/MessageSchedule.cpp"
+#include "../../src/Controllers/ControllerMessage.cpp"
+#include "../../src/Controllers/ControllerMessageSet.cpp"
+#include "../../src/Controllers/ControllerMessages.cpp"
+
+// *********************************************************************************************
+// Messages in the set. The rotation may be anywhere in the set, so play as many messages as the
+// pool can hold.
+static std::set <std::string> PlaySet (c_ControllerMessages & Messages, const String & SetName)
+{
+    std::set <std::string>          Response;
+    c_ControllerMgr::RdsMsgInfo_t   Info;
+
+    for (uint32_t Count = 0;Count < MESSAGE_POOL_SLOTS;++Count)
+    {
+        Messages.GetNextRdsMessage (SetName, Info);
+
+        if (Info.Text[0])
+        {
+            Response.insert (Info.Text);
+        }
+    }
+
+    MessagePool.Release (Info.Handle);
+    return Response;
+}
+
+// Runs Work on another task and waits for it.
+template <typename T>
+static void OnOtherTask (T Work)
+{
+    std::thread Other (Work);
+    Other.join ();
+}
+
+void setUp ()
+{
+    c_ControllerMessages::SetOwnerTask (xTaskGetCurrentTaskHandle ());
+}
+
+void tearDown ()
+{
+    c_ControllerMessages::ApplyPendingEdits ();
+    c_ControllerMessages::SetOwnerTask (NULL);
+}
+
+// *********************************************************************************************
+// The FPPD rename path: a UI callback activates a set that does not exist yet.
+void test_activate_is_queued ()
+{
+    c_ControllerMessages    Messages;
+    String                  SetName = F ("Renamed Sequence");
+
+    Messages.AddControls (1);
+
+    OnOtherTask ([&] ()
+                 {
+                     Messages.ActivateMessageSet (SetName);
+                     Messages.AddMessage (SetName, F ("Now playing"));
+                 });
+
+    TEST_ASSERT_FALSE (Messages.HasMsgSet (SetName));
+    TEST_ASSERT_TRUE (Messages.empty ());
+
+    c_ControllerMessages::ApplyPendingEdits ();
+
+    TEST_ASSERT_TRUE (Messages.HasMsgSet (SetName));
+    TEST_ASSERT_FALSE (Messages.empty (SetName));
+    TEST_ASSERT_EQUAL (1, PlaySet (Messages, SetName).size ());
+    TEST_ASSERT_TRUE (PlaySet (Messages, SetName).count ("Now playing"));
+}
+
+// *********************************************************************************************
+void test_clear_is_queued ()
+{
+    c_ControllerMessages Messages;
+
+    Messages.AddControls (1);
+    Messages.AddMessage (F ("LOCAL"), F ("Welcome"));
+    TEST_ASSERT_FALSE (Messages.empty ());
+
+    OnOtherTask ([&] ()
+                 {
+                     Messages.clear ();
+                     Messages.AddMessage (F ("LOCAL"), F ("Drive slowly"));
+                 });
+
+    TEST_ASSERT_EQUAL (1, PlaySet (Messages, F ("LOCAL")).count ("Welcome"));
+
+    c_ControllerMessages::ApplyPendingEdits ();
+
+    std::set <std::string> Played = PlaySet (Messages, F ("LOCAL"));
+    TEST_ASSERT_EQUAL (1, Played.size ());
+    TEST_ASSERT_EQUAL (1, Played.count ("Drive slowly"));
+}
+
+// *********************************************************************************************
+// A config restore from another task is a copy. The caller's document may be gone by the time
+// the owner task gets to it.
+void test_restore_is_queued ()
+{
+    c_ControllerMessages    Messages;
+    uint32_t                Applied = c_ControllerMessages::EditsApplied;
+
+    OnOtherTask ([&] ()
+                 {
+                     DynamicJsonDocument    ConfigDoc (1024);
+                     JsonObject             Config = ConfigDoc.to <JsonObject>();
+                     Messages.RestoreConfig (Config);
+                 });
+
+    TEST_ASSERT_EQUAL_UINT32 (Applied, c_ControllerMessages::EditsApplied);
+    c_ControllerMessages::ApplyPendingEdits ();
+    TEST_ASSERT_EQUAL_UINT32 (Applied + 1, c_ControllerMessages::EditsApplied);
+}
+
+// *********************************************************************************************
+// PRODUCERS tasks each own one set. Every round they add a batch of messages, rename half of
+// them, erase the other half and set the duration. The owner task applies the edits between
+// picks, as ControllerMgr does. Producers keep the queue below its size, so no edit is dropped
+// and the final contents are exact.
+void test_producers_and_rotation ()
+{
+    static const uint32_t   PRODUCERS   = 4;
+    static const uint32_t   ROUNDS      = 200;
+    static const uint32_t   BATCH       = 6;
+    static const uint32_t   IN_FLIGHT   = 24;
+
+    c_ControllerMessages        Messages;
+    std::vector <std::thread>   Producers;
+    std::atomic <uint32_t>      Issued {0};
+    std::atomic <uint32_t>      Running {PRODUCERS};
+    uint32_t                    AppliedAtStart  = c_ControllerMessages::EditsApplied;
+    uint32_t                    DroppedAtStart  = c_ControllerMessages::EditsDropped;
+    uint32_t                    Picks           = 0;
+    double                      LongestPickUs   = 0;
+    double                      TotalPickUs     = 0;
+
+    Messages.AddControls (1);
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        Messages.AddMessageSet (String ("Set") + String (Producer));
+    }
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        Producers.emplace_back ([&, Producer] ()
+                                {
+                                    String SetName = String ("Set") + String (Producer);
+
+                                    auto Edit = [&] (std::function <void()> Work)
+                                                {
+                                                    while ((Issued - (c_ControllerMessages::EditsApplied - AppliedAtStart)) >= IN_FLIGHT)
+                                                    {
+                                                        std::this_thread::yield ();
+                                                    }
+
+                                                    ++Issued;
+                                                    Work ();
+                                                };
+
+                                    for (uint32_t Round = 0;Round < ROUNDS;++Round)
+                                    {
+                                        for (uint32_t Index = 0;Index < BATCH;++Index)
+                                        {
+                                            String Text = SetName + " round " + String (Round) + " msg " + String (Index);
+                                            Edit ([&] () {Messages.AddMessage (SetName, Text);});
+                                        }
+
+                                        for (uint32_t Index = 0;Index < BATCH;++Index)
+                                        {
+                                            String Text = SetName + " round " + String (Round) + " msg " + String (Index);
+
+                                            if (Index & 1)
+                                            {
+                                                Edit ([&] () {Messages.EraseMessage (SetName, Text);});
+                                            }
+                                            else if (Round + 1 < ROUNDS)
+                                            {
+                                                // Earlier rounds are removed once renamed, so the pool does not fill up.
+                                                Edit ([&] () {Messages.UpdateMessage (SetName, Text, Text + " renamed");});
+                                                Edit ([&] () {Messages.EraseMessage (SetName, Text + " renamed");});
+                                            }
+                                            else
+                                            {
+                                                Edit ([&] () {Messages.UpdateMessage (SetName, Text, Text + " renamed");});
+                                            }
+                                        }
+
+                                        Edit ([&] () {Messages.SetDurration (SetName, 5 + Round % 10);});
+                                        Edit ([&] () {Messages.ActivateMessageSet (SetName);});
+                                    }
+
+                                    --Running;
+                                });
+    }
+
+    c_ControllerMgr::RdsMsgInfo_t Info;
+
+    while (Running || (Issued != (c_ControllerMessages::EditsApplied - AppliedAtStart)))
+    {
+        auto PickStart = std::chrono::steady_clock::now ();
+
+        c_ControllerMessages::ApplyPendingEdits ();
+        Messages.GetNextRdsMessage (String ("Set") + String (Picks % PRODUCERS), Info);
+
+        double PickUs = std::chrono::duration <double, std::micro> (std::chrono::steady_clock::now () - PickStart).count ();
+        LongestPickUs   = (PickUs > LongestPickUs) ? PickUs : LongestPickUs;
+        TotalPickUs     += PickUs;
+        ++Picks;
+    }
+
+    MessagePool.Release (Info.Handle);
+
+    for (auto & Producer : Producers)
+    {
+        Producer.join ();
+    }
+
+    double      Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+    uint32_t    Applied = c_ControllerMessages::EditsApplied - AppliedAtStart;
+
+    char Message[160];
+    snprintf (Message, sizeof (Message), "%u producers, %u edits in %.3f S (%.0f edits/S), %u picks, pick + apply avg %.1f uS, max %.1f uS",
+              unsigned(PRODUCERS), unsigned(Applied), Seconds, double (Applied) / Seconds, unsigned(Picks), TotalPickUs / double (Picks), LongestPickUs);
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (DroppedAtStart, c_ControllerMessages::EditsDropped);
+    TEST_ASSERT_EQUAL_UINT32 (Issued, Applied);
+
+    // Each set keeps the renamed even messages of the last round.
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        String                  SetName = String ("Set") + String (Producer);
+        std::set <std::string>  Played  = PlaySet (Messages, SetName);
+
+        TEST_ASSERT_EQUAL (BATCH / 2, Played.size ());
+
+        for (uint32_t Index = 0;Index < BATCH;Index += 2)
+        {
+            String Text = SetName + " round " + String (ROUNDS - 1) + " msg " + String (Index) + " renamed";
+            TEST_ASSERT_EQUAL (1, Played.count (Text.c_str ()));
+        }
+    }
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_activate_is_queued);
+    RUN_TEST (test_clear_is_queued);
+    RUN_TEST (test_restore_is_queued);
+    RUN_TEST (test_producers_and_rotation);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
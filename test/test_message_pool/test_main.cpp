@@ -0,0 +1,297 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    MessagePool interning, reference counts, stale handles, pool exhaustion and the hash index
+  *    under churn (checked against a reference model). Also several std::thread users interning
+  *    and releasing at once, with the operation rate.
+  *    Run with: pio test -e native -f test_message_pool
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/Controllers/MessagePool.cpp"
+
+// *********************************************************************************************
+static std::string MakeText (uint32_t Number)
+{
+    char Text[40];
+
+    snprintf (Text, sizeof (Text), "Now Playing: Song %u", unsigned(Number));
+    return Text;
+}
+
+// *********************************************************************************************
+void test_identical_texts_share_a_slot ()
+{
+    cMessagePool Pool;
+
+    cMessagePool::Handle_t First    = Pool.Intern ("Merry Christmas");
+    cMessagePool::Handle_t Second   = Pool.Intern ("Merry Christmas");
+    cMessagePool::Handle_t Other    = Pool.Intern ("Happy New Year");
+
+    TEST_ASSERT_EQUAL_HEX16 (First, Second);
+    TEST_ASSERT_TRUE (First != Other);
+    TEST_ASSERT_EQUAL_UINT16 (2, Pool.SlotsInUse ());
+    TEST_ASSERT_EQUAL_STRING ("Merry Christmas", Pool.Text (First));
+    TEST_ASSERT_EQUAL_UINT8 (15, Pool.Length (First));
+
+    // Two references: the slot survives the first release.
+    Pool.Release (First);
+    TEST_ASSERT_EQUAL_HEX16 (cMessagePool::NullHandle, First);
+    TEST_ASSERT_TRUE (Pool.IsValid (Second));
+    Pool.Release (Second);
+    TEST_ASSERT_FALSE (Pool.IsValid (Second));
+    TEST_ASSERT_EQUAL_UINT16 (1, Pool.SlotsInUse ());
+}
+
+// *********************************************************************************************
+void test_text_is_truncated ()
+{
+    cMessagePool    Pool;
+    std::string     Long (RADIOTEXT_SIZE + 10, 'x');
+
+    cMessagePool::Handle_t Handle = Pool.Intern (Long.c_str ());
+
+    TEST_ASSERT_EQUAL_UINT8 (RADIOTEXT_SIZE, Pool.Length (Handle));
+    TEST_ASSERT_EQUAL_HEX16 (Handle, Pool.Intern (Long.substr (0, RADIOTEXT_SIZE).c_str ()));
+}
+
+// *********************************************************************************************
+// A released slot gets a new generation, so old handles to it stop working.
+void test_stale_handle_is_rejected ()
+{
+    cMessagePool Pool;
+
+    cMessagePool::Handle_t Handle   = Pool.Intern ("First");
+    cMessagePool::Handle_t Stale    = Handle;
+
+    Pool.Release (Handle);
+
+    cMessagePool::Handle_t Reused = Pool.Intern ("Second");
+
+    TEST_ASSERT_EQUAL_UINT8 (uint8_t (Stale), uint8_t (Reused));
+    TEST_ASSERT_TRUE (Stale != Reused);
+    TEST_ASSERT_FALSE (Pool.IsValid (Stale));
+    TEST_ASSERT_EQUAL_STRING ("", Pool.Text (Stale));
+    TEST_ASSERT_EQUAL_HEX16 (cMessagePool::NullHandle, Pool.AddRef (Stale));
+    TEST_ASSERT_EQUAL_STRING ("Second", Pool.Text (Reused));
+
+    // Releasing a stale handle must not touch the slot that replaced it.
+    Pool.Release (Stale);
+    TEST_ASSERT_TRUE (Pool.IsValid (Reused));
+}
+
+// *********************************************************************************************
+void test_assign_keeps_counts ()
+{
+    cMessagePool Pool;
+
+    cMessagePool::Handle_t Source   = Pool.Intern ("Source");
+    cMessagePool::Handle_t Target   = Pool.Intern ("Target");
+    cMessagePool::Handle_t Old      = Target;
+
+    Pool.Assign (Target, Source);
+    TEST_ASSERT_EQUAL_HEX16 (Source, Target);
+    TEST_ASSERT_FALSE (Pool.IsValid (Old));
+
+    Pool.Assign (Target, Target);
+    Pool.Release (Source);
+    TEST_ASSERT_TRUE (Pool.IsValid (Target));
+    Pool.Release (Target);
+    TEST_ASSERT_EQUAL_UINT16 (0, Pool.SlotsInUse ());
+}
+
+// *********************************************************************************************
+void test_full_pool_fails_cleanly ()
+{
+    cMessagePool                            Pool;
+    std::vector <cMessagePool::Handle_t>    Handles;
+
+    for (uint32_t Number = 0;Number < MESSAGE_POOL_SLOTS;++Number)
+    {
+        Handles.push_back (Pool.Intern (MakeText (Number).c_str ()));
+        TEST_ASSERT_TRUE (cMessagePool::NullHandle != Handles.back ());
+    }
+
+    TEST_ASSERT_EQUAL_HEX16 (cMessagePool::NullHandle, Pool.Intern ("One too many"));
+    TEST_ASSERT_EQUAL_UINT32 (1, Pool.Failures);
+    TEST_ASSERT_EQUAL_UINT16 (MESSAGE_POOL_SLOTS, Pool.HighWater ());
+
+    // An existing text still interns when the pool is full.
+    cMessagePool::Handle_t Again = Pool.Intern (MakeText (7).c_str ());
+    TEST_ASSERT_EQUAL_HEX16 (Handles[7], Again);
+    Pool.Release (Again);
+
+    Pool.Release (Handles[3]);
+    cMessagePool::Handle_t Late = Pool.Intern ("One too many");
+    TEST_ASSERT_TRUE (cMessagePool::NullHandle != Late);
+    TEST_ASSERT_EQUAL_STRING ("One too many", Pool.Text (Late));
+}
+
+// *********************************************************************************************
+// Random intern / release against a reference model. Backward shift deletes must leave every
+// remaining text reachable, so interning a live text must always return its existing handle.
+void test_index_survives_churn ()
+{
+    cMessagePool                                                        Pool;
+    std::map <uint32_t, std::pair <cMessagePool::Handle_t, uint32_t> >  Model;  // Text number -> handle, references.
+    std::mt19937                                                        Random (1234);
+    uint32_t                                                            Errors = 0;
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    static const uint32_t Operations = 400000;
+
+    for (uint32_t Operation = 0;Operation < Operations;++Operation)
+    {
+        uint32_t    Number  = Random () % (MESSAGE_POOL_SLOTS + 16);
+        auto        Entry   = Model.find (Number);
+
+        if ((Random () % 3) && (Model.end () != Entry))
+        {
+            cMessagePool::Handle_t Handle = Entry->second.first;
+            Pool.Release (Handle);
+
+            if (0 == --Entry->second.second)
+            {
+                Model.erase (Entry);
+            }
+
+            continue;
+        }
+
+        cMessagePool::Handle_t Handle = Pool.Intern (MakeText (Number).c_str ());
+
+        if (Model.end () != Entry)
+        {
+            Errors += (Handle != Entry->second.first) ? 1 : 0;
+            ++Entry->second.second;
+        }
+        else if (Model.size () < MESSAGE_POOL_SLOTS)
+        {
+            Errors += (cMessagePool::NullHandle == Handle) ? 1 : 0;
+            Model[Number] = {Handle, 1};
+        }
+        else
+        {
+            Errors += (cMessagePool::NullHandle != Handle) ? 1 : 0;
+        }
+    }
+
+    double Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+
+    for (auto & Entry : Model)
+    {
+        Errors += (MakeText (Entry.first) != Pool.Text (Entry.second.first)) ? 1 : 0;
+    }
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "%u operations in %.3f S (%.0f ops/S), %u live texts, high water %u, %u full",
+              unsigned(Operations), Seconds, double (Operations) / Seconds, unsigned(Model.size ()),
+              unsigned(Pool.HighWater ()), unsigned(Pool.Failures));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0, Errors);
+    TEST_ASSERT_EQUAL_UINT16 (Model.size (), Pool.SlotsInUse ());
+}
+
+// *********************************************************************************************
+// Several tasks intern, read and release shared texts. A text must never change under a
+// reference and every slot must be free at the end.
+void test_threads_share_the_pool ()
+{
+    static cMessagePool         Pool;
+    std::vector <std::thread>   Users;
+    std::atomic <uint32_t>      Errors {0};
+
+    static const uint32_t   USERS       = 4;
+    static const uint32_t   PER_USER    = 100000;
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t User = 0;User < USERS;++User)
+    {
+        Users.emplace_back ([&, User] ()
+                            {
+                                std::mt19937 Random (User);
+
+                                for (uint32_t Operation = 0;Operation < PER_USER;++Operation)
+                                {
+                                    uint32_t                Number  = Random () % 32;
+                                    std::string             Text    = MakeText (Number);
+                                    cMessagePool::Handle_t  Handle  = Pool.Intern (Text.c_str ());
+                                    cMessagePool::Handle_t  Copy    = cMessagePool::NullHandle;
+
+                                    Pool.Assign (Copy, Handle);
+
+                                    if ((Text != Pool.Text (Handle)) || (Handle != Copy))
+                                    {
+                                        ++Errors;
+                                    }
+
+                                    Pool.Release (Handle);
+                                    Pool.Release (Copy);
+                                }
+                            });
+    }
+
+    for (auto & User : Users)
+    {
+        User.join ();
+    }
+
+    double Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "%u tasks, %u intern/assign/release rounds in %.3f S (%.0f rounds/S)",
+              unsigned(USERS), unsigned(USERS * PER_USER), Seconds, double (USERS * PER_USER) / Seconds);
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0, Errors.load ());
+    TEST_ASSERT_EQUAL_UINT16 (0, Pool.SlotsInUse ());
+    TEST_ASSERT_EQUAL_UINT32 (0, Pool.Failures);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_identical_texts_share_a_slot);
+    RUN_TEST (test_text_is_truncated);
+    RUN_TEST (test_stale_handle_is_rejected);
+    RUN_TEST (test_assign_keeps_counts);
+    RUN_TEST (test_full_pool_fails_cleanly);
+    RUN_TEST (test_index_survives_churn);
+    RUN_TEST (test_threads_share_the_pool);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
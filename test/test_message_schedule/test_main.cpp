@@ -0,0 +1,103 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    cMessageSchedule Parse() / Format() round trips. Run with: pio test -f test_message_schedule
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <string.h>
+#include <unity.h>
+#include "../../src/Controllers/MessageSchedule.cpp"
+
+// *********************************************************************************************
+static void CheckRoundTrip (const char * Text, const char * Expected)
+{
+    cMessageSchedule    Schedule;
+    cMessageSchedule    Copy;
+    char                Buffer[MESSAGE_SCHEDULE_TEXT_SIZE];
+
+    TEST_ASSERT_TRUE_MESSAGE (Schedule.Parse (Text), Text);
+    Schedule.Format (Buffer, sizeof (Buffer));
+    TEST_ASSERT_EQUAL_STRING (Expected, Buffer);
+
+    TEST_ASSERT_TRUE_MESSAGE (Copy.Parse (Buffer), Buffer);
+    TEST_ASSERT_EQUAL_UINT8 (Schedule.DayMask, Copy.DayMask);
+    TEST_ASSERT_EQUAL_UINT16 (Schedule.StartMinute, Copy.StartMinute);
+    TEST_ASSERT_EQUAL_UINT16 (Schedule.EndMinute, Copy.EndMinute);
+    TEST_ASSERT_EQUAL_UINT32 (Schedule.FirstDate, Copy.FirstDate);
+    TEST_ASSERT_EQUAL_UINT32 (Schedule.LastDate, Copy.LastDate);
+}
+
+// *********************************************************************************************
+void test_day_ranges ()
+{
+    CheckRoundTrip ("Always",               "Always");
+    CheckRoundTrip ("Mon,Tue,Wed,Thu,Fri",  "Mon-Fri");
+    CheckRoundTrip ("Sat,Sun",              "Sat,Sun");
+    CheckRoundTrip ("Fri-Mon",              "Fri-Mon");
+    CheckRoundTrip ("Sun,Mon,Wed",          "Sun,Mon,Wed");
+    CheckRoundTrip ("Tue-Thu 18:00-01:00",  "Tue-Thu 18:00-01:00");
+}
+
+// *********************************************************************************************
+void test_longest_form ()
+{
+    CheckRoundTrip ("Sun,Tue,Thu,Sat 23:59-00:01 2022-11-25..2023-01-06",
+                    "Sat,Sun,Tue,Thu 23:59-00:01 2022-11-25..2023-01-06");
+}
+
+// *********************************************************************************************
+// Every day combination, with the longest time window and date range, fits and parses back.
+void test_every_day_mask_fits ()
+{
+    for (uint8_t DayMask = 1;DayMask < cMessageSchedule::AllDays;++DayMask)
+    {
+        cMessageSchedule    Schedule;
+        cMessageSchedule    Copy;
+        char                Buffer[MESSAGE_SCHEDULE_TEXT_SIZE];
+
+        Schedule.DayMask        = DayMask;
+        Schedule.StartMinute    = 23 * 60 + 59;
+        Schedule.EndMinute      = 1;
+        Schedule.FirstDate      = 20221125;
+        Schedule.LastDate       = 20230106;
+        Schedule.Format (Buffer, sizeof (Buffer));
+
+        TEST_ASSERT_LESS_THAN (sizeof (Buffer) - 1, strlen (Buffer));
+        TEST_ASSERT_TRUE_MESSAGE (Copy.Parse (Buffer), Buffer);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE (DayMask, Copy.DayMask, Buffer);
+    }
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_day_ranges);
+    RUN_TEST (test_longest_form);
+    RUN_TEST (test_every_day_mask_fits);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
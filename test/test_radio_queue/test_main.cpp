@@ -0,0 +1,280 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    Radio task hand over. Several std::thread producers feed the radio command queue and the
+  *    latest-value slots while one consumer drains them, the way the UI, FPP and MQTT tasks feed
+  *    the radio task. Checks order, loss and torn entries and reports the throughput.
+  *    Run with: pio test -e native -f test_radio_queue
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../../src/MpscQueue.hpp"
+#include "../../src/LatestValue.hpp"
+
+// *********************************************************************************************
+// Same size as a radio command.
+struct TestEntry_t
+{
+    uint32_t    Producer;
+    uint32_t    Sequence;
+    uint32_t    Check;
+    char        Text[64 + 1];
+};
+
+static const uint32_t   PRODUCERS   = 4;
+static const uint32_t   PER_THREAD  = 200000;
+
+static uint32_t CheckOf (const TestEntry_t & Entry)  {return (Entry.Producer * 0x9E3779B1UL) ^ (Entry.Sequence * 31);}
+
+static TestEntry_t MakeEntry (uint32_t Producer, uint32_t Sequence)
+{
+    TestEntry_t Entry;
+
+    Entry.Producer  = Producer;
+    Entry.Sequence  = Sequence;
+    Entry.Check     = CheckOf (Entry);
+    memset (Entry.Text, char ('a' + Producer), sizeof (Entry.Text) - 1);
+    Entry.Text[sizeof (Entry.Text) - 1] = 0x00;
+
+    return Entry;
+}
+
+static double ElapsedSeconds (std::chrono::steady_clock::time_point Start)
+{
+    return std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+}
+
+// *********************************************************************************************
+void test_queue_full_is_counted ()
+{
+    cMpscQueue <TestEntry_t, 16> Queue;
+    TestEntry_t Entry;
+
+    for (uint32_t index = 0;index < Queue.capacity ();++index)
+    {
+        TEST_ASSERT_TRUE (Queue.push (MakeEntry (0, index)));
+    }
+
+    TEST_ASSERT_FALSE (Queue.push (MakeEntry (0, 16)));
+    TEST_ASSERT_EQUAL_UINT32 (1, Queue.Overflows);
+
+    TEST_ASSERT_TRUE (Queue.pop (Entry));
+    TEST_ASSERT_EQUAL_UINT32 (0, Entry.Sequence);
+    TEST_ASSERT_TRUE (Queue.push (MakeEntry (0, 16)));
+}
+
+// *********************************************************************************************
+// Producers retry while the queue is full, as RunOnRadioTask() does. Nothing may be lost,
+// duplicated, reordered within a producer or torn.
+void test_queue_throughput ()
+{
+    static cMpscQueue <TestEntry_t, 16> Queue;
+    std::vector <std::thread>   Producers;
+    std::atomic <uint32_t>      Retries {0};
+    uint32_t                    NextSequence[PRODUCERS] = {0};
+    uint32_t                    Received    = 0;
+    uint32_t                    Errors      = 0;
+    TestEntry_t                 Entry {};
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        Producers.emplace_back ([&, Producer] ()
+                                {
+                                    for (uint32_t Sequence = 0;Sequence < PER_THREAD;++Sequence)
+                                    {
+                                        TestEntry_t NewEntry = MakeEntry (Producer, Sequence);
+
+                                        while (!Queue.push (NewEntry))
+                                        {
+                                            ++Retries;
+                                            std::this_thread::yield ();
+                                        }
+                                    }
+                                });
+    }
+
+    while (Received < (PRODUCERS * PER_THREAD))
+    {
+        if (!Queue.pop (Entry))
+        {
+            std::this_thread::yield ();
+            continue;
+        }
+
+        ++Received;
+
+        if ((Entry.Producer >= PRODUCERS) ||
+            (Entry.Check != CheckOf (Entry)) ||
+            (Entry.Sequence != NextSequence[Entry.Producer]) ||
+            (Entry.Text[0] != char ('a' + Entry.Producer)))
+        {
+            ++Errors;
+            continue;
+        }
+
+        ++NextSequence[Entry.Producer];
+    }
+
+    for (auto & Producer : Producers)
+    {
+        Producer.join ();
+    }
+
+    double Seconds = ElapsedSeconds (Start);
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "%u producers, %u entries in %.3f S (%.0f entries/S), %u full retries",
+              unsigned(PRODUCERS), unsigned(Received), Seconds, double (Received) / Seconds, unsigned(Retries.load ()));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0, Errors);
+    TEST_ASSERT_FALSE (Queue.pop (Entry));
+    TEST_ASSERT_TRUE (Queue.empty ());
+    TEST_ASSERT_EQUAL_UINT32 (Retries.load (), Queue.Overflows);
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        TEST_ASSERT_EQUAL_UINT32 (PER_THREAD, NextSequence[Producer]);
+    }
+}
+
+// *********************************************************************************************
+void test_latest_value_single_task ()
+{
+    cLatestValue <TestEntry_t> Slot;
+    TestEntry_t Entry;
+
+    TEST_ASSERT_FALSE (Slot.take (Entry));
+
+    Slot.put (MakeEntry (0, 1));
+    Slot.put (MakeEntry (0, 2));
+    Slot.put (MakeEntry (0, 3));
+
+    TEST_ASSERT_TRUE (Slot.take (Entry));
+    TEST_ASSERT_EQUAL_UINT32 (3, Entry.Sequence);
+    TEST_ASSERT_EQUAL_UINT32 (2, Slot.Replaced);
+    TEST_ASSERT_FALSE (Slot.take (Entry));
+
+    // get() still has the last value, the RT+ tags use that.
+    TEST_ASSERT_EQUAL_UINT32 (3, Slot.get ().Sequence);
+}
+
+// *********************************************************************************************
+// Putters never wait for the consumer. The consumer only sees newer values from each putter and
+// always ends with the last value put. Every put is either taken or counted as replaced.
+void test_latest_value_many_putters ()
+{
+    static cLatestValue <TestEntry_t> Slot;
+    std::vector <std::thread>   Producers;
+    std::atomic <uint32_t>      Running {PRODUCERS};
+    int64_t                     LastSequence[PRODUCERS];
+    uint32_t                    Taken   = 0;
+    uint32_t                    Errors  = 0;
+    TestEntry_t                 Entry {};
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        LastSequence[Producer] = -1;
+    }
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t Producer = 0;Producer < PRODUCERS;++Producer)
+    {
+        Producers.emplace_back ([&, Producer] ()
+                                {
+                                    for (uint32_t Sequence = 0;Sequence < PER_THREAD;++Sequence)
+                                    {
+                                        Slot.put (MakeEntry (Producer, Sequence));
+                                    }
+
+                                    --Running;
+                                });
+    }
+
+    do
+    {
+        bool Done = (0 == Running.load ());
+
+        while (Slot.take (Entry))
+        {
+            ++Taken;
+
+            if ((Entry.Producer >= PRODUCERS) ||
+                (Entry.Check != CheckOf (Entry)) ||
+                (int64_t (Entry.Sequence) <= LastSequence[Entry.Producer]))
+            {
+                ++Errors;
+                continue;
+            }
+
+            LastSequence[Entry.Producer] = Entry.Sequence;
+        }
+
+        if (Done)
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for (std::chrono::microseconds (50));
+    } while (true);
+
+    for (auto & Producer : Producers)
+    {
+        Producer.join ();
+    }
+
+    double Seconds = ElapsedSeconds (Start);
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "%u putters, %u puts in %.3f S (%.0f puts/S), %u taken, %u replaced",
+              unsigned(PRODUCERS), unsigned(PRODUCERS * PER_THREAD), Seconds, double (PRODUCERS * PER_THREAD) / Seconds,
+              unsigned(Taken), unsigned(Slot.Replaced.load ()));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0, Errors);
+    TEST_ASSERT_EQUAL_UINT32 (PRODUCERS * PER_THREAD, Taken + Slot.Replaced.load ());
+    TEST_ASSERT_EQUAL_UINT32 (PER_THREAD - 1, Entry.Sequence);
+    TEST_ASSERT_EQUAL_UINT32 (PER_THREAD - 1, Slot.get ().Sequence);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_queue_full_is_counted);
+    RUN_TEST (test_queue_throughput);
+    RUN_TEST (test_latest_value_single_task);
+    RUN_TEST (test_latest_value_many_putters);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,245 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    cRdsBitstream / cRdsDecoder: checkwords against the IEC 62106 generator matrix, encode and
+  *    decode round trips and single bit error correction. Run with: pio test -e native -f test_rds_bitstream
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <chrono>
+#include <unity.h>
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/RdsBitstream.cpp"
+
+// *********************************************************************************************
+static const cRdsEncoder::RdsGroup_t TestGroups[] =
+{
+    {0x12, 0x34, 0x01, 0x28, 0xE0, 0xCD, 'P', 'I'},
+    {0x12, 0x34, 0x21, 0x30, 'H', 'e', 'l', 'l'},
+    {0x12, 0x34, 0x41, 0x21, 0xD2, 0xBE, 0xDB, 0x6A},
+    {0x12, 0x34, 0x09, 0x28, 0x12, 0x34, 'X', 'E'},     // 0B, block 3 uses offset C'
+};
+
+static const size_t TestGroupCount = sizeof (TestGroups) / sizeof (TestGroups[0]);
+
+// Push a group through the decoder. Returns true if a group came out.
+static bool PushGroup (cRdsDecoder & Decoder, const cRdsBitstream::RdsBits_t & Bits, cRdsEncoder::RdsGroup_t & Group)
+{
+    bool Response = false;
+
+    for (size_t Index = 0;Index < RDS_GROUP_BITS;++Index)
+    {
+        if (Decoder.PushBit (cRdsBitstream::GetBit (Bits, Index)))
+        {
+            Decoder.GetGroup (Group);
+            Response = true;
+        }
+    }
+
+    return Response;
+}
+
+// *********************************************************************************************
+// Rows of the generator matrix (IEC 62106 annex B) are the checkwords of the single information bits.
+void test_checkword_generator_matrix ()
+{
+    TEST_ASSERT_EQUAL_HEX16 (0x077, cRdsBitstream::Checkword (0x8000, 0));
+    TEST_ASSERT_EQUAL_HEX16 (0x2E7, cRdsBitstream::Checkword (0x4000, 0));
+    TEST_ASSERT_EQUAL_HEX16 (0x1B9, cRdsBitstream::Checkword (0x0001, 0));
+
+    // The code is linear: the checkword of a sum is the sum of the checkwords.
+    TEST_ASSERT_EQUAL_HEX16 (0x077 ^ 0x1B9, cRdsBitstream::Checkword (0x8001, 0));
+
+    // An all zero block carries only its offset word.
+    TEST_ASSERT_EQUAL_HEX32 (cRdsBitstream::Offset_A, cRdsBitstream::EncodeBlock (0x0000, cRdsBitstream::Offset_A));
+}
+
+// *********************************************************************************************
+void test_round_trip ()
+{
+    cRdsDecoder             Decoder;
+    cRdsBitstream::RdsBits_t Bits;
+    cRdsEncoder::RdsGroup_t Group;
+
+    for (size_t Index = 0;Index < TestGroupCount;++Index)
+    {
+        cRdsBitstream::EncodeGroup (TestGroups[Index], Bits);
+        TEST_ASSERT_TRUE (PushGroup (Decoder, Bits, Group));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (TestGroups[Index], Group, RDS_GROUP_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32 (TestGroupCount,   Decoder.GroupsDecoded);
+    TEST_ASSERT_EQUAL_UINT32 (0,                Decoder.BlockErrors);
+}
+
+// *********************************************************************************************
+// The decoder finds the block boundaries in a stream that starts mid group.
+void test_sync_mid_stream ()
+{
+    cRdsDecoder             Decoder;
+    cRdsBitstream::RdsBits_t Bits;
+    cRdsEncoder::RdsGroup_t Group;
+
+    cRdsBitstream::EncodeGroup (TestGroups[1], Bits);
+
+    for (size_t Index = 37;Index < RDS_GROUP_BITS;++Index)
+    {
+        Decoder.PushBit (cRdsBitstream::GetBit (Bits, Index));
+    }
+
+    TEST_ASSERT_TRUE (Decoder.IsSynchronized ());
+
+    cRdsBitstream::EncodeGroup (TestGroups[0], Bits);
+    TEST_ASSERT_TRUE (PushGroup (Decoder, Bits, Group));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (TestGroups[0], Group, RDS_GROUP_SIZE);
+}
+
+// *********************************************************************************************
+// Differential coding survives the stream being split across calls.
+void test_differential_coding ()
+{
+    cRdsBitstream::RdsBits_t    Bits;
+    cRdsBitstream::RdsBits_t    Coded;
+    uint8_t                     EncodeState = 0;
+    uint8_t                     DecodeState = 0;
+
+    for (size_t Index = 0;Index < TestGroupCount;++Index)
+    {
+        cRdsBitstream::EncodeGroup (TestGroups[Index], Bits);
+        memcpy (Coded, Bits, sizeof (Coded));
+
+        cRdsBitstream::DifferentialEncode (Coded, RDS_GROUP_BITS, EncodeState);
+        TEST_ASSERT_FALSE (0 == memcmp (Coded, Bits, sizeof (Coded)));
+
+        cRdsBitstream::DifferentialDecode (Coded, RDS_GROUP_BITS, DecodeState);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (Bits, Coded, RDS_GROUP_BYTES);
+    }
+}
+
+// *********************************************************************************************
+// Every single bit error in every block is corrected.
+void test_single_bit_correction ()
+{
+    cRdsBitstream::RdsBits_t Bits;
+    cRdsEncoder::RdsGroup_t Group;
+
+    for (size_t GroupIndex = 0;GroupIndex < TestGroupCount;++GroupIndex)
+    {
+        for (size_t ErrorBit = 0;ErrorBit < RDS_GROUP_BITS;++ErrorBit)
+        {
+            cRdsDecoder Decoder;
+
+            // Sync on a clean group first. Errors are only corrected once the block positions are known.
+            cRdsBitstream::EncodeGroup (TestGroups[0], Bits);
+            PushGroup (Decoder, Bits, Group);
+
+            cRdsBitstream::EncodeGroup (TestGroups[GroupIndex], Bits);
+            Bits[ErrorBit >> 3] ^= uint8_t (0x80 >> (ErrorBit & 7));
+
+            TEST_ASSERT_TRUE (PushGroup (Decoder, Bits, Group));
+            TEST_ASSERT_EQUAL_HEX8_ARRAY (TestGroups[GroupIndex], Group, RDS_GROUP_SIZE);
+            TEST_ASSERT_EQUAL_UINT32 (1, Decoder.BlocksCorrected);
+            TEST_ASSERT_EQUAL_UINT32 (0, Decoder.BlockErrors);
+        }
+    }
+}
+
+// *********************************************************************************************
+// Two errors in one block are not corrected. The group is dropped and the decoder resyncs.
+void test_double_bit_error ()
+{
+    cRdsDecoder             Decoder;
+    cRdsBitstream::RdsBits_t Bits;
+    cRdsEncoder::RdsGroup_t Group;
+
+    cRdsBitstream::EncodeGroup (TestGroups[0], Bits);
+    PushGroup (Decoder, Bits, Group);
+
+    cRdsBitstream::EncodeGroup (TestGroups[1], Bits);
+    Bits[4] ^= 0x81;    // Two bits in block B
+    TEST_ASSERT_FALSE (PushGroup (Decoder, Bits, Group));
+    TEST_ASSERT_GREATER_THAN_UINT32 (0, Decoder.BlockErrors);
+
+    cRdsBitstream::EncodeGroup (TestGroups[2], Bits);
+    PushGroup (Decoder, Bits, Group);
+    cRdsBitstream::EncodeGroup (TestGroups[3], Bits);
+    TEST_ASSERT_TRUE (PushGroup (Decoder, Bits, Group));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (TestGroups[3], Group, RDS_GROUP_SIZE);
+}
+
+// *********************************************************************************************
+// Replay encoder output through the bitstream model. Groups must come out in order, none lost.
+void test_throughput ()
+{
+    const uint32_t              Groups = 20000;
+    cRdsEncoder                 Encoder;
+    cRdsDecoder                 Decoder;
+    cRdsBitstream::RdsBits_t    Bits;
+    cRdsEncoder::RdsGroup_t     Group;
+    uint32_t                    Mismatches = 0;
+
+    Encoder.SetPiCode (0x1234);
+    Encoder.SetProgramServiceName ("PIXEYFM");
+    Encoder.SetRadioText ("Merry Christmas from PixelRadio");
+
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t Count = 0;Count < Groups;++Count)
+    {
+        const cRdsEncoder::RdsGroup_t & Sent = (Count & 1) ? Encoder.GetRtGroup (uint8_t (Count >> 1)) : Encoder.GetPsGroup (uint8_t (Count >> 1));
+
+        cRdsBitstream::EncodeGroup (Sent, Bits);
+
+        if (!PushGroup (Decoder, Bits, Group) || (0 != memcmp (Sent, Group, RDS_GROUP_SIZE)))
+        {
+            ++Mismatches;
+        }
+    }
+
+    double Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+
+    char Message[100];
+    snprintf (Message, sizeof (Message), "%u groups in %.3f S (%.0f groups/S, on air: %.1f groups/S)",
+              unsigned(Groups), Seconds, Groups / Seconds, RDS_BIT_RATE / RDS_GROUP_BITS);
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (0,        Mismatches);
+    TEST_ASSERT_EQUAL_UINT32 (Groups,   Decoder.GroupsDecoded);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_checkword_generator_matrix);
+    RUN_TEST (test_round_trip);
+    RUN_TEST (test_sync_mid_stream);
+    RUN_TEST (test_differential_coding);
+    RUN_TEST (test_single_bit_correction);
+    RUN_TEST (test_double_bit_error);
+    RUN_TEST (test_throughput);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
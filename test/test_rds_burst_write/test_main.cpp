@@ -0,0 +1,179 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    QN8027Radio RDS group burst write. Counts I2C transactions per group on the mock bus and
+  *    compares them to one write per RDSD register. Run with: pio test -e native -f test_rds_burst_write
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/QN8027Radio.cpp"
+
+// *********************************************************************************************
+static const uint8_t TestGroup[RDS_GROUP_SIZE] = {0x12, 0x34, 0x20, 0x05, 0x48, 0x65, 0x6C, 0x6C};
+
+// Simulated chip: the RDS sent bit toggles one group time after the ready bit toggles.
+static uint32_t LoadTime    = 0;
+static uint8_t  SentBit     = 0;
+static uint8_t  LastReady   = 0;
+
+static void AttachChip ()
+{
+    LoadTime    = millis ();
+    SentBit     = 0;
+    LastReady   = 0;
+
+    Wire.OnWrite = [] (uint8_t Reg, uint8_t Data)
+                   {
+                       if ((SYSTEM_REG == Reg) && ((Data & 0x04) != LastReady))
+                       {
+                           LastReady    = Data & 0x04;
+                           LoadTime     = millis ();
+                       }
+                   };
+
+    Wire.OnRead = [] (uint8_t Reg) -> uint8_t
+                  {
+                      if (STATUS_REG != Reg)
+                      {
+                          return Wire.Registers[Reg];
+                      }
+
+                      if ((millis () - LoadTime) >= 88)
+                      {
+                          SentBit   ^= RDS_SENT_MASK;
+                          LoadTime  = millis () + 0x40000000;   // toggle once per load
+                      }
+
+                      return FSM_STATE_TRANSMIT | SentBit;
+                  };
+}
+
+static void DetachChip ()
+{
+    Wire.OnWrite    = nullptr;
+    Wire.OnRead     = nullptr;
+}
+
+// *********************************************************************************************
+void test_group_is_one_data_transaction ()
+{
+    QN8027Radio Radio;
+
+    Radio.sendRDSGroup (TestGroup);     // settle SYSTEM_REG in the shadow
+    Wire.ResetCounters ();
+    Radio.I2cWriteCount = 0;
+
+    Radio.sendRDSGroup (TestGroup);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (TestGroup, &Wire.Registers[RDSD0_REG], RDS_GROUP_SIZE);
+    // Burst with the eight data bytes plus the ready bit toggle.
+    TEST_ASSERT_EQUAL_UINT32 (2, Radio.I2cWriteCount);
+    TEST_ASSERT_EQUAL_UINT32 (RDS_GROUP_SIZE + 1, Wire.BytesWritten);
+}
+
+// *********************************************************************************************
+void test_burst_against_single_writes ()
+{
+    QN8027Radio Radio;
+
+    Radio.sendRDSGroup (TestGroup);
+    Wire.ResetCounters ();
+    Radio.sendRDSGroup (TestGroup);
+    uint32_t Burst = Wire.Transactions;
+
+    // The same group the way it was sent before: one transaction per register.
+    Wire.ResetCounters ();
+    Radio.readStatus ();
+
+    for (uint8_t Index = 0;Index < RDS_GROUP_SIZE;++Index)
+    {
+        Radio.write1Byte (RDSD0_REG + Index, TestGroup[Index]);
+    }
+
+    Radio.write1Byte (SYSTEM_REG, Wire.Registers[SYSTEM_REG] ^ 0x04);
+    uint32_t Single = Wire.Transactions;
+
+    char Message[80];
+    snprintf (Message, sizeof (Message), "I2C transactions per group: %u burst, %u single writes", unsigned(Burst), unsigned(Single));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (Burst + RDS_GROUP_SIZE - 1, Single);
+}
+
+// *********************************************************************************************
+// Stream queued groups through pollRDS() against the simulated chip, polling every 5mS.
+void test_polled_stream ()
+{
+    const uint32_t  Groups = 100;
+    QN8027Radio     Radio;
+
+    AttachChip ();
+    Radio.sendRDSGroup (TestGroup);
+    Wire.ResetCounters ();
+
+    uint32_t    Queued  = 0;
+    uint32_t    Start   = millis ();
+
+    while ((Radio.RdsGroupsSent < Groups) && ((millis () - Start) < (Groups * 200)))
+    {
+        while ((Queued < Groups) && (Radio.pendingRDSGroups () < 4))
+        {
+            Radio.queueRDSGroup (TestGroup);
+            ++Queued;
+        }
+
+        Radio.pollRDS ();
+        delay (5);
+    }
+
+    DetachChip ();
+
+    uint32_t Elapsed = millis () - Start;
+
+    char Message[100];
+    snprintf (Message, sizeof (Message), "%u groups in %u mS, %u I2C transactions (%u bytes written)",
+              unsigned(Radio.RdsGroupsSent), unsigned(Elapsed), unsigned(Wire.Transactions), unsigned(Wire.BytesWritten));
+    TEST_MESSAGE (Message);
+
+    TEST_ASSERT_EQUAL_UINT32 (Groups, Radio.RdsGroupsSent);
+    TEST_ASSERT_EQUAL_UINT32 (0, Radio.RdsSendTimeouts);
+    TEST_ASSERT_EQUAL_UINT32 (0, Radio.RdsGroupsDropped);
+    // Two writes per group, the rest are status polls (two transactions each).
+    TEST_ASSERT_EQUAL_UINT32 (Groups * (RDS_GROUP_SIZE + 1), Wire.BytesWritten);
+    TEST_ASSERT_LESS_THAN_UINT32 (Groups * 10, Wire.Transactions);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_group_is_one_data_transaction);
+    RUN_TEST (test_burst_against_single_writes);
+    RUN_TEST (test_polled_stream);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,330 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    cRdsEncoder group payloads against reference vectors (IEC 62106) for groups 0A, 2A, 3A, 4A
+  *    and 11A, and the method A AF list in the 0A groups. Run with: pio test -e native -f test_rds_encoder
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include "../../src/Radio/RdsEncoder.cpp"
+
+// *********************************************************************************************
+// PI 0x1234, PTY 9, TP off. Block 2 then starts with 0x0120 plus the group type.
+static void SetupStation (cRdsEncoder & Encoder)
+{
+    Encoder.SetPiCode (0x1234);
+    Encoder.SetPtyCode (9);
+}
+
+static void CheckGroup (const uint8_t (&Expected)[RDS_GROUP_SIZE], const cRdsEncoder::RdsGroup_t & Group)
+{
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (Expected, Group, RDS_GROUP_SIZE);
+}
+
+// *********************************************************************************************
+void test_group_0A ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    Encoder.SetProgramServiceName ("PIXEYFM");
+    TEST_ASSERT_EQUAL_UINT8 (RDS_PS_GROUP_COUNT, Encoder.GetPsGroupCount ());
+
+    // TA off, MS music, segment address in the low bits, no AF (224, 205), two PS characters.
+    const uint8_t Segment0[] = {0x12, 0x34, 0x01, 0x28, 0xE0, 0xCD, 'P', 'I'};
+    const uint8_t Segment1[] = {0x12, 0x34, 0x01, 0x29, 0xE0, 0xCD, 'X', 'E'};
+    const uint8_t Segment2[] = {0x12, 0x34, 0x01, 0x2A, 0xE0, 0xCD, 'Y', 'F'};
+    // DI d0 (stereo) is sent with the last segment. The name is padded with a space.
+    const uint8_t Segment3[] = {0x12, 0x34, 0x01, 0x2F, 0xE0, 0xCD, 'M', ' '};
+
+    CheckGroup (Segment0,   Encoder.GetPsGroup (0));
+    CheckGroup (Segment1,   Encoder.GetPsGroup (1));
+    CheckGroup (Segment2,   Encoder.GetPsGroup (2));
+    CheckGroup (Segment3,   Encoder.GetPsGroup (3));
+
+    // Mono clears the stereo bit.
+    Encoder.SetDecoderInfo (0);
+    const uint8_t Mono3[] = {0x12, 0x34, 0x01, 0x2B, 0xE0, 0xCD, 'M', ' '};
+    CheckGroup (Mono3, Encoder.GetPsGroup (3));
+}
+
+// *********************************************************************************************
+void test_group_2A ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    Encoder.SetRadioText ("Hello");
+    TEST_ASSERT_EQUAL_UINT8 (2, Encoder.GetRtGroupCount ());
+
+    // First text: A/B flag set. The text is terminated with 0x0D and padded with spaces.
+    const uint8_t Segment0[] = {0x12, 0x34, 0x21, 0x30, 'H', 'e', 'l', 'l'};
+    const uint8_t Segment1[] = {0x12, 0x34, 0x21, 0x31, 'o', 0x0D, ' ', ' '};
+
+    CheckGroup (Segment0,   Encoder.GetRtGroup (0));
+    CheckGroup (Segment1,   Encoder.GetRtGroup (1));
+
+    // A new text flips the A/B flag, the same text does not.
+    Encoder.SetRadioText ("Hello");
+    TEST_ASSERT_EQUAL_HEX8 (0x30, Encoder.GetRtGroup (0)[3]);
+    Encoder.SetRadioText ("World");
+    TEST_ASSERT_EQUAL_HEX8 (0x20, Encoder.GetRtGroup (0)[3]);
+
+    // 64 characters: no terminator, 16 groups.
+    Encoder.SetRadioText ("0123456789012345678901234567890123456789012345678901234567890123");
+    TEST_ASSERT_EQUAL_UINT8 (RDS_RT_MAX_GROUP_COUNT, Encoder.GetRtGroupCount ());
+    const uint8_t Segment15[] = {0x12, 0x34, 0x21, 0x3F, '0', '1', '2', '3'};
+    CheckGroup (Segment15, Encoder.GetRtGroup (15));
+}
+
+// *********************************************************************************************
+void test_group_4A ()
+{
+    cRdsEncoder             Encoder;
+    cRdsEncoder::RdsGroup_t Group;
+
+    TEST_ASSERT_EQUAL_UINT32 (0,        cRdsEncoder::ModifiedJulianDay (1858, 11, 17));
+    TEST_ASSERT_EQUAL_UINT32 (51544,    cRdsEncoder::ModifiedJulianDay (2000, 1, 1));
+    TEST_ASSERT_EQUAL_UINT32 (59743,    cRdsEncoder::ModifiedJulianDay (2022, 6, 13));
+
+    SetupStation (Encoder);
+
+    // 2022-06-13 13:45 UTC, local time UTC-5:00.
+    Encoder.BuildClockTimeGroup (Group, 59743, 13, 45, -10);
+    const uint8_t Expected[] = {0x12, 0x34, 0x41, 0x21, 0xD2, 0xBE, 0xDB, 0x6A};
+    CheckGroup (Expected, Group);
+
+    // Hour bit 4 lands in block 3, positive offset.
+    Encoder.BuildClockTimeGroup (Group, 51544, 23, 59, 2);
+    const uint8_t Late[] = {0x12, 0x34, 0x41, 0x21, 0x92, 0xB1, 0x7E, 0xC2};
+    CheckGroup (Late, Group);
+}
+
+// *********************************************************************************************
+void test_groups_3A_11A ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    TEST_ASSERT_EQUAL_UINT8 (0, Encoder.GetRtPlusGroupCount ());
+
+    // "Title - Artist": ItemTitle at 0 (5 characters), ItemArtist at 8 (6 characters).
+    Encoder.SetRtPlusTags (cRdsEncoder::RtPlus_ItemTitle, 0, 5, cRdsEncoder::RtPlus_ItemArtist, 8, 6);
+    TEST_ASSERT_EQUAL_UINT8 (2, Encoder.GetRtPlusGroupCount ());
+
+    // ODA announcement: application group 11A, AID 0x4BD7.
+    const uint8_t Oda[] = {0x12, 0x34, 0x31, 0x36, 0x00, 0x00, 0x4B, 0xD7};
+    // Item toggle set, item running, length markers hold length - 1.
+    const uint8_t Tags[] = {0x12, 0x34, 0xB1, 0x38, 0x20, 0x08, 0x21, 0x05};
+
+    CheckGroup (Oda,    Encoder.GetRtPlusGroup (0));
+    CheckGroup (Tags,   Encoder.GetRtPlusGroup (1));
+
+    // A new item flips the item toggle.
+    Encoder.SetRtPlusTags (cRdsEncoder::RtPlus_ItemTitle, 0, 7, cRdsEncoder::RtPlus_Dummy, 0, 0);
+    TEST_ASSERT_EQUAL_HEX8 (0x28, Encoder.GetRtPlusGroup (1)[3]);
+    TEST_ASSERT_EQUAL_HEX8 (0x0C, Encoder.GetRtPlusGroup (1)[5]);
+
+    Encoder.ClearRtPlusTags ();
+    TEST_ASSERT_EQUAL_UINT8 (0, Encoder.GetRtPlusGroupCount ());
+}
+
+// *********************************************************************************************
+void test_find_rt_plus_tags ()
+{
+    cRdsEncoder::RtPlusTags_t Tags;
+
+    TEST_ASSERT_TRUE (cRdsEncoder::FindRtPlusTags ("Now: Jingle Bells - Choir", "Jingle Bells - Choir", Tags));
+    TEST_ASSERT_EQUAL_UINT8 (cRdsEncoder::RtPlus_ItemTitle,     Tags.Type1);
+    TEST_ASSERT_EQUAL_UINT8 (5,                                 Tags.Start1);
+    TEST_ASSERT_EQUAL_UINT8 (12,                                Tags.Length1);
+    TEST_ASSERT_EQUAL_UINT8 (cRdsEncoder::RtPlus_ItemArtist,    Tags.Type2);
+    TEST_ASSERT_EQUAL_UINT8 (20,                                Tags.Start2);
+    TEST_ASSERT_EQUAL_UINT8 (5,                                 Tags.Length2);
+
+    TEST_ASSERT_FALSE (cRdsEncoder::FindRtPlusTags ("Merry Christmas", "Jingle Bells", Tags));
+    TEST_ASSERT_TRUE (Tags.IsEmpty ());
+}
+
+// *********************************************************************************************
+// Groups are rebuilt only when the station state changes.
+void test_cached_groups ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    Encoder.SetProgramServiceName ("PIXEYFM");
+
+    const uint8_t * First = Encoder.GetPsGroup (0);
+    uint8_t         Copy[RDS_GROUP_SIZE];
+    memcpy (Copy, First, sizeof (Copy));
+
+    Encoder.SetProgramServiceName ("PIXEYFM");
+    Encoder.SetPiCode (0x1234);
+    TEST_ASSERT_EQUAL_PTR (First, Encoder.GetPsGroup (0));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (Copy, Encoder.GetPsGroup (0), RDS_GROUP_SIZE);
+
+    Encoder.SetPiCode (0xC0DE);
+    TEST_ASSERT_EQUAL_HEX8 (0xC0, Encoder.GetPsGroup (0)[0]);
+    TEST_ASSERT_EQUAL_HEX8 (0xDE, Encoder.GetPsGroup (0)[1]);
+}
+
+// *********************************************************************************************
+// 87.6 MHz is code 1, 107.9 MHz is code 204. Anything else is not an AF.
+void test_af_code ()
+{
+    TEST_ASSERT_EQUAL_UINT8 (0,     cRdsEncoder::AfCode (875));
+    TEST_ASSERT_EQUAL_UINT8 (1,     cRdsEncoder::AfCode (876));
+    TEST_ASSERT_EQUAL_UINT8 (10,    cRdsEncoder::AfCode (885));
+    TEST_ASSERT_EQUAL_UINT8 (204,   cRdsEncoder::AfCode (1079));
+    TEST_ASSERT_EQUAL_UINT8 (0,     cRdsEncoder::AfCode (1080));
+    TEST_ASSERT_EQUAL_UINT8 (0,     cRdsEncoder::AfCode (0));
+}
+
+// *********************************************************************************************
+// Invalid codes are dropped, at most RDS_AF_MAX_COUNT are kept and an unchanged list does not
+// rebuild the groups.
+void test_af_list ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    Encoder.SetProgramServiceName ("PIXEYFM");
+
+    const uint8_t Codes[] = {0, 10, 205, 20, 255, 30};
+    Encoder.SetAlternativeFrequencies (Codes, sizeof (Codes));
+    TEST_ASSERT_EQUAL_UINT8 (3, Encoder.GetAlternativeFrequencyCount ());
+
+    const uint8_t * First = Encoder.GetPsGroup (0);
+    const uint8_t Same[] = {10, 20, 30};
+    Encoder.SetAlternativeFrequencies (Same, sizeof (Same));
+    TEST_ASSERT_EQUAL_PTR (First, Encoder.GetPsGroup (0));
+
+    uint8_t Many[RDS_AF_MAX_COUNT + 5];
+
+    for (uint8_t index = 0;index < sizeof (Many);++index)
+    {
+        Many[index] = uint8_t (index + 1);
+    }
+
+    Encoder.SetAlternativeFrequencies (Many, sizeof (Many));
+    TEST_ASSERT_EQUAL_UINT8 (RDS_AF_MAX_COUNT, Encoder.GetAlternativeFrequencyCount ());
+
+    Encoder.SetAlternativeFrequencies (nullptr, 0);
+    TEST_ASSERT_EQUAL_UINT8 (0, Encoder.GetAlternativeFrequencyCount ());
+    TEST_ASSERT_EQUAL_HEX8 (0xE0, Encoder.GetPsGroup (0)[4]);
+    TEST_ASSERT_EQUAL_HEX8 (0xCD, Encoder.GetPsGroup (0)[5]);
+}
+
+// *********************************************************************************************
+// Method A: "224 + count, AF1" then AF pairs in block 3 of the 0A groups. An odd pair is
+// padded with the filler code 205.
+void test_af_blocks_0A ()
+{
+    cRdsEncoder Encoder;
+
+    SetupStation (Encoder);
+    Encoder.SetProgramServiceName ("PIXEYFM");
+
+    // One AF: the same block in every group.
+    const uint8_t One[] = {10};
+    Encoder.SetAlternativeFrequencies (One, sizeof (One));
+    TEST_ASSERT_EQUAL_UINT8 (RDS_PS_GROUP_COUNT, Encoder.GetPsGroupCount ());
+
+    for (uint8_t index = 0;index < RDS_PS_GROUP_COUNT;++index)
+    {
+        TEST_ASSERT_EQUAL_HEX8 (0xE1,   Encoder.GetPsGroup (index)[4]);
+        TEST_ASSERT_EQUAL_HEX8 (10,     Encoder.GetPsGroup (index)[5]);
+    }
+
+    // Four AFs: the last pair gets the filler.
+    const uint8_t Four[] = {10, 20, 30, 40};
+    Encoder.SetAlternativeFrequencies (Four, sizeof (Four));
+    TEST_ASSERT_EQUAL_UINT8 (RDS_PS_GROUP_COUNT, Encoder.GetPsGroupCount ());
+
+    const uint8_t FourBlocks[][2] = {{0xE4, 10}, {20, 30}, {40, 0xCD}, {0xE4, 10}};
+
+    for (uint8_t index = 0;index < RDS_PS_GROUP_COUNT;++index)
+    {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (FourBlocks[index], &Encoder.GetPsGroup (index)[4], 2);
+    }
+
+    // 25 AFs: 13 blocks, sent in 16 groups so the name still ends complete.
+    uint8_t Codes[RDS_AF_MAX_COUNT];
+
+    for (uint8_t index = 0;index < RDS_AF_MAX_COUNT;++index)
+    {
+        Codes[index] = uint8_t (100 + index);
+    }
+
+    Encoder.SetAlternativeFrequencies (Codes, sizeof (Codes));
+    TEST_ASSERT_EQUAL_UINT8 (RDS_PS_MAX_GROUP_COUNT, Encoder.GetPsGroupCount ());
+    TEST_ASSERT_EQUAL_UINT8 (16, RDS_PS_MAX_GROUP_COUNT);
+
+    TEST_ASSERT_EQUAL_HEX8 (0xE0 + RDS_AF_MAX_COUNT,    Encoder.GetPsGroup (0)[4]);
+    TEST_ASSERT_EQUAL_HEX8 (100,                        Encoder.GetPsGroup (0)[5]);
+
+    for (uint8_t index = 1;index < RDS_AF_BLOCK_COUNT;++index)
+    {
+        TEST_ASSERT_EQUAL_HEX8 (100 + (index * 2) - 1,  Encoder.GetPsGroup (index)[4]);
+        TEST_ASSERT_EQUAL_HEX8 (100 + (index * 2),      Encoder.GetPsGroup (index)[5]);
+    }
+
+    for (uint8_t index = RDS_AF_BLOCK_COUNT;index < RDS_PS_MAX_GROUP_COUNT;++index)
+    {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (&Encoder.GetPsGroup (index - RDS_AF_BLOCK_COUNT)[4], &Encoder.GetPsGroup (index)[4], 2);
+    }
+
+    // Every group still carries its PS segment.
+    for (uint8_t index = 0;index < RDS_PS_MAX_GROUP_COUNT;++index)
+    {
+        TEST_ASSERT_EQUAL_HEX8 (index % RDS_PS_GROUP_COUNT, Encoder.GetPsGroup (index)[3] & 0x03);
+        TEST_ASSERT_EQUAL_HEX8 ("PIXEYFM "[(index % RDS_PS_GROUP_COUNT) * 2], Encoder.GetPsGroup (index)[6]);
+    }
+
+    // 24 AFs: the same 13 blocks, the last one padded.
+    Encoder.SetAlternativeFrequencies (Codes, RDS_AF_MAX_COUNT - 1);
+    TEST_ASSERT_EQUAL_HEX8 (0xE0 + RDS_AF_MAX_COUNT - 1,    Encoder.GetPsGroup (0)[4]);
+    TEST_ASSERT_EQUAL_HEX8 (100 + RDS_AF_MAX_COUNT - 2,     Encoder.GetPsGroup (RDS_AF_BLOCK_COUNT - 1)[4]);
+    TEST_ASSERT_EQUAL_HEX8 (0xCD,                           Encoder.GetPsGroup (RDS_AF_BLOCK_COUNT - 1)[5]);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_group_0A);
+    RUN_TEST (test_group_2A);
+    RUN_TEST (test_group_4A);
+    RUN_TEST (test_groups_3A_11A);
+    RUN_TEST (test_find_rt_plus_tags);
+    RUN_TEST (test_cached_groups);
+    RUN_TEST (test_af_code);
+    RUN_TEST (test_af_list);
+    RUN_TEST (test_af_blocks_0A);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
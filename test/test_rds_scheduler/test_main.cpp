@@ -0,0 +1,278 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    RdsScheduler policies. Six controllers with different weights and message lengths share the
+  *    RadioText slot on a simulated clock. Each policy is checked for its fairness promise and
+  *    reports picks per second, air time share and the longest gap a source waited.
+  *    Run with: pio test -e native -f test_rds_scheduler
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <chrono>
+#include "../../src/Controllers/RdsScheduler.cpp"
+
+// *********************************************************************************************
+static const uint8_t    SOURCES = 6;
+
+struct TestSource_t
+{
+    uint8_t     Weight;
+    uint32_t    DurationMs;
+    bool        Active;
+    uint32_t    Served;
+    uint64_t    AirTimeMs;
+    uint32_t    LastServed;
+    uint32_t    LongestGap;
+};
+
+static TestSource_t Sources[SOURCES];
+static uint32_t     Now = 0;
+
+static bool Serve (uint8_t Id, uint32_t & DurationMs, void *)
+{
+    TestSource_t & Source = Sources[Id];
+
+    if (!Source.Active)
+    {
+        return false;
+    }
+
+    DurationMs = Source.DurationMs;
+    return true;
+}
+
+// Weights 1,1,2,1,4,2 and message lengths from 5 to 20 seconds.
+static void Setup (cRdsScheduler & Scheduler, cRdsScheduler::Policy_e Policy)
+{
+    static const uint8_t    Weights[SOURCES]    = {1, 1, 2, 1, 4, 2};
+    static const uint32_t   Durations[SOURCES]  = {5000, 10000, 20000, 7000, 5000, 15000};
+
+    Now = 0;
+
+    for (uint8_t Id = 0;Id < SOURCES;++Id)
+    {
+        Sources[Id] = {Weights[Id], Durations[Id], true, 0, 0, 0, 0};
+        Scheduler.AddSource (Id, Id, Weights[Id]);
+    }
+
+    Scheduler.SetPolicy (Policy);
+}
+
+// Returns picks per second of host time.
+static double Run (cRdsScheduler & Scheduler, uint32_t Picks)
+{
+    auto Start = std::chrono::steady_clock::now ();
+
+    for (uint32_t Pick = 0;Pick < Picks;++Pick)
+    {
+        int16_t Id = Scheduler.Pick (Serve, nullptr, Now);
+
+        if (Id < 0)
+        {
+            Now += 1000;
+            continue;
+        }
+
+        TestSource_t & Source = Sources[Id];
+        uint32_t Gap = Now - Source.LastServed;
+        Source.LongestGap   = (Gap > Source.LongestGap) ? Gap : Source.LongestGap;
+        Source.LastServed   = Now;
+        ++Source.Served;
+        Source.AirTimeMs    += Source.DurationMs;
+        Now                 += Source.DurationMs;
+    }
+
+    double Seconds = std::chrono::duration <double> (std::chrono::steady_clock::now () - Start).count ();
+    return double (Picks) / Seconds;
+}
+
+static void Report (const char * Name, double PicksPerSecond)
+{
+    uint64_t TotalAirTime = 0;
+
+    for (auto & Source : Sources)
+    {
+        TotalAirTime += Source.AirTimeMs;
+    }
+
+    char Message[200];
+    int  Length = snprintf (Message, sizeof (Message), "%-20s %9.0f picks/S, air %%/longest gap S:", Name, PicksPerSecond);
+
+    for (auto & Source : Sources)
+    {
+        Length += snprintf (&Message[Length], sizeof (Message) - Length, " %4.1f/%u",
+                            TotalAirTime ? (100.0 * double (Source.AirTimeMs) / double (TotalAirTime)) : 0.0,
+                            unsigned(Source.LongestGap / 1000));
+    }
+
+    TEST_MESSAGE (Message);
+}
+
+static const uint32_t PICKS = 200000;
+
+// *********************************************************************************************
+void test_strict_priority ()
+{
+    cRdsScheduler Scheduler;
+
+    Setup (Scheduler, cRdsScheduler::PolicyStrictPriority);
+    Sources[0].Active = false;
+    Report ("Strict Priority", Run (Scheduler, PICKS));
+
+    // Only the most important source with a message is heard.
+    TEST_ASSERT_EQUAL_UINT32 (0, Sources[0].Served);
+    TEST_ASSERT_EQUAL_UINT32 (PICKS, Sources[1].Served);
+
+    for (uint8_t Id = 2;Id < SOURCES;++Id)
+    {
+        TEST_ASSERT_EQUAL_UINT32 (0, Sources[Id].Served);
+    }
+}
+
+// *********************************************************************************************
+// Messages (not air time) follow the weights.
+void test_weighted_round_robin ()
+{
+    cRdsScheduler Scheduler;
+
+    Setup (Scheduler, cRdsScheduler::PolicyWeightedRoundRobin);
+    Report ("Weighted Round Robin", Run (Scheduler, PICKS));
+
+    uint32_t TotalWeight = 0;
+
+    for (auto & Source : Sources)
+    {
+        TotalWeight += Source.Weight;
+    }
+
+    for (auto & Source : Sources)
+    {
+        uint32_t Expected = uint32_t ((uint64_t (PICKS) * Source.Weight) / TotalWeight);
+        TEST_ASSERT_UINT32_WITHIN (SOURCES, Expected, Source.Served);
+    }
+}
+
+// *********************************************************************************************
+// Air time follows the weights even though the message lengths differ.
+void test_deficit_round_robin ()
+{
+    cRdsScheduler Scheduler;
+
+    Setup (Scheduler, cRdsScheduler::PolicyDeficitRoundRobin);
+    Report ("Deficit Round Robin", Run (Scheduler, PICKS));
+
+    uint32_t TotalWeight    = 0;
+    uint64_t TotalAirTime   = 0;
+
+    for (auto & Source : Sources)
+    {
+        TotalWeight     += Source.Weight;
+        TotalAirTime    += Source.AirTimeMs;
+    }
+
+    for (auto & Source : Sources)
+    {
+        double Share    = double (Source.AirTimeMs) / double (TotalAirTime);
+        double Expected = double (Source.Weight) / double (TotalWeight);
+        TEST_ASSERT_FLOAT_WITHIN (0.01, Expected, Share);
+    }
+}
+
+// *********************************************************************************************
+// Every source is heard. Heavier sources wait less.
+void test_earliest_deadline ()
+{
+    cRdsScheduler Scheduler;
+
+    Setup (Scheduler, cRdsScheduler::PolicyEarliestDeadline);
+    Report ("Earliest Deadline", Run (Scheduler, PICKS));
+
+    uint32_t LongestMessage = 0;
+
+    for (auto & Source : Sources)
+    {
+        LongestMessage = (Source.DurationMs > LongestMessage) ? Source.DurationMs : LongestMessage;
+    }
+
+    for (auto & Source : Sources)
+    {
+        TEST_ASSERT_GREATER_THAN_UINT32 (0, Source.Served);
+        // One period per weight plus one message from every other source.
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32 ((Scheduler.EdfPeriodMs / Source.Weight) + (SOURCES * LongestMessage), Source.LongestGap);
+    }
+
+    TEST_ASSERT_LESS_THAN_UINT32 (Sources[0].LongestGap, Sources[4].LongestGap);
+}
+
+// *********************************************************************************************
+// A source that was quiet rejoins at the current round instead of cashing in the credit it
+// would have banked, so it does not lock out the others.
+void test_idle_source_rejoins ()
+{
+    static const cRdsScheduler::Policy_e Policies[] = {cRdsScheduler::PolicyWeightedRoundRobin, cRdsScheduler::PolicyDeficitRoundRobin};
+
+    for (auto Policy : Policies)
+    {
+        cRdsScheduler Scheduler;
+
+        Setup (Scheduler, Policy);
+        Sources[4].Active = false;
+        Run (Scheduler, PICKS / 2);
+
+        Sources[4].Active = true;
+        uint32_t Before = Sources[4].Served;
+        uint32_t Others = 0;
+
+        for (uint32_t Pick = 0;Pick < 20;++Pick)
+        {
+            int16_t Id = Scheduler.Pick (Serve, nullptr, Now);
+            Now += Sources[Id].DurationMs;
+            ++Sources[Id].Served;
+            Others += (4 == Id) ? 0 : 1;
+        }
+
+        char Message[100];
+        snprintf (Message, sizeof (Message), "Policy %u: returning source took %u of the next 20 slots",
+                  unsigned(Policy), unsigned(Sources[4].Served - Before));
+        TEST_MESSAGE (Message);
+
+        TEST_ASSERT_GREATER_THAN_UINT32 (0, Sources[4].Served - Before);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32 (5, Others);
+    }
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_strict_priority);
+    RUN_TEST (test_weighted_round_robin);
+    RUN_TEST (test_deficit_round_robin);
+    RUN_TEST (test_earliest_deadline);
+    RUN_TEST (test_idle_source_rejoins);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
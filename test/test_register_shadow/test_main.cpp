@@ -0,0 +1,147 @@
+/*
+  *    File: test_main.cpp
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    QN8027Radio register shadow. Counts I2C transactions on the mock bus with and without the
+  *    shadow. Run with: pio test -e native -f test_register_shadow
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/QN8027Radio.cpp"
+
+// *********************************************************************************************
+// One pass of the settings a web page refresh or a config restore pushes to the chip.
+// setFrequency() is left out, it writes SYSTEM_REG without the status bits that the others restore.
+static void ApplySettings (QN8027Radio & Radio)
+{
+    Radio.setTxPower (75);
+    Radio.setPreEmphTime50 (OFF);
+    Radio.MonoAudio (OFF);
+    Radio.mute (OFF);
+    Radio.setTxFreqDeviation (129);
+    Radio.setTxPilotFreqDeviation (9);
+    Radio.setRDSFreqDeviation (6);
+    Radio.setTxInputBufferGain (3);
+    Radio.setTxDigitalGain (0);
+    Radio.setAudioInpImp (20);
+}
+
+// *********************************************************************************************
+void test_unchanged_writes_are_skipped ()
+{
+    QN8027Radio Radio;
+
+    ApplySettings (Radio);
+    Wire.ResetCounters ();
+    Radio.I2cWritesSkipped = 0;
+
+    ApplySettings (Radio);
+    TEST_ASSERT_EQUAL_UINT32 (0, Wire.Transactions);
+    TEST_ASSERT_GREATER_THAN_UINT32 (0, Radio.I2cWritesSkipped);
+}
+
+// *********************************************************************************************
+void test_transactions_before_and_after ()
+{
+    const uint32_t  Passes = 100;
+    QN8027Radio     Radio;
+
+    // Without the shadow every writeReg() went to the bus, so skipped writes count as transactions.
+    Wire.ResetCounters ();
+    Radio.I2cWritesSkipped = 0;
+
+    ApplySettings (Radio);
+    uint32_t FirstPass = Wire.Transactions;
+
+    for (uint32_t Pass = 1;Pass < Passes;++Pass)
+    {
+        ApplySettings (Radio);
+    }
+
+    uint32_t    Shadowed    = Wire.Transactions;
+    uint32_t    Unshadowed  = Shadowed + Radio.I2cWritesSkipped;
+
+    char Message[80];
+    snprintf (Message, sizeof (Message), "I2C transactions for %u passes: %u without shadow, %u with shadow",
+              unsigned(Passes), unsigned(Unshadowed), unsigned(Shadowed));
+    TEST_MESSAGE (Message);
+
+    // Only the first pass reaches the bus.
+    TEST_ASSERT_EQUAL_UINT32 (FirstPass, Shadowed);
+    TEST_ASSERT_GREATER_THAN_UINT32 (Shadowed * (Passes - 1), Unshadowed);
+}
+
+// *********************************************************************************************
+void test_cached_reads_stay_off_the_bus ()
+{
+    QN8027Radio Radio;
+
+    Radio.setFrequency (107.9f);
+    Wire.ResetCounters ();
+
+    for (int Count = 0;Count < 50;++Count)
+    {
+        TEST_ASSERT_FLOAT_WITHIN (0.01f, 107.9f, Radio.getFrequency ());
+    }
+
+    TEST_ASSERT_EQUAL_UINT32 (0, Wire.Transactions);
+
+    // Status is volatile and always read from the chip.
+    Radio.readStatus ();
+    TEST_ASSERT_GREATER_THAN_UINT32 (0, Wire.Transactions);
+}
+
+// *********************************************************************************************
+void test_deferred_writes_are_flushed_once ()
+{
+    QN8027Radio Radio;
+
+    ApplySettings (Radio);
+    Wire.ResetCounters ();
+
+    Radio.setDeferredWrites (true);
+    Radio.setTxPower (40);
+    Radio.setTxPower (50);
+    Radio.setTxPower (60);
+    TEST_ASSERT_EQUAL_UINT32 (0, Wire.Transactions);
+    TEST_ASSERT_TRUE (Radio.hasDirtyRegisters ());
+
+    Radio.setDeferredWrites (false);
+    TEST_ASSERT_EQUAL_UINT32 (1, Wire.Transactions);
+    TEST_ASSERT_FALSE (Radio.hasDirtyRegisters ());
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_unchanged_writes_are_skipped);
+    RUN_TEST (test_transactions_before_and_after);
+    RUN_TEST (test_cached_reads_stay_off_the_bus);
+    RUN_TEST (test_deferred_writes_are_flushed_once);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF
@@ -0,0 +1,339 @@
+/*
+  *    File: test_main.cpp (test_rt_plus)
+  *    Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+  *    Version: 1.1.0
+  *    Creation: Dec-16-2021
+  *    Revised:  Jun-13-2022
+  *    Revision History: See PixelRadio.cpp
+  *    Project Leader: T. Black (thomastech)
+  *    Contributors: thomastech
+  *
+  *    (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this license absolutely no warranty is given.
+  *    This Code was formatted with the uncrustify extension.
+  *
+  *    RT+ for FPPD sequence names. The messages of a sequence's message set are picked the way
+  *    RdsText picks them, with and without RT+ tagging, and sent to a simulated chip next to a
+  *    dynamic PS. Reports the cost of a tagged pick, the on air group mix and the RadioText and
+  *    RT+ latency, and checks that RT+ never delays RadioText.
+  *    Run with: pio test -e native -f test_rt_plus
+  */
+
+// *********************************************************************************************
+#ifdef ARDUINO
+    #include <Arduino.h>
+#endif // ifdef ARDUINO
+#include <unity.h>
+#include <chrono>
+#include <vector>
+#include "../../src/language.cpp"
+#include "../../src/Radio/RdsEncoder.cpp"
+#include "../../src/Radio/QN8027Radio.cpp"
+#include "../../src/Controllers/MessagePool.cpp"
+#include "../../src/Controllers/MessageSchedule.cpp"
+#include "../../src/Controllers/ControllerMessage.cpp"
+#include "../../src/Controllers/ControllerMessageSet.cpp"
+#include "../../src/Controllers/ControllerMessages.cpp"
+
+// *********************************************************************************************
+static const char       * SEQUENCE          = "Jingle Bells - Trans-Siberian Choir";
+static const char       * TEXTS []          =
+{
+    "Now playing: Jingle Bells - Trans-Siberian Choir",
+    "Jingle Bells - Trans-Siberian Choir on PixelRadio 88.5",
+    "Tune to 88.5 FM, lights are synced to the music",
+    "Please turn off your headlights. Happy Holidays!",
+};
+static const uint32_t   TEXT_COUNT          = sizeof (TEXTS) / sizeof (TEXTS[0]);
+static const uint32_t   MESSAGE_MS          = 5000;     // Default message duration.
+static const uint32_t   PS_FRAME_MS         = 2000;     // Dynamic PS frame time.
+static const uint32_t   LOOP_MS             = 5;
+static const uint32_t   GROUP_MS            = 88;
+
+void setUp ()
+{
+    c_ControllerMessages::SetOwnerTask (xTaskGetCurrentTaskHandle ());
+}
+
+void tearDown ()
+{
+    c_ControllerMessages::ApplyPendingEdits ();
+    c_ControllerMessages::SetOwnerTask (NULL);
+}
+
+static void AddSequence (c_ControllerMessages & Messages, bool Tagging)
+{
+    Messages.SetRtPlusTagging (Tagging);
+    Messages.AddControls (1);
+
+    for (auto Text : TEXTS)
+    {
+        Messages.AddMessage (SEQUENCE, Text);
+    }
+}
+
+// Every group the chip took.
+struct Loaded_t
+{
+    uint32_t    Ms;
+    uint8_t     Type;
+};
+
+static std::vector <Loaded_t>   Loaded;
+
+// Simulated chip: the RDS sent bit toggles one group time after the ready bit toggles.
+static uint32_t LoadTime    = 0;
+static uint8_t  SentBit     = 0;
+static uint8_t  LastReady   = 0;
+
+static void AttachChip ()
+{
+    LoadTime    = millis ();
+    SentBit     = 0;
+    LastReady   = 0;
+    Loaded.clear ();
+
+    Wire.OnWrite = [] (uint8_t Reg, uint8_t Data)
+                   {
+                       if ((SYSTEM_REG == Reg) && ((Data & 0x04) != LastReady))
+                       {
+                           LastReady    = Data & 0x04;
+                           LoadTime     = millis ();
+                           Loaded.push_back ({millis (), uint8_t (Wire.Registers[RDSD0_REG + 2] >> 4)});
+                       }
+                   };
+
+    Wire.OnRead = [] (uint8_t Reg) -> uint8_t
+                  {
+                      if (STATUS_REG != Reg)
+                      {
+                          return Wire.Registers[Reg];
+                      }
+
+                      if ((millis () - LoadTime) >= GROUP_MS)
+                      {
+                          SentBit   ^= RDS_SENT_MASK;
+                          LoadTime  = millis () + 0x40000000;   // toggle once per load
+                      }
+
+                      return FSM_STATE_TRANSMIT | SentBit;
+                  };
+}
+
+static void DetachChip ()
+{
+    Wire.OnWrite    = nullptr;
+    Wire.OnRead     = nullptr;
+}
+
+// *********************************************************************************************
+// The tags are found once per message text. After that a tagged pick costs the same as an
+// untagged one and always carries the same tags.
+void test_tags_cached_per_message ()
+{
+    const uint32_t  Picks = 200000;
+    double          NsPerPick[2];
+
+    for (uint32_t Tagging = 0;Tagging < 2;++Tagging)
+    {
+        c_ControllerMessages            Messages;
+        c_ControllerMgr::RdsMsgInfo_t   Info;
+        uint32_t                        Tagged = 0;
+
+        AddSequence (Messages, Tagging);
+
+        auto Start = std::chrono::steady_clock::now ();
+
+        for (uint32_t Count = 0;Count < Picks;++Count)
+        {
+            Messages.GetNextRdsMessage (SEQUENCE, Info);
+            Tagged += Info.RtPlus.IsEmpty () ? 0 : 1;
+        }
+
+        NsPerPick[Tagging] = std::chrono::duration <double, std::nano> (std::chrono::steady_clock::now () - Start).count () / Picks;
+
+        // Two of the four texts contain the sequence name.
+        TEST_ASSERT_EQUAL_UINT32 (Tagging ? (Picks / 2) : 0, Tagged);
+
+        for (uint32_t Count = 0;Count < TEXT_COUNT;++Count)
+        {
+            cRdsEncoder::RtPlusTags_t Expected;
+
+            Messages.GetNextRdsMessage (SEQUENCE, Info);
+
+            if (Tagging)
+            {
+                cRdsEncoder::FindRtPlusTags (Info.Text, SEQUENCE, Expected);
+            }
+
+            TEST_ASSERT_EQUAL_MEMORY (&Expected, &Info.RtPlus, sizeof (Expected));
+        }
+
+        MessagePool.Release (Info.Handle);
+    }
+
+    char Message[120];
+    snprintf (Message, sizeof (Message), "Message pick: %.0f nS untagged, %.0f nS with RT+ tags", NsPerPick[0], NsPerPick[1]);
+    TEST_MESSAGE (Message);
+}
+
+// *********************************************************************************************
+// Messages change every MESSAGE_MS while a dynamic PS sends a frame every PS_FRAME_MS. RT+ adds
+// its two groups per message after the RadioText: same RT groups, same RT latency.
+void test_group_mix_and_rt_latency ()
+{
+    const uint32_t  Minutes         = 10;
+    const char      * Names []      = {"PS", "RT", "3A", "11A", "Other"};
+    uint32_t        Mix[2][5]       = {{0}};
+    uint32_t        WorstRtMs[2]    = {0};
+    uint64_t        TotalRtMs[2]    = {0};
+    uint32_t        WorstRtPlusMs   = 0;
+    uint32_t        MessagesSent    = 0;
+
+    for (uint32_t Tagging = 0;Tagging < 2;++Tagging)
+    {
+        c_ControllerMessages            Messages;
+        c_ControllerMgr::RdsMsgInfo_t   Info;
+        QN8027Radio                     Radio;
+        std::vector <uint32_t>          SendTimes;
+        uint32_t                        PsFrame = 0;
+
+        AddSequence (Messages, Tagging);
+        MockMillis () = 0;
+        Radio.sendStationName ("PIXLRADO");
+        Radio.clearRDSQueue ();
+        AttachChip ();
+
+        uint32_t    NextMessage = 0;
+        uint32_t    NextPsFrame = 0;
+
+        for (uint32_t Now = 0;Now < (Minutes * 60 * 1000);Now += LOOP_MS)
+        {
+            if (Now >= NextMessage)
+            {
+                Messages.GetNextRdsMessage (SEQUENCE, Info);
+                Radio.setRtPlusTags (Info.RtPlus);
+                Radio.sendRadioText (Info.Text);
+                SendTimes.push_back (Now);
+                NextMessage += MESSAGE_MS;
+            }
+
+            if (Now >= NextPsFrame)
+            {
+                Radio.sendStationName ((PsFrame++ & 1) ? "88.5 FM " : "PIXLRADO");
+                NextPsFrame += PS_FRAME_MS;
+            }
+
+            Radio.pollRDS ();
+            delay (LOOP_MS);
+        }
+
+        DetachChip ();
+        MessagePool.Release (Info.Handle);
+        MessagesSent = uint32_t (SendTimes.size ());
+
+        // The last RT group of each message marks the text complete on air.
+        uint32_t    Message         = 0;
+        uint32_t    LastRt          = 0;
+        bool        HaveRt          = false;
+
+        auto EndOfMessage = [&] ()
+                            {
+                                if (HaveRt)
+                                {
+                                    uint32_t Latency = LastRt - SendTimes[Message];
+                                    WorstRtMs[Tagging]  = std::max (WorstRtMs[Tagging], Latency);
+                                    TotalRtMs[Tagging] += Latency;
+                                }
+
+                                HaveRt = false;
+                            };
+
+        for (auto & Entry : Loaded)
+        {
+            while (((Message + 1) < SendTimes.size ()) && (Entry.Ms >= SendTimes[Message + 1]))
+            {
+                EndOfMessage ();
+                ++Message;
+            }
+
+            switch (Entry.Type)
+            {
+                case cRdsEncoder::GroupType_PS:     {++Mix[Tagging][0]; break;}
+                case cRdsEncoder::GroupType_RT:     {++Mix[Tagging][1]; LastRt = Entry.Ms; HaveRt = true; break;}
+                case cRdsEncoder::GroupType_ODA:    {++Mix[Tagging][2]; break;}
+                case cRdsEncoder::GroupType_RTPLUS:
+                {
+                    ++Mix[Tagging][3];
+                    WorstRtPlusMs = std::max (WorstRtPlusMs, Entry.Ms - SendTimes[Message]);
+                    break;
+                }
+                default:                            {++Mix[Tagging][4]; break;}
+            } // switch
+        }
+
+        EndOfMessage ();
+
+        TEST_ASSERT_EQUAL_UINT32 (0, Radio.RdsGroupsDropped);
+        TEST_ASSERT_EQUAL_UINT32 (0, Radio.RdsSendTimeouts);
+    }
+
+    char Message[160];
+
+    for (uint32_t Tagging = 0;Tagging < 2;++Tagging)
+    {
+        uint32_t Total = 0;
+
+        for (auto Count : Mix[Tagging])
+        {
+            Total += Count;
+        }
+
+        int Length = snprintf (Message, sizeof (Message), "RT+ %s: %u groups,", Tagging ? "on " : "off", unsigned(Total));
+
+        for (uint32_t Type = 0;Type < 5;++Type)
+        {
+            Length += snprintf (&Message[Length], sizeof (Message) - size_t (Length), " %s %.1f%%", Names[Type], (100.0 * Mix[Tagging][Type]) / Total);
+        }
+
+        TEST_MESSAGE (Message);
+
+        snprintf (Message, sizeof (Message), "RT+ %s: RadioText on air in %u mS on average, %u mS worst",
+                  Tagging ? "on " : "off", unsigned(TotalRtMs[Tagging] / MessagesSent), unsigned(WorstRtMs[Tagging]));
+        TEST_MESSAGE (Message);
+    }
+
+    snprintf (Message, sizeof (Message), "RT+ tags on air within %u mS of the message", unsigned(WorstRtPlusMs));
+    TEST_MESSAGE (Message);
+
+    // Same PS and RT groups, plus one 3A and one 11A for each tagged message.
+    TEST_ASSERT_EQUAL_UINT32 (Mix[0][0], Mix[1][0]);
+    TEST_ASSERT_EQUAL_UINT32 (Mix[0][1], Mix[1][1]);
+    TEST_ASSERT_EQUAL_UINT32 (0, Mix[0][2] + Mix[0][3]);
+    TEST_ASSERT_EQUAL_UINT32 (MessagesSent / 2, Mix[1][2]);
+    TEST_ASSERT_EQUAL_UINT32 (MessagesSent / 2, Mix[1][3]);
+    TEST_ASSERT_EQUAL_UINT32 (0, Mix[0][4] + Mix[1][4]);
+
+    // RadioText is not held back by RT+, and the tags go out while their message is current.
+    TEST_ASSERT_EQUAL_UINT32 (WorstRtMs[0], WorstRtMs[1]);
+    TEST_ASSERT_EQUAL_UINT32 (TotalRtMs[0], TotalRtMs[1]);
+    TEST_ASSERT_LESS_THAN_UINT32 (MESSAGE_MS, WorstRtPlusMs);
+}
+
+// *********************************************************************************************
+static void RunTests ()
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_tags_cached_per_message);
+    RUN_TEST (test_group_mix_and_rt_latency);
+    UNITY_END ();
+}
+
+#ifdef ARDUINO
+    void setup ()   {delay (2000); RunTests ();}
+    void loop ()    {}
+#else // ifdef ARDUINO
+    int main (int, char **) {RunTests (); return 0;}
+#endif // ifdef ARDUINO
+
+// *********************************************************************************************
+// OEF